@@ -0,0 +1,98 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+#ifndef dealii_atomic_add_h
+#define dealii_atomic_add_h
+
+
+#include <deal.II/base/config.h>
+
+#include <atomic>
+#include <complex>
+#include <mutex>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * @addtogroup threads
+ * @{
+ */
+
+namespace Threads
+{
+  /**
+   * Add @p value to @p target as one indivisible operation, i.e., such that
+   * several threads can add to the same memory location at the same time
+   * without losing any of their contributions. The memory location itself
+   * does not need to be of type `std::atomic`: this function is meant for
+   * arrays of plain numbers, such as the values of a matrix or a vector,
+   * into which most of the time only one thread writes.
+   *
+   * No ordering with respect to other memory operations is implied. All
+   * contributions are only guaranteed to be visible once the threads adding
+   * them have been joined, as is the case at the end of WorkStream::run() or
+   * parallel::apply_to_subranges().
+   *
+   * The function uses `std::atomic_ref` if deal.II is compiled with C++20
+   * support, and a compare-and-swap loop via compiler intrinsics otherwise.
+   */
+  template <typename Number>
+  inline void
+  atomic_add(Number &target, const Number value)
+  {
+#if defined(DEAL_II_HAVE_CXX20) && defined(__cpp_lib_atomic_ref)
+    std::atomic_ref<Number>(target).fetch_add(value,
+                                              std::memory_order_relaxed);
+#elif defined(__GNUC__) || defined(__clang__)
+    Number expected;
+    __atomic_load(&target, &expected, __ATOMIC_RELAXED);
+    Number desired = expected + value;
+    while (!__atomic_compare_exchange(&target,
+                                      &expected,
+                                      &desired,
+                                      /* weak */ true,
+                                      __ATOMIC_RELAXED,
+                                      __ATOMIC_RELAXED))
+      desired = expected + value;
+#else
+    static std::mutex           mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    target += value;
+#endif
+  }
+
+
+
+  /**
+   * Same as above, but for complex numbers. The real and imaginary parts are
+   * added individually, which is enough to not lose any contribution since
+   * additions commute.
+   */
+  template <typename Number>
+  inline void
+  atomic_add(std::complex<Number> &target, const std::complex<Number> value)
+  {
+    // the standard guarantees that a complex number can be accessed as an
+    // array of two numbers
+    Number *parts = reinterpret_cast<Number *>(&target);
+    atomic_add(parts[0], value.real());
+    atomic_add(parts[1], value.imag());
+  }
+} // namespace Threads
+
+/**
+ * @}
+ */
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
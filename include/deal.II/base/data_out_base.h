@@ -2853,6 +2853,27 @@ public:
   void
   write_vtu_in_parallel(const std::string &filename, const MPI_Comm comm) const;
 
+  /**
+   * Like the previous function, but with two-level aggregation of the data:
+   * The processes in @p comm are split into groups, and each process sends
+   * its (compressed, if requested by the VtkFlags) data to one aggregator
+   * process per group. Only the aggregators open the file and write their
+   * data in one large contiguous block each, while all other processes can
+   * return as soon as their data has been sent. On large machines, this
+   * avoids the contention of the file system caused by thousands of processes
+   * accessing the same file.
+   *
+   * If @p n_aggregators is zero, one group is formed per shared-memory node,
+   * i.e., there is one aggregator per node. Otherwise, the processes are
+   * split into @p n_aggregators groups of consecutive ranks (but not more
+   * groups than there are processes), and the file written is identical to
+   * the one written by the previous function.
+   */
+  void
+  write_vtu_in_parallel(const std::string &filename,
+                        const MPI_Comm     comm,
+                        const unsigned int n_aggregators) const;
+
   /**
    * Some visualization programs, such as ParaView and VisIt, can read several
    * separate VTU files that all form part of the same simulation, in order to
@@ -3347,6 +3368,14 @@ private:
    * dimension. Can be changed by using the <tt>set_flags</tt> function.
    */
   DataOutBase::Deal_II_IntermediateFlags deal_II_intermediate_flags;
+
+  /**
+   * Return the VTU data of the patches of the current process, without
+   * header and footer, as written into the file by the
+   * write_vtu_in_parallel() functions. Collective on @p comm.
+   */
+  std::string
+  create_vtu_piece_for_parallel_output(const MPI_Comm comm) const;
 };
 
 
@@ -378,6 +378,14 @@ public:
    * i.e. a set of indices that are elements of both index sets. The two index
    * sets must have the same size (though of course they do not have to have
    * the same number of indices).
+   *
+   * The ranges of the two sets are walked in lockstep, but runs of ranges of
+   * one set that lie entirely within a gap of the other set are skipped by a
+   * binary search. Intersecting a set consisting of few ranges (such as the
+   * locally owned indices) with one consisting of many ranges (such as the
+   * locally relevant indices of a high-order discretization) therefore only
+   * takes time proportional to the logarithm of the number of ranges of the
+   * latter for each range of the former.
    */
   IndexSet
   operator&(const IndexSet &is) const;
@@ -333,6 +333,45 @@ namespace Utilities
         return MPI_SUCCESS;
       }
 
+      /**
+       * Start a non-blocking write of a possibly large @p count of data at
+       * the location @p offset. The buffer @p buf must not be modified
+       * until the operation identified by @p request has completed.
+       *
+       * See the MPI 4.x standard for details.
+       */
+      inline int
+      File_iwrite_at_c(MPI_File     fh,
+                       MPI_Offset   offset,
+                       const void  *buf,
+                       MPI_Count    count,
+                       MPI_Datatype datatype,
+                       MPI_Request *request)
+      {
+        if (count <= LargeCount::mpi_max_int_count)
+          return MPI_File_iwrite_at(fh, offset, buf, count, datatype, request);
+
+        MPI_Datatype bigtype;
+        int          ierr;
+        ierr = Type_contiguous_c(count, datatype, &bigtype);
+        if (ierr != MPI_SUCCESS)
+          return ierr;
+        ierr = MPI_Type_commit(&bigtype);
+        if (ierr != MPI_SUCCESS)
+          return ierr;
+
+        ierr = MPI_File_iwrite_at(fh, offset, buf, 1, bigtype, request);
+        if (ierr != MPI_SUCCESS)
+          return ierr;
+
+        // Freeing the datatype only marks it for deallocation; the pending
+        // write operation still completes normally.
+        ierr = MPI_Type_free(&bigtype);
+        if (ierr != MPI_SUCCESS)
+          return ierr;
+        return MPI_SUCCESS;
+      }
+
       /**
        * Collectively write a possibly large @p count of data in order.
        *
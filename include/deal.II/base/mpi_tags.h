@@ -146,6 +146,17 @@ namespace Utilities
 
           // GridTools::internal::distributed_compute_point_locations
           distributed_compute_point_locations,
+
+          // DataOutInterface::write_vtu_in_parallel() with aggregation
+          data_out_base_write_vtu_in_parallel_aggregated,
+
+          // internal::DoFHandlerImplementation::Policy::ParallelDistributed,
+          // setup of the exchange of DoF indices on ghost cells
+          dof_handler_policy_exchange_ghost_cells,
+
+          // internal::DoFHandlerImplementation::Policy::ParallelDistributed,
+          // exchange of DoF indices on ghost cells
+          dof_handler_policy_exchange_dof_indices,
         };
       } // namespace Tags
     }   // namespace internal
@@ -77,6 +77,9 @@ class MatrixFree;
  * hundred elements found in small engineering problems of the early 1980s
  * (the second edition was published in 1984), but certainly not with those
  * used in this library, featuring several 10,000 to a few 100,000 elements.
+ * A cheaper alternative is the search for a pseudo-peripheral starting point
+ * by George and Liu, which only needs a few breadth-first searches through
+ * the graph; it is used by the reverse_Cuthill_McKee() function.
  *
  *
  * <h4>Implementation of renumbering schemes</h4>
@@ -636,6 +639,47 @@ namespace DoFRenumbering
                 const std::vector<types::global_dof_index> &starting_indices =
                   std::vector<types::global_dof_index>());
 
+  /**
+   * Renumber the degrees of freedom according to the reverse Cuthill-McKee
+   * method, starting each connected component of the connectivity graph at a
+   * pseudo-peripheral degree of freedom. See
+   * SparsityTools::reorder_reverse_Cuthill_McKee() and
+   * SparsityTools::find_pseudo_peripheral_index() for the algorithm.
+   *
+   * In contrast to calling Cuthill_McKee() with <code>reversed_numbering =
+   * true</code>, which starts at a degree of freedom with the smallest
+   * number of couplings, this function searches for a starting point at one
+   * end of a longest path through the mesh. The level sets of the
+   * resulting front are typically narrower, which translates into a smaller
+   * bandwidth and profile of the system matrix and, for the reverse
+   * numbering, less fill-in of (incomplete) factorizations.
+   *
+   * For parallel triangulations, the function works on the locally owned
+   * degrees of freedom of each process as described for Cuthill_McKee().
+   * The construction of the fronts is done in parallel using tasks for large
+   * meshes; the result does not depend on the number of threads.
+   */
+  template <int dim, int spacedim>
+  void
+  reverse_Cuthill_McKee(DoFHandler<dim, spacedim> &dof_handler,
+                        const bool                 use_constraints = false);
+
+  /**
+   * Compute the renumbering vector needed by the reverse_Cuthill_McKee()
+   * function. This function does not perform the renumbering on the
+   * DoFHandler DoFs but only returns the renumbering vector.
+   *
+   * If a valid level is passed as parameter, the renumbering vector for this
+   * grid level is returned.
+   */
+  template <int dim, int spacedim>
+  void
+  compute_reverse_Cuthill_McKee(
+    std::vector<types::global_dof_index> &new_dof_indices,
+    const DoFHandler<dim, spacedim>      &dof_handler,
+    const bool                            use_constraints = false,
+    const unsigned int level = numbers::invalid_unsigned_int);
+
   /**
    * @name Component-wise numberings
    * @{
@@ -992,6 +1036,37 @@ namespace DoFRenumbering
     const std::vector<typename DoFHandler<dim, spacedim>::level_cell_iterator>
       &cell_order);
 
+  /**
+   * Renumber degrees of freedom cell by cell, with the locally owned active
+   * cells traversed in the order of the Hilbert space filling curve through
+   * their centers. This is cell_wise() with a cell order computed by
+   * Utilities::inverse_Hilbert_space_filling_curve().
+   *
+   * The resulting numbering keeps the degrees of freedom of each cell in a
+   * contiguous block and neighboring cells close to each other in index
+   * space, independently of the refinement history of the mesh. It is meant
+   * to improve the cache locality of operations that access vector entries
+   * cell by cell or row by row, such as matrix-vector products, the
+   * application of (incomplete) factorizations, and the assembly of
+   * matrices, rather than to minimize the bandwidth of the matrix.
+   *
+   * For parallel triangulations, each process orders its locally owned
+   * cells independently, relative to their bounding box.
+   */
+  template <int dim, int spacedim>
+  void
+  hilbert_curve(DoFHandler<dim, spacedim> &dof_handler);
+
+  /**
+   * Compute the renumbering vector needed by the hilbert_curve() function.
+   * Does not perform the renumbering on the DoFHandler dofs but returns the
+   * renumbering vector.
+   */
+  template <int dim, int spacedim>
+  void
+  compute_hilbert_curve(std::vector<types::global_dof_index> &new_dof_indices,
+                        const DoFHandler<dim, spacedim>      &dof_handler);
+
   /**
    * @}
    */
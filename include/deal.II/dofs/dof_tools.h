@@ -55,8 +55,10 @@ DEAL_II_CXX20_REQUIRES(concepts::is_triangulation_or_dof_handler<MeshType>)
 class InterGridMap;
 template <int dim, int spacedim>
 class Mapping;
+class SparsityPattern;
 template <int dim, class T>
 class Table;
+class TimerOutput;
 template <typename Number>
 class Vector;
 
@@ -416,6 +418,14 @@ namespace DoFTools
    * need to remember using SparsityPattern::compress() after generating the
    * pattern.
    *
+   * @note If more than one thread is available (see MultithreadInfo), the
+   * entries of the cells are computed in parallel, in chunks of cells. Since
+   * sparsity pattern objects in general can not be written to concurrently,
+   * the entries of each chunk are sorted by rows in parallel and then added
+   * to @p sparsity_pattern row by row by the calling thread. The same
+   * applies to the other make_sparsity_pattern() and
+   * make_flux_sparsity_pattern() functions working on a single DoFHandler.
+   *
    * @ingroup constraints
    */
   template <int dim, int spacedim, typename number = double>
@@ -427,6 +437,53 @@ namespace DoFTools
     const bool                       keep_constrained_dofs = true,
     const types::subdomain_id subdomain_id = numbers::invalid_subdomain_id);
 
+  /**
+   * Create the sparsity pattern of a matrix built on the given
+   * @p dof_handler directly in the compressed storage of a SparsityPattern,
+   * without going through a DynamicSparsityPattern. The resulting pattern
+   * is the same as the one obtained by calling the previous function with a
+   * DynamicSparsityPattern and copying it into a SparsityPattern via
+   * SparsityPattern::copy_from(), and the arguments have the same meaning.
+   *
+   * The function works in two passes over the degrees of freedom: The first
+   * one computes the exact number of entries in each row, which is then used
+   * to allocate the memory of the @p sparsity_pattern in one piece. The
+   * second pass writes the column indices of each row into their final
+   * place. Both passes work on independent rows and are run in parallel.
+   * Before that, the degrees of freedom of the cells are gathered and the
+   * list of cells each degree of freedom is associated with is built, both
+   * in parallel over ranges of cells and rows that are then joined by a
+   * prefix sum; only the collection of the cell iterators and the prefix sum
+   * over the ranges are done sequentially.
+   *
+   * This avoids the many small memory allocations of a
+   * DynamicSparsityPattern as well as keeping both a DynamicSparsityPattern
+   * and a SparsityPattern in memory at the same time, which can be
+   * substantial for large problems.
+   *
+   * In addition to the @p sparsity_pattern, the function temporarily stores
+   * the (constrained) degrees of freedom of all cells and the list of cells
+   * each degree of freedom is associated with. The @p sparsity_pattern is
+   * reinitialized by this function and is compressed upon return.
+   *
+   * @note This function builds a sparsity pattern with one row per degree
+   * of freedom, and is therefore meant for sequential computations (or for
+   * building the pattern of a subdomain via @p subdomain_id). For finite
+   * elements that define a local sparsity pattern that is not full (see
+   * FiniteElement::get_local_dof_sparsity_pattern()), the function falls
+   * back to using a DynamicSparsityPattern.
+   *
+   * @ingroup constraints
+   */
+  template <int dim, int spacedim, typename number = double>
+  void
+  make_sparsity_pattern_two_pass(
+    const DoFHandler<dim, spacedim> &dof_handler,
+    SparsityPattern                 &sparsity_pattern,
+    const AffineConstraints<number> &constraints           = {},
+    const bool                       keep_constrained_dofs = true,
+    const types::subdomain_id subdomain_id = numbers::invalid_subdomain_id);
+
   /**
    * Compute which entries of a matrix built on the given @p dof_handler may
    * possibly be nonzero, and create a sparsity pattern object that represents
@@ -650,6 +707,10 @@ namespace DoFTools
    *      return 0 < face_center[0];
    *    };
    * @endcode
+   *
+   * While the cells are processed in parallel if more than one thread is
+   * available, @p face_has_flux_coupling is never called concurrently, so it
+   * may capture and modify state, e.g., an FEFaceValues object.
    */
   template <int dim, int spacedim, typename number>
   void
@@ -753,12 +814,17 @@ namespace DoFTools
    * all constraints due to differing mesh sizes (h) or polynomial degrees (p)
    * between adjacent cells.
    *
+   * If a @p timer_output object is given, the traversal of the faces of all
+   * cells, which makes up the work of this function, is timed in a section
+   * named "make_hanging_node_constraints: face traversal".
+   *
    * @ingroup constraints
    */
   template <int dim, int spacedim, typename number>
   void
   make_hanging_node_constraints(const DoFHandler<dim, spacedim> &dof_handler,
-                                AffineConstraints<number>       &constraints);
+                                AffineConstraints<number>       &constraints,
+                                TimerOutput *timer_output = nullptr);
 
   /**
    * This function is used when different variables in a problem are
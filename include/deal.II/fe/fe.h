@@ -2988,6 +2988,83 @@ protected:
                                                                        spacedim>
       &output_data) const;
 
+  /**
+   * Return whether the objects created by get_data(), get_face_data(), and
+   * get_subface_data() are only read, but never written to, by
+   * fill_fe_values() and the related functions. In that case, a single such
+   * object can be used by several FEValues objects at the same time, also
+   * on different threads, see get_shared_data().
+   *
+   * The default implementation returns `false`.
+   */
+  virtual bool
+  internal_data_is_read_only() const;
+
+  /**
+   * Return whether fill_fe_values() and the related functions only compute
+   * the shape functions of those vector components that are selected by the
+   * component mask of the output object (see
+   * FEValuesBase::restrict_to_components()), and leave the data of all other
+   * components untouched. Otherwise, the mask is ignored and all shape
+   * functions are computed.
+   *
+   * The default implementation returns `false`.
+   */
+  virtual bool
+  fill_fe_values_respects_component_mask() const;
+
+  /**
+   * Like get_data(), but return an object that may be shared with other
+   * callers. If internal_data_is_read_only() returns `true`, the object is
+   * taken from a cache that is keyed by the current element, the mapping,
+   * the quadrature formula, and the update flags, and get_data() is only
+   * called if no other FEValues object currently uses an object for the
+   * same key. The parts of @p output_data that get_data() pre-computes on
+   * the reference cell are then copied from the cache as well. The cache
+   * only holds weak references, i.e., an object is deleted as soon as the
+   * last FEValues object using it goes out of scope.
+   *
+   * This way, the tables of shape function values and derivatives on the
+   * reference cell exist only once, even if many FEValues objects are
+   * created with the same arguments, as is the case for the scratch data
+   * objects of the different threads in WorkStream::run(). If
+   * internal_data_is_read_only() returns `false`, this function simply
+   * returns the object created by get_data().
+   *
+   * This function is thread-safe.
+   */
+  std::shared_ptr<const InternalDataBase>
+  get_shared_data(const UpdateFlags             update_flags,
+                  const Mapping<dim, spacedim> &mapping,
+                  const Quadrature<dim>        &quadrature,
+                  dealii::internal::FEValuesImplementation::
+                    FiniteElementRelatedData<dim, spacedim> &output_data) const;
+
+  /**
+   * Like get_shared_data(), but for the objects created by get_face_data().
+   */
+  std::shared_ptr<const InternalDataBase>
+  get_shared_face_data(
+    const UpdateFlags               update_flags,
+    const Mapping<dim, spacedim>   &mapping,
+    const hp::QCollection<dim - 1> &quadrature,
+    dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
+                                                                       spacedim>
+      &output_data) const;
+
+  /**
+   * Like get_shared_data(), but for the objects created by
+   * get_subface_data().
+   */
+  std::shared_ptr<const InternalDataBase>
+  get_shared_subface_data(
+    const UpdateFlags             update_flags,
+    const Mapping<dim, spacedim> &mapping,
+    const Quadrature<dim - 1>    &quadrature,
+    dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
+                                                                       spacedim>
+      &output_data) const;
+
   /**
    * Compute information about the shape functions on the cell denoted by the
    * first argument. Derived classes will have to implement this function
@@ -2041,6 +2041,59 @@ public:
    * @}
    */
 
+  /**
+   * @name Access to jumps and averages of all shape functions at once
+   * @{
+   */
+
+  /**
+   * Fill @p jumps with the jumps in the values of all interface shape
+   * functions at all quadrature points, i.e., the entry <code>(i,q)</code>
+   * equals jump_in_shape_values(i, q, component).
+   *
+   * In the assembly of face terms, e.g., for interior penalty methods, the
+   * jumps and averages are needed many times in the innermost loops over
+   * pairs of shape functions. Computing them once per interface with this
+   * function avoids looking up the shape functions of the two cells for
+   * every call of jump_in_shape_values(), and skips the shape functions that
+   * are zero in @p component altogether.
+   *
+   * The table is resized to n_current_interface_dofs() times the number of
+   * quadrature points. This does not allocate memory if the table has been
+   * used for an interface with at least as many entries before.
+   */
+  void
+  get_jump_in_shape_values(Table<2, double>  &jumps,
+                           const unsigned int component = 0) const;
+
+  /**
+   * Like get_jump_in_shape_values(), but for the jumps in the gradients as
+   * returned by jump_in_shape_gradients().
+   */
+  void
+  get_jump_in_shape_gradients(Table<2, Tensor<1, spacedim>> &jumps,
+                              const unsigned int component = 0) const;
+
+  /**
+   * Like get_jump_in_shape_values(), but for the averages of the values as
+   * returned by average_of_shape_values().
+   */
+  void
+  get_average_of_shape_values(Table<2, double>  &averages,
+                              const unsigned int component = 0) const;
+
+  /**
+   * Like get_jump_in_shape_values(), but for the averages of the gradients
+   * as returned by average_of_shape_gradients().
+   */
+  void
+  get_average_of_shape_gradients(Table<2, Tensor<1, spacedim>> &averages,
+                                 const unsigned int component = 0) const;
+
+  /**
+   * @}
+   */
+
 
 
   /**
@@ -2199,6 +2252,27 @@ private:
   std::vector<std::pair<types::global_dof_index, std::array<unsigned int, 2>>>
     interface_dof_data;
 
+  /**
+   * The DoF indices of the first and the second cell adjacent to the
+   * current interface. These are only needed within reinit(), but are
+   * kept as members so that their memory can be reused.
+   */
+  std::array<std::vector<types::global_dof_index>, 2> cell_dof_indices;
+
+  /**
+   * Fill @p table with the weighted sum of the values @p evaluate returns
+   * for the shape functions of the two cells that make up an interface
+   * shape function, with weights @p weights for the two cells. This is the
+   * implementation of get_jump_in_shape_values() and the related
+   * functions.
+   */
+  template <typename ValueType, typename Evaluator>
+  void
+  fill_shape_function_table(const std::array<double, 2> &weights,
+                            const unsigned int           component,
+                            const Evaluator             &evaluate,
+                            Table<2, ValueType>         &table) const;
+
   /**
    * Pointer to internal_fe_face_values or internal_fe_subface_values,
    * respectively as determined in reinit().
@@ -2690,12 +2764,13 @@ FEInterfaceValues<dim, spacedim>::reinit(
   // Set up dof mapping and remove duplicates (for continuous elements).
   if constexpr (is_dof_cell_accessor_neighbor && is_dof_cell_accessor)
     {
-      // Get dof indices first:
-      std::vector<types::global_dof_index> v_1(
-        fe_face_values->get_fe().n_dofs_per_cell());
+      // Get dof indices first. The vectors keep their memory from previous
+      // calls, so resizing them does not allocate in the typical case:
+      std::vector<types::global_dof_index> &v_1 = cell_dof_indices[0];
+      v_1.resize(fe_face_values->get_fe().n_dofs_per_cell());
       cell->get_active_or_mg_dof_indices(v_1);
-      std::vector<types::global_dof_index> v_2(
-        fe_face_values_neighbor->get_fe().n_dofs_per_cell());
+      std::vector<types::global_dof_index> &v_2 = cell_dof_indices[1];
+      v_2.resize(fe_face_values_neighbor->get_fe().n_dofs_per_cell());
       cell_neighbor->get_active_or_mg_dof_indices(v_2);
 
       interface_dof_data.resize(v_1.size() + v_2.size());
@@ -2732,6 +2807,27 @@ FEInterfaceValues<dim, spacedim>::reinit(
                   interface_dof_data_end_after_v_1,
                   compare_interface_dofs);
 
+      // If all DoFs of one of the two elements are located in the interior
+      // of the cell, as for discontinuous elements, the two cells cannot
+      // share any DoFs, unless a cell is its own neighbor across a periodic
+      // boundary. The DoFs of the second cell then simply follow the sorted
+      // ones of the first cell, in the same order as they would be added
+      // below, and we can skip the search for common DoFs.
+      const auto all_dofs_in_interior =
+        [](const FiniteElement<dim, spacedim> &fe) {
+          return fe.template n_dofs_per_object<dim>() == fe.n_dofs_per_cell();
+        };
+      if ((all_dofs_in_interior(fe_face_values->get_fe()) ||
+           all_dofs_in_interior(fe_face_values_neighbor->get_fe())) &&
+          (cell->level() != cell_neighbor->level() ||
+           cell->index() != cell_neighbor->index()))
+        {
+          for (unsigned int i = 0; i < v_2.size(); ++i)
+            interface_dof_data[v_1.size() + i] = {
+              v_2[i], {{numbers::invalid_unsigned_int, i}}};
+          return;
+        }
+
       // Now add the second set of DoFs:
       unsigned int idx = v_1.size();
       for (unsigned int i = 0; i < v_2.size(); ++i)
@@ -2827,8 +2923,9 @@ FEInterfaceValues<dim, spacedim>::reinit(const CellIteratorType &cell,
       fe_face_values_neighbor = nullptr;
     }
 
-  std::vector<types::global_dof_index> interface_dof_indices(
-    fe_face_values->get_fe().n_dofs_per_cell());
+  std::vector<types::global_dof_index> &interface_dof_indices =
+    cell_dof_indices[0];
+  interface_dof_indices.resize(fe_face_values->get_fe().n_dofs_per_cell());
 
   if constexpr (std::is_same_v<typename CellIteratorType::AccessorType,
                                DoFCellAccessor<dim, spacedim, true>> ||
@@ -3292,6 +3389,120 @@ FEInterfaceValues<dim, spacedim>::average_of_shape_hessians(
 
 
 
+template <int dim, int spacedim>
+template <typename ValueType, typename Evaluator>
+void
+FEInterfaceValues<dim, spacedim>::fill_shape_function_table(
+  const std::array<double, 2> &weights,
+  const unsigned int           component,
+  const Evaluator             &evaluate,
+  Table<2, ValueType>         &table) const
+{
+  const unsigned int n_interface_dofs = n_current_interface_dofs();
+  table.reinit(n_interface_dofs, n_quadrature_points);
+
+  for (unsigned int i = 0; i < n_interface_dofs; ++i)
+    {
+      const std::array<unsigned int, 2> &dof_pair =
+        interface_dof_data[i].second;
+      for (unsigned int side = 0; side < 2; ++side)
+        if (dof_pair[side] != numbers::invalid_unsigned_int)
+          {
+            const FEFaceValuesBase<dim, spacedim> &fe_values =
+              get_fe_face_values(side);
+            AssertIndexRange(component, fe_values.get_fe().n_components());
+            if (fe_values.get_fe().get_nonzero_components(
+                  dof_pair[side])[component] == false)
+              continue;
+
+            for (unsigned int q = 0; q < n_quadrature_points; ++q)
+              table(i, q) +=
+                weights[side] * evaluate(fe_values, dof_pair[side], q);
+          }
+    }
+}
+
+
+
+template <int dim, int spacedim>
+void
+FEInterfaceValues<dim, spacedim>::get_jump_in_shape_values(
+  Table<2, double>  &jumps,
+  const unsigned int component) const
+{
+  fill_shape_function_table(
+    {{1., -1.}},
+    component,
+    [component](const FEFaceValuesBase<dim, spacedim> &fe_values,
+                const unsigned int                     i,
+                const unsigned int                     q) {
+      return fe_values.shape_value_component(i, q, component);
+    },
+    jumps);
+}
+
+
+
+template <int dim, int spacedim>
+void
+FEInterfaceValues<dim, spacedim>::get_jump_in_shape_gradients(
+  Table<2, Tensor<1, spacedim>> &jumps,
+  const unsigned int             component) const
+{
+  fill_shape_function_table(
+    {{1., -1.}},
+    component,
+    [component](const FEFaceValuesBase<dim, spacedim> &fe_values,
+                const unsigned int                     i,
+                const unsigned int                     q) {
+      return fe_values.shape_grad_component(i, q, component);
+    },
+    jumps);
+}
+
+
+
+template <int dim, int spacedim>
+void
+FEInterfaceValues<dim, spacedim>::get_average_of_shape_values(
+  Table<2, double>  &averages,
+  const unsigned int component) const
+{
+  // on the boundary, the average is the value on the first cell
+  const double weight = at_boundary() ? 1. : 0.5;
+  fill_shape_function_table(
+    {{weight, weight}},
+    component,
+    [component](const FEFaceValuesBase<dim, spacedim> &fe_values,
+                const unsigned int                     i,
+                const unsigned int                     q) {
+      return fe_values.shape_value_component(i, q, component);
+    },
+    averages);
+}
+
+
+
+template <int dim, int spacedim>
+void
+FEInterfaceValues<dim, spacedim>::get_average_of_shape_gradients(
+  Table<2, Tensor<1, spacedim>> &averages,
+  const unsigned int             component) const
+{
+  const double weight = at_boundary() ? 1. : 0.5;
+  fill_shape_function_table(
+    {{weight, weight}},
+    component,
+    [component](const FEFaceValuesBase<dim, spacedim> &fe_values,
+                const unsigned int                     i,
+                const unsigned int                     q) {
+      return fe_values.shape_grad_component(i, q, component);
+    },
+    averages);
+}
+
+
+
 template <int dim, int spacedim>
 Tensor<1, spacedim>
 FEInterfaceValues<dim, spacedim>::jump_in_shape_gradients(
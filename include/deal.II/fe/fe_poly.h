@@ -248,6 +248,14 @@ public:
   memory_consumption() const override;
 
 protected:
+  /**
+   * Return `true`: The InternalData object of this class only holds the
+   * shape function values and derivatives on the reference cell, which
+   * fill_fe_values() and the related functions only read.
+   */
+  virtual bool
+  internal_data_is_read_only() const override;
+
   /*
    * NOTE: The following function has its definition inlined into the class
    * declaration because we otherwise run into a compiler error with MS Visual
@@ -1073,6 +1073,14 @@ public:
   };
 
 protected:
+  /**
+   * Return `true`: The shape functions of the base elements are only
+   * computed for those vector components that are selected by the component
+   * mask of the output object.
+   */
+  virtual bool
+  fill_fe_values_respects_component_mask() const override;
+
   virtual std::unique_ptr<
     typename FiniteElement<dim, spacedim>::InternalDataBase>
   get_data(
@@ -1276,13 +1284,14 @@ private:
     void
     set_fe_data(
       const unsigned int base_no,
-      std::unique_ptr<typename FiniteElement<dim, spacedim>::InternalDataBase>);
+      std::shared_ptr<
+        const typename FiniteElement<dim, spacedim>::InternalDataBase>);
 
     /**
      * Give read-access to the pointer to a @p InternalData of the
      * `base_no`th base element.
      */
-    typename FiniteElement<dim, spacedim>::InternalDataBase &
+    const typename FiniteElement<dim, spacedim>::InternalDataBase &
     get_fe_data(const unsigned int base_no) const;
 
     /**
@@ -1302,10 +1311,12 @@ private:
      * InternalData constructor.  It is filled by the @p get_data function.
      * Note that since the data for each instance of a base class is
      * necessarily the same, we only need as many of these objects as there
-     * are base elements, irrespective of their multiplicity.
+     * are base elements, irrespective of their multiplicity. The objects are
+     * obtained from FiniteElement::get_shared_data() and related functions,
+     * i.e., they may be shared with other FEValues objects.
      */
-    typename std::vector<
-      std::unique_ptr<typename FiniteElement<dim, spacedim>::InternalDataBase>>
+    std::vector<std::shared_ptr<
+      const typename FiniteElement<dim, spacedim>::InternalDataBase>>
       base_fe_datas;
 
     /**
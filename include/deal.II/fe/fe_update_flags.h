@@ -19,6 +19,8 @@
 #include <deal.II/base/table.h>
 #include <deal.II/base/tensor.h>
 
+#include <deal.II/fe/component_mask.h>
+
 #include <vector>
 
 
@@ -517,6 +519,16 @@ namespace internal
        * <code>[i*n_components, (i+1)*n_components)</code>.
        */
       std::vector<unsigned int> shape_function_to_row_table;
+
+      /**
+       * The vector components for which FiniteElement::fill_fe_values() and
+       * the related functions need to compute the shape function data, as
+       * set by FEValuesBase::restrict_to_components(). A default-constructed
+       * mask selects all components. Elements may ignore this information and
+       * compute all components; FESystem skips the base elements none of
+       * whose components are selected.
+       */
+      ComponentMask component_mask;
     };
   } // namespace FEValuesImplementation
 } // namespace internal
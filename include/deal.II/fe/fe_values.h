@@ -44,6 +44,8 @@
 #include <algorithm>
 #include <memory>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -163,12 +165,134 @@ public:
   const FEValues<dim, spacedim> &
   get_present_fe_values() const;
 
+  /**
+   * Statistics of the geometry cache, see enable_geometry_cache().
+   */
+  struct GeometryCacheStatistics
+  {
+    /**
+     * The number of calls to reinit() that looked up the geometry of the
+     * cell in the cache. These are all calls for cells that are not a
+     * translation of the previous cell (see CellSimilarity).
+     */
+    unsigned int n_lookups = 0;
+
+    /**
+     * The number of lookups that found the geometry of the cell in the
+     * cache.
+     */
+    unsigned int n_hits = 0;
+
+    /**
+     * The number of geometries currently stored in the cache.
+     */
+    unsigned int n_entries = 0;
+  };
+
+  /**
+   * Enable a cache of the data computed by the mapping and the finite
+   * element, keyed by the geometry of the cell up to a translation. With
+   * the default CellSimilarity check, this data is only reused if a cell is
+   * a translation of the cell visited immediately before. With the cache,
+   * the data is reused whenever a cell is a translation of any of the
+   * (up to @p max_n_entries) cells stored in the cache, which is the case
+   * for many cells of structured meshes that are refined locally, or that
+   * are traversed in an order where similar cells are not consecutive.
+   *
+   * A cell is looked up by a hash of the differences between its vertices
+   * and its first vertex, and is considered a translation of a cached cell
+   * if these differences agree to about twelve digits. The cache is filled
+   * with the first @p max_n_entries distinct geometries that are
+   * encountered. Cells with a different geometry are computed as usual
+   * once the cache is full. Calling this function again empties the cache,
+   * and calling it with @p max_n_entries equal to zero disables it.
+   *
+   * Reusing the data for translated cells is only correct if neither the
+   * mapping nor the finite element depend on the location of the cell
+   * other than through the quadrature points. The cache is therefore only
+   * enabled for cells with `dim == spacedim`, for a MappingQ of degree one
+   * that preserves the vertex locations or a MappingCartesian, and for
+   * finite elements derived from FE_Poly (such as FE_Q and FE_DGQ) or
+   * FESystem objects composed of them. For all other cases, this function
+   * does nothing, which can be seen from get_geometry_cache_statistics().
+   *
+   * Like the CellSimilarity check, the cache can lead to results that
+   * differ by round-off from the results without cache. This is why it is
+   * not enabled by default, see also
+   * FEValuesBase::always_allow_check_for_cell_similarity().
+   */
+  void
+  enable_geometry_cache(const unsigned int max_n_entries = 64);
+
+  /**
+   * Return the number of lookups in and hits of the geometry cache since
+   * the last call to enable_geometry_cache(). The hit rate is
+   * `n_hits / n_lookups`.
+   */
+  GeometryCacheStatistics
+  get_geometry_cache_statistics() const;
+
 private:
   /**
    * Store a copy of the quadrature formula here.
    */
   const Quadrature<dim> quadrature;
 
+  /**
+   * The data stored in the geometry cache for a cell, see
+   * enable_geometry_cache().
+   */
+  struct GeometryCacheEntry
+  {
+    /**
+     * The differences between the vertices of the cell and its first
+     * vertex, which describe the geometry up to a translation.
+     */
+    std::vector<Tensor<1, spacedim>> vertex_differences;
+
+    /**
+     * The first vertex of the cell, used to translate the quadrature points
+     * to another cell.
+     */
+    Point<spacedim> first_vertex;
+
+    /**
+     * The output of the mapping and the finite element on the cell.
+     */
+    internal::FEValuesImplementation::MappingRelatedData<dim, spacedim>
+      mapping_output;
+    internal::FEValuesImplementation::FiniteElementRelatedData<dim, spacedim>
+      finite_element_output;
+  };
+
+  /**
+   * The maximal number of entries of the geometry cache, or zero if the
+   * cache is not used.
+   */
+  unsigned int geometry_cache_max_n_entries;
+
+  /**
+   * The entries of the geometry cache, sorted by the hash of their vertex
+   * differences.
+   */
+  std::unordered_multimap<std::size_t, GeometryCacheEntry> geometry_cache;
+
+  /**
+   * The statistics returned by get_geometry_cache_statistics().
+   */
+  GeometryCacheStatistics geometry_cache_statistics;
+
+  /**
+   * Look up the present cell in the geometry cache and, if it is found,
+   * copy the cached data into the output objects of the mapping and the
+   * finite element. Return whether the cell has been found. Otherwise,
+   * the vertex differences of the present cell and their hash are
+   * returned in the two arguments.
+   */
+  bool
+  reuse_cached_geometry(std::vector<Tensor<1, spacedim>> &vertex_differences,
+                        std::size_t                       &hash);
+
   /**
    * Do work common to the two constructors.
    */
@@ -51,6 +51,26 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// Forward declarations
+#ifndef DOXYGEN
+namespace Utilities
+{
+  namespace MPI
+  {
+    class Partitioner;
+  }
+} // namespace Utilities
+
+namespace internal
+{
+  namespace FEValuesImplementation
+  {
+    template <int dim>
+    struct TensorProductEvaluationData;
+  }
+} // namespace internal
+#endif
+
 /**
  * FEValues, FEFaceValues and FESubfaceValues objects are interfaces to finite
  * element and mapping classes on the one hand side, to cells and quadrature
@@ -610,6 +630,33 @@ public:
                       ArrayView<std::vector<Number>>                  values,
                       const bool quadrature_points_fastest) const;
 
+  /**
+   * Return the values of several finite element functions at the quadrature
+   * points of the current cell, face, or subface, as needed for example by
+   * multistep time integrators that combine the solutions of several time
+   * steps. This is equivalent to calling the first get_function_values()
+   * function for each of the vectors in @p fe_functions, but the indices of
+   * the degrees of freedom of the current cell are only looked up once.
+   *
+   * This function may only be used if the finite element in use is a scalar
+   * one.
+   *
+   * @param[in] fe_functions Pointers to the vectors that describe
+   * (globally) the finite element functions to be evaluated.
+   *
+   * @param[out] values The values of the functions at the quadrature points
+   * of the current cell, i.e., <code>values[v][q]</code> is the value of the
+   * function <code>*fe_functions[v]</code> at the $q$th quadrature point.
+   * The object is assumed to already have the correct size.
+   *
+   * @dealiiRequiresUpdateFlags{update_values}
+   */
+  template <typename Number>
+  void
+  get_function_values(
+    const std::vector<const ReadVector<Number> *> &fe_functions,
+    std::vector<std::vector<Number>>              &values) const;
+
   /** @} */
   /// @name Access to derivatives of global finite element fields
   /** @{ */
@@ -715,6 +762,22 @@ public:
     ArrayView<std::vector<Tensor<1, spacedim, Number>>> gradients,
     const bool quadrature_points_fastest = false) const;
 
+  /**
+   * Return the gradients of several finite element functions at the
+   * quadrature points of the current cell, face, or subface. This function
+   * relates to the first of the get_function_gradients() functions above in
+   * the same way as the get_function_values() function for several vectors
+   * relates to the first of the get_function_values() functions. See there
+   * for more information.
+   *
+   * @dealiiRequiresUpdateFlags{update_gradients}
+   */
+  template <typename Number>
+  void
+  get_function_gradients(
+    const std::vector<const ReadVector<Number> *>         &fe_functions,
+    std::vector<std::vector<Tensor<1, spacedim, Number>>> &gradients) const;
+
   /** @} */
   /// @name Access to second derivatives
   ///
@@ -1469,6 +1532,37 @@ public:
   UpdateFlags
   get_update_flags() const;
 
+  /**
+   * Restrict the computation of shape function values and derivatives in
+   * subsequent calls to reinit() to the vector components selected by
+   * @p mask. For an FESystem, the base elements none of whose components
+   * are selected are then not evaluated at all, which saves work in
+   * assembly routines that only need some of the components, e.g., only the
+   * pressure when assembling a Schur complement preconditioner. Other
+   * elements ignore the restriction and compute all components as before,
+   * see FiniteElement::fill_fe_values_respects_component_mask().
+   *
+   * For an FESystem, the shape function data of the components that are not
+   * selected are set to signaling NaNs and are in general not computed any
+   * more, so they must not be accessed until this function is called again
+   * with a mask that selects them. Accessing them, e.g., through a view that
+   * represents such a component, leads to invalid results. In particular,
+   * the functions computing the values of finite element fields for all
+   * components at once, like get_function_values() for vector-valued
+   * elements, must not be used. Changing the mask disables the reuse of data
+   * from the previous cell in the next call to reinit(), even if the new
+   * cell is a translation of it. A default-constructed ComponentMask selects
+   * all components.
+   */
+  void
+  restrict_to_components(const ComponentMask &mask);
+
+  /**
+   * Return the mask set by restrict_to_components().
+   */
+  const ComponentMask &
+  get_component_mask() const;
+
   /**
    * Return a triangulation iterator to the current cell.
    */
@@ -1616,6 +1710,20 @@ protected:
     CellIteratorWrapper(
       const typename DoFHandler<dim, spacedim>::level_cell_iterator &cell);
 
+    /**
+     * Copy constructor.
+     */
+    CellIteratorWrapper(const CellIteratorWrapper &other) = default;
+
+    /**
+     * Copy assignment. In contrast to the default copy assignment, this
+     * operator copies the cached indices of the degrees of freedom into the
+     * memory already allocated by the current object, so that it can be
+     * reused when FEValues::reinit() assigns a new cell to the object.
+     */
+    CellIteratorWrapper &
+    operator=(const CellIteratorWrapper &other);
+
     /**
      * Indicate whether FEValues::reinit() was called.
      */
@@ -1640,6 +1748,17 @@ protected:
     /**
      * Call @p get_interpolated_dof_values of the iterator with the
      * given arguments.
+     *
+     * For active cells of a DoFHandler, the indices of the degrees of
+     * freedom are only queried from the DoFHandler the first time this
+     * function is called for the current cell, and are then stored in this
+     * object for later calls, e.g., when evaluating both the values and the
+     * gradients of a solution, or several solution vectors. For vectors of
+     * type Vector and LinearAlgebra::distributed::Vector, the values are
+     * then read directly from the vector's memory with SIMD gather
+     * instructions, using cached indices into the locally stored elements
+     * in the latter case, rather than through the virtual function
+     * ReadVector::extract_subvector_to().
      */
     template <typename Number>
     void
@@ -1647,6 +1766,15 @@ protected:
                                 ArrayView<Number>         out) const;
 
   private:
+    /**
+     * Read the entries of a vector described by the indices stored in
+     * #dof_indices into @p out.
+     */
+    template <typename Number>
+    void
+    gather_dof_values(const ReadVector<Number> &in,
+                      ArrayView<Number>         out) const;
+
     /**
      * The cell in question, if one has been assigned to this object. The
      * concrete data type can either be a Triangulation cell iterator, a
@@ -1657,6 +1785,28 @@ protected:
                    typename DoFHandler<dim, spacedim>::cell_iterator,
                    typename DoFHandler<dim, spacedim>::level_cell_iterator>>
       cell;
+
+    /**
+     * The indices of the degrees of freedom of the cell, if it is an active
+     * cell of a DoFHandler, filled the first time they are needed. An empty
+     * vector indicates that they have not been computed yet.
+     */
+    mutable std::vector<types::global_dof_index> dof_indices;
+
+    /**
+     * The indices of the degrees of freedom of the cell translated to the
+     * indices into the locally stored elements of a
+     * LinearAlgebra::distributed::Vector with the partitioner
+     * #local_dof_indices_partitioner. An empty vector indicates that the
+     * translation has not been computed yet.
+     */
+    mutable std::vector<unsigned int> local_dof_indices;
+
+    /**
+     * The partitioner for which #local_dof_indices have been computed.
+     */
+    mutable const Utilities::MPI::Partitioner *local_dof_indices_partitioner =
+      nullptr;
   };
 
   /**
@@ -1737,10 +1887,12 @@ protected:
 
   /**
    * A pointer to the internal data object of finite element, obtained from
-   * FiniteElement::get_data(), Mapping::get_face_data(), or
-   * FiniteElement::get_subface_data().
+   * FiniteElement::get_shared_data(), FiniteElement::get_shared_face_data(),
+   * or FiniteElement::get_shared_subface_data(). The object may be shared
+   * with other FEValues objects using the same finite element, mapping,
+   * quadrature formula, and update flags.
    */
-  std::unique_ptr<typename FiniteElement<dim, spacedim>::InternalDataBase>
+  std::shared_ptr<const typename FiniteElement<dim, spacedim>::InternalDataBase>
     fe_data;
 
   /**
@@ -1784,6 +1936,34 @@ protected:
   check_cell_similarity(
     const typename Triangulation<dim, spacedim>::cell_iterator &cell);
 
+  /**
+   * Data for the evaluation of finite element functions at the quadrature
+   * points with sum factorization, used by the get_function_values() and
+   * get_function_gradients() functions for scalar elements. Rather than
+   * multiplying the vector of local degrees of freedom with the full table
+   * of shape values or gradients, with a cost proportional to
+   * $(p+1)^{2d}$ for polynomial degree $p$, the one-dimensional shape
+   * functions are applied dimension by dimension with a cost proportional
+   * to $(p+1)^{d+1}$.
+   *
+   * This object is only set up by FEValues, and only for elements and
+   * quadrature formulas that are tensor products of the same
+   * one-dimensional object in all coordinate directions, such as FE_Q or
+   * FE_DGQ of degree two or higher combined with QGauss. Otherwise, it is
+   * empty.
+   */
+  std::unique_ptr<
+    internal::FEValuesImplementation::TensorProductEvaluationData<dim>>
+    tensor_product_evaluation;
+
+  /**
+   * Set up the #tensor_product_evaluation field for the finite element of
+   * this object and the given quadrature formula, if they can be evaluated
+   * with sum factorization. Return whether this is the case.
+   */
+  bool
+  initialize_tensor_product_evaluation(const Quadrature<dim> &quadrature);
+
 private:
   /**
    * A cache for all possible FEValuesViews objects.
@@ -2179,6 +2359,15 @@ FEValuesBase<dim, spacedim>::get_update_flags() const
 
 
 
+template <int dim, int spacedim>
+inline const ComponentMask &
+FEValuesBase<dim, spacedim>::get_component_mask() const
+{
+  return this->finite_element_output.component_mask;
+}
+
+
+
 template <int dim, int spacedim>
 inline const std::vector<Point<spacedim>> &
 FEValuesBase<dim, spacedim>::get_quadrature_points() const
@@ -0,0 +1,532 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+#ifndef dealii_fe_values_batch_h
+#define dealii_fe_values_batch_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/observer_pointer.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/std_cxx20/iota_view.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_update_flags.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declaration
+#ifndef DOXYGEN
+template <int, int>
+class MappingQ;
+#endif
+
+/**
+ * A class that evaluates finite element shape functions and the geometry of a
+ * <i>batch</i> of cells at once, with one cell in each lane of a
+ * VectorizedArray. The interface is modeled after FEValues: After a call to
+ * reinit() with up to VectorizedArray<Number>::size() cells, shape_value(),
+ * shape_grad(), JxW(), and quadrature_point() return the respective values
+ * of all cells of the batch, so that an assembly loop written for FEValues
+ * can be run on several cells at once by changing the type of the local
+ * matrix entries to VectorizedArray<Number>:
+ * @code
+ * FEValuesBatch<dim> fe_values(mapping, fe, quadrature,
+ *                              update_gradients | update_JxW_values);
+ * for (unsigned int c = 0; c < cells.size(); c += fe_values.n_lanes)
+ *   {
+ *     const unsigned int n_cells =
+ *       std::min<unsigned int>(fe_values.n_lanes, cells.size() - c);
+ *     fe_values.reinit(make_array_view(cells.data() + c,
+ *                                      cells.data() + c + n_cells));
+ *
+ *     for (const unsigned int q : fe_values.quadrature_point_indices())
+ *       for (const unsigned int i : fe_values.dof_indices())
+ *         for (const unsigned int j : fe_values.dof_indices())
+ *           cell_matrix(i, j) += fe_values.shape_grad(i, q) *
+ *                                fe_values.shape_grad(j, q) *
+ *                                fe_values.JxW(q);
+ *
+ *     for (unsigned int lane = 0; lane < n_cells; ++lane)
+ *       // copy lane 'lane' of cell_matrix into the global matrix, using the
+ *       // degrees of freedom of cells[c + lane]
+ *   }
+ * @endcode
+ * Here, `cell_matrix` is a FullMatrix<VectorizedArray<double>> (or a
+ * similar container) that needs to be set to zero for each batch.
+ *
+ * In contrast to FEValues, where the mapping and the finite element fill
+ * their data with loops over the quadrature points of a single cell, the
+ * present class computes the Jacobians, their inverses and determinants,
+ * and the gradients of the shape functions for all cells of the batch with
+ * arithmetic operations on VectorizedArray. For mappings of type MappingQ
+ * (and the classes derived from it, such as MappingQCache), the geometry is
+ * computed from the support points of the mapping in the same way as
+ * MappingQ does it, but vectorized over the cells. For all other mappings,
+ * the Jacobians are computed by an FEValues object, one cell at a time,
+ * and only the remaining operations are vectorized.
+ *
+ * The class is restricted to primitive elements whose shape functions are
+ * the same on all cells, i.e., elements like FE_Q, FE_DGQ, or FESystem
+ * objects composed of such elements, and to the flags update_values,
+ * update_gradients, update_JxW_values, update_quadrature_points,
+ * update_jacobians, and update_inverse_jacobians.
+ *
+ * If fewer cells than lanes are given to reinit(), the remaining lanes are
+ * filled with the data of the last cell, such that all lanes contain valid
+ * numbers. The data of these lanes is meaningless and should not be used.
+ *
+ * @ingroup feaccess
+ */
+template <int dim, typename Number = double>
+class FEValuesBatch
+{
+public:
+  /**
+   * The vectorized data type used for the data of a batch of cells.
+   */
+  using VectorizedArrayType = VectorizedArray<Number>;
+
+  /**
+   * The number of cells that are treated at once.
+   */
+  static constexpr unsigned int n_lanes = VectorizedArrayType::size();
+
+  /**
+   * Constructor. Set up the reference-cell data of the finite element
+   * @p fe and the mapping @p mapping at the points of @p quadrature, for
+   * the data selected by @p update_flags.
+   */
+  FEValuesBatch(const Mapping<dim>       &mapping,
+                const FiniteElement<dim> &fe,
+                const Quadrature<dim>    &quadrature,
+                const UpdateFlags         update_flags);
+
+  /**
+   * Like the function above, but using the default mapping of the reference
+   * cell of @p fe.
+   */
+  FEValuesBatch(const FiniteElement<dim> &fe,
+                const Quadrature<dim>    &quadrature,
+                const UpdateFlags         update_flags);
+
+  /**
+   * Compute the data of the given cells, which are placed in the lanes in
+   * the order given. The number of cells must be between one and #n_lanes.
+   */
+  void
+  reinit(
+    const ArrayView<const typename Triangulation<dim>::cell_iterator> &cells);
+
+  /**
+   * Like the function above, but for an array of iterators of any type that
+   * can be converted to a Triangulation::cell_iterator, such as the
+   * iterators of a DoFHandler.
+   */
+  template <typename CellIteratorType>
+  void
+  reinit(const ArrayView<CellIteratorType> &cells);
+
+  /**
+   * Return the value of shape function @p i at quadrature point @p q. Since
+   * this class is restricted to elements whose shape functions do not depend
+   * on the cell, all lanes hold the same number.
+   */
+  const VectorizedArrayType &
+  shape_value(const unsigned int i, const unsigned int q) const;
+
+  /**
+   * Return the gradient of shape function @p i at quadrature point @p q in
+   * real space, for all cells of the batch.
+   */
+  const Tensor<1, dim, VectorizedArrayType> &
+  shape_grad(const unsigned int i, const unsigned int q) const;
+
+  /**
+   * Return the mapped quadrature weight, i.e., the determinant of the
+   * Jacobian times the quadrature weight, at quadrature point @p q.
+   */
+  const VectorizedArrayType &
+  JxW(const unsigned int q) const;
+
+  /**
+   * Return the location of quadrature point @p q in real space.
+   */
+  const Point<dim, VectorizedArrayType> &
+  quadrature_point(const unsigned int q) const;
+
+  /**
+   * Return the Jacobian of the transformation from the reference cell to
+   * the real cells at quadrature point @p q, with the entry $J_{ij} =
+   * \partial x_i / \partial \hat x_j$.
+   */
+  const Tensor<2, dim, VectorizedArrayType> &
+  jacobian(const unsigned int q) const;
+
+  /**
+   * Return the inverse of the Jacobian at quadrature point @p q.
+   */
+  const Tensor<2, dim, VectorizedArrayType> &
+  inverse_jacobian(const unsigned int q) const;
+
+  /**
+   * Return the number of lanes filled with cells by the last call to
+   * reinit().
+   */
+  unsigned int
+  n_filled_lanes() const;
+
+  /**
+   * Return the cell placed in the given @p lane by the last call to
+   * reinit().
+   */
+  const typename Triangulation<dim>::cell_iterator &
+  get_cell(const unsigned int lane) const;
+
+  /**
+   * Return an object that can be thought of as an array containing all
+   * indices from zero to `dofs_per_cell`, like FEValuesBase::dof_indices().
+   */
+  std_cxx20::ranges::iota_view<unsigned int, unsigned int>
+  dof_indices() const;
+
+  /**
+   * Return an object that can be thought of as an array containing all
+   * indices from zero to `n_quadrature_points`, like
+   * FEValuesBase::quadrature_point_indices().
+   */
+  std_cxx20::ranges::iota_view<unsigned int, unsigned int>
+  quadrature_point_indices() const;
+
+  /**
+   * Return a reference to the finite element.
+   */
+  const FiniteElement<dim> &
+  get_fe() const;
+
+  /**
+   * Return a reference to the mapping.
+   */
+  const Mapping<dim> &
+  get_mapping() const;
+
+  /**
+   * Return the update flags given to the constructor.
+   */
+  UpdateFlags
+  get_update_flags() const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * The number of degrees of freedom per cell.
+   */
+  const unsigned int dofs_per_cell;
+
+  /**
+   * The number of quadrature points.
+   */
+  const unsigned int n_quadrature_points;
+
+private:
+  /**
+   * Compute the Jacobians and, if requested, the quadrature points from the
+   * support points of a MappingQ object.
+   */
+  void
+  compute_mapping_data_q();
+
+  /**
+   * Compute the Jacobians and, if requested, the quadrature points with an
+   * FEValues object, one cell at a time.
+   */
+  void
+  compute_mapping_data_generic();
+
+  /**
+   * The mapping given to the constructor.
+   */
+  ObserverPointer<const Mapping<dim>> mapping;
+
+  /**
+   * The mapping given to the constructor, if it is of type MappingQ, and a
+   * null pointer otherwise.
+   */
+  const MappingQ<dim, dim> *mapping_q;
+
+  /**
+   * The finite element given to the constructor.
+   */
+  ObserverPointer<const FiniteElement<dim>> fe;
+
+  /**
+   * The quadrature formula given to the constructor.
+   */
+  const Quadrature<dim> quadrature;
+
+  /**
+   * The update flags given to the constructor.
+   */
+  const UpdateFlags update_flags;
+
+  /**
+   * The cells of the current batch. The entries beyond #n_filled_cells
+   * repeat the last cell.
+   */
+  std::array<typename Triangulation<dim>::cell_iterator, n_lanes> cells;
+
+  /**
+   * The number of cells of the current batch.
+   */
+  unsigned int n_filled_cells;
+
+  /**
+   * The values of the shape functions on the reference cell, with the
+   * index `i * n_quadrature_points + q`.
+   */
+  std::vector<VectorizedArrayType> shape_values;
+
+  /**
+   * The gradients of the shape functions on the reference cell, with the
+   * same index as #shape_values.
+   */
+  std::vector<Tensor<1, dim, Number>> unit_shape_gradients;
+
+  /**
+   * The gradients of the shape functions on the cells of the current batch.
+   */
+  std::vector<Tensor<1, dim, VectorizedArrayType>> shape_gradients;
+
+  /**
+   * The values and gradients of the polynomials of a MappingQ object on the
+   * reference cell, in the numbering of the mapping support points and with
+   * the index `q * n_mapping_support_points + k`.
+   */
+  std::vector<Number>                 mapping_shape_values;
+  std::vector<Tensor<1, dim, Number>> mapping_shape_gradients;
+
+  /**
+   * The support points of a MappingQ object on the cells of the current
+   * batch.
+   */
+  std::vector<Point<dim, VectorizedArrayType>> mapping_support_points;
+
+  /**
+   * An FEValues object used to compute the Jacobians for mappings that are
+   * not of type MappingQ.
+   */
+  std::unique_ptr<FEValues<dim>> scalar_fe_values;
+
+  /**
+   * The geometry of the cells of the current batch at the quadrature
+   * points.
+   */
+  std::vector<Point<dim, VectorizedArrayType>>     quadrature_points;
+  std::vector<Tensor<2, dim, VectorizedArrayType>> jacobians;
+  std::vector<Tensor<2, dim, VectorizedArrayType>> inverse_jacobians;
+  std::vector<VectorizedArrayType>                 JxW_values;
+};
+
+
+#ifndef DOXYGEN
+
+template <int dim, typename Number>
+template <typename CellIteratorType>
+inline void
+FEValuesBatch<dim, Number>::reinit(const ArrayView<CellIteratorType> &cells)
+{
+  AssertIndexRange(cells.size(), n_lanes + 1);
+  std::array<typename Triangulation<dim>::cell_iterator, n_lanes> tria_cells;
+  for (unsigned int lane = 0; lane < cells.size(); ++lane)
+    tria_cells[lane] = cells[lane];
+  reinit(make_array_view(tria_cells.cbegin(),
+                         tria_cells.cbegin() + cells.size()));
+}
+
+
+
+template <int dim, typename Number>
+inline const typename FEValuesBatch<dim, Number>::VectorizedArrayType &
+FEValuesBatch<dim, Number>::shape_value(const unsigned int i,
+                                        const unsigned int q) const
+{
+  Assert(update_flags & update_values,
+         typename FEValuesBase<dim>::ExcAccessToUninitializedField(
+           "update_values"));
+  AssertIndexRange(i, dofs_per_cell);
+  AssertIndexRange(q, n_quadrature_points);
+  return shape_values[i * n_quadrature_points + q];
+}
+
+
+
+template <int dim, typename Number>
+inline const Tensor<1,
+                    dim,
+                    typename FEValuesBatch<dim, Number>::VectorizedArrayType> &
+FEValuesBatch<dim, Number>::shape_grad(const unsigned int i,
+                                       const unsigned int q) const
+{
+  Assert(update_flags & update_gradients,
+         typename FEValuesBase<dim>::ExcAccessToUninitializedField(
+           "update_gradients"));
+  AssertIndexRange(i, dofs_per_cell);
+  AssertIndexRange(q, n_quadrature_points);
+  return shape_gradients[i * n_quadrature_points + q];
+}
+
+
+
+template <int dim, typename Number>
+inline const typename FEValuesBatch<dim, Number>::VectorizedArrayType &
+FEValuesBatch<dim, Number>::JxW(const unsigned int q) const
+{
+  Assert(update_flags & update_JxW_values,
+         typename FEValuesBase<dim>::ExcAccessToUninitializedField(
+           "update_JxW_values"));
+  AssertIndexRange(q, n_quadrature_points);
+  return JxW_values[q];
+}
+
+
+
+template <int dim, typename Number>
+inline const Point<dim,
+                   typename FEValuesBatch<dim, Number>::VectorizedArrayType> &
+FEValuesBatch<dim, Number>::quadrature_point(const unsigned int q) const
+{
+  Assert(update_flags & update_quadrature_points,
+         typename FEValuesBase<dim>::ExcAccessToUninitializedField(
+           "update_quadrature_points"));
+  AssertIndexRange(q, n_quadrature_points);
+  return quadrature_points[q];
+}
+
+
+
+template <int dim, typename Number>
+inline const Tensor<2,
+                    dim,
+                    typename FEValuesBatch<dim, Number>::VectorizedArrayType> &
+FEValuesBatch<dim, Number>::jacobian(const unsigned int q) const
+{
+  Assert(update_flags & update_jacobians,
+         typename FEValuesBase<dim>::ExcAccessToUninitializedField(
+           "update_jacobians"));
+  AssertIndexRange(q, n_quadrature_points);
+  return jacobians[q];
+}
+
+
+
+template <int dim, typename Number>
+inline const Tensor<2,
+                    dim,
+                    typename FEValuesBatch<dim, Number>::VectorizedArrayType> &
+FEValuesBatch<dim, Number>::inverse_jacobian(const unsigned int q) const
+{
+  Assert(update_flags & update_inverse_jacobians,
+         typename FEValuesBase<dim>::ExcAccessToUninitializedField(
+           "update_inverse_jacobians"));
+  AssertIndexRange(q, n_quadrature_points);
+  return inverse_jacobians[q];
+}
+
+
+
+template <int dim, typename Number>
+inline unsigned int
+FEValuesBatch<dim, Number>::n_filled_lanes() const
+{
+  return n_filled_cells;
+}
+
+
+
+template <int dim, typename Number>
+inline const typename Triangulation<dim>::cell_iterator &
+FEValuesBatch<dim, Number>::get_cell(const unsigned int lane) const
+{
+  AssertIndexRange(lane, n_filled_cells);
+  return cells[lane];
+}
+
+
+
+template <int dim, typename Number>
+inline std_cxx20::ranges::iota_view<unsigned int, unsigned int>
+FEValuesBatch<dim, Number>::dof_indices() const
+{
+  return std_cxx20::ranges::iota_view<unsigned int, unsigned int>(
+    0U, dofs_per_cell);
+}
+
+
+
+template <int dim, typename Number>
+inline std_cxx20::ranges::iota_view<unsigned int, unsigned int>
+FEValuesBatch<dim, Number>::quadrature_point_indices() const
+{
+  return std_cxx20::ranges::iota_view<unsigned int, unsigned int>(
+    0U, n_quadrature_points);
+}
+
+
+
+template <int dim, typename Number>
+inline const FiniteElement<dim> &
+FEValuesBatch<dim, Number>::get_fe() const
+{
+  return *fe;
+}
+
+
+
+template <int dim, typename Number>
+inline const Mapping<dim> &
+FEValuesBatch<dim, Number>::get_mapping() const
+{
+  return *mapping;
+}
+
+
+
+template <int dim, typename Number>
+inline UpdateFlags
+FEValuesBatch<dim, Number>::get_update_flags() const
+{
+  return update_flags;
+}
+
+#endif
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
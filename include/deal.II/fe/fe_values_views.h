@@ -258,6 +258,28 @@ namespace FEValuesViews
     Scalar &
     operator=(Scalar<dim, spacedim> &&) noexcept = default;
 
+    /**
+     * Return the indices of the shape functions for which the vector
+     * component selected by this view may be nonzero, in ascending order.
+     * For a vector-valued element, this is typically a small subset of all
+     * shape functions, and loops in assembly routines that only involve the
+     * current component can run over these shape functions only, rather
+     * than over all of them:
+     * @code
+     *   const auto &pressure_view = fe_values[pressure];
+     *   for (const unsigned int i : pressure_view.nonzero_shape_functions())
+     *     for (const unsigned int j : pressure_view.nonzero_shape_functions())
+     *       for (const unsigned int q : fe_values.quadrature_point_indices())
+     *         cell_matrix(i, j) += pressure_view.value(i, q) *
+     *                              pressure_view.value(j, q) *
+     *                              fe_values.JxW(q);
+     * @endcode
+     * The functions get_function_values() and similar of this class also
+     * only visit these shape functions.
+     */
+    const std::vector<unsigned int> &
+    nonzero_shape_functions() const;
+
     /**
      * Return the value of the vector component selected by this view, for the
      * shape function and quadrature point selected by the arguments.
@@ -546,6 +568,12 @@ namespace FEValuesViews
      * Store the data about shape functions.
      */
     std::vector<ShapeFunctionData> shape_function_data;
+
+    /**
+     * The indices of the shape functions for which the component of this
+     * view may be nonzero, see nonzero_shape_functions().
+     */
+    std::vector<unsigned int> nonzero_shape_function_indices;
   };
 
 
@@ -805,6 +833,15 @@ namespace FEValuesViews
     Vector &
     operator=(Vector<dim, spacedim> &&) = default; // NOLINT
 
+    /**
+     * Return the indices of the shape functions for which at least one of
+     * the vector components selected by this view may be nonzero, in
+     * ascending order. See Scalar::nonzero_shape_functions() for an example
+     * of how this can be used to restrict loops in assembly routines.
+     */
+    const std::vector<unsigned int> &
+    nonzero_shape_functions() const;
+
     /**
      * Return the value of the vector components selected by this view, for
      * the shape function and quadrature point selected by the arguments.
@@ -1269,6 +1306,12 @@ namespace FEValuesViews
      * Store the data about shape functions.
      */
     std::vector<ShapeFunctionData> shape_function_data;
+
+    /**
+     * The indices of the shape functions for which at least one of the
+     * components of this view may be nonzero, see nonzero_shape_functions().
+     */
+    std::vector<unsigned int> nonzero_shape_function_indices;
   };
 
 
@@ -2073,6 +2116,15 @@ namespace FEValuesViews
 
 namespace FEValuesViews
 {
+  template <int dim, int spacedim>
+  inline const std::vector<unsigned int> &
+  Scalar<dim, spacedim>::nonzero_shape_functions() const
+  {
+    return nonzero_shape_function_indices;
+  }
+
+
+
   template <int dim, int spacedim>
   inline typename Scalar<dim, spacedim>::value_type
   Scalar<dim, spacedim>::value(const unsigned int shape_function,
@@ -2164,6 +2216,15 @@ namespace FEValuesViews
 
 
 
+  template <int dim, int spacedim>
+  inline const std::vector<unsigned int> &
+  Vector<dim, spacedim>::nonzero_shape_functions() const
+  {
+    return nonzero_shape_function_indices;
+  }
+
+
+
   template <int dim, int spacedim>
   inline typename Vector<dim, spacedim>::value_type
   Vector<dim, spacedim>::value(const unsigned int shape_function,
@@ -40,7 +40,9 @@ namespace FEValuesViews
     // ------------------------- scalar functions --------------------------
 
     /**
-     * Compute function values for Scalars.
+     * Compute function values for Scalars. Only the shape functions listed
+     * in @p nonzero_shape_functions, i.e., those for which the component of
+     * the view may be nonzero, are visited.
      */
     template <int dim, int spacedim, typename Number>
     void
@@ -48,7 +50,8 @@ namespace FEValuesViews
       const ArrayView<const Number> &dof_values,
       const Table<2, double>        &shape_values,
       const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
-        &shape_function_data,
+                                      &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename ProductType<Number, double>::type> &values);
 
     /**
@@ -61,7 +64,8 @@ namespace FEValuesViews
       const ArrayView<const Number>                   &dof_values,
       const Table<2, dealii::Tensor<order, spacedim>> &shape_derivatives,
       const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
-        &shape_function_data,
+                                      &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<
         typename ProductType<Number, dealii::Tensor<order, spacedim>>::type>
         &derivatives);
@@ -75,7 +79,8 @@ namespace FEValuesViews
       const ArrayView<const Number>               &dof_values,
       const Table<2, dealii::Tensor<2, spacedim>> &shape_hessians,
       const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
-        &shape_function_data,
+                                      &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename Scalar<dim, spacedim>::
                     template solution_laplacian_type<Number>> &laplacians);
 
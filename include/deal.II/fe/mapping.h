@@ -517,6 +517,30 @@ public:
     const ArrayView<const Point<spacedim>>                     &real_points,
     const ArrayView<Point<dim>> &unit_points) const;
 
+  /**
+   * The same as the previous function, but using the reference locations
+   * given in @p initial_unit_points as starting points of the inverse
+   * mapping of the points in @p real_points, e.g., the reference locations
+   * of the same points computed in an earlier call before the points moved
+   * by a small distance, as is common for particles or for the points of
+   * RemotePointEvaluation on deforming meshes. Mappings that compute the
+   * inverse by an iterative method, such as MappingQ, then often need only
+   * one or two iterations. MappingQ projects guesses outside the reference
+   * cell to it, and if the iteration from an initial guess does not
+   * succeed, it transforms the point as in the previous function. The same
+   * is done for guesses that are not finite, e.g., reference locations that
+   * have not been computed yet and are still set to signaling NaNs.
+   *
+   * The default implementation ignores @p initial_unit_points and calls the
+   * previous function.
+   */
+  virtual void
+  transform_points_real_to_unit_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<spacedim>>                     &real_points,
+    const ArrayView<const Point<dim>> &initial_unit_points,
+    const ArrayView<Point<dim>>       &unit_points) const;
+
   /**
    * Transform the point @p p on the real @p cell to the corresponding point
    * on the reference cell, and then project this point to a (dim-1)-dimensional
@@ -111,6 +111,8 @@ public:
     const ArrayView<const Point<spacedim>>                     &real_points,
     const ArrayView<Point<dim>> &unit_points) const override;
 
+  using Mapping<dim, spacedim>::transform_points_real_to_unit_cell;
+
   /**
    * @}
    */
@@ -28,6 +28,7 @@
 #include <deal.II/matrix_free/shape_info.h>
 
 #include <array>
+#include <atomic>
 #include <cmath>
 
 DEAL_II_NAMESPACE_OPEN
@@ -170,6 +171,67 @@ public:
     const ArrayView<const Point<spacedim>>                     &real_points,
     const ArrayView<Point<dim>> &unit_points) const override;
 
+  // for documentation, see the Mapping base class
+  virtual void
+  transform_points_real_to_unit_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<spacedim>>                     &real_points,
+    const ArrayView<const Point<dim>> &initial_unit_points,
+    const ArrayView<Point<dim>>       &unit_points) const override;
+
+  /**
+   * A structure holding statistics on the Newton iterations performed by the
+   * transform_points_real_to_unit_cell() functions of this object.
+   */
+  struct InverseMappingStatistics
+  {
+    /**
+     * The number of points that have been transformed.
+     */
+    std::size_t n_points;
+
+    /**
+     * The number of Newton iterations, summed over all points. Points that
+     * are transformed together in the lanes of a VectorizedArray count the
+     * iterations of their batch each.
+     */
+    std::size_t n_newton_iterations;
+
+    /**
+     * The number of points for which the Newton iteration starting from a
+     * given initial guess did not succeed, so that the point was transformed
+     * again starting from an approximation of the inverse mapping.
+     */
+    std::size_t n_initial_guesses_rejected;
+
+    /**
+     * The number of points for which the transformation failed.
+     */
+    std::size_t n_failed;
+  };
+
+  /**
+   * Return the statistics on the Newton iterations of all calls to
+   * transform_points_real_to_unit_cell() on this object since its creation
+   * or the last call to reset_inverse_mapping_statistics(). This allows to
+   * judge the quality of the initial guesses handed to these functions,
+   * e.g., when tracking particles. Transformations of single points by
+   * transform_real_to_unit_cell() and mappings with dim < spacedim, which go
+   * through the base class implementation, are not counted.
+   *
+   * The statistics are collected in a thread-safe way, so this object may be
+   * used from several threads at once.
+   */
+  InverseMappingStatistics
+  get_inverse_mapping_statistics() const;
+
+  /**
+   * Reset the statistics returned by get_inverse_mapping_statistics() to
+   * zero.
+   */
+  void
+  reset_inverse_mapping_statistics() const;
+
   /**
    * @}
    */
@@ -577,6 +639,26 @@ protected:
    */
   const Table<2, double> support_point_weights_cell;
 
+  /**
+   * Counters for the statistics returned by
+   * get_inverse_mapping_statistics(), in the order of the members of
+   * InverseMappingStatistics.
+   */
+  mutable std::array<std::atomic<std::size_t>, 4> inverse_mapping_counters;
+
+  /**
+   * Implementation of the transform_points_real_to_unit_cell() functions
+   * for dim == spacedim. If @p initial_unit_points is empty, or for those
+   * of its points that are not finite, the Newton iteration starts from an
+   * approximation of the inverse mapping.
+   */
+  void
+  do_transform_points_real_to_unit_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<spacedim>>                     &real_points,
+    const ArrayView<const Point<dim>> &initial_unit_points,
+    const ArrayView<Point<dim>>       &unit_points) const;
+
   /**
    * Return the locations of support points for the mapping. For example, for
    * $Q_1$ mappings these are the vertices, and for higher order polynomial
@@ -662,6 +744,11 @@ protected:
   // compute_mapping_support_points() function.
   template <int, int>
   friend class MappingQCache;
+
+  // Make FEValuesBatch a friend since it evaluates the mapping from the
+  // support points and the polynomials of this class.
+  template <int, typename>
+  friend class FEValuesBatch;
 };
 
 
@@ -58,8 +58,17 @@ public:
    * Constructor. @p polynomial_degree denotes the polynomial degree of the
    * polynomials that are used to map cells from the reference to the real
    * cell.
+   *
+   * If @p use_float_storage is set to true, the mapping support points are
+   * stored in single precision, which halves the memory consumption of the
+   * cache. The points are computed in double precision and only rounded
+   * when they are stored, so the geometry is represented with a relative
+   * accuracy of around $10^{-7}$, which is sufficient in many applications
+   * that use the cache for large meshes, but not in tests comparing to
+   * double-precision results.
    */
-  explicit MappingQCache(const unsigned int polynomial_degree);
+  explicit MappingQCache(const unsigned int polynomial_degree,
+                         const bool         use_float_storage = false);
 
   /**
    * Copy constructor.
@@ -192,6 +201,50 @@ public:
              const MGLevelObject<VectorType> &vectors,
              const bool vector_describes_relative_displacement);
 
+  /**
+   * Recompute the mapping support points of the cells in @p cells by the
+   * function @p compute_points_on_cell, keeping the cached points of all
+   * other cells. For meshes where only a part of the cells moves, e.g. in
+   * arbitrary Lagrangian-Eulerian (ALE) computations, this is much cheaper
+   * than calling initialize() again, and it re-uses the memory of the cache.
+   *
+   * The cache must have been set up by one of the initialize() functions
+   * for the same triangulation, and the triangulation must not have changed
+   * since then. The requirements on @p compute_points_on_cell and the notes
+   * on multithreading are the same as for the initialize() function taking
+   * a function object.
+   *
+   * @note Copies of this object created via clone() or the copy constructor
+   * share the cache, so they see the updated points as well.
+   */
+  void
+  update(const std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+           &cells,
+         const std::function<std::vector<Point<spacedim>>(
+           const typename Triangulation<dim, spacedim>::cell_iterator &)>
+           &compute_points_on_cell);
+
+  /**
+   * Recompute the mapping support points of the cells in @p cells from a
+   * discrete field (specified by @p dof_handler and @p vector) that
+   * describes the absolute or relative position of each support point, in
+   * the same way as the initialize() function with the same arguments does
+   * for all cells. The points of all other cells are kept. For the
+   * requirements on the cache, see the other update() function.
+   *
+   * A typical use is a moving mesh where the displacement field only changes
+   * in some part of the domain: one passes the active cells adjacent to the
+   * degrees of freedom whose displacement has changed.
+   */
+  template <typename VectorType>
+  void
+  update(const Mapping<dim, spacedim>    &mapping,
+         const DoFHandler<dim, spacedim> &dof_handler,
+         const VectorType                &vector,
+         const bool vector_describes_relative_displacement,
+         const std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+           &cells);
+
   /**
    * @copydoc Mapping::get_vertices()
    */
@@ -221,6 +274,37 @@ protected:
     boost::container::small_vector<Point<spacedim>, 200> &a) const override;
 
 private:
+  /**
+   * Implementation of the initialize() and update() functions taking a
+   * discrete field on the active cells. If @p cells is a null pointer, the
+   * cache is initialized for all cells, otherwise only the given cells are
+   * updated.
+   */
+  template <typename VectorType>
+  void
+  initialize_or_update(
+    const Mapping<dim, spacedim>    &mapping,
+    const DoFHandler<dim, spacedim> &dof_handler,
+    const VectorType                &vector,
+    const bool                       vector_describes_relative_displacement,
+    const std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+      *cells);
+
+  /**
+   * Store the given mapping support points of a cell in the cache, in the
+   * precision selected in the constructor.
+   */
+  void
+  store_support_points(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const std::vector<Point<spacedim>>                         &points);
+
+  /**
+   * Whether the support points are stored in single precision, i.e., in
+   * support_point_cache_float rather than support_point_cache.
+   */
+  bool use_float_storage;
+
   /**
    * The point cache filled upon calling initialize(). It is made a shared
    * pointer to allow several instances (created via clone()) to share this
@@ -229,6 +313,14 @@ private:
   std::shared_ptr<std::vector<std::vector<std::vector<Point<spacedim>>>>>
     support_point_cache;
 
+  /**
+   * The same as support_point_cache, but in single precision. Only one of
+   * the two caches is used, depending on the variable use_float_storage.
+   */
+  std::shared_ptr<
+    std::vector<std::vector<std::vector<Point<spacedim, float>>>>>
+    support_point_cache_float;
+
   /**
    * The connection to Triangulation::signals::any that must be reset once
    * this class goes out of scope.
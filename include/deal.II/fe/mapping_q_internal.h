@@ -470,7 +470,8 @@ namespace internal
 
     /**
      * Implementation of transform_real_to_unit_cell for either type double
-     * or VectorizedArray<double>
+     * or VectorizedArray<double>. If @p n_iterations is not a null pointer,
+     * the number of Newton iterations performed is written into it.
      */
     template <int dim, int spacedim, typename Number>
     inline Point<dim, Number>
@@ -480,8 +481,12 @@ namespace internal
       const ArrayView<const Point<spacedim>>             &points,
       const std::vector<Polynomials::Polynomial<double>> &polynomials_1d,
       const std::vector<unsigned int>                    &renumber,
-      const bool print_iterations_to_deallog = false)
+      const bool          print_iterations_to_deallog = false,
+      unsigned int *const n_iterations                = nullptr)
     {
+      if (n_iterations != nullptr)
+        *n_iterations = 0;
+
       if (print_iterations_to_deallog)
         deallog << "Start MappingQ::do_transform_real_to_unit_cell for real "
                 << "point [ " << p << " ] " << std::endl;
@@ -604,7 +609,11 @@ namespace internal
                   continue;
                 }
               else
-                return invalid_point;
+                {
+                  if (n_iterations != nullptr)
+                    *n_iterations = newton_iteration;
+                  return invalid_point;
+                }
             }
 
           // Solve  [f'(x)]d=f(x)
@@ -702,11 +711,11 @@ namespace internal
               tried_project_to_unit_cell  = true;
               continue;
             }
-          else if (step_length <= 0.05)
-            return invalid_point;
-
           ++newton_iteration;
-          if (newton_iteration > newton_iteration_limit)
+          if (n_iterations != nullptr)
+            *n_iterations = newton_iteration;
+
+          if (step_length <= 0.05 || newton_iteration > newton_iteration_limit)
             return invalid_point;
         }
       // Stop if f_weighted_norm_square <= eps^2 on all SIMD lanes or if the
@@ -509,8 +509,15 @@ namespace GridTools
    * Mapping::transform_unit_to_real(qpoints[c][0])
    * returns @p points[a].
    *
-   * The algorithm builds an rtree of @p points to sort them spatially, before
-   * attempting to call find_active_cell_around_point().
+   * The algorithm builds an rtree of @p points to sort them spatially and
+   * groups them into batches of points that lie within the bounding box of
+   * the same cell. For each batch, the inverse mapping is evaluated for all
+   * points at once via Mapping::transform_points_real_to_unit_cell(), which
+   * is considerably faster than the point-by-point variant for mappings such
+   * as MappingQ. Only the points that are not found well inside the cell of
+   * their batch are passed on to find_active_cell_around_point(). The batches
+   * are processed in parallel if deal.II is configured with multithreading,
+   * while the result is independent of the number of threads.
    *
    * @note This function is not implemented for the codimension one case (<tt>spacedim != dim</tt>).
    *
@@ -51,15 +51,33 @@ namespace GridTools
    * for faster access whenever the triangulation has not changed.
    *
    * Notice that this class only notices if the underlying Triangulation has
-   * changed due to a Triangulation::Signals::any_change() signal being
-   * triggered.
+   * changed due to one of the signals collected in
+   * Triangulation::Signals::any_change() being triggered.
+   *
+   * For a serial Triangulation, the data structures that have already been
+   * computed are not discarded upon refinement and coarsening. Rather, the
+   * entries of the cells that are refined or coarsened away are removed
+   * before the Triangulation changes, and the entries of the newly created
+   * active cells are added afterwards. The latter step is deferred to the
+   * next call of the respective `get_*` function, such that a mapping that
+   * depends on data attached to the new mesh (such as MappingQEulerian or
+   * MappingFEField) may be updated in the meantime. This incremental update
+   * assumes that the mapping of the cells that have not been refined or
+   * coarsened is not changed by the refinement step. The vertex-to-cell
+   * relations are only updated incrementally in steps without coarsening,
+   * and are recomputed from scratch otherwise. For all
+   * parallel::TriangulationBase objects, all data structures are recomputed.
    *
    * If the triangulation changes for other reasons, for example because you
    * use it in conjunction with a MappingQEulerian object that sees the
    * vertices through its own transformation, or because you manually change
    * some vertex locations, then some of the structures in this class become
    * obsolete, and you will have to mark them as outdated, by calling the
-   * method mark_for_update() manually.
+   * method mark_for_update() manually. If only the location of the vertices
+   * has changed but not the connectivity of the mesh, calling
+   * mark_for_update() with the flag GridTools::update_geometric_data keeps
+   * the vertex-to-cell map. The same is done automatically when the
+   * Triangulation::Signals::mesh_movement() signal is triggered.
    */
   template <int dim, int spacedim = dim>
   class Cache : public EnableObserverPointer
@@ -327,11 +345,131 @@ namespace GridTools
                        vertices_with_ghost_neighbors;
     mutable std::mutex vertices_with_ghost_neighbors_mutex;
 
+    /**
+     * A list of the active cells that have been created by the last
+     * refinement and coarsening step of a serial triangulation, and that
+     * still need to be added to the data structures indicated by
+     * #pending_update_flags. The entries are added when the respective
+     * `get_*` function is called next.
+     */
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+      pending_cells;
+
+    /**
+     * The flags of those data structures that still need the cells in
+     * #pending_cells to be added.
+     */
+    mutable std::atomic<std::underlying_type_t<CacheUpdateFlags>>
+      pending_update_flags;
+
+    /**
+     * The flags of those data structures that are maintained incrementally
+     * during the refinement step of the triangulation currently in progress.
+     * Set upon the Triangulation::Signals::pre_refinement() signal, and
+     * evaluated upon the Triangulation::Signals::post_refinement() signal.
+     */
+    CacheUpdateFlags incremental_update_flags;
+
+    /**
+     * The cells that are refined during the refinement step currently in
+     * progress. After refinement, the children of these cells are the new
+     * active cells.
+     */
+    std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+      refined_cells;
+
+    /**
+     * The cells whose children are coarsened away during the refinement step
+     * currently in progress. After coarsening, these cells are active.
+     */
+    std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+      coarsened_cells;
+
+    /**
+     * The vertices of the active cells that are removed during the
+     * refinement step currently in progress.
+     */
+    std::vector<unsigned int> vertices_of_removed_cells;
+
+    /**
+     * The vertices whose entry in the vertex-to-cell map has been changed
+     * during the refinement step currently in progress.
+     */
+    std::set<unsigned int> touched_vertices;
+
+    /**
+     * Connect this object to the signals of the triangulation, as described
+     * in the documentation of this class.
+     */
+    void
+    connect_to_triangulation_signals();
+
+    /**
+     * Function connected to Triangulation::Signals::pre_refinement() for
+     * serial triangulations. Determines which of the cached data structures
+     * can be updated incrementally, and removes the cells flagged for
+     * refinement from them.
+     */
+    void
+    prepare_incremental_update();
+
+    /**
+     * Function connected to Triangulation::Signals::pre_coarsening_on_cell()
+     * for serial triangulations. Removes the children of @p parent from
+     * the cached data structures.
+     */
+    void
+    remove_children_of_coarsened_cell(
+      const typename Triangulation<dim, spacedim>::cell_iterator &parent);
+
+    /**
+     * Remove the entries of a single active cell that is about to be
+     * refined or coarsened away from the cached data structures.
+     */
+    void
+    remove_cell(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell);
+
+    /**
+     * Function connected to Triangulation::Signals::post_refinement() for
+     * serial triangulations. Adds the new active cells to the vertex-to-cell
+     * map and schedules them for addition to the remaining data structures.
+     */
+    void
+    finalize_incremental_update();
+
+    /**
+     * Add the relations between @p cell and the vertices in its neighborhood
+     * to #vertex_to_cells, following the rules of
+     * GridTools::vertex_to_cell_map().
+     */
+    void
+    add_to_vertex_to_cell_map(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell);
+
+    /**
+     * Compute the bounding boxes of the given cells with the stored mapping,
+     * possibly in parallel.
+     */
+    std::vector<std::pair<
+      BoundingBox<spacedim>,
+      typename Triangulation<dim, spacedim>::active_cell_iterator>>
+    compute_cell_bounding_boxes(
+      const std::vector<
+        typename Triangulation<dim, spacedim>::active_cell_iterator> &cells)
+      const;
+
     /**
      * Storage for the status of the triangulation change signal.
      */
     boost::signals2::connection tria_change_signal;
 
+    /**
+     * Storage for the status of the signals used for the incremental update
+     * of serial triangulations.
+     */
+    std::vector<boost::signals2::connection> tria_refinement_signals;
+
     /**
      * Storage for the status of the triangulation creation signal.
      */
@@ -87,6 +87,15 @@ namespace GridTools
      */
     update_vertex_with_ghost_neighbors = 0x200,
 
+    /**
+     * Update all objects that depend on the location of the vertices, i.e.,
+     * all objects except the vertex_to_cell_map that only depends on the
+     * connectivity of the mesh. This is the appropriate flag after the mesh
+     * has been moved, e.g., by changing the displacement vector of a
+     * MappingQEulerian object.
+     */
+    update_geometric_data = 0xFFE,
+
     /**
      * Update all objects.
      */
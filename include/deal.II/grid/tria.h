@@ -428,6 +428,14 @@ namespace internal
     std::vector<pack_callback_t> pack_callbacks_variable;
   };
 
+  /**
+   * Buffers, file handles, and requests of a write operation started by
+   * CellAttachedDataSerializer::start_save() that has not been completed
+   * yet. The definition of this structure is in tria.cc.
+   */
+  struct PendingCellAttachedDataSave;
+
+
   /**
    * A structure that stores information about the data that has been, or
    * will be, attached to cells via the register_data_attach() function
@@ -531,6 +539,45 @@ namespace internal
          const std::string &file_basename,
          const MPI_Comm    &mpi_communicator) const;
 
+    /**
+     * Like save(), but only start writing the data and return without
+     * waiting for the write operations to complete. The packed buffers
+     * <tt>src_*</tt> are moved into an internal object that is kept alive
+     * until the data has been written, i.e., until wait_for_save() is called.
+     * The files written are the same as the ones written by save().
+     *
+     * If MPI support is enabled and more than one process is involved, the
+     * data is written via non-blocking MPI I/O. Otherwise, the files are
+     * written on a separate thread.
+     *
+     * Data has to be previously packed with pack_data().
+     */
+    void
+    start_save(const unsigned int global_first_cell,
+               const unsigned int global_num_cells,
+               const std::string &file_basename,
+               const MPI_Comm    &mpi_communicator);
+
+    /**
+     * Wait until the data written by the last call to start_save() has been
+     * written completely, and release the associated buffers. This function
+     * does nothing if there is no such operation in progress.
+     *
+     * If MPI support is enabled and more than one process is involved, this
+     * is a collective operation.
+     */
+    void
+    wait_for_save();
+
+    /**
+     * Return the number of bytes written by the current process in the
+     * write operation started by the last call to start_save() and the wall
+     * time in seconds it took, or zeros if there is no such operation or if
+     * it has not been completed by wait_for_save() yet.
+     */
+    std::pair<std::size_t, double>
+    get_save_statistics() const;
+
     /**
      * Deserialize data from file system.
      *
@@ -599,6 +646,20 @@ namespace internal
     std::vector<int>  dest_sizes_variable;
     std::vector<char> src_data_variable;
     std::vector<char> dest_data_variable;
+
+    /**
+     * Flag that denotes if Triangulation::save() writes the packed data via
+     * start_save() rather than save().
+     */
+    bool save_asynchronously;
+
+    /**
+     * The write operation started by the last call to start_save(). Once it
+     * has been completed by wait_for_save(), this object only keeps its
+     * statistics, see get_save_statistics(). Destroying this object waits
+     * for the operation to complete.
+     */
+    std::shared_ptr<PendingCellAttachedDataSave> pending_save;
   };
 } // namespace internal
 
@@ -3721,6 +3782,76 @@ public:
   virtual void
   load(const std::string &file_basename);
 
+  /**
+   * Select whether save() writes the data attached to the cells (e.g., via
+   * SolutionTransfer::prepare_for_serialization()) asynchronously. If set to
+   * `true`, save() packs the data into buffers, starts writing them, and
+   * returns without waiting for the write operations to complete: In
+   * parallel computations, the data is written via non-blocking MPI I/O,
+   * otherwise on a separate thread. This allows overlapping the output of a
+   * checkpoint with the computations that follow it. The format of the
+   * files written is not affected by this flag.
+   *
+   * The files written by save() are only complete after a call to
+   * wait_for_asynchronous_save(). This function is also called implicitly
+   * at the beginning of the next call to save() or load(), and when this
+   * object is destroyed.
+   *
+   * By default, data is written synchronously.
+   */
+  void
+  set_asynchronous_save(const bool asynchronous);
+
+  /**
+   * Wait until the data written by a call to save() with asynchronous saving
+   * enabled (see set_asynchronous_save()) has been written completely. This
+   * function does nothing if no such write operation is in progress.
+   *
+   * @note In parallel computations, this is a collective operation that
+   * needs to be called on all processes.
+   */
+  void
+  wait_for_asynchronous_save() const;
+
+  /**
+   * A structure that describes the last write operation of data attached to
+   * the cells that was started by save() with asynchronous saving enabled,
+   * see get_asynchronous_save_statistics().
+   */
+  struct AsynchronousSaveStatistics
+  {
+    /**
+     * The number of bytes written by the current process.
+     */
+    std::size_t n_bytes;
+
+    /**
+     * The wall time in seconds from starting the write operations in save()
+     * until they completed. If the data is written on a separate thread,
+     * this is the time that thread took. With non-blocking MPI I/O,
+     * completion can only be observed when waiting for it, so the time is
+     * measured until wait_for_asynchronous_save() returns and is an upper
+     * bound if other work is done in between.
+     */
+    double wall_time;
+
+    /**
+     * Return the throughput of the current process in bytes per second,
+     * i.e., <tt>n_bytes/wall_time</tt>, or zero if nothing was written.
+     */
+    double
+    throughput() const;
+  };
+
+  /**
+   * Return the number of bytes and the time of the last asynchronous write
+   * operation started by save(), once it has been completed by
+   * wait_for_asynchronous_save() or implicitly by load(). As long as no
+   * such operation has been completed, both numbers are zero.
+   */
+  AsynchronousSaveStatistics
+  get_asynchronous_save_statistics() const;
+
 
   /**
    * Declare the (coarse) face pairs given in the argument of this function as
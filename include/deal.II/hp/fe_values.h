@@ -28,6 +28,7 @@
 #include <deal.II/hp/q_collection.h>
 
 #include <memory>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -128,6 +129,9 @@ namespace hp
      * This function precalculates the FE*Values objects corresponding to the
      * provided parameters: The total of all vector entries corresponding to the
      * same index describes an FE*Values object similarly to select_fe_values().
+     * Objects that already exist, e.g., because they have been used in
+     * reinit() before, are not created again, so this function can also be
+     * used to complete the set of objects of a partially used object.
      */
     void
     precalculate_fe_values(const std::vector<unsigned int> &fe_indices,
@@ -149,6 +153,62 @@ namespace hp
     void
     precalculate_fe_values();
 
+    /**
+     * A structure holding statistics on the calls to the reinit() functions
+     * of this object. Each member has one entry per element of the
+     * hp::FECollection, indexed by the FE index used in reinit().
+     */
+    struct ReinitStatistics
+    {
+      /**
+       * The number of calls to reinit().
+       */
+      std::vector<std::size_t> n_reinits;
+
+      /**
+       * The number of FE*Values objects that have been created, either
+       * lazily in reinit() or by precalculate_fe_values().
+       */
+      std::vector<std::size_t> n_fe_values_created;
+
+      /**
+       * The wall time in seconds spent in reinit(), including the creation
+       * of FE*Values objects on first use. The times are only measured
+       * after a call to measure_reinit_times(), as querying the clock on
+       * every call to reinit() is not free.
+       */
+      std::vector<double> reinit_times;
+    };
+
+    /**
+     * Return the statistics on the calls to reinit() since the creation of
+     * this object or the last call to reset_reinit_statistics(). This allows
+     * to see how the work of assembly loops is distributed among the
+     * elements of an hp::FECollection and how many FE*Values objects are
+     * created lazily during the loop rather than in advance.
+     *
+     * The statistics are not synchronized between different objects, so
+     * when using copies of this object on several threads, e.g., as part of
+     * the scratch data of WorkStream::run(), each copy counts only the calls
+     * made on it. A copy starts with empty statistics.
+     */
+    const ReinitStatistics &
+    get_reinit_statistics() const;
+
+    /**
+     * Reset the statistics returned by get_reinit_statistics() to zero.
+     */
+    void
+    reset_reinit_statistics();
+
+    /**
+     * Enable or disable measuring the time spent in reinit() for the
+     * statistics returned by get_reinit_statistics(). The times are not
+     * measured by default.
+     */
+    void
+    measure_reinit_times(const bool measure = true);
+
     /**
      * Get a reference to the collection of finite element objects used
      * here.
@@ -196,6 +256,18 @@ namespace hp
                      const unsigned int mapping_index,
                      const unsigned int q_index);
 
+    /**
+     * Select a FEValues object via select_fe_values() and call its reinit()
+     * function with the given arguments, recording the call in the
+     * statistics returned by get_reinit_statistics().
+     */
+    template <typename... Args>
+    void
+    reinit_fe_values(const unsigned int fe_index,
+                     const unsigned int mapping_index,
+                     const unsigned int q_index,
+                     const Args &...args);
+
   protected:
     /**
      * A pointer to the collection of finite elements to be used.
@@ -252,6 +324,17 @@ namespace hp
      * Values of the update flags as given to the constructor.
      */
     const UpdateFlags update_flags;
+
+    /**
+     * The statistics returned by get_reinit_statistics().
+     */
+    ReinitStatistics reinit_statistics;
+
+    /**
+     * Whether the time spent in reinit() is measured, as set by
+     * measure_reinit_times().
+     */
+    bool measure_times;
   };
 
 } // namespace hp
@@ -705,6 +788,16 @@ namespace hp
 
 
 
+  template <int dim, int q_dim, typename FEValuesType>
+  inline const typename FEValuesBase<dim, q_dim, FEValuesType>::
+    ReinitStatistics &
+  FEValuesBase<dim, q_dim, FEValuesType>::get_reinit_statistics() const
+  {
+    return reinit_statistics;
+  }
+
+
+
   template <int dim, int q_dim, typename FEValuesType>
   inline const FECollection<dim, FEValuesType::space_dimension> &
   FEValuesBase<dim, q_dim, FEValuesType>::get_fe_collection() const
@@ -46,6 +46,7 @@ template <typename number>
 class SparseMatrix;
 template <typename number>
 class BlockSparseMatrix;
+class TimerOutput;
 
 namespace internal
 {
@@ -174,6 +175,14 @@ namespace internal
       void
       reinit(const size_type n_local_rows);
 
+      /**
+       * Copy the content of @p other into this object. As opposed to the
+       * copy operations of the Distributing objects stored here, this
+       * function leaves @p other untouched.
+       */
+      void
+      copy_from(const GlobalRowsFromLocal<number> &other);
+
       void
       insert_index(const size_type global_row,
                    const size_type local_row,
@@ -289,6 +298,13 @@ namespace internal
       size_type
       constraint_origin(size_type i) const;
 
+      /**
+       * Return an estimate for the memory consumption (in bytes) of this
+       * object.
+       */
+      std::size_t
+      memory_consumption() const;
+
       /**
        * A vector that contains all the global ids and the corresponding local
        * ids as well as a pointer to that data where we store how to resolve
@@ -986,9 +1002,18 @@ public:
    * cycles in this graph of constraints are not allowed, i.e., for example
    * $u_4$ may not itself be constrained, directly or indirectly, to $u_{13}$
    * again.
+   *
+   * If a @p timer_output object is given, the internal phases of this
+   * function are timed in separate sections of it: "AffineConstraints::close:
+   * sort lines" for sorting the constraint lines and removing zero entries,
+   * "AffineConstraints::close: detect cycles" for computing the depth of each
+   * line in the graph of constraints (which also reveals cycles),
+   * "AffineConstraints::close: resolve chains" for the resolution of chained
+   * constraints, and "AffineConstraints::close: sort entries" for sorting and
+   * merging the entries of each line.
    */
   void
-  close();
+  close(TimerOutput *timer_output = nullptr);
 
   /**
    * Check if the function close() was called or there are no
@@ -1736,6 +1761,252 @@ public:
                              VectorType                   &global_vector,
                              bool use_inhomogeneities_for_rhs = false) const;
 
+  /**
+   * A cache for the element-local resolution of constraints that is done in
+   * every call to distribute_local_to_global(). For each cell, the function
+   * needs to find out which of the local degrees of freedom are constrained,
+   * to which global degrees of freedom the constraints refer and with which
+   * weights, and it needs to sort the resulting list of global rows. For a
+   * fixed set of constraints and a fixed numbering of degrees of freedom,
+   * this information does not change from one assembly to the next, so it
+   * can be computed once by prepare_local_to_global() and then be re-used by
+   * the variant of distribute_local_to_global() that takes an object of this
+   * type.
+   *
+   * Cells are identified by an arbitrary index chosen by the user, typically
+   * the active cell index:
+   * @code
+   *   AffineConstraints<double>::LocalToGlobalCache cache;
+   *   cache.reinit(triangulation.n_active_cells());
+   *   for (const auto &cell : dof_handler.active_cell_iterators())
+   *     if (cell->is_locally_owned())
+   *       {
+   *         cell->get_dof_indices(local_dof_indices);
+   *         constraints.prepare_local_to_global(cell->active_cell_index(),
+   *                                             local_dof_indices,
+   *                                             cache);
+   *       }
+   * @endcode
+   *
+   * For cells none of whose degrees of freedom are constrained, the object
+   * only stores the order in which the local rows have to be traversed to
+   * visit the global rows in ascending order. The full resolution of the
+   * constraints (global rows, origin of each entry, weights) is only stored
+   * for cells that actually have constrained degrees of freedom.
+   *
+   * The object needs to be re-computed whenever the constraints or the
+   * numbering of the degrees of freedom change.
+   */
+  class LocalToGlobalCache
+  {
+  public:
+    /**
+     * Constructor. Create an empty object.
+     */
+    LocalToGlobalCache();
+
+    /**
+     * Copy constructor. Deleted because the stored data can only be moved.
+     */
+    LocalToGlobalCache(const LocalToGlobalCache &) = delete;
+
+    /**
+     * Move constructor.
+     */
+    LocalToGlobalCache(LocalToGlobalCache &&) = default;
+
+    /**
+     * Copy assignment. Deleted because the stored data can only be moved.
+     */
+    LocalToGlobalCache &
+    operator=(const LocalToGlobalCache &) = delete;
+
+    /**
+     * Move assignment.
+     */
+    LocalToGlobalCache &
+    operator=(LocalToGlobalCache &&) = default;
+
+    /**
+     * Clear all data and set up the object to hold the data of @p n_cells
+     * cells, none of which is prepared yet.
+     */
+    void
+    reinit(const unsigned int n_cells);
+
+    /**
+     * Clear all data.
+     */
+    void
+    clear();
+
+    /**
+     * Return the number of cells this object has been set up for.
+     */
+    unsigned int
+    size() const;
+
+    /**
+     * Return whether prepare_local_to_global() has been called for the cell
+     * with index @p cell_index.
+     */
+    bool
+    is_prepared(const unsigned int cell_index) const;
+
+    /**
+     * Return the number of prepared cells with at least one constrained
+     * degree of freedom.
+     */
+    unsigned int
+    n_constrained_cells() const;
+
+    /**
+     * Return an estimate for the memory consumption (in bytes) of this
+     * object.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * The constraints object that filled this cache. Only used for checking
+     * that the cache is used together with the right object.
+     */
+    const AffineConstraints<number> *constraints;
+
+    /**
+     * For each cell, whether it has been prepared.
+     */
+    std::vector<bool> prepared;
+
+    /**
+     * For each cell, the index into @p constrained_rows, or
+     * numbers::invalid_unsigned_int for cells without constrained degrees
+     * of freedom.
+     */
+    std::vector<unsigned int> constrained_index;
+
+    /**
+     * For each cell without constrained degrees of freedom, the local rows
+     * sorted by their global index.
+     */
+    std::vector<std::vector<unsigned int>> row_order;
+
+    /**
+     * The resolved constraints of all cells with constrained degrees of
+     * freedom.
+     */
+    std::vector<internal::AffineConstraints::GlobalRowsFromLocal<number>>
+      constrained_rows;
+
+    friend class AffineConstraints<number>;
+  };
+
+  /**
+   * Compute the constraint resolution for the local degrees of freedom
+   * @p local_dof_indices of the cell with index @p cell_index and store it
+   * in @p cache, to be used by the variant of distribute_local_to_global()
+   * that takes a LocalToGlobalCache object. The object must be closed.
+   *
+   * This function is not thread-safe if several threads write into the same
+   * @p cache object.
+   */
+  void
+  prepare_local_to_global(const unsigned int            cell_index,
+                          const std::vector<size_type> &local_dof_indices,
+                          LocalToGlobalCache           &cache) const;
+
+  /**
+   * Same as the distribute_local_to_global() function above, but take the
+   * resolution of the constraints on the current cell from @p cache rather
+   * than re-computing it. The cell with index @p cell_index must have been
+   * prepared via prepare_local_to_global() with the same
+   * @p local_dof_indices, and neither the constraints nor the
+   * @p local_dof_indices must have changed since then. The result is
+   * identical to the one of the function above.
+   *
+   * @note This function is thread-safe in the same sense as the function
+   * above. Several threads may read from the same @p cache simultaneously.
+   */
+  template <typename MatrixType, typename VectorType>
+  void
+  distribute_local_to_global(const LocalToGlobalCache     &cache,
+                             const unsigned int            cell_index,
+                             const FullMatrix<number>     &local_matrix,
+                             const Vector<number>         &local_vector,
+                             const std::vector<size_type> &local_dof_indices,
+                             MatrixType                   &global_matrix,
+                             VectorType                   &global_vector,
+                             bool use_inhomogeneities_for_rhs = false) const;
+
+  /**
+   * Same as the function above, but only write into a matrix.
+   */
+  template <typename MatrixType>
+  void
+  distribute_local_to_global(const LocalToGlobalCache     &cache,
+                             const unsigned int            cell_index,
+                             const FullMatrix<number>     &local_matrix,
+                             const std::vector<size_type> &local_dof_indices,
+                             MatrixType &global_matrix) const;
+
+  /**
+   * Same as the distribute_local_to_global() function above that writes
+   * into a matrix and a vector at the same time, but add all entries into
+   * @p global_matrix and @p global_vector as atomic operations via
+   * SparseMatrix::add_atomic() and Vector::add_atomic().
+   *
+   * As a consequence, several threads can call this function at the same
+   * time even if their cells share degrees of freedom. This allows
+   * distributing the local contributions directly in the worker function of
+   * WorkStream::run(), without a copier that WorkStream would have to call
+   * sequentially and without having to color the cells:
+   * @code
+   *   WorkStream::run(
+   *     dof_handler.begin_active(),
+   *     dof_handler.end(),
+   *     [&](const auto &cell, ScratchData &scratch, CopyData &copy) {
+   *       ... // compute copy.cell_matrix and copy.cell_rhs
+   *       constraints.distribute_local_to_global_atomic(
+   *         copy.cell_matrix, copy.cell_rhs, copy.local_dof_indices,
+   *         system_matrix, system_rhs);
+   *     },
+   *     std::function<void(const CopyData &)>(),
+   *     ScratchData(...),
+   *     CopyData(...));
+   * @endcode
+   *
+   * The result is the same as with the function above up to round-off,
+   * because the order in which the contributions of different cells are
+   * added to a matrix entry is not deterministic.
+   *
+   * If @p cache is given, the resolution of the constraints is taken from
+   * there as in the variant of distribute_local_to_global() taking a
+   * LocalToGlobalCache.
+   */
+  void
+  distribute_local_to_global_atomic(
+    const FullMatrix<number>     &local_matrix,
+    const Vector<number>         &local_vector,
+    const std::vector<size_type> &local_dof_indices,
+    SparseMatrix<number>         &global_matrix,
+    Vector<number>               &global_vector,
+    const bool                    use_inhomogeneities_for_rhs = false,
+    const LocalToGlobalCache     *cache                       = nullptr,
+    const unsigned int cell_index = numbers::invalid_unsigned_int) const;
+
+  /**
+   * Same as the function above, but only write into a matrix.
+   */
+  void
+  distribute_local_to_global_atomic(
+    const FullMatrix<number>     &local_matrix,
+    const std::vector<size_type> &local_dof_indices,
+    SparseMatrix<number>         &global_matrix,
+    const LocalToGlobalCache     *cache      = nullptr,
+    const unsigned int            cell_index = numbers::invalid_unsigned_int)
+    const;
+
   /**
    * Do a similar operation as the distribute_local_to_global() function that
    * distributes writing entries into a matrix for constrained degrees of
@@ -2312,6 +2583,8 @@ private:
                              MatrixType                   &global_matrix,
                              VectorType                   &global_vector,
                              const bool use_inhomogeneities_for_rhs,
+                             const LocalToGlobalCache *cache,
+                             const unsigned int        cell_index,
                              const std::bool_constant<false>) const;
 
   /**
@@ -2326,8 +2599,26 @@ private:
                              MatrixType                   &global_matrix,
                              VectorType                   &global_vector,
                              const bool use_inhomogeneities_for_rhs,
+                             const LocalToGlobalCache *cache,
+                             const unsigned int        cell_index,
                              const std::bool_constant<true>) const;
 
+  /**
+   * Internal helper function for distribute_local_to_global function.
+   *
+   * Return the list of affected global rows for distribution. If @p cache is
+   * a null pointer, the list is computed via make_sorted_row_list() into
+   * @p global_rows, otherwise it is taken from the cache, possibly using
+   * @p global_rows as storage.
+   */
+  const internal::AffineConstraints::GlobalRowsFromLocal<number> &
+  get_sorted_row_list(
+    const std::vector<size_type>                             &local_dof_indices,
+    const LocalToGlobalCache                                 *cache,
+    const unsigned int                                        cell_index,
+    internal::AffineConstraints::GlobalRowsFromLocal<number> &global_rows)
+    const;
+
   /**
    * Internal helper function for distribute_local_to_global function.
    *
@@ -3022,6 +3313,8 @@ AffineConstraints<number>::distribute_local_to_global(
     global_matrix,
     dummy,
     false,
+    nullptr,
+    numbers::invalid_unsigned_int,
     std::bool_constant<
       internal::AffineConstraints::IsBlockMatrix<MatrixType>::value>());
 }
@@ -3048,6 +3341,98 @@ AffineConstraints<number>::distribute_local_to_global(
     global_matrix,
     global_vector,
     use_inhomogeneities_for_rhs,
+    nullptr,
+    numbers::invalid_unsigned_int,
+    std::bool_constant<
+      internal::AffineConstraints::IsBlockMatrix<MatrixType>::value>());
+}
+
+
+
+template <typename number>
+inline AffineConstraints<number>::LocalToGlobalCache::LocalToGlobalCache()
+  : constraints(nullptr)
+{}
+
+
+
+template <typename number>
+inline unsigned int
+AffineConstraints<number>::LocalToGlobalCache::size() const
+{
+  return prepared.size();
+}
+
+
+
+template <typename number>
+inline bool
+AffineConstraints<number>::LocalToGlobalCache::is_prepared(
+  const unsigned int cell_index) const
+{
+  AssertIndexRange(cell_index, prepared.size());
+  return prepared[cell_index];
+}
+
+
+
+template <typename number>
+inline unsigned int
+AffineConstraints<number>::LocalToGlobalCache::n_constrained_cells() const
+{
+  return constrained_rows.size();
+}
+
+
+
+template <typename number>
+template <typename MatrixType>
+inline void
+AffineConstraints<number>::distribute_local_to_global(
+  const LocalToGlobalCache     &cache,
+  const unsigned int            cell_index,
+  const FullMatrix<number>     &local_matrix,
+  const std::vector<size_type> &local_dof_indices,
+  MatrixType                   &global_matrix) const
+{
+  Vector<typename MatrixType::value_type> dummy(0);
+  distribute_local_to_global(
+    local_matrix,
+    dummy,
+    local_dof_indices,
+    global_matrix,
+    dummy,
+    false,
+    &cache,
+    cell_index,
+    std::bool_constant<
+      internal::AffineConstraints::IsBlockMatrix<MatrixType>::value>());
+}
+
+
+
+template <typename number>
+template <typename MatrixType, typename VectorType>
+inline void
+AffineConstraints<number>::distribute_local_to_global(
+  const LocalToGlobalCache     &cache,
+  const unsigned int            cell_index,
+  const FullMatrix<number>     &local_matrix,
+  const Vector<number>         &local_vector,
+  const std::vector<size_type> &local_dof_indices,
+  MatrixType                   &global_matrix,
+  VectorType                   &global_vector,
+  bool                          use_inhomogeneities_for_rhs) const
+{
+  distribute_local_to_global(
+    local_matrix,
+    local_vector,
+    local_dof_indices,
+    global_matrix,
+    global_vector,
+    use_inhomogeneities_for_rhs,
+    &cache,
+    cell_index,
     std::bool_constant<
       internal::AffineConstraints::IsBlockMatrix<MatrixType>::value>());
 }
@@ -16,10 +16,12 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/multithread_info.h>
 #include <deal.II/base/parallel.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/thread_management.h>
+#include <deal.II/base/timer.h>
 #include <deal.II/base/trilinos_utilities.h>
 
 #include <deal.II/lac/affine_constraints.h>
@@ -64,6 +66,7 @@
 #include <complex>
 #include <iomanip>
 #include <numeric>
+#include <optional>
 #include <ostream>
 #include <set>
 
@@ -739,17 +742,69 @@ AffineConstraints<number>::add_selected_constraints(
 
 template <typename number>
 void
-AffineConstraints<number>::close()
+AffineConstraints<number>::close(TimerOutput *timer_output)
 {
   if (sorted == true)
     return;
 
-  // sort the lines
-  std::sort(lines.begin(),
-            lines.end(),
-            [](const ConstraintLine &l1, const ConstraintLine &l2) {
-              return l1.index < l2.index;
-            });
+  // if requested, time each of the phases below in its own section. the
+  // previous section is left when the next one is entered or, for the last
+  // one, when this function returns
+  std::optional<TimerOutput::Scope> timer_section;
+  const auto enter_section = [&](const char *section_name) {
+    timer_section.reset();
+    if (timer_output != nullptr)
+      timer_section.emplace(*timer_output,
+                            std::string("AffineConstraints::close: ") +
+                              section_name);
+  };
+
+  enter_section("sort lines");
+
+  // sort the lines. lines are often added in (almost) ascending order, so
+  // check first whether there is anything to do. otherwise, sort blocks of
+  // the array in parallel and then merge them pairwise, again in parallel
+  const auto compare_lines = [](const ConstraintLine &l1,
+                                const ConstraintLine &l2) {
+    return l1.index < l2.index;
+  };
+  if (std::is_sorted(lines.begin(), lines.end(), compare_lines) == false)
+    {
+      std::size_t n_blocks = 1;
+      while (n_blocks < MultithreadInfo::n_threads() &&
+             lines.size() / (2 * n_blocks) >= 1000)
+        n_blocks *= 2;
+
+      std::vector<std::size_t> block_starts(n_blocks + 1);
+      for (std::size_t b = 0; b <= n_blocks; ++b)
+        block_starts[b] = lines.size() * b / n_blocks;
+
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        n_blocks,
+        [&](const std::size_t begin, const std::size_t end) {
+          for (std::size_t b = begin; b < end; ++b)
+            std::sort(lines.begin() + block_starts[b],
+                      lines.begin() + block_starts[b + 1],
+                      compare_lines);
+        },
+        1);
+
+      for (std::size_t width = 1; width < n_blocks; width *= 2)
+        parallel::apply_to_subranges(
+          std::size_t(0),
+          n_blocks / (2 * width),
+          [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t b = begin; b < end; ++b)
+              std::inplace_merge(lines.begin() + block_starts[2 * b * width],
+                                 lines.begin() +
+                                   block_starts[(2 * b + 1) * width],
+                                 lines.begin() +
+                                   block_starts[(2 * b + 2) * width],
+                                 compare_lines);
+          },
+          1);
+    }
 
   // update list of pointers and give the vector a sharp size since we
   // won't modify the size any more after this point.
@@ -796,174 +851,202 @@ AffineConstraints<number>::close()
 
 
 
-  // In debug mode we are computing an estimate for the maximum number
-  // of constraints so that we can bail out if there is a cycle in the
-  // constraints (which is easier than searching for cycles in the graph).
+  // replace references to dofs that are themselves constrained. for
+  // example if x3=x0/2+x2/2 and x2=x0/2+x1/2, then the new list will be
+  // x3=x0/2+x0/4+x1/4. note that x0 appears twice. we will throw this
+  // duplicate out in the following step, where we sort the list so that
+  // throwing out duplicates becomes much more efficient.
   //
-  // Let us figure out the largest dof index. This is an upper bound for the
-  // number of constraints because it is an approximation for the number of dofs
-  // in our system.
-  [[maybe_unused]] size_type largest_idx = 0;
-  if constexpr (running_in_debug_mode())
-    {
-      for (const ConstraintLine &line : lines)
-        for (const std::pair<size_type, number> &entry : line.entries)
-          largest_idx = std::max(largest_idx, entry.first);
-    }
+  // because dofs may be constrained to other dofs that are themselves
+  // constrained to third ones, we first compute the depth of each line in
+  // the graph of constraints: a line that only refers to unconstrained dofs
+  // has depth zero, and any other line has a depth one larger than the
+  // largest depth of the lines it refers to. this also reveals cycles in the
+  // constraints. the lines are then resolved in the order of their depth: a
+  // line of depth d only refers to lines of smaller depth that are already
+  // resolved, so a single replacement step per line suffices, and all lines
+  // of the same depth can be resolved in parallel.
+  const size_type lines_cache_size = lines_cache.size();
+  const auto      constraining_line = [&](const size_type dof) {
+    const size_type dof_index = calculate_line_index(dof);
+    return (dof_index < lines_cache_size) ? lines_cache[dof_index] :
+                                                 numbers::invalid_size_type;
+  };
 
-  // replace references to dofs that are themselves constrained. note that
-  // because we may replace references to other dofs that may themselves be
-  // constrained to third ones, we have to iterate over all this until we
-  // replace no chains of constraints any more
-  //
-  // the iteration replaces references to constrained degrees of freedom by
-  // second-order references. for example if x3=x0/2+x2/2 and x2=x0/2+x1/2,
-  // then the new list will be x3=x0/2+x0/4+x1/4. note that x0 appear
-  // twice. we will throw this duplicate out in the following step, where
-  // we sort the list so that throwing out duplicates becomes much more
-  // efficient. also, we have to do it only once, rather than in each
-  // iteration
-  [[maybe_unused]] size_type iteration                   = 0;
-  bool                       chained_constraint_replaced = false;
-  std::vector<bool>          line_finalized(lines.size(), false);
-  do
+  enter_section("detect cycles");
+
+  const unsigned int depth_unknown = numbers::invalid_unsigned_int;
+  const unsigned int depth_in_progress = numbers::invalid_unsigned_int - 1;
+  std::vector<unsigned int> line_depths(lines.size(), depth_unknown);
+  unsigned int              max_depth = 0;
+  {
+    // depth-first search without recursion, storing the line and the next
+    // entry to look at on a stack
+    std::vector<std::pair<size_type, std::size_t>> stack;
+    for (size_type start = 0; start < lines.size(); ++start)
+      if (line_depths[start] == depth_unknown)
+        {
+          line_depths[start] = depth_in_progress;
+          stack.emplace_back(start, 0);
+          while (stack.empty() == false)
+            {
+              const size_type line_index = stack.back().first;
+              const typename ConstraintLine::Entries &entries =
+                lines[line_index].entries;
+
+              bool descended = false;
+              for (std::size_t &entry = stack.back().second;
+                   entry < entries.size();
+                   ++entry)
+                {
+                  const size_type other_line =
+                    constraining_line(entries[entry].first);
+                  if (other_line == numbers::invalid_size_type)
+                    continue;
+
+                  AssertThrow(line_depths[other_line] != depth_in_progress,
+                              ExcMessage("Cycle in constraints detected!"));
+                  if (line_depths[other_line] == depth_unknown)
+                    {
+                      line_depths[other_line] = depth_in_progress;
+                      ++entry;
+                      stack.emplace_back(other_line, 0);
+                      descended = true;
+                      break;
+                    }
+                }
+
+              if (descended == false)
+                {
+                  unsigned int depth = 0;
+                  for (const std::pair<size_type, number> &entry : entries)
+                    {
+                      const size_type other_line =
+                        constraining_line(entry.first);
+                      if (other_line != numbers::invalid_size_type)
+                        depth = std::max(depth, line_depths[other_line] + 1);
+                    }
+                  line_depths[line_index] = depth;
+                  max_depth               = std::max(max_depth, depth);
+                  stack.pop_back();
+                }
+            }
+        }
+  }
+
+  enter_section("resolve chains");
+
+  if (max_depth > 0)
     {
-      chained_constraint_replaced = false;
-      for (unsigned int line_index = 0; line_index < lines.size(); ++line_index)
-        if (line_finalized[line_index] == false)
-          {
-            ConstraintLine &line = lines[line_index];
-
-            // we need to keep track of how many replacements we do in this
-            // line, because we can end up in a cycle A->B->C->A without the
-            // number of entries growing.
-            [[maybe_unused]] size_type n_replacements = 0;
-
-            // loop over all entries of this line (including ones that we
-            // have appended in this go around) and see whether they are
-            // further constrained. ignore elements that we don't store on
-            // the current processor.
-            const unsigned int n_original_entries  = line.entries.size();
-            bool               has_sub_constraints = false;
-            const size_type    lines_cache_size    = lines_cache.size();
-            for (unsigned int entry = 0; entry < n_original_entries; ++entry)
-              {
-                const size_type dof_index =
-                  calculate_line_index(line.entries[entry].first);
+      // sort the lines by depth...
+      std::vector<size_type> depth_starts(max_depth + 2, 0);
+      for (const unsigned int depth : line_depths)
+        ++depth_starts[depth + 1];
+      std::partial_sum(depth_starts.begin(),
+                       depth_starts.end(),
+                       depth_starts.begin());
+      std::vector<size_type> lines_by_depth(lines.size());
+      {
+        std::vector<size_type> next_position(depth_starts.begin(),
+                                             depth_starts.end() - 1);
+        for (size_type line_index = 0; line_index < lines.size();
+             ++line_index)
+          lines_by_depth[next_position[line_depths[line_index]]++] =
+            line_index;
+      }
 
-                if (dof_index < lines_cache_size &&
-                    lines_cache[dof_index] != numbers::invalid_size_type)
+      // ...and resolve them one depth after the other
+      for (unsigned int depth = 1; depth <= max_depth; ++depth)
+        parallel::apply_to_subranges(
+          depth_starts[depth],
+          depth_starts[depth + 1],
+          [&](const size_type begin, const size_type end) {
+            for (size_type i = begin; i < end; ++i)
+              {
+                ConstraintLine &line = lines[lines_by_depth[i]];
+
+                // replace each entry that refers to a constrained dof by its
+                // expansion: overwrite the entry by the first entry of the
+                // expansion and add the remaining ones to the end. if the
+                // dof is only constrained to its inhomogeneity (i.e., its
+                // list of entries is empty), mark the entry for deletion
+                const std::size_t n_original_entries = line.entries.size();
+                bool              entries_deleted    = false;
+                for (std::size_t entry = 0; entry < n_original_entries;
+                     ++entry)
                   {
-                    // Now we found an index that is further constrained, so
-                    // we need to resolve the entries.  We may replace some of
-                    // them, and we may add some, but we only walk through the
-                    // original entries (and also don't touch the
-                    // replacements) even though in principle we could also do
-                    // the ones we have added or replaced. There is no harm in
-                    // doing so: we will simply treat those in the next round
-                    // around of the outer iteration.
-                    has_sub_constraints = true;
-
-                    const number weight = line.entries[entry].second;
-                    Assert(line.entries[entry].first != line.index,
-                           ExcMessage("Cycle in constraints detected!"));
+                    const size_type other_line =
+                      constraining_line(line.entries[entry].first);
+                    if (other_line == numbers::invalid_size_type)
+                      continue;
 
                     const ConstraintLine &constrained_line =
-                      lines[lines_cache[dof_index]];
-                    Assert(constrained_line.index == line.entries[entry].first,
+                      lines[other_line];
+                    Assert(constrained_line.index ==
+                             line.entries[entry].first,
                            ExcInternalError());
+                    const number weight = line.entries[entry].second;
 
-                    // now we have to replace an entry by its expansion. we do
-                    // that by overwriting the entry by the first entry of the
-                    // expansion and adding the remaining ones to the end,
-                    // where we will later process them once more
-                    //
-                    // we can of course only do that if the DoF that we are
-                    // currently handling is constrained by a linear combination
-                    // of other dofs:
                     if (constrained_line.entries.size() > 0)
                       {
-                        for (size_type i = 0;
-                             i < constrained_line.entries.size();
-                             ++i)
-                          Assert(line.entries[entry].first !=
-                                   constrained_line.entries[i].first,
-                                 ExcMessage("Cycle in constraints detected!"));
-
-                        // replace first entry, then tack the rest to the end
-                        // of the list
                         line.entries[entry] = std::pair<size_type, number>(
                           constrained_line.entries[0].first,
                           constrained_line.entries[0].second * weight);
 
-                        for (size_type i = 1;
-                             i < constrained_line.entries.size();
-                             ++i)
+                        for (size_type j = 1;
+                             j < constrained_line.entries.size();
+                             ++j)
                           line.entries.emplace_back(
-                            constrained_line.entries[i].first,
-                            constrained_line.entries[i].second * weight);
-
-                        if constexpr (library_build_mode ==
-                                      LibraryBuildMode::debug)
-                          {
-                            // keep track of how many entries we replace in this
-                            // line. If we do more than there are constraints or
-                            // dofs in our system, we must have a cycle.
-                            ++n_replacements;
-                            Assert(n_replacements / 2 < largest_idx,
-                                   ExcMessage(
-                                     "Cycle in constraints detected!"));
-                          }
+                            constrained_line.entries[j].first,
+                            constrained_line.entries[j].second * weight);
                       }
                     else
-                      // the DoF that we encountered is not constrained by a
-                      // linear combination of other dofs but is equal to just
-                      // the inhomogeneity (i.e. its chain of entries is
-                      // empty). in that case, we can't just overwrite the
-                      // current entry, but we have to actually eliminate
-                      // it. we do not want to change the loop length above we
-                      // do so by setting the 'first' entry to
-                      // invalid_size_type here to finally remove entries in a
-                      // second loop
                       {
                         line.entries[entry].first = numbers::invalid_size_type;
+                        entries_deleted           = true;
                       }
 
                     line.inhomogeneity +=
                       constrained_line.inhomogeneity * weight;
                   }
-              }
-
-            // If none of the entries in the current line refer to DoFs that are
-            // themselves constrained, then we can move on:
-            if (has_sub_constraints == false)
-              line_finalized[line_index] = true;
-            else
-              {
-                chained_constraint_replaced = true;
 
-                // Now delete the elements we have marked for deletion.
-                auto remaining_entries = line.entries.begin();
-                for (const auto &entry : line.entries)
-                  if (entry.first != numbers::invalid_size_type)
-                    {
-                      *remaining_entries = entry;
-                      ++remaining_entries;
-                    }
-                line.entries.erase(remaining_entries, line.entries.end());
+                // now delete the elements we have marked for deletion
+                if (entries_deleted)
+                  line.entries.erase(
+                    std::remove_if(line.entries.begin(),
+                                   line.entries.end(),
+                                   [](const std::pair<size_type, number> &p) {
+                                     return p.first ==
+                                            numbers::invalid_size_type;
+                                   }),
+                    line.entries.end());
+
+                // lines of larger depth will copy the entries of this line,
+                // so merge duplicates right away to keep the lines short
+                std::sort(line.entries.begin(),
+                          line.entries.end(),
+                          [](const std::pair<size_type, number> &a,
+                             const std::pair<size_type, number> &b) {
+                            return a.first < b.first;
+                          });
+                auto last_entry = line.entries.begin();
+                for (auto entry = line.entries.begin();
+                     entry != line.entries.end();
+                     ++entry)
+                  if (entry == last_entry)
+                    continue;
+                  else if (entry->first == last_entry->first)
+                    last_entry->second += entry->second;
+                  else
+                    *(++last_entry) = *entry;
+                if (line.entries.empty() == false)
+                  line.entries.erase(last_entry + 1, line.entries.end());
               }
-          }
-
-      if constexpr (running_in_debug_mode())
-        {
-          // increase iteration count. note that we should not iterate more
-          // times than there are constraints, since this puts a natural upper
-          // bound on the length of constraint chains
-          ++iteration;
-          Assert(iteration <= lines.size() + 1, ExcInternalError());
-        }
+          },
+          /* grainsize = */ 100);
     }
-  while (chained_constraint_replaced == true);
+
+  enter_section("sort entries");
 
   // Finally sort the entries and re-scale them if necessary. in this step,
   // we also throw out duplicates as mentioned above. moreover, as some
@@ -3146,6 +3229,26 @@ namespace internal
 
 
 
+    template <typename number>
+    void
+    GlobalRowsFromLocal<number>::copy_from(
+      const GlobalRowsFromLocal<number> &other)
+    {
+      total_row_indices.resize(other.total_row_indices.size());
+      for (unsigned int i = 0; i < total_row_indices.size(); ++i)
+        {
+          const Distributing &entry               = other.total_row_indices[i];
+          total_row_indices[i].global_row          = entry.global_row;
+          total_row_indices[i].local_row           = entry.local_row;
+          total_row_indices[i].constraint_position = entry.constraint_position;
+        }
+      data_cache           = other.data_cache;
+      n_active_rows        = other.n_active_rows;
+      n_inhomogeneous_rows = other.n_inhomogeneous_rows;
+    }
+
+
+
     template <typename number>
     void
     GlobalRowsFromLocal<number>::print(std::ostream &os)
@@ -3311,6 +3414,20 @@ namespace internal
     }
 
 
+
+    template <typename number>
+    std::size_t
+    GlobalRowsFromLocal<number>::memory_consumption() const
+    {
+      return sizeof(*this) +
+             total_row_indices.capacity() * sizeof(Distributing) +
+             data_cache.data.capacity() *
+               sizeof(std::pair<size_type, number>) +
+             MemoryConsumption::memory_consumption(
+               data_cache.individual_size);
+    }
+
+
     // a function that appends an additional row to the list of values, or
     // appends a value to an already existing row. Similar functionality as for
     // std::map<size_type,Distributing>, but here done for a
@@ -4005,6 +4122,118 @@ namespace internal
         }
     }
 
+    // thin wrappers around a SparseMatrix and a Vector that turn all additions
+    // done by the generic implementation of distribute_local_to_global() into
+    // atomic ones. they provide exactly the interface used there.
+    template <typename number>
+    class AtomicSparseMatrixAdd
+    {
+    public:
+      using value_type = number;
+
+      AtomicSparseMatrixAdd(SparseMatrix<number> &matrix)
+        : matrix(matrix)
+      {}
+
+      size_type
+      m() const
+      {
+        return matrix.m();
+      }
+
+      size_type
+      n() const
+      {
+        return matrix.n();
+      }
+
+      void
+      add(const size_type i, const size_type j, const number value)
+      {
+        matrix.add_atomic(i, j, value);
+      }
+
+      void
+      add(const size_type  row,
+          const size_type  n_cols,
+          const size_type *col_indices,
+          const number    *values,
+          const bool       elide_zero_values,
+          const bool       col_indices_are_sorted)
+      {
+        matrix.add_atomic(row,
+                          n_cols,
+                          col_indices,
+                          values,
+                          elide_zero_values,
+                          col_indices_are_sorted);
+      }
+
+    private:
+      SparseMatrix<number> &matrix;
+    };
+
+
+
+    template <typename number>
+    class AtomicVectorAdd
+    {
+    public:
+      using value_type = number;
+
+      // the object returned by operator(), only supporting atomic additions
+      class Entry
+      {
+      public:
+        Entry(number &entry)
+          : entry(entry)
+        {}
+
+        void
+        operator+=(const number value)
+        {
+          Threads::atomic_add(entry, value);
+        }
+
+      private:
+        number &entry;
+      };
+
+      AtomicVectorAdd(Vector<number> &vector)
+        : vector(vector)
+      {}
+
+      size_type
+      size() const
+      {
+        return vector.size();
+      }
+
+      bool
+      has_ghost_elements() const
+      {
+        return false;
+      }
+
+      void
+      add(const std::vector<size_type> &indices,
+          const std::vector<number>    &values)
+      {
+        vector.add_atomic(indices, values);
+      }
+
+      Entry
+      operator()(const size_type i)
+      {
+        return Entry(vector(i));
+      }
+
+    private:
+      Vector<number> &vector;
+    };
+
+
+
     // similar function as the one above for setting matrix diagonals, but now
     // doing that for sparsity patterns when setting them up using
     // add_entries_local_to_global(). In case we keep constrained entries, add
@@ -4128,6 +4357,155 @@ AffineConstraints<number>::make_sorted_row_list(
 
 
 
+template <typename number>
+inline const internal::AffineConstraints::GlobalRowsFromLocal<number> &
+AffineConstraints<number>::get_sorted_row_list(
+  const std::vector<size_type>                             &local_dof_indices,
+  const LocalToGlobalCache                                 *cache,
+  const unsigned int                                        cell_index,
+  internal::AffineConstraints::GlobalRowsFromLocal<number> &global_rows) const
+{
+  const size_type n_local_dofs = local_dof_indices.size();
+  if (cache == nullptr)
+    {
+      global_rows.reinit(n_local_dofs);
+      make_sorted_row_list(local_dof_indices, global_rows);
+      return global_rows;
+    }
+
+  Assert(cache->constraints == this,
+         ExcMessage("The LocalToGlobalCache object has been prepared by a "
+                    "different AffineConstraints object."));
+  Assert(cache->is_prepared(cell_index),
+         ExcMessage("The cell with the given index has not been prepared "
+                    "with prepare_local_to_global()."));
+
+  const unsigned int index = cache->constrained_index[cell_index];
+  if (index != numbers::invalid_unsigned_int)
+    {
+      // all work has been done during the setup, only check in debug mode
+      // that the indices still match
+      const internal::AffineConstraints::GlobalRowsFromLocal<number>
+        &cached_rows = cache->constrained_rows[index];
+      if constexpr (running_in_debug_mode())
+        {
+          for (size_type i = 0; i < cached_rows.size(); ++i)
+            if (cached_rows.local_row(i) != numbers::invalid_size_type)
+              Assert(local_dof_indices[cached_rows.local_row(i)] ==
+                       cached_rows.global_row(i),
+                     ExcMessage("The local dof indices do not match the ones "
+                                "the LocalToGlobalCache was prepared with."));
+          for (size_type i = 0; i < cached_rows.n_constraints(); ++i)
+            Assert(cached_rows.constraint_origin(i) < n_local_dofs,
+                   ExcInternalError());
+        }
+      return cached_rows;
+    }
+
+  // the cell has no constrained degrees of freedom, so we only need to
+  // bring the rows into the stored order, which is what
+  // make_sorted_row_list() would have done
+  const std::vector<unsigned int> &row_order = cache->row_order[cell_index];
+  AssertDimension(row_order.size(), n_local_dofs);
+  global_rows.reinit(n_local_dofs);
+  for (size_type i = 0; i < n_local_dofs; ++i)
+    {
+      global_rows.local_row(i)  = row_order[i];
+      global_rows.global_row(i) = local_dof_indices[row_order[i]];
+      Assert(is_constrained(global_rows.global_row(i)) == false,
+             ExcMessage("The local dof indices do not match the ones "
+                        "the LocalToGlobalCache was prepared with."));
+    }
+  return global_rows;
+}
+
+
+
+template <typename number>
+void
+AffineConstraints<number>::prepare_local_to_global(
+  const unsigned int            cell_index,
+  const std::vector<size_type> &local_dof_indices,
+  LocalToGlobalCache           &cache) const
+{
+  Assert(lines.empty() || sorted == true, ExcMatrixNotClosed());
+  AssertIndexRange(cell_index, cache.size());
+  Assert(cache.constraints == nullptr || cache.constraints == this,
+         ExcMessage("The LocalToGlobalCache object has been prepared by a "
+                    "different AffineConstraints object."));
+  cache.constraints = this;
+
+  const size_type n_local_dofs = local_dof_indices.size();
+  internal::AffineConstraints::GlobalRowsFromLocal<number> global_rows;
+  global_rows.reinit(n_local_dofs);
+  make_sorted_row_list(local_dof_indices, global_rows);
+
+  std::vector<unsigned int> &row_order = cache.row_order[cell_index];
+  if (global_rows.n_constraints() == 0)
+    {
+      row_order.resize(n_local_dofs);
+      for (size_type i = 0; i < n_local_dofs; ++i)
+        row_order[i] = global_rows.local_row(i);
+      cache.constrained_index[cell_index] = numbers::invalid_unsigned_int;
+    }
+  else
+    {
+      std::vector<unsigned int>().swap(row_order);
+      if (cache.constrained_index[cell_index] == numbers::invalid_unsigned_int)
+        {
+          cache.constrained_index[cell_index] = cache.constrained_rows.size();
+          cache.constrained_rows.emplace_back(std::move(global_rows));
+        }
+      else
+        cache.constrained_rows[cache.constrained_index[cell_index]] =
+          std::move(global_rows);
+    }
+  cache.prepared[cell_index] = true;
+}
+
+
+
+template <typename number>
+void
+AffineConstraints<number>::LocalToGlobalCache::reinit(
+  const unsigned int n_cells)
+{
+  clear();
+  prepared.resize(n_cells, false);
+  constrained_index.resize(n_cells, numbers::invalid_unsigned_int);
+  row_order.resize(n_cells);
+}
+
+
+
+template <typename number>
+void
+AffineConstraints<number>::LocalToGlobalCache::clear()
+{
+  constraints = nullptr;
+  prepared.clear();
+  constrained_index.clear();
+  row_order.clear();
+  constrained_rows.clear();
+}
+
+
+
+template <typename number>
+std::size_t
+AffineConstraints<number>::LocalToGlobalCache::memory_consumption() const
+{
+  std::size_t memory =
+    sizeof(*this) + MemoryConsumption::memory_consumption(prepared) +
+    MemoryConsumption::memory_consumption(constrained_index) +
+    MemoryConsumption::memory_consumption(row_order);
+  for (const auto &rows : constrained_rows)
+    memory += rows.memory_consumption();
+  return memory;
+}
+
+
+
 // Same function as before, but now do only extract the global indices that
 // come from the local ones without storing their origin. Used for sparsity
 // pattern generation.
@@ -4246,6 +4624,8 @@ AffineConstraints<number>::distribute_local_to_global(
   MatrixType                   &global_matrix,
   VectorType                   &global_vector,
   const bool                    use_inhomogeneities_for_rhs,
+  const LocalToGlobalCache     *cache,
+  const unsigned int            cell_index,
   const std::bool_constant<false>) const
 {
   // FIXME: static_assert MatrixType::value_type == number
@@ -4254,7 +4634,7 @@ AffineConstraints<number>::distribute_local_to_global(
   // calling the other function above.
   const bool use_vectors =
     (local_vector.size() == 0 && global_vector.size() == 0) ? false : true;
-  const bool use_dealii_matrix =
+  constexpr bool use_dealii_matrix =
     std::is_same_v<MatrixType, SparseMatrix<number>>;
 
   AssertDimension(local_matrix.n(), local_dof_indices.size());
@@ -4268,15 +4648,14 @@ AffineConstraints<number>::distribute_local_to_global(
     }
   Assert(lines.empty() || sorted == true, ExcMatrixNotClosed());
 
-  const size_type n_local_dofs = local_dof_indices.size();
-
   typename internal::AffineConstraints::ScratchDataAccessor<number>
     scratch_data(this->scratch_data);
 
-  internal::AffineConstraints::GlobalRowsFromLocal<number> &global_rows =
-    scratch_data->global_rows;
-  global_rows.reinit(n_local_dofs);
-  make_sorted_row_list(local_dof_indices, global_rows);
+  const internal::AffineConstraints::GlobalRowsFromLocal<number>
+    &global_rows = get_sorted_row_list(local_dof_indices,
+                                       cache,
+                                       cell_index,
+                                       scratch_data->global_rows);
 
   const size_type n_actual_dofs = global_rows.size();
 
@@ -4294,15 +4673,14 @@ AffineConstraints<number>::distribute_local_to_global(
     scratch_data->vector_values;
   vector_indices.resize(n_actual_dofs);
   vector_values.resize(n_actual_dofs);
-  SparseMatrix<number> *sparse_matrix =
-    dynamic_cast<SparseMatrix<number> *>(&global_matrix);
-  if (use_dealii_matrix == false)
+  SparseMatrix<number> *sparse_matrix = nullptr;
+  if constexpr (use_dealii_matrix)
+    sparse_matrix = &global_matrix;
+  else
     {
       cols.resize(n_actual_dofs);
       vals.resize(n_actual_dofs);
     }
-  else
-    Assert(sparse_matrix != nullptr, ExcInternalError());
 
   // now do the actual job. go through all the global rows that we will touch
   // and call resolve_matrix_row for each of those.
@@ -4394,6 +4772,56 @@ AffineConstraints<number>::distribute_local_to_global(
 
 
 
+template <typename number>
+void
+AffineConstraints<number>::distribute_local_to_global_atomic(
+  const FullMatrix<number>     &local_matrix,
+  const Vector<number>         &local_vector,
+  const std::vector<size_type> &local_dof_indices,
+  SparseMatrix<number>         &global_matrix,
+  Vector<number>               &global_vector,
+  const bool                    use_inhomogeneities_for_rhs,
+  const LocalToGlobalCache     *cache,
+  const unsigned int            cell_index) const
+{
+  internal::AffineConstraints::AtomicSparseMatrixAdd<number> matrix(
+    global_matrix);
+  internal::AffineConstraints::AtomicVectorAdd<number> vector(global_vector);
+  distribute_local_to_global(local_matrix,
+                             local_vector,
+                             local_dof_indices,
+                             matrix,
+                             vector,
+                             use_inhomogeneities_for_rhs,
+                             cache,
+                             cell_index,
+                             std::bool_constant<false>());
+}
+
+
+
+template <typename number>
+void
+AffineConstraints<number>::distribute_local_to_global_atomic(
+  const FullMatrix<number>     &local_matrix,
+  const std::vector<size_type> &local_dof_indices,
+  SparseMatrix<number>         &global_matrix,
+  const LocalToGlobalCache     *cache,
+  const unsigned int            cell_index) const
+{
+  Vector<number> dummy(0);
+  distribute_local_to_global_atomic(local_matrix,
+                                    dummy,
+                                    local_dof_indices,
+                                    global_matrix,
+                                    dummy,
+                                    false,
+                                    cache,
+                                    cell_index);
+}
+
+
+
 // similar function as above, but now specialized for block matrices. See the
 // other function for additional comments.
 template <typename number>
@@ -4406,6 +4834,8 @@ AffineConstraints<number>::distribute_local_to_global(
   MatrixType                   &global_matrix,
   VectorType                   &global_vector,
   const bool                    use_inhomogeneities_for_rhs,
+  const LocalToGlobalCache     *cache,
+  const unsigned int            cell_index,
   const std::bool_constant<true>) const
 {
   const bool use_vectors =
@@ -4429,12 +4859,15 @@ AffineConstraints<number>::distribute_local_to_global(
   typename internal::AffineConstraints::ScratchDataAccessor<number>
     scratch_data(this->scratch_data);
 
-  const size_type n_local_dofs = local_dof_indices.size();
+  // the row indices are transformed into block-local indices in place below,
+  // so we need to work on a copy of cached data
   internal::AffineConstraints::GlobalRowsFromLocal<number> &global_rows =
     scratch_data->global_rows;
-  global_rows.reinit(n_local_dofs);
-
-  make_sorted_row_list(local_dof_indices, global_rows);
+  const internal::AffineConstraints::GlobalRowsFromLocal<number>
+    &sorted_rows =
+      get_sorted_row_list(local_dof_indices, cache, cell_index, global_rows);
+  if (&sorted_rows != &global_rows)
+    global_rows.copy_from(sorted_rows);
   const size_type n_actual_dofs = global_rows.size();
 
   std::vector<size_type> &global_indices = scratch_data->vector_indices;
@@ -0,0 +1,314 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+#ifndef dealii_precondition_amg_h
+#define dealii_precondition_amg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/enable_observer_pointer.h>
+#include <deal.II/base/observer_pointer.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <memory>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * @addtogroup Preconditioners
+ * @{
+ */
+
+/**
+ * An algebraic multigrid (AMG) preconditioner based on smoothed aggregation
+ * for matrices of type SparseMatrix<double>. In contrast to
+ * TrilinosWrappers::PreconditionAMG and PETScWrappers::PreconditionBoomerAMG,
+ * this class does not need any external library, and it is meant for
+ * problems that are solved on a single machine, using the threads available
+ * there.
+ *
+ * The hierarchy of coarser matrices is built as described in the paper by
+ * P. Vaněk, J. Mandel, and M. Brezina, "Algebraic multigrid by smoothed
+ * aggregation for second and fourth order elliptic problems", Computing 56
+ * (1996):
+ * - The <i>strong couplings</i> of a matrix $A$ are the entries for which
+ *   $|a_{ij}| > \theta \sqrt{|a_{ii} a_{jj}|}$, where the threshold $\theta$
+ *   is given by AdditionalData::aggregation_threshold.
+ * - The unknowns are grouped into <i>aggregates</i>, i.e., small sets of
+ *   strongly coupled unknowns, each of which becomes one unknown of the next
+ *   coarser level. Rows without any strong coupling, such as the ones of
+ *   unknowns constrained by Dirichlet boundary conditions, are not part of
+ *   any aggregate, and consequently are only treated by the smoother.
+ * - The tentative prolongation $T$ interpolates the constant function on
+ *   each aggregate. It is smoothed by one step of the damped Jacobi method,
+ *   $P = (I - \omega D^{-1} A) T$, with
+ *   $\omega = \frac{4}{3} / \lambda_{\max}(D^{-1}A)$.
+ * - The matrix on the coarser level is the Galerkin product $P^T A P$,
+ *   computed by SparseMatrix::triple_product().
+ *
+ * This is repeated until the number of unknowns is at most
+ * AdditionalData::max_coarse_size, which is then solved by a direct
+ * method, or until AdditionalData::max_levels levels have been created.
+ * The near null space is assumed to be the constant function, which makes
+ * this class appropriate for scalar elliptic problems such as the Laplace
+ * equation, but not for systems such as linear elasticity.
+ *
+ * Each application of the preconditioner (i.e., each call to vmult())
+ * performs AdditionalData::n_cycles V-cycles. The smoother on each level is
+ * a PreconditionChebyshev object around the diagonal of the level matrix,
+ * of degree AdditionalData::smoother_sweeps, so that the V-cycle is
+ * symmetric and the preconditioner can be used with SolverCG.
+ *
+ * Computing the strong couplings, the products of the setup phase, and all
+ * matrix-vector products and vector operations in the V-cycle are split into
+ * ranges of rows that are worked on in parallel. The aggregation itself is
+ * a sequential greedy algorithm.
+ *
+ * The following shows the typical use of this class:
+ * @code
+ * PreconditionAMG preconditioner;
+ * preconditioner.initialize(system_matrix);
+ *
+ * SolverControl            solver_control(1000, 1e-12);
+ * SolverCG<Vector<double>> solver(solver_control);
+ * solver.solve(system_matrix, solution, system_rhs, preconditioner);
+ * @endcode
+ */
+class PreconditionAMG : public EnableObserverPointer
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Parameters that control how the multigrid hierarchy is built and
+   * applied.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(const double       aggregation_threshold = 1e-4,
+                   const unsigned int smoother_sweeps       = 2,
+                   const double       smoothing_range       = 20.,
+                   const unsigned int n_cycles              = 1,
+                   const size_type    max_coarse_size       = 500,
+                   const unsigned int max_levels            = 20,
+                   const double       prolongator_damping   = 4. / 3.);
+
+    /**
+     * The threshold $\theta$ above which an off-diagonal entry is considered
+     * a strong coupling, relative to the geometric mean of the two diagonal
+     * entries involved.
+     */
+    double aggregation_threshold;
+
+    /**
+     * The degree of the Chebyshev polynomial used as pre- and post-smoother
+     * on each level, i.e., the number of matrix-vector products in each
+     * smoothing step.
+     */
+    unsigned int smoother_sweeps;
+
+    /**
+     * The ratio between the largest eigenvalue of a level matrix and the
+     * smallest one that is still to be damped by the smoother. See
+     * PreconditionChebyshev::AdditionalData::smoothing_range.
+     */
+    double smoothing_range;
+
+    /**
+     * The number of V-cycles performed in each application of the
+     * preconditioner.
+     */
+    unsigned int n_cycles;
+
+    /**
+     * The number of unknowns below which no further coarsening is done. The
+     * matrix on the coarsest level is inverted by Gaussian elimination if it
+     * is not larger than this number, and otherwise only smoothed.
+     */
+    size_type max_coarse_size;
+
+    /**
+     * The maximal number of levels of the hierarchy, including the level of
+     * the original matrix.
+     */
+    unsigned int max_levels;
+
+    /**
+     * The damping factor of the prolongator smoothing, relative to the
+     * inverse of the largest eigenvalue of $D^{-1}A$. The latter is the
+     * estimate computed for the Chebyshev smoother, which includes a safety
+     * factor.
+     */
+    double prolongator_damping;
+  };
+
+  /**
+   * Constructor. Call initialize() before using this object as a
+   * preconditioner.
+   */
+  PreconditionAMG() = default;
+
+  /**
+   * Build the multigrid hierarchy for the given matrix. The matrix needs to
+   * be symmetric and positive definite, or close to it, and have positive
+   * diagonal entries. The matrix is not copied, and needs to live as long as
+   * this object is used.
+   */
+  void
+  initialize(const SparseMatrix<double> &matrix,
+             const AdditionalData       &additional_data = AdditionalData());
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Apply the preconditioner, i.e., perform AdditionalData::n_cycles
+   * V-cycles on the system with right hand side @p src, starting from zero.
+   */
+  void
+  vmult(Vector<double> &dst, const Vector<double> &src) const;
+
+  /**
+   * Apply the transpose of the preconditioner. Since the V-cycle is
+   * symmetric, this is the same as vmult().
+   */
+  void
+  Tvmult(Vector<double> &dst, const Vector<double> &src) const;
+
+  /**
+   * Return the dimension of the codomain (or range) space, i.e., the number
+   * of rows of the matrix given to initialize().
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the dimension of the domain space, i.e., the number of columns
+   * of the matrix given to initialize().
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of levels of the multigrid hierarchy, including the
+   * level of the original matrix.
+   */
+  unsigned int
+  n_levels() const;
+
+  /**
+   * Return the matrix on the given @p level, where level zero is the matrix
+   * given to initialize().
+   */
+  const SparseMatrix<double> &
+  get_matrix(const unsigned int level) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object, not including the matrix given to initialize().
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * The data stored for each level of the hierarchy. The matrices refer to
+   * the sparsity patterns stored in the same object, which is why the
+   * levels are held by pointer.
+   */
+  struct Level
+  {
+    /**
+     * The sparsity pattern and entries of the level matrix. Empty on the
+     * finest level, which uses the matrix given to initialize().
+     */
+    SparsityPattern      matrix_sparsity;
+    SparseMatrix<double> matrix;
+
+    /**
+     * The prolongation from the next coarser level to this one, and the
+     * restriction as its transpose. Empty on the coarsest level.
+     */
+    SparsityPattern      prolongation_sparsity;
+    SparseMatrix<double> prolongation;
+    SparsityPattern      restriction_sparsity;
+    SparseMatrix<double> restriction;
+
+    /**
+     * The smoother of this level.
+     */
+    PreconditionChebyshev<SparseMatrix<double>, Vector<double>> smoother;
+
+    /**
+     * Vectors for the residual, and for the right hand side and solution
+     * of the coarse-grid correction, which live on the next coarser level.
+     */
+    mutable Vector<double> residual;
+    mutable Vector<double> coarse_rhs;
+    mutable Vector<double> coarse_solution;
+  };
+
+  /**
+   * Perform one V-cycle on the given @p level, starting from @p dst, or
+   * from zero if @p dst_is_zero is set, in which case the content of
+   * @p dst is ignored.
+   */
+  void
+  v_cycle(const unsigned int    level,
+          Vector<double>       &dst,
+          const Vector<double> &src,
+          const bool            dst_is_zero) const;
+
+  /**
+   * The matrix given to initialize().
+   */
+  ObserverPointer<const SparseMatrix<double>, PreconditionAMG> matrix;
+
+  /**
+   * The parameters given to initialize().
+   */
+  AdditionalData data;
+
+  /**
+   * The levels of the hierarchy, starting with the finest one.
+   */
+  std::vector<std::unique_ptr<Level>> levels;
+
+  /**
+   * The inverse of the coarsest matrix, if it is small enough to be
+   * inverted.
+   */
+  FullMatrix<double> coarse_inverse;
+};
+
+/** @} */
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
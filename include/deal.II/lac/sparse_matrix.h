@@ -15,6 +15,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/atomic_add.h>
 #include <deal.II/base/enable_observer_pointer.h>
 #include <deal.II/base/mpi_stub.h>
 #include <deal.II/base/observer_pointer.h>
@@ -930,6 +931,29 @@ public:
       const bool       elide_zero_values      = true,
       const bool       col_indices_are_sorted = false);
 
+  /**
+   * Same as the add() function for a single element, but add the value as an
+   * atomic operation via Threads::atomic_add(). Several threads may thus add
+   * into the same matrix at the same time, also into the same entries, for
+   * example from the worker functions of WorkStream::run() without a copier
+   * and without coloring the cells. The sparsity pattern must not be changed
+   * while this happens.
+   */
+  void
+  add_atomic(const size_type i, const size_type j, const number value);
+
+  /**
+   * Same as the add() function for several elements of a row above, but add
+   * each value as an atomic operation via Threads::atomic_add().
+   */
+  void
+  add_atomic(const size_type  row,
+             const size_type  n_cols,
+             const size_type *col_indices,
+             const number    *values,
+             const bool       elide_zero_values      = true,
+             const bool       col_indices_are_sorted = false);
+
   /**
    * Multiply the entire matrix by a fixed factor.
    */
@@ -1302,6 +1326,39 @@ public:
          const Vector<number>        &V = Vector<number>(),
          const bool                   rebuild_sparsity_pattern = true) const;
 
+  /**
+   * Compute the triple matrix product <tt>C = R * A * P</tt>, where
+   * <tt>A</tt> is the current matrix. This is the product that computes the
+   * Galerkin coarse-level operator of a multigrid or algebraic coarse-grid
+   * method from the restriction matrix <tt>R</tt>, the fine-level matrix
+   * <tt>A</tt>, and the prolongation matrix <tt>P</tt>. The sizes of the
+   * three matrices have to be compatible, i.e., <tt>R.n() == A.m()</tt> and
+   * <tt>A.n() == P.m()</tt>.
+   *
+   * Rather than computing the product <tt>R * A</tt> (or <tt>A * P</tt>)
+   * first and storing it in a separate matrix, each row of <tt>R * A</tt> is
+   * computed when it is needed and immediately multiplied with <tt>P</tt>.
+   *
+   * The optional flag @p rebuild_sparsity_pattern has the same meaning as
+   * for mmult(), and the same caveats apply. If it is @p false, the product
+   * is added to the current content of @p C, whose sparsity pattern needs to
+   * contain all entries of the product. This is how the more expensive
+   * computation of the sparsity pattern is done only once when the same
+   * product has to be computed repeatedly for matrices whose values change,
+   * for example in the setup of a nonlinear solver: set <tt>C = 0</tt> and
+   * call this function with @p false as last argument.
+   *
+   * Both the computation of the sparsity pattern and of the entries of
+   * @p C are split into subranges of rows that are worked on in parallel,
+   * as are the ones of mmult() and Tmmult().
+   */
+  template <typename numberR, typename numberP, typename numberC>
+  void
+  triple_product(SparseMatrix<numberC>       &C,
+                 const SparseMatrix<numberR> &R,
+                 const SparseMatrix<numberP> &P,
+                 const bool rebuild_sparsity_pattern = true) const;
+
   /** @} */
   /**
    * @name Matrix norms
@@ -1943,6 +2000,33 @@ SparseMatrix<number>::add(const size_type i,
 
 
 
+template <typename number>
+inline void
+SparseMatrix<number>::add_atomic(const size_type i,
+                                 const size_type j,
+                                 const number    value)
+{
+  AssertIsFinite(value);
+
+  if (value == number())
+    return;
+
+  const size_type index = cols->operator()(i, j);
+
+  // it is allowed to add elements to the matrix that are not part of the
+  // sparsity pattern, if the value to which we set it is zero
+  if (index == SparsityPattern::invalid_entry)
+    {
+      Assert((index != SparsityPattern::invalid_entry) || (value == number()),
+             ExcInvalidIndex(i, j));
+      return;
+    }
+
+  Threads::atomic_add(val[index], value);
+}
+
+
+
 template <typename number>
 template <typename number2>
 inline void
@@ -33,6 +33,7 @@
 #include <cmath>
 #include <functional>
 #include <iomanip>
+#include <limits>
 #include <numeric>
 #include <ostream>
 #include <vector>
@@ -653,6 +654,82 @@ SparseMatrix<number>::add(const size_type  row,
 
 
 
+template <typename number>
+void
+SparseMatrix<number>::add_atomic(const size_type  row,
+                                 const size_type  n_cols,
+                                 const size_type *col_indices,
+                                 const number    *values,
+                                 const bool       elide_zero_values,
+                                 const bool       col_indices_are_sorted)
+{
+  Assert(cols != nullptr, ExcNeedsSparsityPattern());
+  AssertIndexRange(row, m());
+
+  const size_type *const my_cols        = cols->colnums.get();
+  const size_type        row_start      = cols->rowstart[row];
+  const size_type        next_row_index = cols->rowstart[row + 1];
+
+  // with sorted indices, walk through the row and the given indices in
+  // parallel like in add(). Otherwise, try the next entry of the row first
+  // and do a search only if that is not the right one
+  if (col_indices_are_sorted == true)
+    {
+      // the diagonal of square matrices is usually stored first, all other
+      // entries are sorted
+      const bool diagonal_first = cols->store_diagonal_first_in_row;
+      size_type  index          = diagonal_first ? row_start + 1 : row_start;
+      for (size_type j = 0; j < n_cols; ++j)
+        {
+          const number value = values[j];
+          AssertIsFinite(value);
+          if (elide_zero_values == true && value == number())
+            continue;
+
+          if (diagonal_first && col_indices[j] == row)
+            {
+              Threads::atomic_add(val[row_start], value);
+              continue;
+            }
+
+          while (index < next_row_index && my_cols[index] < col_indices[j])
+            ++index;
+
+          if (index == next_row_index || my_cols[index] != col_indices[j])
+            {
+              Assert(value == number(), ExcInvalidIndex(row, col_indices[j]));
+              continue;
+            }
+          Threads::atomic_add(val[index], value);
+        }
+      return;
+    }
+
+  size_type index = row_start;
+  for (size_type j = 0; j < n_cols; ++j)
+    {
+      const number value = values[j];
+      AssertIsFinite(value);
+      if (elide_zero_values == true && value == number())
+        continue;
+
+      if (!(index < next_row_index && my_cols[index] == col_indices[j]))
+        {
+          index = cols->operator()(row, col_indices[j]);
+          if (index == SparsityPattern::invalid_entry)
+            {
+              Assert(value == number(), ExcInvalidIndex(row, col_indices[j]));
+              continue;
+            }
+        }
+
+      Threads::atomic_add(val[index], value);
+      ++index;
+    }
+}
+
+
+
 template <typename number>
 template <typename number2>
 void
@@ -982,6 +1059,144 @@ SparseMatrix<number>::matrix_scalar_product(const Vector<somenumber> &u,
 
 
 
+namespace internal
+{
+  namespace SparseMatrixImplementation
+  {
+    /**
+     * Reset the sparsity pattern of @p C to the one of the matrix-matrix
+     * product $LB$ and reinitialize @p C with it. The rows of the left
+     * factor $L$ are generated on the fly by @p get_left_row, which is called
+     * as <code>get_left_row(i, entries)</code> and fills @p entries with
+     * pairs of column indices and values of row $i$ of $L$. The right factor
+     * $B$ is given by the @p B_rowstart and @p B_colnums arrays of its
+     * sparsity pattern.
+     *
+     * The column indices of the rows of the product are computed in parallel
+     * for subranges of rows. Every subrange works on its own copy of
+     * @p get_left_row, which may therefore hold scratch data.
+     */
+    template <typename numberC, typename LeftRowFunction>
+    void
+    reinit_to_product_pattern(SparseMatrix<numberC> &C,
+                              const size_type        n_rows,
+                              const size_type        n_cols,
+                              const LeftRowFunction &get_left_row,
+                              const std::size_t     *B_rowstart,
+                              const size_type       *B_colnums)
+    {
+      // need to change the sparsity pattern of C, so cast away const-ness.
+      SparsityPattern &sp_C =
+        *(const_cast<SparsityPattern *>(&C.get_sparsity_pattern()));
+      C.clear();
+      sp_C.reinit(0, 0, 0);
+
+      std::vector<std::vector<size_type>> column_indices(n_rows);
+      parallel::apply_to_subranges(
+        size_type(0),
+        n_rows,
+        [&](const size_type begin_row, const size_type end_row) {
+          LeftRowFunction                            left_row = get_left_row;
+          std::vector<std::pair<size_type, numberC>> left_entries;
+
+          // the last row in which a column was found, so that we can
+          // avoid duplicates without searching
+          std::vector<size_type> last_row(n_cols, numbers::invalid_size_type);
+          for (size_type i = begin_row; i < end_row; ++i)
+            {
+              left_row(i, left_entries);
+              std::vector<size_type> &columns = column_indices[i];
+              for (const auto &entry : left_entries)
+                for (std::size_t j = B_rowstart[entry.first];
+                     j < B_rowstart[entry.first + 1];
+                     ++j)
+                  if (last_row[B_colnums[j]] != i)
+                    {
+                      last_row[B_colnums[j]] = i;
+                      columns.push_back(B_colnums[j]);
+                    }
+              std::sort(columns.begin(), columns.end());
+            }
+        },
+        minimum_parallel_grain_size);
+
+      sp_C.copy_from(n_rows,
+                     n_cols,
+                     column_indices.begin(),
+                     column_indices.end());
+      C.reinit(sp_C);
+    }
+
+
+
+    /**
+     * Add the matrix-matrix product $LB$ to the values @p C_values of a
+     * matrix $C$ whose sparsity pattern, given by @p C_rowstart and
+     * @p C_colnums, contains all entries of the product. The rows of $L$ are
+     * given by @p get_left_row as explained for reinit_to_product_pattern().
+     *
+     * The rows of $C$ are computed in parallel for subranges of rows. For
+     * each row, the positions of its entries are first scattered into an
+     * array indexed by the column, so that the contributions can be added
+     * without searching the row.
+     */
+    template <typename numberB, typename numberC, typename LeftRowFunction>
+    void
+    add_product_entries(const size_type        n_rows,
+                        const size_type        n_cols,
+                        const LeftRowFunction &get_left_row,
+                        const std::size_t     *B_rowstart,
+                        const size_type       *B_colnums,
+                        const numberB         *B_values,
+                        const std::size_t     *C_rowstart,
+                        const size_type       *C_colnums,
+                        numberC               *C_values)
+    {
+      constexpr std::size_t invalid_position =
+        std::numeric_limits<std::size_t>::max();
+
+      parallel::apply_to_subranges(
+        size_type(0),
+        n_rows,
+        [&](const size_type begin_row, const size_type end_row) {
+          LeftRowFunction                            left_row = get_left_row;
+          std::vector<std::pair<size_type, numberC>> left_entries;
+          std::vector<std::size_t> position(n_cols, invalid_position);
+          for (size_type i = begin_row; i < end_row; ++i)
+            {
+              for (std::size_t j = C_rowstart[i]; j < C_rowstart[i + 1]; ++j)
+                position[C_colnums[j]] = j;
+
+              left_row(i, left_entries);
+              for (const auto &entry : left_entries)
+                for (std::size_t j = B_rowstart[entry.first];
+                     j < B_rowstart[entry.first + 1];
+                     ++j)
+                  {
+                    const std::size_t p = position[B_colnums[j]];
+                    if (p != invalid_position)
+                      C_values[p] += entry.second * numberC(B_values[j]);
+                    else
+                      Assert(false,
+                             ExcMessage(
+                               "The sparsity pattern of the result matrix "
+                               "does not contain entry (" +
+                               std::to_string(i) + "," +
+                               std::to_string(B_colnums[j]) +
+                               ") of the product."));
+                  }
+
+              for (std::size_t j = C_rowstart[i]; j < C_rowstart[i + 1]; ++j)
+                position[C_colnums[j]] = invalid_position;
+            }
+        },
+        minimum_parallel_grain_size);
+    }
+  } // namespace SparseMatrixImplementation
+} // namespace internal
+
+
+
 template <typename number>
 template <typename numberB, typename numberC>
 void
@@ -999,6 +1214,18 @@ SparseMatrix<number>::mmult(SparseMatrix<numberC>       &C,
   const SparsityPattern &sp_A = *cols;
   const SparsityPattern &sp_B = *B.cols;
 
+  // row i of C is the linear combination of the rows of B with the entries
+  // of row i of A as coefficients
+  const auto get_left_row =
+    [&](const size_type                             row,
+        std::vector<std::pair<size_type, numberC>> &entries) {
+      entries.clear();
+      for (std::size_t j = sp_A.rowstart[row]; j < sp_A.rowstart[row + 1]; ++j)
+        entries.emplace_back(sp_A.colnums[j],
+                             numberC(val[j]) *
+                               numberC(use_vector ? V(sp_A.colnums[j]) : 1));
+    };
+
   // clear previous content of C
   if (rebuild_sparsity_C == true)
     {
@@ -1011,79 +1238,28 @@ SparseMatrix<number>::mmult(SparseMatrix<numberC>       &C,
              ExcMessage("Can't use the same sparsity pattern for "
                         "different matrices if it is to be rebuilt."));
 
-      // need to change the sparsity pattern of C, so cast away const-ness.
-      SparsityPattern &sp_C =
-        *(const_cast<SparsityPattern *>(&C.get_sparsity_pattern()));
-      C.clear();
-      sp_C.reinit(0, 0, 0);
-
-      // create a sparsity pattern for the matrix C.
-      {
-        DynamicSparsityPattern dsp;
-        dsp.compute_mmult_pattern(sp_A, sp_B);
-        sp_C.copy_from(dsp);
-      }
-
-      // reinit matrix C from that information
-      C.reinit(sp_C);
+      internal::SparseMatrixImplementation::reinit_to_product_pattern(
+        C,
+        m(),
+        B.n(),
+        get_left_row,
+        sp_B.rowstart.get(),
+        sp_B.colnums.get());
     }
 
   Assert(C.m() == m(), ExcDimensionMismatch(C.m(), m()));
   Assert(C.n() == B.n(), ExcDimensionMismatch(C.n(), B.n()));
 
-  // create an array that caches some
-  // elements that are going to be written
-  // into the new matrix.
-  unsigned int max_n_cols_B = 0;
-  for (size_type i = 0; i < B.m(); ++i)
-    max_n_cols_B = std::max(max_n_cols_B, sp_B.row_length(i));
-  std::vector<numberC> new_entries(max_n_cols_B);
-
-  // now compute the actual entries: a matrix-matrix product involves three
-  // nested loops. One over the rows of A, for each row we then loop over all
-  // the columns, and then we need to multiply each element with all the
-  // elements in that row in B.
-  for (size_type i = 0; i < C.m(); ++i)
-    {
-      const size_type       *rows     = &sp_A.colnums[sp_A.rowstart[i]];
-      const size_type *const end_rows = &sp_A.colnums[sp_A.rowstart[i + 1]];
-      for (; rows != end_rows; ++rows)
-        {
-          const number     A_val = val[rows - &sp_A.colnums[sp_A.rowstart[0]]];
-          const size_type  col   = *rows;
-          const size_type *new_cols = (&sp_B.colnums[sp_B.rowstart[col]]);
-
-          // special treatment for diagonal
-          if (sp_B.n_rows() == sp_B.n_cols())
-            {
-              C.add(i,
-                    *new_cols,
-                    numberC(A_val) *
-                      numberC(
-                        B.val[new_cols - &sp_B.colnums[sp_B.rowstart[0]]]) *
-                      numberC(use_vector ? V(col) : 1));
-              ++new_cols;
-            }
-
-          // now the innermost loop that goes over all the elements in row
-          // 'col' of matrix B. Cache the elements, and then write them into C
-          // at once
-          numberC       *new_ptr = new_entries.data();
-          const numberB *B_val_ptr =
-            &B.val[new_cols - &sp_B.colnums[sp_B.rowstart[0]]];
-          const numberB *const end_cols = &B.val[sp_B.rowstart[col + 1]];
-          for (; B_val_ptr != end_cols; ++B_val_ptr)
-            *new_ptr++ = numberC(A_val) * numberC(*B_val_ptr) *
-                         numberC(use_vector ? V(col) : 1);
-
-          C.add(i,
-                new_ptr - new_entries.data(),
-                new_cols,
-                new_entries.data(),
-                false,
-                true);
-        }
-    }
+  internal::SparseMatrixImplementation::add_product_entries(
+    C.m(),
+    C.n(),
+    get_left_row,
+    sp_B.rowstart.get(),
+    sp_B.colnums.get(),
+    B.val.get(),
+    C.cols->rowstart.get(),
+    C.cols->colnums.get(),
+    C.val.get());
 }
 
 
@@ -1105,6 +1281,35 @@ SparseMatrix<number>::Tmmult(SparseMatrix<numberC>       &C,
   const SparsityPattern &sp_A = *cols;
   const SparsityPattern &sp_B = *B.cols;
 
+  // row i of C is the linear combination of the rows of B with the entries
+  // of column i of A as coefficients. to compute the rows of C independently
+  // of each other, we first collect the columns of A, i.e., we transpose A
+  std::vector<std::size_t> transpose_rowstart(n() + 1, 0);
+  for (size_type i = 0; i < m(); ++i)
+    for (std::size_t j = sp_A.rowstart[i]; j < sp_A.rowstart[i + 1]; ++j)
+      ++transpose_rowstart[sp_A.colnums[j] + 1];
+  std::partial_sum(transpose_rowstart.begin(),
+                   transpose_rowstart.end(),
+                   transpose_rowstart.begin());
+
+  std::vector<std::pair<size_type, numberC>> transpose_entries(
+    transpose_rowstart.back());
+  {
+    std::vector<std::size_t> next_entry(transpose_rowstart.begin(),
+                                        transpose_rowstart.end() - 1);
+    for (size_type i = 0; i < m(); ++i)
+      for (std::size_t j = sp_A.rowstart[i]; j < sp_A.rowstart[i + 1]; ++j)
+        transpose_entries[next_entry[sp_A.colnums[j]]++] = {
+          i, numberC(val[j]) * numberC(use_vector ? V(i) : 1)};
+  }
+
+  const auto get_left_row =
+    [&](const size_type                             row,
+        std::vector<std::pair<size_type, numberC>> &entries) {
+      entries.assign(transpose_entries.begin() + transpose_rowstart[row],
+                     transpose_entries.begin() + transpose_rowstart[row + 1]);
+    };
+
   // clear previous content of C
   if (rebuild_sparsity_C == true)
     {
@@ -1117,80 +1322,118 @@ SparseMatrix<number>::Tmmult(SparseMatrix<numberC>       &C,
              ExcMessage("Can't use the same sparsity pattern for "
                         "different matrices if it is to be rebuilt."));
 
-      // need to change the sparsity pattern of C, so cast away const-ness.
-      SparsityPattern &sp_C =
-        *(const_cast<SparsityPattern *>(&C.get_sparsity_pattern()));
-      C.clear();
-      sp_C.reinit(0, 0, 0);
-
-      // create a sparsity pattern for the matrix.
-      {
-        DynamicSparsityPattern dsp;
-        dsp.compute_Tmmult_pattern(sp_A, sp_B);
-        sp_C.copy_from(dsp);
-      }
-
-      // reinit matrix C from that information
-      C.reinit(sp_C);
+      internal::SparseMatrixImplementation::reinit_to_product_pattern(
+        C,
+        n(),
+        B.n(),
+        get_left_row,
+        sp_B.rowstart.get(),
+        sp_B.colnums.get());
     }
 
   Assert(C.m() == n(), ExcDimensionMismatch(C.m(), n()));
   Assert(C.n() == B.n(), ExcDimensionMismatch(C.n(), B.n()));
 
-  // create an array that caches some
-  // elements that are going to be written
-  // into the new matrix.
-  unsigned int max_n_cols_B = 0;
-  for (size_type i = 0; i < B.m(); ++i)
-    max_n_cols_B = std::max(max_n_cols_B, sp_B.row_length(i));
-  std::vector<numberC> new_entries(max_n_cols_B);
-
-  // now compute the actual entries: a matrix-matrix product involves three
-  // nested loops. One over the rows of A, for each row we then loop over all
-  // the columns, and then we need to multiply each element with all the
-  // elements in that row in B.
-  for (size_type i = 0; i < m(); ++i)
-    {
-      const size_type       *rows     = &sp_A.colnums[sp_A.rowstart[i]];
-      const size_type *const end_rows = &sp_A.colnums[sp_A.rowstart[i + 1]];
-      const size_type       *new_cols = &sp_B.colnums[sp_B.rowstart[i]];
-      if (sp_B.n_rows() == sp_B.n_cols())
-        ++new_cols;
+  internal::SparseMatrixImplementation::add_product_entries(
+    C.m(),
+    C.n(),
+    get_left_row,
+    sp_B.rowstart.get(),
+    sp_B.colnums.get(),
+    B.val.get(),
+    C.cols->rowstart.get(),
+    C.cols->colnums.get(),
+    C.val.get());
+}
+
 
-      const numberB *const end_cols = &B.val[sp_B.rowstart[i + 1]];
 
-      for (; rows != end_rows; ++rows)
+template <typename number>
+template <typename numberR, typename numberP, typename numberC>
+void
+SparseMatrix<number>::triple_product(SparseMatrix<numberC>       &C,
+                                     const SparseMatrix<numberR> &R,
+                                     const SparseMatrix<numberP> &P,
+                                     const bool rebuild_sparsity_C) const
+{
+  Assert(R.n() == m(), ExcDimensionMismatch(R.n(), m()));
+  Assert(n() == P.m(), ExcDimensionMismatch(n(), P.m()));
+  Assert(cols != nullptr, ExcNeedsSparsityPattern());
+  Assert(R.cols != nullptr, ExcNeedsSparsityPattern());
+  Assert(P.cols != nullptr, ExcNeedsSparsityPattern());
+  Assert(C.cols != nullptr, ExcNeedsSparsityPattern());
+
+  const SparsityPattern &sp_A = *cols;
+  const SparsityPattern &sp_R = *R.cols;
+  const SparsityPattern &sp_P = *P.cols;
+
+  // row i of C is row i of the product RA, multiplied by P. we compute the
+  // rows of RA on the fly and never store that product: the entries of a row
+  // are accumulated in an array indexed by the column, whose nonzero
+  // positions are tracked in the list of entries that is handed on to the
+  // multiplication with P
+  const auto get_left_row =
+    [&, position = std::vector<size_type>(n(), numbers::invalid_size_type)](
+      const size_type                             row,
+      std::vector<std::pair<size_type, numberC>> &entries) mutable {
+      entries.clear();
+      for (std::size_t r = sp_R.rowstart[row]; r < sp_R.rowstart[row + 1];
+           ++r)
         {
-          const size_type row   = *rows;
-          const number    A_val = val[rows - &sp_A.colnums[sp_A.rowstart[0]]];
-
-          // special treatment for diagonal
-          if (sp_B.n_rows() == sp_B.n_cols())
-            C.add(row,
-                  i,
-                  numberC(A_val) *
-                    numberC(
-                      B.val[new_cols - 1 - &sp_B.colnums[sp_B.rowstart[0]]]) *
-                    numberC(use_vector ? V(i) : 1));
-
-          // now the innermost loop that goes over all the elements in row
-          // 'col' of matrix B. Cache the elements, and then write them into C
-          // at once
-          numberC       *new_ptr = new_entries.data();
-          const numberB *B_val_ptr =
-            &B.val[new_cols - &sp_B.colnums[sp_B.rowstart[0]]];
-          for (; B_val_ptr != end_cols; ++B_val_ptr)
-            *new_ptr++ = numberC(A_val) * numberC(*B_val_ptr) *
-                         numberC(use_vector ? V(i) : 1);
-
-          C.add(row,
-                new_ptr - new_entries.data(),
-                new_cols,
-                new_entries.data(),
-                false,
-                true);
+          const size_type k     = sp_R.colnums[r];
+          const numberC   R_val = numberC(R.val[r]);
+          for (std::size_t j = sp_A.rowstart[k]; j < sp_A.rowstart[k + 1]; ++j)
+            {
+              const size_type col = sp_A.colnums[j];
+              if (position[col] == numbers::invalid_size_type)
+                {
+                  position[col] = entries.size();
+                  entries.emplace_back(col, numberC());
+                }
+              entries[position[col]].second += R_val * numberC(val[j]);
+            }
         }
+
+      for (const auto &entry : entries)
+        position[entry.first] = numbers::invalid_size_type;
+    };
+
+  if (rebuild_sparsity_C == true)
+    {
+      // we are about to change the sparsity pattern of C. this can not work
+      // if any of the other matrices uses the same sparsity pattern
+      Assert(&C.get_sparsity_pattern() != &this->get_sparsity_pattern(),
+             ExcMessage("Can't use the same sparsity pattern for "
+                        "different matrices if it is to be rebuilt."));
+      Assert(&C.get_sparsity_pattern() != &R.get_sparsity_pattern(),
+             ExcMessage("Can't use the same sparsity pattern for "
+                        "different matrices if it is to be rebuilt."));
+      Assert(&C.get_sparsity_pattern() != &P.get_sparsity_pattern(),
+             ExcMessage("Can't use the same sparsity pattern for "
+                        "different matrices if it is to be rebuilt."));
+
+      internal::SparseMatrixImplementation::reinit_to_product_pattern(
+        C,
+        R.m(),
+        P.n(),
+        get_left_row,
+        sp_P.rowstart.get(),
+        sp_P.colnums.get());
     }
+
+  Assert(C.m() == R.m(), ExcDimensionMismatch(C.m(), R.m()));
+  Assert(C.n() == P.n(), ExcDimensionMismatch(C.n(), P.n()));
+
+  internal::SparseMatrixImplementation::add_product_entries(
+    C.m(),
+    C.n(),
+    get_left_row,
+    sp_P.rowstart.get(),
+    sp_P.colnums.get(),
+    P.val.get(),
+    C.cols->rowstart.get(),
+    C.cols->colnums.get(),
+    C.val.get());
 }
 
 
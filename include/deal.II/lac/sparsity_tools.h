@@ -202,6 +202,10 @@ namespace SparsityTools
    * exception if starting indices are given, taking the latter as an
    * indication that the caller of the function would like to override the
    * part of the algorithm that chooses starting indices.
+   *
+   * For large fronts, the search for the indices of the next front is split
+   * among several tasks. The resulting numbering is the same as the one
+   * obtained with a single thread.
    */
   void
   reorder_Cuthill_McKee(
@@ -210,6 +214,50 @@ namespace SparsityTools
     const std::vector<DynamicSparsityPattern::size_type> &starting_indices =
       std::vector<DynamicSparsityPattern::size_type>());
 
+  /**
+   * For a given sparsity pattern, compute a re-enumeration of row/column
+   * indices based on the reverse Cuthill-McKee algorithm: This is the
+   * algorithm of reorder_Cuthill_McKee(), with the resulting numbering
+   * reversed, which typically reduces the fill-in of incomplete or complete
+   * factorizations compared to the original ordering while keeping the
+   * bandwidth the same.
+   *
+   * Rather than starting each connected component of the graph at an index
+   * with the smallest coordination number, this function starts it at a
+   * pseudo-peripheral index as computed by find_pseudo_peripheral_index(),
+   * i.e., at one end of a long path through the graph. This yields narrow
+   * level sets and consequently smaller bandwidths and profiles, in
+   * particular on the hierarchically refined meshes for which the choice by
+   * coordination number is highly ambiguous.
+   *
+   * Like reorder_Cuthill_McKee(), the expansion of large fronts is split
+   * among several tasks. The result does not depend on the number of
+   * threads.
+   */
+  void
+  reorder_reverse_Cuthill_McKee(
+    const DynamicSparsityPattern                   &sparsity,
+    std::vector<DynamicSparsityPattern::size_type> &new_indices);
+
+  /**
+   * Find a pseudo-peripheral index of the graph described by @p sparsity,
+   * i.e., an index whose eccentricity (the largest graph distance to any
+   * other index in its connected component) is close to the diameter of the
+   * graph. This is the algorithm of George and Liu (1979): Starting from
+   * @p start, it repeatedly computes the level structure of the current
+   * candidate by a breadth-first search and moves on to the index with the
+   * smallest coordination number in the last level, as long as this
+   * increases the number of levels.
+   *
+   * If @p start is not given, the search starts from an index with the
+   * smallest coordination number. The result lies in the same connected
+   * component as @p start.
+   */
+  DynamicSparsityPattern::size_type
+  find_pseudo_peripheral_index(
+    const DynamicSparsityPattern     &sparsity,
+    DynamicSparsityPattern::size_type start = numbers::invalid_size_type);
+
   /**
    * For a given sparsity pattern, compute a re-enumeration of row/column
    * indices in a hierarchical way, similar to what
@@ -17,6 +17,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/atomic_add.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/index_set.h>
 #include <deal.II/base/numbers.h>
@@ -789,6 +790,18 @@ public:
       const size_type   *indices,
       const OtherNumber *values);
 
+  /**
+   * Same as the collective add operation above, but add each value as an
+   * atomic operation via Threads::atomic_add(). This allows several threads
+   * to add into the same vector at the same time, also into the same
+   * entries, for example from the worker functions of WorkStream::run()
+   * without a copier. It is slower than the function above when only a
+   * single thread writes into the vector.
+   */
+  void
+  add_atomic(const std::vector<size_type> &indices,
+             const std::vector<Number>    &values);
+
   /**
    * Addition of @p s to all components. Note that @p s is a scalar and not a
    * vector.
@@ -1367,6 +1380,22 @@ Vector<Number>::add(const size_type    n_indices,
 
 
 
+template <typename Number>
+inline void
+Vector<Number>::add_atomic(const std::vector<size_type> &indices,
+                           const std::vector<Number>    &values)
+{
+  AssertDimension(indices.size(), values.size());
+  for (size_type i = 0; i < indices.size(); ++i)
+    {
+      AssertIndexRange(indices[i], size());
+      AssertIsFinite(values[i]);
+      Threads::atomic_add(this->values[indices[i]], values[i]);
+    }
+}
+
+
+
 template <typename Number>
 template <typename Number2>
 inline bool
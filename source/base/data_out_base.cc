@@ -16,6 +16,7 @@
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi_large_count.h>
 #include <deal.II/base/numbers.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/scope_exit.h>
 #include <deal.II/base/thread_management.h>
@@ -136,9 +137,76 @@ namespace
 #    endif
 #  endif
 
+#  ifdef DEAL_II_WITH_ZLIB
+  /**
+   * Encode the given bytes in base64 and write the result to the provided
+   * output stream.
+   *
+   * Rather than use Utilities::encode_base64(), avoid creating one large
+   * temporary buffer: The data is split into chunks whose sizes are
+   * multiples of three bytes (so that the encoded chunks can simply be
+   * concatenated) and a number of chunks is encoded in parallel before being
+   * written to the stream in order.
+   */
+  void
+  write_base64(const unsigned char *data,
+               const std::size_t    n_bytes,
+               std::ostringstream  &output)
+  {
+    using namespace boost::archive::iterators;
+    using iterator =
+      base64_from_binary<transform_width<const unsigned char *, 6, 8>>;
+
+    const auto encode = [](const unsigned char *begin,
+                           const unsigned char *end,
+                           std::string         &encoded) {
+      encoded.resize(((end - begin) + 2) / 3 * 4);
+      std::size_t count = 0;
+      for (auto it = iterator(begin); it != iterator(end); ++it, ++count)
+        encoded[count] = *it;
+      encoded.resize(count);
+    };
+
+    constexpr std::size_t    chunk_size       = 3 * (1 << 16);
+    constexpr std::size_t    chunks_per_round = 64;
+    std::vector<std::string> encoded_chunks(chunks_per_round);
+
+    const std::size_t n_chunks = (n_bytes + chunk_size - 1) / chunk_size;
+    for (std::size_t first = 0; first < n_chunks; first += chunks_per_round)
+      {
+        const std::size_t last = std::min(first + chunks_per_round, n_chunks);
+        parallel::apply_to_subranges(
+          first,
+          last,
+          [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t c = begin; c < end; ++c)
+              encode(data + c * chunk_size,
+                     data + std::min((c + 1) * chunk_size, n_bytes),
+                     encoded_chunks[c - first]);
+          },
+          1);
+        for (std::size_t c = first; c < last; ++c)
+          output.write(encoded_chunks[c - first].data(),
+                       encoded_chunks[c - first].size());
+      }
+
+    const std::array<std::string, 3> paddings{{"", "==", "="}};
+    output << paddings[n_bytes % 3];
+  }
+#  endif
+
+
+
   /**
    * Do a zlib compression followed by a base64 encoding of the given data, and
    * save the result to the provided output stream.
+   *
+   * Following the VTK format for compressed data, the data is split into
+   * blocks of (at most) a fixed size that are compressed independently of
+   * each other, and in parallel. The compression header lists the number of
+   * blocks, the uncompressed sizes of all but the last and of the last
+   * block, and the compressed sizes of all blocks. Arrays that fit into one
+   * block result in exactly one block, as before.
    */
   template <typename T>
   void
@@ -151,86 +219,89 @@ namespace
       {
         const std::size_t uncompressed_size = (data.size() * sizeof(T));
 
-        // While zlib's compress2 uses unsigned long (which is 64bits
-        // on Linux), the vtu compression header stores the block size
-        // as an std::uint32_t (see below). While we could implement
-        // writing several smaller blocks, we haven't done that. Let's
-        // trigger an error for the user instead:
-        AssertThrow(uncompressed_size <=
-                      std::numeric_limits<std::uint32_t>::max(),
-                    ExcNotImplemented());
-
-        // allocate a buffer for compressing data and do so
-        auto compressed_data_length = compressBound(uncompressed_size);
-        AssertThrow(compressed_data_length <=
-                      std::numeric_limits<std::uint32_t>::max(),
+        // The vtu compression header stores the sizes of blocks as
+        // std::uint32_t, so the blocks must not be larger than that. Larger
+        // blocks also do not compress noticeably better with zlib, whose
+        // window is only 32kB, but reduce the available parallelism.
+        constexpr std::size_t block_size = 1 << 20;
+        const std::size_t     n_blocks =
+          (uncompressed_size + block_size - 1) / block_size;
+        AssertThrow(n_blocks <= std::numeric_limits<std::uint32_t>::max(),
                     ExcNotImplemented());
 
-        std::vector<unsigned char> compressed_data(compressed_data_length);
-
-        int err = compress2(&compressed_data[0],
-                            &compressed_data_length,
-                            reinterpret_cast<const Bytef *>(data.data()),
-                            uncompressed_size,
-                            get_zlib_compression_level(compression_level));
-        Assert(err == Z_OK, ExcInternalError());
-
-        // Discard the unnecessary bytes
-        compressed_data.resize(compressed_data_length);
+        const std::size_t first_block_size =
+          std::min(uncompressed_size, block_size);
+        const std::size_t last_block_size =
+          uncompressed_size - (n_blocks - 1) * first_block_size;
+
+        // compress the blocks in parallel, each into a buffer of its own
+        std::vector<std::vector<unsigned char>> compressed_blocks(n_blocks);
+        parallel::apply_to_subranges(
+          std::size_t(0),
+          n_blocks,
+          [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t b = begin; b < end; ++b)
+              {
+                const std::size_t this_block_size =
+                  (b == n_blocks - 1) ? last_block_size : first_block_size;
+
+                auto compressed_data_length = compressBound(this_block_size);
+                std::vector<unsigned char> &compressed_data =
+                  compressed_blocks[b];
+                compressed_data.resize(compressed_data_length);
+
+                int err = compress2(
+                  &compressed_data[0],
+                  &compressed_data_length,
+                  reinterpret_cast<const Bytef *>(data.data()) +
+                    b * first_block_size,
+                  this_block_size,
+                  get_zlib_compression_level(compression_level));
+                Assert(err == Z_OK, ExcInternalError());
+                (void)err;
+
+                // Discard the unnecessary bytes
+                compressed_data.resize(compressed_data_length);
+              }
+          },
+          1);
 
         // now encode the compression header
-        const std::uint32_t compression_header[4] = {
-          1,                                             /* number of blocks */
-          static_cast<std::uint32_t>(uncompressed_size), /* size of block */
-          static_cast<std::uint32_t>(
-            uncompressed_size), /* size of last block */
-          static_cast<std::uint32_t>(
-            compressed_data_length)}; /* list of compressed sizes of blocks */
-
-        // Both the header and the data need padding
-        const std::array<std::string, 3> paddings{{"", "==", "="}};
-
-        // Rather than use Utilities::encode_base64(), avoid creating large
-        // temporary buffers by either writing directly to the output stream.
-        static_assert(sizeof(compressed_data[0]) == 1);
-        using namespace boost::archive::iterators;
-        using iterator =
-          base64_from_binary<transform_width<const unsigned char *, 6, 8>>;
-        {
-          auto char_begin = reinterpret_cast<const unsigned char *>(
-                 std::begin(compression_header)),
-               char_end = reinterpret_cast<const unsigned char *>(
-                 std::end(compression_header));
-          auto begin = iterator(char_begin), end = iterator(char_end);
-          for (auto it = begin; it != end; ++it)
-            output << *it;
-
-          output << paddings[(char_end - char_begin) % 3];
-        }
-
-        {
-          // Similarly, avoid the overhead of calling std::ostream::operator<<
-          // (which is virtual) on every character by writing to a small buffer
-          // first.
-          auto it  = iterator(compressed_data.data()),
-               end = iterator(compressed_data.data() + compressed_data.size());
-          std::array<char, 128> buffer;
-          while (it != end)
-            {
-              std::streamsize count = 0;
-              for (; count < static_cast<std::streamsize>(buffer.size());
-                   ++count)
-                {
-                  if (it == end)
-                    break;
-                  buffer[count] = *it;
-                  ++it;
-                }
-              output.write(buffer.data(), count);
-            }
-
-          output << paddings[compressed_data.size() % 3];
-        }
+        std::vector<std::uint32_t> compression_header;
+        compression_header.reserve(3 + n_blocks);
+        compression_header.push_back(n_blocks); /* number of blocks */
+        compression_header.push_back(first_block_size); /* size of block */
+        compression_header.push_back(last_block_size); /* size of last block */
+        for (const auto &block : compressed_blocks) /* compressed sizes */
+          compression_header.push_back(block.size());
+
+        write_base64(reinterpret_cast<const unsigned char *>(
+                       compression_header.data()),
+                     compression_header.size() * sizeof(std::uint32_t),
+                     output);
+
+        // The blocks are encoded as one stream of data, so concatenate them
+        // (unless there is only one).
+        if (n_blocks == 1)
+          write_base64(compressed_blocks[0].data(),
+                       compressed_blocks[0].size(),
+                       output);
+        else
+          {
+            std::size_t compressed_size = 0;
+            for (const auto &block : compressed_blocks)
+              compressed_size += block.size();
+
+            std::vector<unsigned char> compressed_data;
+            compressed_data.reserve(compressed_size);
+            for (const auto &block : compressed_blocks)
+              compressed_data.insert(compressed_data.end(),
+                                     block.begin(),
+                                     block.end());
+            write_base64(compressed_data.data(),
+                         compressed_data.size(),
+                         output);
+          }
       }
 #  else
     (void)data;
@@ -7795,6 +7866,148 @@ DataOutInterface<dim, spacedim>::write_svg(std::ostream &out) const
 }
 
 
+#ifdef DEAL_II_WITH_MPI
+namespace
+{
+  /**
+   * Write a .vtu file via MPI I/O. Every process in @p comm provides the
+   * VTU data of its @p piece without header and footer. The pieces are
+   * written one after the other in the order of the ranks in @p comm, and
+   * enclosed by the header and footer written by the first and the last
+   * process, respectively.
+   */
+  void
+  write_vtu_pieces_in_parallel(const std::string           &filename,
+                               const std::string           &piece,
+                               const DataOutBase::VtkFlags &vtk_flags,
+                               const MPI_Comm               comm)
+  {
+    const unsigned int myrank  = Utilities::MPI::this_mpi_process(comm);
+    const unsigned int n_ranks = Utilities::MPI::n_mpi_processes(comm);
+    MPI_Info           info;
+    int                ierr = MPI_Info_create(&info);
+    AssertThrowMPI(ierr);
+    MPI_File fh;
+    ierr = MPI_File_open(
+      comm, filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, info, &fh);
+    AssertThrow(ierr == MPI_SUCCESS, ExcFileNotOpen(filename));
+
+    ierr = MPI_File_set_size(fh, 0); // delete the file contents
+    AssertThrowMPI(ierr);
+    // this barrier is necessary, because otherwise others might already write
+    // while one core is still setting the size to zero.
+    ierr = MPI_Barrier(comm);
+    AssertThrowMPI(ierr);
+    ierr = MPI_Info_free(&info);
+    AssertThrowMPI(ierr);
+
+    // Define header size so we can broadcast later.
+    unsigned int  header_size;
+    std::uint64_t footer_offset;
+
+    // write header
+    if (myrank == 0)
+      {
+        std::stringstream ss;
+        DataOutBase::write_vtu_header(ss, vtk_flags);
+        header_size = ss.str().size();
+        // Write the header on rank 0 at the start of a file, i.e., offset 0.
+        ierr = Utilities::MPI::LargeCount::File_write_at_c(
+          fh, 0, ss.str().c_str(), header_size, MPI_CHAR, MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+
+    ierr = MPI_Bcast(&header_size, 1, MPI_UNSIGNED, 0, comm);
+    AssertThrowMPI(ierr);
+
+    {
+      // Use prefix sum to find specific offset to write at.
+      const std::uint64_t size_on_proc = piece.size();
+      std::uint64_t       prefix_sum   = 0;
+      ierr                             = MPI_Exscan(&size_on_proc,
+                        &prefix_sum,
+                        1,
+                        Utilities::MPI::mpi_type_id_for_type<std::uint64_t>,
+                        MPI_SUM,
+                        comm);
+      AssertThrowMPI(ierr);
+
+      // Locate specific offset for each processor.
+      const MPI_Offset offset =
+        static_cast<MPI_Offset>(header_size) + prefix_sum;
+
+      ierr = Utilities::MPI::LargeCount::File_write_at_all_c(fh,
+                                                             offset,
+                                                             piece.c_str(),
+                                                             piece.size(),
+                                                             MPI_CHAR,
+                                                             MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+
+      if (myrank == n_ranks - 1)
+        {
+          // Locating Footer with offset on last rank.
+          footer_offset = size_on_proc + offset;
+
+          std::stringstream ss;
+          DataOutBase::write_vtu_footer(ss);
+          const unsigned int footer_size = ss.str().size();
+
+          // Writing footer:
+          ierr = Utilities::MPI::LargeCount::File_write_at_c(fh,
+                                                             footer_offset,
+                                                             ss.str().c_str(),
+                                                             footer_size,
+                                                             MPI_CHAR,
+                                                             MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+    }
+
+    // Make sure we sync to disk. As written in the standard,
+    // MPI_File_close() actually already implies a sync but there seems
+    // to be a bug on at least one configuration (running with multiple
+    // nodes using OpenMPI 4.1) that requires it. Without this call, the
+    // footer is sometimes missing.
+    ierr = MPI_File_sync(fh);
+    AssertThrowMPI(ierr);
+
+    ierr = MPI_File_close(&fh);
+    AssertThrowMPI(ierr);
+  }
+} // namespace
+#endif
+
+
+
+template <int dim, int spacedim>
+std::string
+DataOutInterface<dim, spacedim>::create_vtu_piece_for_parallel_output(
+  const MPI_Comm comm) const
+{
+  const auto                   &patches      = get_patches();
+  const types::global_dof_index my_n_patches = patches.size();
+  const types::global_dof_index global_n_patches =
+    Utilities::MPI::sum(my_n_patches, comm);
+
+  // Do not write pieces with 0 cells as this will crash paraview if this is
+  // the first piece written. But if nobody has any pieces to write (file is
+  // empty), let processor 0 write their empty data, otherwise the vtk file is
+  // invalid.
+  std::stringstream ss;
+  if (my_n_patches > 0 ||
+      (global_n_patches == 0 && Utilities::MPI::this_mpi_process(comm) == 0))
+    DataOutBase::write_vtu_main(patches,
+                                get_dataset_names(),
+                                get_nonscalar_data_ranges(),
+                                vtk_flags,
+                                ss);
+
+  return ss.str();
+}
+
+
+
 template <int dim, int spacedim>
 void
 DataOutInterface<dim, spacedim>::write_vtu_in_parallel(
@@ -7809,115 +8022,115 @@ DataOutInterface<dim, spacedim>::write_vtu_in_parallel(
   AssertThrow(f, ExcFileNotOpen(filename));
   write_vtu(f);
 #else
+  write_vtu_pieces_in_parallel(filename,
+                               create_vtu_piece_for_parallel_output(comm),
+                               vtk_flags,
+                               comm);
+#endif
+}
 
+
+
+template <int dim, int spacedim>
+void
+DataOutInterface<dim, spacedim>::write_vtu_in_parallel(
+  const std::string &filename,
+  const MPI_Comm     comm,
+  const unsigned int n_aggregators) const
+{
+#ifndef DEAL_II_WITH_MPI
+  (void)n_aggregators;
+  write_vtu_in_parallel(filename, comm);
+#else
   const unsigned int myrank  = Utilities::MPI::this_mpi_process(comm);
   const unsigned int n_ranks = Utilities::MPI::n_mpi_processes(comm);
-  MPI_Info           info;
-  int                ierr = MPI_Info_create(&info);
-  AssertThrowMPI(ierr);
-  MPI_File fh;
-  ierr = MPI_File_open(
-    comm, filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, info, &fh);
-  AssertThrow(ierr == MPI_SUCCESS, ExcFileNotOpen(filename));
 
-  ierr = MPI_File_set_size(fh, 0); // delete the file contents
-  AssertThrowMPI(ierr);
-  // this barrier is necessary, because otherwise others might already write
-  // while one core is still setting the size to zero.
-  ierr = MPI_Barrier(comm);
-  AssertThrowMPI(ierr);
-  ierr = MPI_Info_free(&info);
+  // Split the processes into groups, each of which sends its data to one
+  // aggregator, the process with the lowest rank in the group. Either
+  // form one group per shared-memory node, or n_aggregators groups of
+  // consecutive ranks.
+  MPI_Comm comm_group;
+  int      ierr;
+  if (n_aggregators == 0)
+    ierr = MPI_Comm_split_type(
+      comm, MPI_COMM_TYPE_SHARED, myrank, MPI_INFO_NULL, &comm_group);
+  else
+    {
+      const std::uint64_t n_groups = std::min(n_aggregators, n_ranks);
+      const int color = static_cast<int>(n_groups * myrank / n_ranks);
+      ierr            = MPI_Comm_split(comm, color, myrank, &comm_group);
+    }
   AssertThrowMPI(ierr);
 
-  // Define header size so we can broadcast later.
-  unsigned int  header_size;
-  std::uint64_t footer_offset;
+  const unsigned int rank_in_group =
+    Utilities::MPI::this_mpi_process(comm_group);
+  const unsigned int group_size = Utilities::MPI::n_mpi_processes(comm_group);
+  const bool         is_aggregator = (rank_in_group == 0);
+
+  std::string piece = create_vtu_piece_for_parallel_output(comm);
+
+  // Collect the pieces of the group on the aggregator, concatenated in the
+  // order of the ranks.
+  const std::uint64_t        my_piece_size = piece.size();
+  std::vector<std::uint64_t> piece_sizes(is_aggregator ? group_size : 0);
+  ierr = MPI_Gather(&my_piece_size,
+                    1,
+                    Utilities::MPI::mpi_type_id_for_type<std::uint64_t>,
+                    piece_sizes.data(),
+                    1,
+                    Utilities::MPI::mpi_type_id_for_type<std::uint64_t>,
+                    0,
+                    comm_group);
+  AssertThrowMPI(ierr);
 
-  // write header
-  if (myrank == 0)
+  const int mpi_tag = Utilities::MPI::internal::Tags::
+    data_out_base_write_vtu_in_parallel_aggregated;
+  if (is_aggregator)
+    {
+      piece.resize(std::accumulate(piece_sizes.begin(),
+                                   piece_sizes.end(),
+                                   std::uint64_t(0)));
+      std::uint64_t position = my_piece_size;
+      for (unsigned int i = 1; i < group_size; ++i)
+        {
+          ierr = Utilities::MPI::LargeCount::Recv_c(piece.data() + position,
+                                                    piece_sizes[i],
+                                                    MPI_CHAR,
+                                                    i,
+                                                    mpi_tag,
+                                                    comm_group,
+                                                    MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+          position += piece_sizes[i];
+        }
+    }
+  else
     {
-      std::stringstream ss;
-      DataOutBase::write_vtu_header(ss, vtk_flags);
-      header_size = ss.str().size();
-      // Write the header on rank 0 at the start of a file, i.e., offset 0.
-      ierr = Utilities::MPI::LargeCount::File_write_at_c(
-        fh, 0, ss.str().c_str(), header_size, MPI_CHAR, MPI_STATUS_IGNORE);
+      ierr = Utilities::MPI::LargeCount::Send_c(
+        piece.data(), piece.size(), MPI_CHAR, 0, mpi_tag, comm_group);
       AssertThrowMPI(ierr);
     }
 
-  ierr = MPI_Bcast(&header_size, 1, MPI_UNSIGNED, 0, comm);
-  AssertThrowMPI(ierr);
-
-  {
-    const auto                   &patches      = get_patches();
-    const types::global_dof_index my_n_patches = patches.size();
-    const types::global_dof_index global_n_patches =
-      Utilities::MPI::sum(my_n_patches, comm);
-
-    // Do not write pieces with 0 cells as this will crash paraview if this is
-    // the first piece written. But if nobody has any pieces to write (file is
-    // empty), let processor 0 write their empty data, otherwise the vtk file is
-    // invalid.
-    std::stringstream ss;
-    if (my_n_patches > 0 || (global_n_patches == 0 && myrank == 0))
-      DataOutBase::write_vtu_main(patches,
-                                  get_dataset_names(),
-                                  get_nonscalar_data_ranges(),
-                                  vtk_flags,
-                                  ss);
-
-    // Use prefix sum to find specific offset to write at.
-    const std::uint64_t size_on_proc = ss.str().size();
-    std::uint64_t       prefix_sum   = 0;
-    ierr                             = MPI_Exscan(&size_on_proc,
-                      &prefix_sum,
-                      1,
-                      Utilities::MPI::mpi_type_id_for_type<std::uint64_t>,
-                      MPI_SUM,
-                      comm);
-    AssertThrowMPI(ierr);
-
-    // Locate specific offset for each processor.
-    const MPI_Offset offset = static_cast<MPI_Offset>(header_size) + prefix_sum;
-
-    ierr = Utilities::MPI::LargeCount::File_write_at_all_c(fh,
-                                                           offset,
-                                                           ss.str().c_str(),
-                                                           ss.str().size(),
-                                                           MPI_CHAR,
-                                                           MPI_STATUS_IGNORE);
-    AssertThrowMPI(ierr);
-
-    if (myrank == n_ranks - 1)
-      {
-        // Locating Footer with offset on last rank.
-        footer_offset = size_on_proc + offset;
+  Utilities::MPI::free_communicator(comm_group);
 
-        std::stringstream ss;
-        DataOutBase::write_vtu_footer(ss);
-        const unsigned int footer_size = ss.str().size();
-
-        // Writing footer:
-        ierr = Utilities::MPI::LargeCount::File_write_at_c(fh,
-                                                           footer_offset,
-                                                           ss.str().c_str(),
-                                                           footer_size,
-                                                           MPI_CHAR,
-                                                           MPI_STATUS_IGNORE);
-        AssertThrowMPI(ierr);
-      }
-  }
-
-  // Make sure we sync to disk. As written in the standard,
-  // MPI_File_close() actually already implies a sync but there seems
-  // to be a bug on at least one configuration (running with multiple
-  // nodes using OpenMPI 4.1) that requires it. Without this call, the
-  // footer is sometimes missing.
-  ierr = MPI_File_sync(fh);
+  // Only the aggregators take part in writing the file, each with one
+  // contiguous block. The other processes can return right away. The first
+  // process of comm is always an aggregator and hence writes the header.
+  MPI_Comm comm_aggregators;
+  ierr = MPI_Comm_split(comm,
+                        is_aggregator ? 0 : MPI_UNDEFINED,
+                        myrank,
+                        &comm_aggregators);
   AssertThrowMPI(ierr);
 
-  ierr = MPI_File_close(&fh);
-  AssertThrowMPI(ierr);
+  if (is_aggregator)
+    {
+      write_vtu_pieces_in_parallel(filename,
+                                   piece,
+                                   vtk_flags,
+                                   comm_aggregators);
+      Utilities::MPI::free_communicator(comm_aggregators);
+    }
 #endif
 }
 
@@ -19,6 +19,7 @@
 
 #include <boost/container/small_vector.hpp>
 
+#include <algorithm>
 #include <vector>
 
 #ifdef DEAL_II_WITH_TRILINOS
@@ -40,6 +41,51 @@ DEAL_II_NAMESPACE_OPEN
 
 
 
+namespace
+{
+  /**
+   * Given a sorted range of non-overlapping IndexSet::Range objects, return
+   * the first one that ends after @p index, i.e., the first range that may
+   * still contain @p index or an index after it. Rather than stepping through
+   * the ranges one at a time, we use an exponential ("galloping") search
+   * followed by a binary search. This is as fast as a linear walk if the
+   * sought range is close to @p first, but only takes a logarithmic number
+   * of steps if many ranges need to be skipped, as is the case when
+   * intersecting a small set with a large, fragmented one.
+   */
+  template <typename Iterator, typename SizeType>
+  Iterator
+  skip_ranges_ending_before(Iterator        first,
+                            const Iterator &last,
+                            const SizeType  index)
+  {
+    if (first == last || first->end > index)
+      return first;
+
+    // invariant: lower->end <= index
+    Iterator    lower = first;
+    Iterator    upper = last;
+    std::size_t step  = 1;
+    while (static_cast<std::size_t>(last - lower) > step)
+      {
+        const Iterator probe = lower + step;
+        if (probe->end > index)
+          {
+            upper = probe;
+            break;
+          }
+        lower = probe;
+        step *= 2;
+      }
+
+    return std::partition_point(lower + 1, upper, [index](const auto &range) {
+      return range.end <= index;
+    });
+  }
+} // namespace
+
+
+
 #ifdef DEAL_II_WITH_TRILINOS
 
 #  ifdef DEAL_II_TRILINOS_WITH_TPETRA
@@ -258,11 +304,11 @@ IndexSet::operator&(const IndexSet &is) const
   while ((r1 != ranges.end()) && (r2 != is.ranges.end()))
     {
       // if r1 and r2 do not overlap at all, then move the pointer that sits
-      // to the left of the other up by one
+      // to the left of the other up to the first range that might overlap
       if (r1->end <= r2->begin)
-        ++r1;
+        r1 = skip_ranges_ending_before(r1, ranges.cend(), r2->begin);
       else if (r2->end <= r1->begin)
-        ++r2;
+        r2 = skip_ranges_ending_before(r2, is.ranges.cend(), r1->begin);
       else
         {
           // the ranges must overlap somehow
@@ -511,17 +557,23 @@ IndexSet::subtract_set(const IndexSet &other)
 
   while (own_it != ranges.end() && other_it != other.ranges.end())
     {
-      // advance own iterator until we get an overlap
+      // advance own iterator until we get an overlap, copying all ranges in
+      // between in one go
       if (own_it->end <= other_it->begin)
         {
-          new_ranges.push_back(*own_it);
-          ++own_it;
+          const std::vector<Range>::iterator next =
+            skip_ranges_ending_before(own_it, ranges.end(), other_it->begin);
+          new_ranges.insert(new_ranges.end(), own_it, next);
+          own_it = next;
           continue;
         }
-      // we are done with other_it, so advance
+      // we are done with other_it, so advance to the first range of other
+      // that might overlap with own_it
       if (own_it->begin >= other_it->end)
         {
-          ++other_it;
+          other_it = skip_ranges_ending_before(other_it,
+                                               other.ranges.end(),
+                                               own_it->begin);
           continue;
         }
 
@@ -603,12 +655,39 @@ IndexSet::pop_front()
   const size_type index = ranges.front().begin;
   ++ranges.front().begin;
 
-  if (ranges.front().begin == ranges.front().end)
+  const bool front_is_empty = (ranges.front().begin == ranges.front().end);
+  if (front_is_empty)
     ranges.erase(ranges.begin());
 
-  // We have to set this in any case, because nth_index_in_set is no longer
-  // up to date for all but the first range
-  is_compressed = false;
+  // nth_index_in_set is no longer up to date for all but the first range. if
+  // the set was compressed before, update it (and the index of the largest
+  // range) in place rather than leaving that to a complete run of
+  // do_compress() on the next query
+  if (is_compressed)
+    {
+      for (auto range = ranges.begin() + (front_is_empty ? 0 : 1);
+           range != ranges.end();
+           ++range)
+        --range->nth_index_in_set;
+
+      if (largest_range > 0)
+        {
+          if (front_is_empty)
+            --largest_range;
+        }
+      else
+        {
+          // the first range was the largest one and has shrunk, so some
+          // other range might now be the largest one
+          size_type largest_range_size = 0;
+          for (unsigned int i = 0; i < ranges.size(); ++i)
+            if (ranges[i].end - ranges[i].begin > largest_range_size)
+              {
+                largest_range_size = ranges[i].end - ranges[i].begin;
+                largest_range      = i;
+              }
+        }
+    }
 
   return index;
 }
@@ -650,10 +729,21 @@ IndexSet::add_ranges_internal(
   // want to be in the other branch then.
   if (tmp_ranges.size() > 9)
     {
+      // the ranges are sorted by their first index, so we can merge
+      // overlapping and adjacent ones right away rather than inserting them
+      // one by one and leaving the merging to compress()
       IndexSet tmp_set(size());
       tmp_set.ranges.reserve(tmp_ranges.size());
       for (const auto &i : tmp_ranges)
-        tmp_set.add_range(i.first, i.second);
+        if (i.first == i.second)
+          continue;
+        else if (tmp_set.ranges.empty() ||
+                 i.first > tmp_set.ranges.back().end)
+          tmp_set.ranges.emplace_back(i.first, i.second);
+        else
+          tmp_set.ranges.back().end =
+            std::max(tmp_set.ranges.back().end, i.second);
+      tmp_set.is_compressed = false;
 
       // Case if we have zero or just one range: Add into the other set with
       // its indices, as that is cheaper
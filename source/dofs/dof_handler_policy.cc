@@ -13,6 +13,7 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi_tags.h>
 #include <deal.II/base/partitioner.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/types.h>
@@ -3517,109 +3518,328 @@ namespace internal
 
 
         /**
-         * A function that communicates the DoF indices from that subset of
-         * locally owned cells that have their user indices set to the
-         * corresponding ghost cells on other processors.
+         * A class that communicates the DoF indices of locally owned cells
+         * to the processors on which these cells are ghost cells.
          *
-         * This function makes use of the user flags in the following
-         * way:
-         * - On locally owned cells, the flag indicates whether we still
-         *   need to send the DoF indices to other processors on which
-         *   the current cell is a ghost. In phase 1, this is true for
-         *   all locally owned cells that are adjacent to ghost cells
-         *   in some way. In phase 2, this is only true if before phase
-         *   1 we did not know all dof indices yet
-         * - On ghost cells, the flag indicates whether we still expect
-         *   information to be sent to us. In phase 1, this is true for
-         *   all ghost cells. In phase 2, this is only true if we
-         *   did not receive a complete set of DoF indices in phase 1.
+         * The set of cells to exchange with each neighboring processor is
+         * determined once, in the constructor: every processor sends the
+         * CellIds of its ghost cells to their owners, which translate them
+         * into cell iterators. Each subsequent call to exchange() is then a
+         * single round of point-to-point messages containing nothing but the
+         * DoF indices of the relevant cells, in the agreed order. Neither
+         * side has to send the list of cells again, or to serialize the
+         * data.
+         *
+         * The function makes use of the cell marks in the following way:
+         * - On ghost cells, the mark indicates whether we still expect
+         *   information to be sent to us. In the first round, this has to be
+         *   true for all ghost cells. After each round, it is only true if
+         *   we did not receive a complete set of DoF indices.
+         * - On the sending side, the same information is kept in the form of
+         *   a flag for each requested cell that states whether the DoF
+         *   indices sent in the previous round contained invalid entries.
+         *   Only these cells are sent again in the next round. Since a
+         *   ghost cell receives a complete set of indices exactly if its
+         *   owner sent one, both sides agree on the cells of each round
+         *   without having to communicate about it.
          */
         template <int dim, int spacedim>
-        void
-        communicate_dof_indices_on_marked_cells(
-          const DoFHandler<dim, spacedim> &dof_handler,
-          std::vector<bool>               &cell_marked)
+        class GhostDoFIndexExchanger
+        {
+        public:
+          /**
+           * Set up the communication pattern by exchanging the CellIds of
+           * all ghost cells with their owners.
+           */
+          GhostDoFIndexExchanger(
+            const DoFHandler<dim, spacedim> &dof_handler);
+
+          /**
+           * Send the DoF indices of all locally owned cells that are ghost
+           * cells elsewhere and whose indices were not complete in the last
+           * round (or of all of them in the first round), and receive the
+           * ones of all marked ghost cells.
+           */
+          void
+          exchange(std::vector<bool> &cell_marked);
+
+        private:
+          using active_cell_iterator =
+            typename DoFHandler<dim, spacedim>::active_cell_iterator;
+
+          const DoFHandler<dim, spacedim> &dof_handler;
+
+          /**
+           * The owners of our ghost cells, and for each of them the ghost
+           * cells it owns.
+           */
+          std::vector<types::subdomain_id>               ghost_owners;
+          std::vector<std::vector<active_cell_iterator>> ghost_cells;
+
+          /**
+           * The processors that have ghost cells we own, and for each of
+           * them these cells along with the flag whether they need to be
+           * sent (again) in the next round.
+           */
+          std::vector<types::subdomain_id>               requesters;
+          std::vector<std::vector<active_cell_iterator>> requested_cells;
+          std::vector<std::vector<bool>>                 send_again;
+        };
+
+
+
+        template <int dim, int spacedim>
+        GhostDoFIndexExchanger<dim, spacedim>::GhostDoFIndexExchanger(
+          const DoFHandler<dim, spacedim> &dof_handler)
+          : dof_handler(dof_handler)
         {
 #  ifndef DEAL_II_WITH_MPI
-          (void)dof_handler;
           DEAL_II_NOT_IMPLEMENTED();
 #  else
+          const auto *tria = dynamic_cast<
+            const dealii::parallel::TriangulationBase<dim, spacedim> *>(
+            &dof_handler.get_triangulation());
+          Assert(tria != nullptr, ExcInternalError());
+          const MPI_Comm communicator = tria->get_mpi_communicator();
+
+          // the ghost layer is symmetric: the owners of our ghost cells are
+          // exactly the processors that have some of our cells as ghosts
+          for (const auto owner : tria->ghost_owners())
+            ghost_owners.push_back(owner);
+          ghost_cells.resize(ghost_owners.size());
+          for (const auto &cell : dof_handler.active_cell_iterators())
+            if (cell->is_ghost())
+              {
+                const auto position = std::lower_bound(ghost_owners.begin(),
+                                                       ghost_owners.end(),
+                                                       cell->subdomain_id());
+                Assert(position != ghost_owners.end() &&
+                         *position == cell->subdomain_id(),
+                       ExcInternalError());
+                ghost_cells[position - ghost_owners.begin()].push_back(cell);
+              }
 
-          // define functions that pack data on cells that are ghost cells
-          // somewhere else, and unpack data on cells where we get information
-          // from elsewhere
-          const auto pack = [](const auto &cell) {
-            Assert(cell->is_locally_owned(), ExcInternalError());
+          const int mpi_tag = Utilities::MPI::internal::Tags::
+            dof_handler_policy_exchange_ghost_cells;
 
-            std::vector<dealii::types::global_dof_index> data(
-              cell->get_fe().n_dofs_per_cell());
+          std::vector<std::vector<CellId::binary_type>> cell_ids(
+            ghost_owners.size());
+          std::vector<MPI_Request> requests(ghost_owners.size());
+          for (unsigned int i = 0; i < ghost_owners.size(); ++i)
+            {
+              cell_ids[i].reserve(ghost_cells[i].size());
+              for (const auto &cell : ghost_cells[i])
+                cell_ids[i].push_back(
+                  cell->id().template to_binary<spacedim>());
+
+              const int ierr =
+                MPI_Isend(cell_ids[i].data(),
+                          cell_ids[i].size() * sizeof(CellId::binary_type),
+                          MPI_BYTE,
+                          ghost_owners[i],
+                          mpi_tag,
+                          communicator,
+                          &requests[i]);
+              AssertThrowMPI(ierr);
+            }
 
-            // bypass the cache which is not filled yet
-            internal::DoFAccessorImplementation::Implementation::
-              get_dof_indices(*cell, data, cell->active_fe_index());
+          requesters.resize(ghost_owners.size());
+          requested_cells.resize(ghost_owners.size());
+          send_again.resize(ghost_owners.size());
+          std::vector<CellId::binary_type> received_ids;
+          for (unsigned int i = 0; i < ghost_owners.size(); ++i)
+            {
+              MPI_Status status;
+              int        ierr =
+                MPI_Probe(MPI_ANY_SOURCE, mpi_tag, communicator, &status);
+              AssertThrowMPI(ierr);
 
-            return data;
-          };
+              int len;
+              ierr = MPI_Get_count(&status, MPI_BYTE, &len);
+              AssertThrowMPI(ierr);
+              Assert(len % sizeof(CellId::binary_type) == 0,
+                     ExcInternalError());
 
-          const auto unpack = [&cell_marked](const auto &cell,
-                                             const auto &dofs) {
-            Assert(cell->get_fe().n_dofs_per_cell() == dofs.size(),
-                   ExcInternalError());
+              received_ids.resize(len / sizeof(CellId::binary_type));
+              ierr = MPI_Recv(received_ids.data(),
+                              len,
+                              MPI_BYTE,
+                              status.MPI_SOURCE,
+                              status.MPI_TAG,
+                              communicator,
+                              MPI_STATUS_IGNORE);
+              AssertThrowMPI(ierr);
 
-            Assert(cell->is_ghost(), ExcInternalError());
+              requesters[i] = status.MPI_SOURCE;
+              requested_cells[i].reserve(received_ids.size());
+              for (const auto &id : received_ids)
+                {
+                  const auto cell = tria->create_cell_iterator(CellId(id));
+                  requested_cells[i].emplace_back(tria,
+                                                  cell->level(),
+                                                  cell->index(),
+                                                  &dof_handler);
+                  Assert(requested_cells[i].back()->is_locally_owned(),
+                         ExcInternalError());
+                }
+              send_again[i].assign(received_ids.size(), true);
+            }
 
-            // Use a combined read/set function on the entities of the dof
-            // indices to speed things up against get_dof_indices +
-            // set_dof_indices
-            bool complete = true;
-            DoFAccessorImplementation::Implementation::process_dof_indices(
-              *cell,
-              dofs,
-              cell->active_fe_index(),
-              DoFAccessorImplementation::Implementation::
-                DoFIndexProcessor<dim, spacedim>(),
+          if (requests.size() > 0)
+            {
+              const int ierr = MPI_Waitall(requests.size(),
+                                           requests.data(),
+                                           MPI_STATUSES_IGNORE);
+              AssertThrowMPI(ierr);
+            }
+#  endif
+        }
 
-              // Intel ICC 18 and earlier for some reason believe that
-              // numbers::invalid_dof_index is not a valid object
-              // inside the lambda function. Fix this by creating a
-              // local variable initialized by the global one.
-              //
-              // Intel ICC 19 and earlier have trouble with our Assert
-              // macros inside the lambda function. We disable the macro
-              // for these compilers.
-              [&complete, invalid_dof_index = numbers::invalid_dof_index](
-                auto &stored_index, const auto received_index) {
-                if (*received_index != invalid_dof_index)
+
+
+        template <int dim, int spacedim>
+        void
+        GhostDoFIndexExchanger<dim, spacedim>::exchange(
+          std::vector<bool> &cell_marked)
+        {
+#  ifndef DEAL_II_WITH_MPI
+          (void)cell_marked;
+          DEAL_II_NOT_IMPLEMENTED();
+#  else
+          const MPI_Comm communicator =
+            dof_handler.get_triangulation().get_mpi_communicator();
+          const int mpi_tag = Utilities::MPI::internal::Tags::
+            dof_handler_policy_exchange_dof_indices;
+
+          // post the receives for all marked ghost cells; both sides know
+          // the finite element on each cell and thus the size of each message
+          std::vector<std::vector<types::global_dof_index>> receive_buffers(
+            ghost_owners.size());
+          std::vector<MPI_Request> receive_requests;
+          receive_requests.reserve(ghost_owners.size());
+          for (unsigned int i = 0; i < ghost_owners.size(); ++i)
+            {
+              std::size_t size = 0;
+              for (const auto &cell : ghost_cells[i])
+                if (cell_marked[cell->active_cell_index()])
+                  size += cell->get_fe().n_dofs_per_cell();
+              if (size == 0)
+                continue;
+
+              receive_buffers[i].resize(size);
+              receive_requests.emplace_back();
+              const int ierr = MPI_Irecv(
+                receive_buffers[i].data(),
+                size,
+                Utilities::MPI::mpi_type_id_for_type<types::global_dof_index>,
+                ghost_owners[i],
+                mpi_tag,
+                communicator,
+                &receive_requests.back());
+              AssertThrowMPI(ierr);
+            }
+
+          // pack and send the DoF indices of the requested cells, bypassing
+          // the cache which is not filled yet
+          std::vector<std::vector<types::global_dof_index>> send_buffers(
+            requesters.size());
+          std::vector<MPI_Request> send_requests;
+          send_requests.reserve(requesters.size());
+          std::vector<types::global_dof_index> dof_indices;
+          for (unsigned int i = 0; i < requesters.size(); ++i)
+            {
+              for (unsigned int c = 0; c < requested_cells[i].size(); ++c)
+                if (send_again[i][c])
                   {
-#    if !defined(__INTEL_COMPILER) || __INTEL_COMPILER >= 1900
-                    Assert((stored_index == invalid_dof_index) ||
-                             (stored_index == *received_index),
-                           ExcInternalError());
-#    endif
-                    stored_index = *received_index;
+                    const auto &cell = requested_cells[i][c];
+                    dof_indices.resize(cell->get_fe().n_dofs_per_cell());
+                    internal::DoFAccessorImplementation::Implementation::
+                      get_dof_indices(*cell,
+                                      dof_indices,
+                                      cell->active_fe_index());
+                    send_again[i][c] =
+                      std::find(dof_indices.begin(),
+                                dof_indices.end(),
+                                numbers::invalid_dof_index) !=
+                      dof_indices.end();
+                    send_buffers[i].insert(send_buffers[i].end(),
+                                           dof_indices.begin(),
+                                           dof_indices.end());
                   }
-                else
-                  complete = false;
-              },
-              false);
+              if (send_buffers[i].empty())
+                continue;
 
-            if (!complete)
-              {
-                // We should have the cell already marked
-                Assert(cell_marked[cell->active_cell_index()],
-                       ExcInternalError());
-              }
-            else
-              cell_marked[cell->active_cell_index()] = false;
-          };
+              send_requests.emplace_back();
+              const int ierr = MPI_Isend(
+                send_buffers[i].data(),
+                send_buffers[i].size(),
+                Utilities::MPI::mpi_type_id_for_type<types::global_dof_index>,
+                requesters[i],
+                mpi_tag,
+                communicator,
+                &send_requests.back());
+              AssertThrowMPI(ierr);
+            }
 
-          const auto filter = [&cell_marked](const auto &cell) {
-            return cell_marked[cell->active_cell_index()];
-          };
+          if (receive_requests.size() > 0)
+            {
+              const int ierr = MPI_Waitall(receive_requests.size(),
+                                           receive_requests.data(),
+                                           MPI_STATUSES_IGNORE);
+              AssertThrowMPI(ierr);
+            }
 
-          GridTools::exchange_cell_data_to_ghosts<
-            std::vector<types::global_dof_index>,
-            DoFHandler<dim, spacedim>>(dof_handler, pack, unpack, filter);
+          // unpack the received indices into the ghost cells. Use a combined
+          // read/set function on the entities of the dof indices to speed
+          // things up against get_dof_indices + set_dof_indices
+          for (unsigned int i = 0; i < ghost_owners.size(); ++i)
+            {
+              auto received = receive_buffers[i].cbegin();
+              for (const auto &cell : ghost_cells[i])
+                if (cell_marked[cell->active_cell_index()])
+                  {
+                    const unsigned int n_dofs =
+                      cell->get_fe().n_dofs_per_cell();
+                    dof_indices.assign(received, received + n_dofs);
+                    received += n_dofs;
+
+                    bool complete = true;
+                    DoFAccessorImplementation::Implementation::
+                      process_dof_indices(
+                        *cell,
+                        dof_indices,
+                        cell->active_fe_index(),
+                        DoFAccessorImplementation::Implementation::
+                          DoFIndexProcessor<dim, spacedim>(),
+                        [&complete](auto &stored_index,
+                                    const auto received_index) {
+                          if (*received_index != numbers::invalid_dof_index)
+                            {
+                              Assert((stored_index ==
+                                      numbers::invalid_dof_index) ||
+                                       (stored_index == *received_index),
+                                     ExcInternalError());
+                              stored_index = *received_index;
+                            }
+                          else
+                            complete = false;
+                        },
+                        false);
+
+                    if (complete)
+                      cell_marked[cell->active_cell_index()] = false;
+                  }
+              Assert(received == receive_buffers[i].cend(),
+                     ExcInternalError());
+            }
+
+          if (send_requests.size() > 0)
+            {
+              const int ierr = MPI_Waitall(send_requests.size(),
+                                           send_requests.data(),
+                                           MPI_STATUSES_IGNORE);
+              AssertThrowMPI(ierr);
+            }
 #  endif
         }
 
@@ -3775,13 +3995,16 @@ namespace internal
             if (cell->is_ghost())
               cell_marked[cell->active_cell_index()] = true;
 
-          // Send and receive cells. After this, only the local cells
-          // are marked, that received new data. This has to be
-          // communicated in a second communication step.
+          // Send and receive cells. After this, only the ghost cells
+          // are marked that did not receive a complete set of indices.
+          // This has to be communicated in a second communication step.
           //
           // as explained in the 'distributed' paper, this has to be
-          // done twice
-          communicate_dof_indices_on_marked_cells(*dof_handler, cell_marked);
+          // done twice. the exchanger agrees on the cells to send with
+          // each neighbor only once, so the second round only consists of
+          // the DoF indices of the cells that are still incomplete
+          GhostDoFIndexExchanger<dim, spacedim> exchanger(*dof_handler);
+          exchanger.exchange(cell_marked);
 
           // If the DoFHandler has hp-capabilities enabled, then we may have
           // received valid indices of degrees of freedom that are dominated
@@ -3794,7 +4017,7 @@ namespace internal
           //                    DoF indices set. however, some ghost cells
           //                    may still have invalid ones. thus, exchange
           //                    one more time.
-          communicate_dof_indices_on_marked_cells(*dof_handler, cell_marked);
+          exchanger.exchange(cell_marked);
 
           // at this point, we must have taken care of the data transfer
           // on all cells we had previously marked. verify this
@@ -4132,13 +4355,16 @@ namespace internal
             if (cell->is_ghost())
               cell_marked[cell->active_cell_index()] = true;
 
-          // Send and receive cells. After this, only the local cells
-          // are marked, that received new data. This has to be
-          // communicated in a second communication step.
+          // Send and receive cells. After this, only the ghost cells
+          // are marked that did not receive a complete set of indices.
+          // This has to be communicated in a second communication step.
           //
           // as explained in the 'distributed' paper, this has to be
-          // done twice
-          communicate_dof_indices_on_marked_cells(*dof_handler, cell_marked);
+          // done twice. the exchanger agrees on the cells to send with
+          // each neighbor only once, so the second round only consists of
+          // the DoF indices of the cells that are still incomplete
+          GhostDoFIndexExchanger<dim, spacedim> exchanger(*dof_handler);
+          exchanger.exchange(cell_marked);
 
           // if the DoFHandler has hp-capabilities then we may have
           // received valid indices of degrees of freedom that are
@@ -4148,7 +4374,7 @@ namespace internal
           Implementation::merge_invalid_dof_indices_on_ghost_interfaces(
             *dof_handler);
 
-          communicate_dof_indices_on_marked_cells(*dof_handler, cell_marked);
+          exchanger.exchange(cell_marked);
         }
 
         NumberCache number_cache;
@@ -59,6 +59,7 @@
 #include <cmath>
 #include <functional>
 #include <map>
+#include <numeric>
 #include <vector>
 
 
@@ -389,249 +390,328 @@ namespace DoFRenumbering
 
 
 
-  template <int dim, int spacedim>
-  void
-  compute_Cuthill_McKee(
-    std::vector<types::global_dof_index>       &new_indices,
-    const DoFHandler<dim, spacedim>            &dof_handler,
-    const bool                                  reversed_numbering,
-    const bool                                  use_constraints,
-    const std::vector<types::global_dof_index> &starting_indices,
-    const unsigned int                          level)
+  namespace
   {
-    const bool reorder_level_dofs =
-      (level == numbers::invalid_unsigned_int) ? false : true;
-
-    // see if there is anything to do at all or whether we can skip the work on
-    // this processor
-    if (dof_handler.locally_owned_dofs().n_elements() == 0)
-      {
-        Assert(new_indices.empty(), ExcInternalError());
-        return;
-      }
-
-    // make the connection graph
-    //
-    // note that if constraints are not requested, then the 'constraints'
-    // object will be empty and using it has no effect
-    if (reorder_level_dofs == true)
-      Assert(dof_handler.n_dofs(level) != numbers::invalid_dof_index,
-             ExcDoFHandlerNotInitialized());
-
-    const IndexSet locally_relevant_dofs =
-      (reorder_level_dofs == false ?
-         DoFTools::extract_locally_relevant_dofs(dof_handler) :
-         DoFTools::extract_locally_relevant_level_dofs(dof_handler, level));
-    const IndexSet &locally_owned_dofs =
-      (reorder_level_dofs == false ? dof_handler.locally_owned_dofs() :
-                                     dof_handler.locally_owned_mg_dofs(level));
+    /**
+     * Build the connectivity graph of the (locally owned or locally active)
+     * degrees of freedom of @p dof_handler, let @p reorder compute a
+     * renumbering of this graph, and translate the result back into the
+     * global index space. This is the common part of compute_Cuthill_McKee()
+     * and compute_reverse_Cuthill_McKee().
+     */
+    template <int dim, int spacedim, typename ReorderFunction>
+    void
+    compute_graph_renumbering(
+      std::vector<types::global_dof_index>       &new_indices,
+      const DoFHandler<dim, spacedim>            &dof_handler,
+      const bool                                  use_constraints,
+      const std::vector<types::global_dof_index> &starting_indices,
+      const unsigned int                          level,
+      const ReorderFunction                      &reorder)
+    {
+      const bool reorder_level_dofs =
+        (level == numbers::invalid_unsigned_int) ? false : true;
 
-    AffineConstraints<double> constraints;
-    if (use_constraints)
-      {
-        // reordering with constraints is not yet implemented on a level basis
-        Assert(reorder_level_dofs == false, ExcNotImplemented());
+      // see if there is anything to do at all or whether we can skip the
+      // work on this processor
+      if (dof_handler.locally_owned_dofs().n_elements() == 0)
+        {
+          Assert(new_indices.empty(), ExcInternalError());
+          return;
+        }
 
-        constraints.reinit(locally_owned_dofs, locally_relevant_dofs);
-        DoFTools::make_hanging_node_constraints(dof_handler, constraints);
-      }
-    constraints.close();
+      // make the connection graph
+      //
+      // note that if constraints are not requested, then the 'constraints'
+      // object will be empty and using it has no effect
+      if (reorder_level_dofs == true)
+        Assert(dof_handler.n_dofs(level) != numbers::invalid_dof_index,
+               ExcDoFHandlerNotInitialized());
+
+      const IndexSet locally_relevant_dofs =
+        (reorder_level_dofs == false ?
+           DoFTools::extract_locally_relevant_dofs(dof_handler) :
+           DoFTools::extract_locally_relevant_level_dofs(dof_handler, level));
+      const IndexSet &locally_owned_dofs =
+        (reorder_level_dofs == false ?
+           dof_handler.locally_owned_dofs() :
+           dof_handler.locally_owned_mg_dofs(level));
+
+      AffineConstraints<double> constraints;
+      if (use_constraints)
+        {
+          // reordering with constraints is not yet implemented on a level basis
+          Assert(reorder_level_dofs == false, ExcNotImplemented());
 
-    // see if we can get away with the sequential algorithm
-    if (locally_owned_dofs.n_elements() == locally_owned_dofs.size())
-      {
-        AssertDimension(new_indices.size(), locally_owned_dofs.n_elements());
+          constraints.reinit(locally_owned_dofs, locally_relevant_dofs);
+          DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+        }
+      constraints.close();
 
-        DynamicSparsityPattern dsp(locally_owned_dofs.size(),
-                                   locally_owned_dofs.size());
-        if (reorder_level_dofs == false)
-          {
-            DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints);
-          }
-        else
-          {
-            MGTools::make_sparsity_pattern(dof_handler, dsp, level);
-          }
+      // see if we can get away with the sequential algorithm
+      if (locally_owned_dofs.n_elements() == locally_owned_dofs.size())
+        {
+          AssertDimension(new_indices.size(), locally_owned_dofs.n_elements());
 
-        SparsityTools::reorder_Cuthill_McKee(dsp,
-                                             new_indices,
-                                             starting_indices);
-        if (reversed_numbering)
-          new_indices = Utilities::reverse_permutation(new_indices);
-      }
-    else
-      {
-        // we are in the parallel case where we need to work in the
-        // local index space, i.e., the locally owned part of the
-        // sparsity pattern.
-        //
-        // first figure out whether the user only gave us starting
-        // indices that are locally owned, or that are only locally
-        // relevant. in the process, also check that all indices
-        // really belong to at least the locally relevant ones
-        const IndexSet locally_active_dofs =
-          (reorder_level_dofs == false ?
-             DoFTools::extract_locally_active_dofs(dof_handler) :
-             DoFTools::extract_locally_active_level_dofs(dof_handler, level));
-
-        bool needs_locally_active = false;
-        for (const auto starting_index : starting_indices)
-          {
-            if ((needs_locally_active ==
-                 /* previously already set to */ true) ||
-                (locally_owned_dofs.is_element(starting_index) == false))
-              {
-                Assert(
-                  locally_active_dofs.is_element(starting_index),
-                  ExcMessage(
-                    "You specified global degree of freedom " +
-                    std::to_string(starting_index) +
-                    " as a starting index, but this index is not among the "
-                    "locally active ones on this processor, as required "
-                    "for this function."));
-                needs_locally_active = true;
-              }
-          }
+          DynamicSparsityPattern dsp(locally_owned_dofs.size(),
+                                     locally_owned_dofs.size());
+          if (reorder_level_dofs == false)
+            {
+              DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints);
+            }
+          else
+            {
+              MGTools::make_sparsity_pattern(dof_handler, dsp, level);
+            }
 
-        const IndexSet index_set_to_use =
-          (needs_locally_active ? locally_active_dofs : locally_owned_dofs);
+          reorder(dsp, new_indices, starting_indices);
+        }
+      else
+        {
+          // we are in the parallel case where we need to work in the
+          // local index space, i.e., the locally owned part of the
+          // sparsity pattern.
+          //
+          // first figure out whether the user only gave us starting
+          // indices that are locally owned, or that are only locally
+          // relevant. in the process, also check that all indices
+          // really belong to at least the locally relevant ones
+          const IndexSet locally_active_dofs =
+            (reorder_level_dofs == false ?
+               DoFTools::extract_locally_active_dofs(dof_handler) :
+               DoFTools::extract_locally_active_level_dofs(dof_handler, level));
+
+          bool needs_locally_active = false;
+          for (const auto starting_index : starting_indices)
+            {
+              if ((needs_locally_active ==
+                   /* previously already set to */ true) ||
+                  (locally_owned_dofs.is_element(starting_index) == false))
+                {
+                  Assert(
+                    locally_active_dofs.is_element(starting_index),
+                    ExcMessage(
+                      "You specified global degree of freedom " +
+                      std::to_string(starting_index) +
+                      " as a starting index, but this index is not among the "
+                      "locally active ones on this processor, as required "
+                      "for this function."));
+                  needs_locally_active = true;
+                }
+            }
 
-        // if this process doesn't own any DoFs (on this level), there is
-        // nothing to do
-        if (index_set_to_use.n_elements() == 0)
-          return;
+          const IndexSet index_set_to_use =
+            (needs_locally_active ? locally_active_dofs : locally_owned_dofs);
+
+          // if this process doesn't own any DoFs (on this level), there is
+          // nothing to do
+          if (index_set_to_use.n_elements() == 0)
+            return;
+
+          // then create first the global sparsity pattern, and then the local
+          // sparsity pattern from the global one by transferring its indices to
+          // processor-local (locally owned or locally active) index space
+          DynamicSparsityPattern dsp(index_set_to_use.size(),
+                                     index_set_to_use.size(),
+                                     index_set_to_use);
+          if (reorder_level_dofs == false)
+            {
+              DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints);
+            }
+          else
+            {
+              MGTools::make_sparsity_pattern(dof_handler, dsp, level);
+            }
 
-        // then create first the global sparsity pattern, and then the local
-        // sparsity pattern from the global one by transferring its indices to
-        // processor-local (locally owned or locally active) index space
-        DynamicSparsityPattern dsp(index_set_to_use.size(),
-                                   index_set_to_use.size(),
-                                   index_set_to_use);
-        if (reorder_level_dofs == false)
-          {
-            DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints);
-          }
-        else
-          {
-            MGTools::make_sparsity_pattern(dof_handler, dsp, level);
-          }
+          DynamicSparsityPattern local_sparsity(index_set_to_use.n_elements(),
+                                                index_set_to_use.n_elements());
+          std::vector<types::global_dof_index> row_entries;
+          for (unsigned int i = 0; i < index_set_to_use.n_elements(); ++i)
+            {
+              const types::global_dof_index row =
+                index_set_to_use.nth_index_in_set(i);
+              const unsigned int row_length = dsp.row_length(row);
+              row_entries.clear();
+              for (unsigned int j = 0; j < row_length; ++j)
+                {
+                  // index_within_set() returns an invalid index for indices
+                  // not in the set, so there is no need to also ask
+                  // is_element() for each entry
+                  const types::global_dof_index col =
+                    dsp.column_number(row, j);
+                  const types::global_dof_index local_col =
+                    index_set_to_use.index_within_set(col);
+                  if (col != row && local_col != numbers::invalid_dof_index)
+                    row_entries.push_back(local_col);
+                }
+              local_sparsity.add_entries(i,
+                                         row_entries.begin(),
+                                         row_entries.end(),
+                                         true);
+            }
 
-        DynamicSparsityPattern local_sparsity(index_set_to_use.n_elements(),
-                                              index_set_to_use.n_elements());
-        std::vector<types::global_dof_index> row_entries;
-        for (unsigned int i = 0; i < index_set_to_use.n_elements(); ++i)
-          {
-            const types::global_dof_index row =
-              index_set_to_use.nth_index_in_set(i);
-            const unsigned int row_length = dsp.row_length(row);
-            row_entries.clear();
-            for (unsigned int j = 0; j < row_length; ++j)
-              {
-                const unsigned int col = dsp.column_number(row, j);
-                if (col != row && index_set_to_use.is_element(col))
-                  row_entries.push_back(index_set_to_use.index_within_set(col));
-              }
-            local_sparsity.add_entries(i,
-                                       row_entries.begin(),
-                                       row_entries.end(),
-                                       true);
-          }
+          // translate starting indices from global to local indices
+          std::vector<types::global_dof_index> local_starting_indices(
+            starting_indices.size());
+          for (unsigned int i = 0; i < starting_indices.size(); ++i)
+            local_starting_indices[i] =
+              index_set_to_use.index_within_set(starting_indices[i]);
+
+          // then do the renumbering on the locally owned portion
+          AssertDimension(new_indices.size(), locally_owned_dofs.n_elements());
+          std::vector<types::global_dof_index> my_new_indices(
+            index_set_to_use.n_elements());
+          reorder(local_sparsity, my_new_indices, local_starting_indices);
+
+          // now that we have a re-enumeration of all DoFs, we need to throw
+          // out the ones that are not locally owned in case we have worked
+          // with the locally active ones. that's because the renumbering
+          // functions only want new indices for the locally owned DoFs (other
+          // processors are responsible for renumbering the ones that are
+          // on cell interfaces)
+          if (needs_locally_active == true)
+            {
+              // first step: figure out which DoF indices to eliminate
+              IndexSet active_but_not_owned_dofs = locally_active_dofs;
+              active_but_not_owned_dofs.subtract_set(locally_owned_dofs);
 
-        // translate starting indices from global to local indices
-        std::vector<types::global_dof_index> local_starting_indices(
-          starting_indices.size());
-        for (unsigned int i = 0; i < starting_indices.size(); ++i)
-          local_starting_indices[i] =
-            index_set_to_use.index_within_set(starting_indices[i]);
-
-        // then do the renumbering on the locally owned portion
-        AssertDimension(new_indices.size(), locally_owned_dofs.n_elements());
-        std::vector<types::global_dof_index> my_new_indices(
-          index_set_to_use.n_elements());
-        SparsityTools::reorder_Cuthill_McKee(local_sparsity,
-                                             my_new_indices,
-                                             local_starting_indices);
-        if (reversed_numbering)
-          my_new_indices = Utilities::reverse_permutation(my_new_indices);
-
-        // now that we have a re-enumeration of all DoFs, we need to throw
-        // out the ones that are not locally owned in case we have worked
-        // with the locally active ones. that's because the renumbering
-        // functions only want new indices for the locally owned DoFs (other
-        // processors are responsible for renumbering the ones that are
-        // on cell interfaces)
-        if (needs_locally_active == true)
-          {
-            // first step: figure out which DoF indices to eliminate
-            IndexSet active_but_not_owned_dofs = locally_active_dofs;
-            active_but_not_owned_dofs.subtract_set(locally_owned_dofs);
+              std::set<types::global_dof_index> erase_these_indices;
+              for (const auto p : active_but_not_owned_dofs)
+                {
+                  const auto index = index_set_to_use.index_within_set(p);
+                  Assert(index < index_set_to_use.n_elements(),
+                         ExcInternalError());
+                  erase_these_indices.insert(my_new_indices[index]);
+                  my_new_indices[index] = numbers::invalid_dof_index;
+                }
+              Assert(erase_these_indices.size() ==
+                       active_but_not_owned_dofs.n_elements(),
+                     ExcInternalError());
+              Assert(static_cast<unsigned int>(
+                       std::count(my_new_indices.begin(),
+                                  my_new_indices.end(),
+                                  numbers::invalid_dof_index)) ==
+                       active_but_not_owned_dofs.n_elements(),
+                     ExcInternalError());
 
-            std::set<types::global_dof_index> erase_these_indices;
-            for (const auto p : active_but_not_owned_dofs)
+              // then compute a renumbering of the remaining ones
+              std::vector<types::global_dof_index> translate_indices(
+                my_new_indices.size());
               {
-                const auto index = index_set_to_use.index_within_set(p);
-                Assert(index < index_set_to_use.n_elements(),
+                std::set<types::global_dof_index>::const_iterator
+                  next_erased_index = erase_these_indices.begin();
+                types::global_dof_index next_new_index = 0;
+                for (unsigned int i = 0; i < translate_indices.size(); ++i)
+                  if ((next_erased_index != erase_these_indices.end()) &&
+                      (*next_erased_index == i))
+                    {
+                      translate_indices[i] = numbers::invalid_dof_index;
+                      ++next_erased_index;
+                    }
+                  else
+                    {
+                      translate_indices[i] = next_new_index;
+                      ++next_new_index;
+                    }
+                Assert(next_new_index == locally_owned_dofs.n_elements(),
                        ExcInternalError());
-                erase_these_indices.insert(my_new_indices[index]);
-                my_new_indices[index] = numbers::invalid_dof_index;
               }
-            Assert(erase_these_indices.size() ==
-                     active_but_not_owned_dofs.n_elements(),
-                   ExcInternalError());
-            Assert(static_cast<unsigned int>(
-                     std::count(my_new_indices.begin(),
-                                my_new_indices.end(),
-                                numbers::invalid_dof_index)) ==
-                     active_but_not_owned_dofs.n_elements(),
-                   ExcInternalError());
 
-            // then compute a renumbering of the remaining ones
-            std::vector<types::global_dof_index> translate_indices(
-              my_new_indices.size());
-            {
-              std::set<types::global_dof_index>::const_iterator
-                next_erased_index = erase_these_indices.begin();
-              types::global_dof_index next_new_index = 0;
-              for (unsigned int i = 0; i < translate_indices.size(); ++i)
-                if ((next_erased_index != erase_these_indices.end()) &&
-                    (*next_erased_index == i))
+              // and then do the renumbering of the result of the
+              // Cuthill-McKee algorithm above, right into the output array
+              new_indices.clear();
+              new_indices.reserve(locally_owned_dofs.n_elements());
+              for (const auto &p : my_new_indices)
+                if (p != numbers::invalid_dof_index)
                   {
-                    translate_indices[i] = numbers::invalid_dof_index;
-                    ++next_erased_index;
+                    Assert(translate_indices[p] != numbers::invalid_dof_index,
+                           ExcInternalError());
+                    new_indices.push_back(translate_indices[p]);
                   }
-                else
-                  {
-                    translate_indices[i] = next_new_index;
-                    ++next_new_index;
-                  }
-              Assert(next_new_index == locally_owned_dofs.n_elements(),
+              Assert(new_indices.size() == locally_owned_dofs.n_elements(),
                      ExcInternalError());
             }
+          else
+            new_indices = std::move(my_new_indices);
+
+          // convert indices back to global index space. in both of the branches
+          // above, we ended up with new_indices only containing the local
+          // indices of the locally-owned DoFs. so that's where we get the
+          // indices
+          for (types::global_dof_index &new_index : new_indices)
+            new_index = locally_owned_dofs.nth_index_in_set(new_index);
+        }
+    }
+  } // namespace
 
-            // and then do the renumbering of the result of the
-            // Cuthill-McKee algorithm above, right into the output array
-            new_indices.clear();
-            new_indices.reserve(locally_owned_dofs.n_elements());
-            for (const auto &p : my_new_indices)
-              if (p != numbers::invalid_dof_index)
-                {
-                  Assert(translate_indices[p] != numbers::invalid_dof_index,
-                         ExcInternalError());
-                  new_indices.push_back(translate_indices[p]);
-                }
-            Assert(new_indices.size() == locally_owned_dofs.n_elements(),
-                   ExcInternalError());
-          }
-        else
-          new_indices = std::move(my_new_indices);
-
-        // convert indices back to global index space. in both of the branches
-        // above, we ended up with new_indices only containing the local
-        // indices of the locally-owned DoFs. so that's where we get the
-        // indices
-        for (types::global_dof_index &new_index : new_indices)
-          new_index = locally_owned_dofs.nth_index_in_set(new_index);
-      }
+
+
+  template <int dim, int spacedim>
+  void
+  compute_Cuthill_McKee(
+    std::vector<types::global_dof_index>       &new_indices,
+    const DoFHandler<dim, spacedim>            &dof_handler,
+    const bool                                  reversed_numbering,
+    const bool                                  use_constraints,
+    const std::vector<types::global_dof_index> &starting_indices,
+    const unsigned int                          level)
+  {
+    compute_graph_renumbering(
+      new_indices,
+      dof_handler,
+      use_constraints,
+      starting_indices,
+      level,
+      [reversed_numbering](
+        const DynamicSparsityPattern               &graph,
+        std::vector<types::global_dof_index>       &graph_indices,
+        const std::vector<types::global_dof_index> &graph_starting_indices) {
+        SparsityTools::reorder_Cuthill_McKee(graph,
+                                             graph_indices,
+                                             graph_starting_indices);
+        if (reversed_numbering)
+          graph_indices = Utilities::reverse_permutation(graph_indices);
+      });
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  reverse_Cuthill_McKee(DoFHandler<dim, spacedim> &dof_handler,
+                        const bool                 use_constraints)
+  {
+    std::vector<types::global_dof_index> renumbering(
+      dof_handler.locally_owned_dofs().n_elements(),
+      numbers::invalid_dof_index);
+    compute_reverse_Cuthill_McKee(renumbering, dof_handler, use_constraints);
+
+    dof_handler.renumber_dofs(renumbering);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_reverse_Cuthill_McKee(
+    std::vector<types::global_dof_index> &new_indices,
+    const DoFHandler<dim, spacedim>      &dof_handler,
+    const bool                            use_constraints,
+    const unsigned int                    level)
+  {
+    compute_graph_renumbering(
+      new_indices,
+      dof_handler,
+      use_constraints,
+      {},
+      level,
+      [](const DynamicSparsityPattern               &graph,
+         std::vector<types::global_dof_index>       &graph_indices,
+         const std::vector<types::global_dof_index> &graph_starting_indices) {
+        Assert(graph_starting_indices.empty(), ExcInternalError());
+        (void)graph_starting_indices;
+        SparsityTools::reorder_reverse_Cuthill_McKee(graph, graph_indices);
+      });
   }
 
 
@@ -1916,6 +1996,63 @@ namespace DoFRenumbering
 
 
 
+  template <int dim, int spacedim>
+  void
+  hilbert_curve(DoFHandler<dim, spacedim> &dof_handler)
+  {
+    std::vector<types::global_dof_index> renumbering(
+      dof_handler.n_locally_owned_dofs());
+    compute_hilbert_curve(renumbering, dof_handler);
+
+    dof_handler.renumber_dofs(renumbering);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_hilbert_curve(std::vector<types::global_dof_index> &new_indices,
+                        const DoFHandler<dim, spacedim>      &dof_handler)
+  {
+    AssertDimension(new_indices.size(), dof_handler.n_locally_owned_dofs());
+
+    std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+                                 cells;
+    std::vector<Point<spacedim>> centers;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          cells.push_back(cell);
+          centers.push_back(cell->center());
+        }
+
+    // the Hilbert indices are computed relative to the bounding box of the
+    // locally owned cells, which is all we need since the renumbering only
+    // permutes the locally owned DoFs among themselves
+    const std::vector<std::array<std::uint64_t, spacedim>> hilbert_indices =
+      Utilities::inverse_Hilbert_space_filling_curve(centers);
+
+    std::vector<unsigned int> order(cells.size());
+    std::iota(order.begin(), order.end(), 0U);
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&hilbert_indices](const unsigned int a,
+                                        const unsigned int b) {
+                       return hilbert_indices[a] < hilbert_indices[b];
+                     });
+
+    std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+      ordered_cells;
+    ordered_cells.reserve(cells.size());
+    for (const unsigned int i : order)
+      ordered_cells.push_back(cells[i]);
+
+    std::vector<types::global_dof_index> reverse(new_indices.size());
+    compute_cell_wise(new_indices, reverse, dof_handler, ordered_cells);
+  }
+
+
+
   template <int dim, int spacedim>
   void
   downstream(DoFHandler<dim, spacedim> &dof,
@@ -12,6 +12,7 @@
 
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
+#include <deal.II/base/timer.h>
 #include <deal.II/base/utilities.h>
 #include <deal.II/base/work_stream.h>
 
@@ -44,6 +45,7 @@
 #include <complex>
 #include <memory>
 #include <numeric>
+#include <optional>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -586,6 +588,111 @@ namespace DoFTools
             }
       }
 
+
+
+      /**
+       * Scratch data for the computation of hp-hanging node constraints on
+       * one cell. In addition to some arrays that are only kept here to
+       * avoid repeated memory allocation, it stores caches for the face and
+       * subface interpolation matrices between different (or the same)
+       * finite elements. We compute them only once per thread, namely the
+       * first time they are needed, and then just reuse them.
+       */
+      template <int dim>
+      struct HangingNodeScratchData
+      {
+        HangingNodeScratchData(const unsigned int n_fes)
+          : face_interpolation_matrices(n_fes, n_fes)
+          , subface_interpolation_matrices(
+              n_fes,
+              n_fes,
+              GeometryInfo<dim>::max_children_per_face)
+          , split_face_interpolation_matrices(n_fes, n_fes)
+          , primary_dof_masks(n_fes, n_fes)
+        {}
+
+        /**
+         * Copy constructor. Since the caches are filled lazily on each
+         * thread, only the sizes of the caches are copied.
+         */
+        HangingNodeScratchData(const HangingNodeScratchData &scratch_data)
+          : HangingNodeScratchData(
+              scratch_data.face_interpolation_matrices.size(0))
+        {}
+
+        /**
+         * A matrix to be used for constraints, as well as arrays that
+         * hold primary and dependent dof numbers, and a scratch array
+         * needed for the complicated case.
+         */
+        FullMatrix<double>                   constraint_matrix;
+        std::vector<types::global_dof_index> primary_dofs;
+        std::vector<types::global_dof_index> dependent_dofs;
+        std::vector<types::global_dof_index> scratch_dofs;
+
+        Table<2, std::unique_ptr<FullMatrix<double>>>
+          face_interpolation_matrices;
+        Table<3, std::unique_ptr<FullMatrix<double>>>
+          subface_interpolation_matrices;
+
+        /**
+         * Cache for the matrices that are split into their primary and
+         * dependent parts, and for which the primary part is inverted. These
+         * two matrices are derived from the face interpolation matrix as
+         * described in the @ref hp_paper "hp-paper".
+         */
+        Table<2,
+              std::unique_ptr<
+                std::pair<FullMatrix<double>, FullMatrix<double>>>>
+          split_face_interpolation_matrices;
+
+        /**
+         * For each pair of finite elements, a mask that states which of the
+         * degrees of freedom on the coarse side of a refined face will act
+         * as primary dofs.
+         */
+        Table<2, std::unique_ptr<std::vector<bool>>> primary_dof_masks;
+      };
+
+
+
+      /**
+       * The hanging node constraints computed on one cell, in the form of
+       * the arguments to filter_constraints(). Whether a constraint is
+       * actually added depends on the constraints already present, so these
+       * blocks are passed on to filter_constraints() in the order of the
+       * cells.
+       */
+      struct HangingNodeCopyData
+      {
+        struct ConstraintBlock
+        {
+          std::vector<types::global_dof_index> primary_dofs;
+          std::vector<types::global_dof_index> dependent_dofs;
+          FullMatrix<double>                   face_constraints;
+        };
+
+        std::vector<ConstraintBlock> constraint_blocks;
+      };
+
+
+
+      /**
+       * Variant of filter_constraints() that only records its arguments in
+       * @p copy_data.
+       */
+      template <typename number>
+      void
+      filter_constraints(
+        const std::vector<types::global_dof_index> &primary_dofs,
+        const std::vector<types::global_dof_index> &dependent_dofs,
+        const FullMatrix<number>                   &face_constraints,
+        HangingNodeCopyData                        &copy_data)
+      {
+        copy_data.constraint_blocks.push_back(
+          {primary_dofs, dependent_dofs, face_constraints});
+      }
+
     } // namespace
 
 
@@ -2331,54 +2438,43 @@ namespace DoFTools
       // on here
 
 
-      // a matrix to be used for constraints below. declared here and simply
-      // resized down below to avoid permanent re-allocation of memory
-      FullMatrix<double> constraint_matrix;
-
-      // similarly have arrays that will hold primary and dependent dof numbers,
-      // as well as a scratch array needed for the complicated case below
-      std::vector<types::global_dof_index> primary_dofs;
-      std::vector<types::global_dof_index> dependent_dofs;
-      std::vector<types::global_dof_index> scratch_dofs;
-
-      // caches for the face and subface interpolation matrices between
-      // different (or the same) finite elements. we compute them only once,
-      // namely the first time they are needed, and then just reuse them
-      Table<2, std::unique_ptr<FullMatrix<double>>> face_interpolation_matrices(
-        n_finite_elements(dof_handler), n_finite_elements(dof_handler));
-      Table<3, std::unique_ptr<FullMatrix<double>>>
-        subface_interpolation_matrices(
-          n_finite_elements(dof_handler),
-          n_finite_elements(dof_handler),
-          GeometryInfo<dim>::max_children_per_face);
-
-      // similarly have a cache for the matrices that are split into their
-      // primary and dependent parts, and for which the primary part is
-      // inverted. these two matrices are derived from the face interpolation
-      // matrix
-      // as described in the @ref hp_paper "hp-paper"
-      Table<2,
-            std::unique_ptr<std::pair<FullMatrix<double>, FullMatrix<double>>>>
-        split_face_interpolation_matrices(n_finite_elements(dof_handler),
-                                          n_finite_elements(dof_handler));
-
-      // finally, for each pair of finite elements, have a mask that states
-      // which of the degrees of freedom on the coarse side of a refined face
-      // will act as primary dofs.
-      Table<2, std::unique_ptr<std::vector<bool>>> primary_dof_masks(
-        n_finite_elements(dof_handler), n_finite_elements(dof_handler));
-
       // loop over all faces
       //
       // note that even though we may visit a face twice if the neighboring
       // cells are equally refined, we can only visit each face with hanging
       // nodes once
-      for (const auto &cell : dof_handler.active_cell_iterators())
-        {
+      //
+      // the constraints of the cells are computed in parallel. whether a
+      // constraint is entered into the AffineConstraints object however
+      // depends on the ones already present, so the copier adds them in the
+      // order of the cells
+      auto worker =
+        [&dof_handler](
+          const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+          HangingNodeScratchData<dim> &scratch_data,
+          HangingNodeCopyData         &copy_data) {
+          copy_data.constraint_blocks.clear();
+
+          FullMatrix<double> &constraint_matrix =
+            scratch_data.constraint_matrix;
+          std::vector<types::global_dof_index> &primary_dofs =
+            scratch_data.primary_dofs;
+          std::vector<types::global_dof_index> &dependent_dofs =
+            scratch_data.dependent_dofs;
+          std::vector<types::global_dof_index> &scratch_dofs =
+            scratch_data.scratch_dofs;
+          auto &face_interpolation_matrices =
+            scratch_data.face_interpolation_matrices;
+          auto &subface_interpolation_matrices =
+            scratch_data.subface_interpolation_matrices;
+          auto &split_face_interpolation_matrices =
+            scratch_data.split_face_interpolation_matrices;
+          auto &primary_dof_masks = scratch_data.primary_dof_masks;
+
           // artificial cells can at best neighbor ghost cells, but we're not
           // interested in these interfaces
           if (cell->is_artificial())
-            continue;
+            return;
 
           for (const unsigned int face : cell->face_indices())
             if (cell->face(face)->has_children())
@@ -2556,7 +2652,7 @@ namespace DoFTools
                                                *(subface_interpolation_matrices
                                                    [cell->active_fe_index()]
                                                    [subface_fe_index][c]),
-                                               constraints);
+                                               copy_data);
                           } // loop over subfaces
 
                         break;
@@ -2701,7 +2797,7 @@ namespace DoFTools
                         filter_constraints(primary_dofs,
                                            dependent_dofs,
                                            constraint_matrix,
-                                           constraints);
+                                           copy_data);
 
 
 
@@ -2764,7 +2860,7 @@ namespace DoFTools
                             filter_constraints(primary_dofs,
                                                dependent_dofs,
                                                constraint_matrix,
-                                               constraints);
+                                               copy_data);
                           } // loop over subfaces
 
                         break;
@@ -2850,7 +2946,7 @@ namespace DoFTools
                               *(face_interpolation_matrices
                                   [cell->active_fe_index()]
                                   [neighbor->active_fe_index()]),
-                              constraints);
+                              copy_data);
 
                             break;
                           }
@@ -3019,7 +3115,7 @@ namespace DoFTools
                             filter_constraints(primary_dofs,
                                                dependent_dofs,
                                                constraint_matrix,
-                                               constraints);
+                                               copy_data);
 
                             // now do the same for another FE this is pretty
                             // much the same we do above to resolve h-refinement
@@ -3057,7 +3153,7 @@ namespace DoFTools
                             filter_constraints(primary_dofs,
                                                dependent_dofs,
                                                constraint_matrix,
-                                               constraints);
+                                               copy_data);
 
                             break;
                           }
@@ -3074,7 +3170,23 @@ namespace DoFTools
                       }
                   }
               }
-        }
+        };
+
+      auto copier = [&constraints](const HangingNodeCopyData &copy_data) {
+        for (const auto &block : copy_data.constraint_blocks)
+          filter_constraints(block.primary_dofs,
+                             block.dependent_dofs,
+                             block.face_constraints,
+                             constraints);
+      };
+
+      WorkStream::run(dof_handler.begin_active(),
+                      dof_handler.end(),
+                      worker,
+                      copier,
+                      HangingNodeScratchData<dim>(
+                        n_finite_elements(dof_handler)),
+                      HangingNodeCopyData());
     }
   } // namespace internal
 
@@ -3083,13 +3195,19 @@ namespace DoFTools
   template <int dim, int spacedim, typename number>
   void
   make_hanging_node_constraints(const DoFHandler<dim, spacedim> &dof_handler,
-                                AffineConstraints<number>       &constraints)
+                                AffineConstraints<number>       &constraints,
+                                TimerOutput                     *timer_output)
   {
     Assert(dof_handler.has_active_dofs(),
            ExcMessage(
              "The given DoFHandler does not have any DoFs. Did you forget to "
              "call dof_handler.distribute_dofs()?"));
 
+    std::optional<TimerOutput::Scope> timer_section;
+    if (timer_output != nullptr)
+      timer_section.emplace(*timer_output,
+                            "make_hanging_node_constraints: face traversal");
+
     // Decide whether to use make_hanging_node_constraints_nedelec,
     // the new or old make_hanging_node_constraints
     // function. If all the FiniteElement or all elements in a FECollection
@@ -10,6 +10,8 @@
 //
 // -----------------------------------------------------------------------------
 
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
@@ -37,11 +39,15 @@
 #include <deal.II/hp/q_collection.h>
 
 #include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
 #include <deal.II/lac/sparsity_pattern_base.h>
 #include <deal.II/lac/vector.h>
 
 #include <algorithm>
+#include <array>
 #include <complex>
+#include <mutex>
 #include <numeric>
 
 DEAL_II_NAMESPACE_OPEN
@@ -50,6 +56,207 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace DoFTools
 {
+  namespace internal
+  {
+    namespace
+    {
+      /**
+       * A class that implements the interface of SparsityPatternBase but,
+       * rather than storing a sparsity pattern, only records the entries
+       * added to it. The entries are sorted into buckets, each of which holds
+       * the entries of a contiguous range of rows.
+       */
+      class SparsityPatternEntryRecorder : public SparsityPatternBase
+      {
+      public:
+        SparsityPatternEntryRecorder(const size_type    n_rows,
+                                     const size_type    n_cols,
+                                     const unsigned int n_row_ranges)
+          : SparsityPatternBase(n_rows, n_cols)
+          , rows_per_range(
+              std::max<size_type>((n_rows + n_row_ranges - 1) / n_row_ranges,
+                                  1))
+          , entries(n_row_ranges)
+        {}
+
+        virtual void
+        add_row_entries(const size_type                  &row,
+                        const ArrayView<const size_type> &columns,
+                        const bool) override
+        {
+          auto &range_entries = entries[row / rows_per_range];
+          for (const size_type column : columns)
+            range_entries.emplace_back(row, column);
+        }
+
+        virtual void
+        add_entries(const ArrayView<const std::pair<size_type, size_type>>
+                      &new_entries) override
+        {
+          for (const auto &entry : new_entries)
+            entries[entry.first / rows_per_range].push_back(entry);
+        }
+
+        /**
+         * The number of rows per bucket.
+         */
+        const size_type rows_per_range;
+
+        /**
+         * The recorded entries, one vector per range of rows.
+         */
+        std::vector<std::vector<std::pair<size_type, size_type>>> entries;
+      };
+
+
+
+      /**
+       * Scratch arrays used by the functions creating the entries of a cell.
+       */
+      struct CellScratchData
+      {
+        std::vector<types::global_dof_index> dofs_on_this_cell;
+        std::vector<types::global_dof_index> dofs_on_other_cell;
+        std::vector<std::pair<SparsityPatternBase::size_type,
+                              SparsityPatternBase::size_type>>
+          cell_entries;
+      };
+
+
+
+      /**
+       * Call @p cell_worker on all locally owned active cells of @p dof that
+       * are in the subdomain @p subdomain_id (or on all locally owned cells
+       * if @p subdomain_id is numbers::invalid_subdomain_id), and add the
+       * entries it creates to @p sparsity.
+       *
+       * If more than one thread is available, the cells are processed in
+       * chunks: The entries of the cells of a chunk are computed in parallel
+       * and recorded separately for each task. They are then sorted and made
+       * unique in parallel for disjoint ranges of rows, and finally added
+       * row by row to @p sparsity, which is done by the calling thread
+       * since general sparsity pattern classes do not allow concurrent
+       * writes. @p n_entries_per_cell is an estimate of the number of
+       * entries created per cell and bounds the size of a chunk, and hence
+       * the memory used for recording the entries.
+       *
+       * @p cell_worker needs to be callable concurrently for different
+       * cells.
+       */
+      template <int dim, int spacedim, typename CellWorker>
+      void
+      add_entries_of_cells(const DoFHandler<dim, spacedim> &dof,
+                           const types::subdomain_id        subdomain_id,
+                           const std::size_t                n_entries_per_cell,
+                           SparsityPatternBase             &sparsity,
+                           const CellWorker                &cell_worker)
+      {
+        using size_type = SparsityPatternBase::size_type;
+
+        // In case we work with a distributed sparsity pattern of Trilinos
+        // type, we only have to do the work if the current cell is owned by
+        // the calling processor. Otherwise, just continue.
+        const auto cell_is_relevant = [subdomain_id](const auto &cell) {
+          return ((subdomain_id == numbers::invalid_subdomain_id) ||
+                  (subdomain_id == cell->subdomain_id())) &&
+                 cell->is_locally_owned();
+        };
+
+        if (MultithreadInfo::n_threads() == 1)
+          {
+            CellScratchData scratch_data;
+            for (const auto &cell : dof.active_cell_iterators())
+              if (cell_is_relevant(cell))
+                cell_worker(cell, scratch_data, sparsity);
+            return;
+          }
+
+        const unsigned int n_tasks = 4 * MultithreadInfo::n_threads();
+        std::vector<SparsityPatternEntryRecorder> recorders(
+          n_tasks,
+          SparsityPatternEntryRecorder(sparsity.n_rows(),
+                                       sparsity.n_cols(),
+                                       n_tasks));
+        std::vector<std::vector<std::pair<size_type, size_type>>>
+                               range_entries(n_tasks);
+        std::vector<size_type> columns;
+
+        const std::size_t chunk_size = std::max<std::size_t>(
+          16 * n_tasks,
+          (std::size_t(1) << 22) /
+            std::max<std::size_t>(n_entries_per_cell, 1));
+        std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+          cells;
+        cells.reserve(chunk_size);
+
+        const auto process_chunk = [&]() {
+          // compute the entries of the cells...
+          parallel::apply_to_subranges(
+            0U,
+            n_tasks,
+            [&](const unsigned int begin, const unsigned int end) {
+              CellScratchData scratch_data;
+              for (unsigned int t = begin; t < end; ++t)
+                {
+                  for (auto &entries : recorders[t].entries)
+                    entries.clear();
+                  for (std::size_t c = cells.size() * t / n_tasks;
+                       c < cells.size() * (t + 1) / n_tasks;
+                       ++c)
+                    cell_worker(cells[c], scratch_data, recorders[t]);
+                }
+            },
+            1);
+
+          // ...collect them for each range of rows...
+          parallel::apply_to_subranges(
+            0U,
+            n_tasks,
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int r = begin; r < end; ++r)
+                {
+                  auto &entries = range_entries[r];
+                  entries.clear();
+                  for (const auto &recorder : recorders)
+                    entries.insert(entries.end(),
+                                   recorder.entries[r].begin(),
+                                   recorder.entries[r].end());
+                  std::sort(entries.begin(), entries.end());
+                  entries.erase(std::unique(entries.begin(), entries.end()),
+                                entries.end());
+                }
+            },
+            1);
+
+          // ...and add them to the sparsity pattern row by row
+          for (const auto &entries : range_entries)
+            for (auto entry = entries.begin(); entry != entries.end();)
+              {
+                const size_type row = entry->first;
+                columns.clear();
+                for (; entry != entries.end() && entry->first == row; ++entry)
+                  columns.push_back(entry->second);
+                sparsity.add_row_entries(row, make_array_view(columns), true);
+              }
+
+          cells.clear();
+        };
+
+        for (const auto &cell : dof.active_cell_iterators())
+          if (cell_is_relevant(cell))
+            {
+              cells.push_back(cell);
+              if (cells.size() == chunk_size)
+                process_chunk();
+            }
+        if (cells.size() > 0)
+          process_chunk();
+      }
+    } // namespace
+  } // namespace internal
+
+
+
   template <int dim, int spacedim, typename number>
   void
   make_sparsity_pattern(const DoFHandler<dim, spacedim> &dof,
@@ -88,39 +295,402 @@ namespace DoFTools
         fe_dof_mask[f] = fe_collection[f].get_local_dof_sparsity_pattern();
       }
 
-    std::vector<types::global_dof_index> dofs_on_this_cell;
-    dofs_on_this_cell.reserve(dof.get_fe_collection().max_dofs_per_cell());
+    const std::size_t max_dofs_per_cell = fe_collection.max_dofs_per_cell();
+    internal::add_entries_of_cells(
+      dof,
+      subdomain_id,
+      max_dofs_per_cell * max_dofs_per_cell,
+      sparsity,
+      [&](const auto                &cell,
+          internal::CellScratchData &scratch_data,
+          SparsityPatternBase       &cell_sparsity) {
+        std::vector<types::global_dof_index> &dofs_on_this_cell =
+          scratch_data.dofs_on_this_cell;
+        const unsigned int dofs_per_cell = cell->get_fe().n_dofs_per_cell();
+        dofs_on_this_cell.resize(dofs_per_cell);
+        cell->get_dof_indices(dofs_on_this_cell);
+
+        // make sparsity pattern for this cell. if no constraints pattern
+        // was given, then the following call acts as if simply no
+        // constraints existed
+        const types::fe_index fe_index = cell->active_fe_index();
+        if (fe_dof_mask[fe_index].empty())
+          constraints.add_entries_local_to_global(dofs_on_this_cell,
+                                                  cell_sparsity,
+                                                  keep_constrained_dofs);
+        else
+          constraints.add_entries_local_to_global(dofs_on_this_cell,
+                                                  cell_sparsity,
+                                                  keep_constrained_dofs,
+                                                  fe_dof_mask[fe_index]);
+      });
+  }
+
+
+
+  template <int dim, int spacedim, typename number>
+  void
+  make_sparsity_pattern_two_pass(
+    const DoFHandler<dim, spacedim> &dof,
+    SparsityPattern                 &sparsity,
+    const AffineConstraints<number> &constraints,
+    const bool                       keep_constrained_dofs,
+    const types::subdomain_id        subdomain_id)
+  {
+    const types::global_dof_index n_dofs = dof.n_dofs();
+
+    // Finite elements with a local sparsity pattern need the full logic of
+    // AffineConstraints::add_entries_local_to_global(), so build the pattern
+    // via a DynamicSparsityPattern for them.
+    const auto &fe_collection = dof.get_fe_collection();
+    for (unsigned int f = 0; f < fe_collection.size(); ++f)
+      if (!fe_collection[f].get_local_dof_sparsity_pattern().empty())
+        {
+          DynamicSparsityPattern dsp(n_dofs, n_dofs);
+          make_sparsity_pattern(
+            dof, dsp, constraints, keep_constrained_dofs, subdomain_id);
+          sparsity.copy_from(dsp);
+          return;
+        }
 
-    // In case we work with a distributed sparsity pattern of Trilinos
-    // type, we only have to do the work if the current cell is owned by
-    // the calling processor. Otherwise, just continue.
+    // The entries created on a cell with the set of local degrees of freedom
+    // L are the same as in AffineConstraints::add_entries_local_to_global():
+    // all couplings within the set A of unconstrained degrees of freedom of L
+    // and of those the constrained degrees of freedom C of L are constrained
+    // to, plus either all couplings between C and L in both directions (if
+    // constrained degrees of freedom are kept), or the diagonal entries of C.
+    //
+    // Start by storing A, C, and (if needed) L for every cell, as sorted
+    // lists in compressed row storage. The cells are split into contiguous
+    // ranges, one per task, each of which creates the lists of its cells
+    // separately; the lists are then concatenated.
+    std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+      cells;
     for (const auto &cell : dof.active_cell_iterators())
       if (((subdomain_id == numbers::invalid_subdomain_id) ||
            (subdomain_id == cell->subdomain_id())) &&
           cell->is_locally_owned())
-        {
-          const unsigned int dofs_per_cell = cell->get_fe().n_dofs_per_cell();
-          dofs_on_this_cell.resize(dofs_per_cell);
-          cell->get_dof_indices(dofs_on_this_cell);
-
-          // make sparsity pattern for this cell. if no constraints pattern
-          // was given, then the following call acts as if simply no
-          // constraints existed
-          const types::fe_index fe_index = cell->active_fe_index();
-          if (fe_dof_mask[fe_index].empty())
-            constraints.add_entries_local_to_global(dofs_on_this_cell,
-                                                    sparsity,
-                                                    keep_constrained_dofs);
-          else
-            constraints.add_entries_local_to_global(dofs_on_this_cell,
-                                                    sparsity,
-                                                    keep_constrained_dofs,
-                                                    fe_dof_mask[fe_index]);
-        }
+        cells.push_back(cell);
+    const std::size_t n_cells = cells.size();
+
+    const unsigned int n_tasks =
+      (MultithreadInfo::n_threads() > 1 ? 4 * MultithreadInfo::n_threads() :
+                                          1);
+    const auto first_cell_of_task = [&](const unsigned int t) {
+      return n_cells * t / n_tasks;
+    };
+
+    struct CellLists
+    {
+      // the end of the lists of each cell within the vectors below
+      std::vector<std::size_t>             a_end, c_end, l_end;
+      std::vector<types::global_dof_index> a_dofs, c_dofs, l_dofs;
+    };
+    std::vector<CellLists> task_lists(n_tasks);
+    parallel::apply_to_subranges(
+      0U,
+      n_tasks,
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<types::global_dof_index> dofs_on_this_cell;
+        dofs_on_this_cell.reserve(fe_collection.max_dofs_per_cell());
+        for (unsigned int t = begin; t < end; ++t)
+          {
+            CellLists &lists = task_lists[t];
+            for (std::size_t c = first_cell_of_task(t);
+                 c < first_cell_of_task(t + 1);
+                 ++c)
+              {
+                dofs_on_this_cell.resize(cells[c]->get_fe().n_dofs_per_cell());
+                cells[c]->get_dof_indices(dofs_on_this_cell);
+                std::sort(dofs_on_this_cell.begin(), dofs_on_this_cell.end());
+                dofs_on_this_cell.erase(std::unique(dofs_on_this_cell.begin(),
+                                                    dofs_on_this_cell.end()),
+                                        dofs_on_this_cell.end());
+
+                const std::size_t a_begin = lists.a_dofs.size();
+                const std::size_t c_begin = lists.c_dofs.size();
+                for (const types::global_dof_index i : dofs_on_this_cell)
+                  if (const auto *entries =
+                        constraints.get_constraint_entries(i))
+                    {
+                      lists.c_dofs.push_back(i);
+                      for (const auto &entry : *entries)
+                        lists.a_dofs.push_back(entry.first);
+                    }
+                  else
+                    lists.a_dofs.push_back(i);
+
+                if (lists.c_dofs.size() > c_begin)
+                  {
+                    std::sort(lists.a_dofs.begin() + a_begin,
+                              lists.a_dofs.end());
+                    lists.a_dofs.erase(std::unique(lists.a_dofs.begin() +
+                                                     a_begin,
+                                                   lists.a_dofs.end()),
+                                       lists.a_dofs.end());
+                    if (keep_constrained_dofs)
+                      lists.l_dofs.insert(lists.l_dofs.end(),
+                                          dofs_on_this_cell.begin(),
+                                          dofs_on_this_cell.end());
+                  }
+
+                lists.a_end.push_back(lists.a_dofs.size());
+                lists.c_end.push_back(lists.c_dofs.size());
+                lists.l_end.push_back(lists.l_dofs.size());
+              }
+          }
+      },
+      1);
+
+    // concatenate the lists of all tasks, using the prefix sums of their
+    // sizes as offsets
+    std::vector<std::size_t>             a_start(n_cells + 1, 0),
+      c_start(n_cells + 1, 0), l_start(n_cells + 1, 0);
+    std::vector<types::global_dof_index> a_dofs, c_dofs, l_dofs;
+    {
+      std::vector<std::array<std::size_t, 3>> offsets(n_tasks + 1, {{0, 0, 0}});
+      for (unsigned int t = 0; t < n_tasks; ++t)
+        offsets[t + 1] = {{offsets[t][0] + task_lists[t].a_dofs.size(),
+                           offsets[t][1] + task_lists[t].c_dofs.size(),
+                           offsets[t][2] + task_lists[t].l_dofs.size()}};
+      a_dofs.resize(offsets[n_tasks][0]);
+      c_dofs.resize(offsets[n_tasks][1]);
+      l_dofs.resize(offsets[n_tasks][2]);
+
+      parallel::apply_to_subranges(
+        0U,
+        n_tasks,
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int t = begin; t < end; ++t)
+            {
+              CellLists         &lists = task_lists[t];
+              const std::size_t  first = first_cell_of_task(t);
+              for (std::size_t k = 0; k < lists.a_end.size(); ++k)
+                {
+                  a_start[first + k + 1] = offsets[t][0] + lists.a_end[k];
+                  c_start[first + k + 1] = offsets[t][1] + lists.c_end[k];
+                  l_start[first + k + 1] = offsets[t][2] + lists.l_end[k];
+                }
+              std::copy(lists.a_dofs.begin(),
+                        lists.a_dofs.end(),
+                        a_dofs.begin() + offsets[t][0]);
+              std::copy(lists.c_dofs.begin(),
+                        lists.c_dofs.end(),
+                        c_dofs.begin() + offsets[t][1]);
+              std::copy(lists.l_dofs.begin(),
+                        lists.l_dofs.end(),
+                        l_dofs.begin() + offsets[t][2]);
+              lists = CellLists();
+            }
+        },
+        1);
+    }
+    cells = decltype(cells)();
+
+    // Next, invert these lists: For each row, collect references to the
+    // cells and lists that contribute to it. A reference encodes the index
+    // of the cell along with which of its lists (A, L, C, or only the
+    // diagonal entry) describes the columns of the row.
+    enum ColumnSet : std::uint64_t
+    {
+      columns_a        = 0,
+      columns_l        = 1,
+      columns_c        = 2,
+      columns_diagonal = 3
+    };
+    std::vector<std::size_t>   row_start(n_dofs + 1, 0);
+    std::vector<std::uint64_t> row_references;
+    {
+      // The rows are split into as many ranges as there are tasks. Each
+      // task first records the references of its range of cells separately
+      // for each range of rows, so that the references of each range of
+      // rows can then be counted and sorted into place by one task without
+      // synchronization.
+      const types::global_dof_index rows_per_range = std::max<
+        types::global_dof_index>((n_dofs + n_tasks - 1) / n_tasks, 1);
+      std::vector<std::vector<
+        std::vector<std::pair<types::global_dof_index, std::uint64_t>>>>
+        range_references(
+          n_tasks,
+          std::vector<
+            std::vector<std::pair<types::global_dof_index, std::uint64_t>>>(
+            n_tasks));
+      parallel::apply_to_subranges(
+        0U,
+        n_tasks,
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int t = begin; t < end; ++t)
+            {
+              auto      &references = range_references[t];
+              const auto add_reference =
+                [&](const types::global_dof_index row,
+                    const std::uint64_t           reference) {
+                  references[row / rows_per_range].emplace_back(row,
+                                                                reference);
+                };
+              for (std::size_t c = first_cell_of_task(t);
+                   c < first_cell_of_task(t + 1);
+                   ++c)
+                {
+                  for (std::size_t k = a_start[c]; k < a_start[c + 1]; ++k)
+                    add_reference(a_dofs[k], 4 * c + columns_a);
+                  for (std::size_t k = c_start[c]; k < c_start[c + 1]; ++k)
+                    add_reference(c_dofs[k],
+                                  4 * c + (keep_constrained_dofs ?
+                                             columns_l :
+                                             columns_diagonal));
+                  for (std::size_t k = l_start[c]; k < l_start[c + 1]; ++k)
+                    add_reference(l_dofs[k], 4 * c + columns_c);
+                }
+            }
+        },
+        1);
+
+      const auto first_row_of_range = [&](const unsigned int r) {
+        return std::min<types::global_dof_index>(r * rows_per_range, n_dofs);
+      };
+
+      // count the references of each row and sum them up within each range
+      // of rows...
+      parallel::apply_to_subranges(
+        0U,
+        n_tasks,
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int r = begin; r < end; ++r)
+            {
+              for (const auto &references : range_references)
+                for (const auto &reference : references[r])
+                  ++row_start[reference.first + 1];
+              std::partial_sum(row_start.begin() + first_row_of_range(r) + 1,
+                               row_start.begin() + first_row_of_range(r + 1) +
+                                 1,
+                               row_start.begin() + first_row_of_range(r) + 1);
+            }
+        },
+        1);
+
+      // ...then compute the offsets of the ranges...
+      std::vector<std::size_t> range_offsets(n_tasks + 1, 0);
+      for (unsigned int r = 0; r < n_tasks; ++r)
+        range_offsets[r + 1] =
+          range_offsets[r] + row_start[first_row_of_range(r + 1)];
+
+      // ...and put the references into place. Each task only reads and
+      // updates the row starts after the first row of its range.
+      row_references.resize(range_offsets[n_tasks]);
+      parallel::apply_to_subranges(
+        0U,
+        n_tasks,
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int r = begin; r < end; ++r)
+            {
+              const types::global_dof_index first_row = first_row_of_range(r);
+              const types::global_dof_index end_row =
+                first_row_of_range(r + 1);
+              for (types::global_dof_index row = first_row + 1; row <= end_row;
+                   ++row)
+                row_start[row] += range_offsets[r];
+
+              std::vector<std::size_t> next_reference(end_row - first_row,
+                                                      range_offsets[r]);
+              if (first_row < end_row)
+                std::copy(row_start.begin() + first_row + 1,
+                          row_start.begin() + end_row,
+                          next_reference.begin() + 1);
+              for (auto &references : range_references)
+                {
+                  for (const auto &reference : references[r])
+                    row_references[next_reference[reference.first -
+                                                  first_row]++] =
+                      reference.second;
+                  references[r] = std::vector<
+                    std::pair<types::global_dof_index, std::uint64_t>>();
+                }
+            }
+        },
+        1);
+    }
+
+    // Collect the sorted column indices of one row from the references.
+    const auto collect_columns =
+      [&](const types::global_dof_index         row,
+          std::vector<types::global_dof_index> &columns) {
+        // the diagonal entry is always stored for square patterns
+        columns.clear();
+        columns.push_back(row);
+        for (std::size_t k = row_start[row]; k < row_start[row + 1]; ++k)
+          {
+            const std::size_t c = row_references[k] / 4;
+            switch (row_references[k] % 4)
+              {
+                case columns_a:
+                  columns.insert(columns.end(),
+                                 a_dofs.begin() + a_start[c],
+                                 a_dofs.begin() + a_start[c + 1]);
+                  break;
+                case columns_l:
+                  columns.insert(columns.end(),
+                                 l_dofs.begin() + l_start[c],
+                                 l_dofs.begin() + l_start[c + 1]);
+                  break;
+                case columns_c:
+                  columns.insert(columns.end(),
+                                 c_dofs.begin() + c_start[c],
+                                 c_dofs.begin() + c_start[c + 1]);
+                  break;
+                default:
+                  columns.push_back(row);
+              }
+          }
+        std::sort(columns.begin(), columns.end());
+        columns.erase(std::unique(columns.begin(), columns.end()),
+                      columns.end());
+      };
+
+    // First pass over the rows: count the entries...
+    std::vector<unsigned int> row_lengths(n_dofs);
+    parallel::apply_to_subranges(
+      types::global_dof_index(0),
+      n_dofs,
+      [&](const types::global_dof_index begin,
+          const types::global_dof_index end) {
+        std::vector<types::global_dof_index> columns;
+        for (types::global_dof_index row = begin; row < end; ++row)
+          {
+            collect_columns(row, columns);
+            row_lengths[row] = columns.size();
+          }
+      },
+      256);
+
+    // ...then allocate the sparsity pattern and write the entries in a
+    // second pass. Since the rows are allocated with their exact length and
+    // are written independently of each other, this can be done in parallel
+    // as well.
+    sparsity.reinit(n_dofs, n_dofs, row_lengths);
+    row_lengths = std::vector<unsigned int>();
+    parallel::apply_to_subranges(
+      types::global_dof_index(0),
+      n_dofs,
+      [&](const types::global_dof_index begin,
+          const types::global_dof_index end) {
+        std::vector<types::global_dof_index> columns;
+        for (types::global_dof_index row = begin; row < end; ++row)
+          {
+            collect_columns(row, columns);
+            sparsity.add_entries(row, columns.begin(), columns.end(), true);
+          }
+      },
+      256);
+
+    // all rows are completely filled, so this only marks the pattern as
+    // compressed
+    sparsity.compress();
   }
 
 
 
+
   template <int dim, int spacedim, typename number>
   void
   make_sparsity_pattern(const DoFHandler<dim, spacedim> &dof,
@@ -187,33 +757,33 @@ namespace DoFTools
               bool_dof_mask[f](i, j) = true;
       }
 
-    std::vector<types::global_dof_index> dofs_on_this_cell(
-      fe_collection.max_dofs_per_cell());
-
-    // In case we work with a distributed sparsity pattern of Trilinos
-    // type, we only have to do the work if the current cell is owned by
-    // the calling processor. Otherwise, just continue.
-    for (const auto &cell : dof.active_cell_iterators())
-      if (((subdomain_id == numbers::invalid_subdomain_id) ||
-           (subdomain_id == cell->subdomain_id())) &&
-          cell->is_locally_owned())
-        {
-          const types::fe_index fe_index = cell->active_fe_index();
-          const unsigned int    dofs_per_cell =
-            fe_collection[fe_index].n_dofs_per_cell();
-
-          dofs_on_this_cell.resize(dofs_per_cell);
-          cell->get_dof_indices(dofs_on_this_cell);
-
-
-          // make sparsity pattern for this cell. if no constraints pattern
-          // was given, then the following call acts as if simply no
-          // constraints existed
-          constraints.add_entries_local_to_global(dofs_on_this_cell,
-                                                  sparsity,
-                                                  keep_constrained_dofs,
-                                                  bool_dof_mask[fe_index]);
-        }
+    const std::size_t max_dofs_per_cell = fe_collection.max_dofs_per_cell();
+    internal::add_entries_of_cells(
+      dof,
+      subdomain_id,
+      max_dofs_per_cell * max_dofs_per_cell,
+      sparsity,
+      [&](const auto                &cell,
+          internal::CellScratchData &scratch_data,
+          SparsityPatternBase       &cell_sparsity) {
+        std::vector<types::global_dof_index> &dofs_on_this_cell =
+          scratch_data.dofs_on_this_cell;
+        const types::fe_index fe_index = cell->active_fe_index();
+        const unsigned int    dofs_per_cell =
+          fe_collection[fe_index].n_dofs_per_cell();
+
+        dofs_on_this_cell.resize(dofs_per_cell);
+        cell->get_dof_indices(dofs_on_this_cell);
+
+
+        // make sparsity pattern for this cell. if no constraints pattern
+        // was given, then the following call acts as if simply no
+        // constraints existed
+        constraints.add_entries_local_to_global(dofs_on_this_cell,
+                                                cell_sparsity,
+                                                keep_constrained_dofs,
+                                                bool_dof_mask[fe_index]);
+      });
   }
 
 
@@ -579,139 +1149,141 @@ namespace DoFTools
                  "locally owned one does not make sense."));
       }
 
-    std::vector<types::global_dof_index> dofs_on_this_cell;
-    std::vector<types::global_dof_index> dofs_on_other_cell;
-    dofs_on_this_cell.reserve(dof.get_fe_collection().max_dofs_per_cell());
-    dofs_on_other_cell.reserve(dof.get_fe_collection().max_dofs_per_cell());
-
     // TODO: in an old implementation, we used user flags before to tag
     // faces that were already touched. this way, we could reduce the work
     // a little bit. now, we instead add only data from one side. this
     // should be OK, but we need to actually verify it.
 
-    // In case we work with a distributed sparsity pattern of Trilinos
-    // type, we only have to do the work if the current cell is owned by
-    // the calling processor. Otherwise, just continue.
-    for (const auto &cell : dof.active_cell_iterators())
-      if (((subdomain_id == numbers::invalid_subdomain_id) ||
-           (subdomain_id == cell->subdomain_id())) &&
-          cell->is_locally_owned())
-        {
-          const unsigned int n_dofs_on_this_cell =
-            cell->get_fe().n_dofs_per_cell();
-          dofs_on_this_cell.resize(n_dofs_on_this_cell);
-          cell->get_dof_indices(dofs_on_this_cell);
-
-          // make sparsity pattern for this cell. if no constraints pattern
-          // was given, then the following call acts as if simply no
-          // constraints existed
-          constraints.add_entries_local_to_global(dofs_on_this_cell,
-                                                  sparsity,
-                                                  keep_constrained_dofs);
-
-          for (const unsigned int face : cell->face_indices())
-            {
-              typename DoFHandler<dim, spacedim>::face_iterator cell_face =
-                cell->face(face);
-              const bool periodic_neighbor = cell->has_periodic_neighbor(face);
-              if (!cell->at_boundary(face) || periodic_neighbor)
-                {
-                  typename DoFHandler<dim, spacedim>::level_cell_iterator
-                    neighbor = cell->neighbor_or_periodic_neighbor(face);
-
-                  // in 1d, we do not need to worry whether the neighbor
-                  // might have children and then loop over those children.
-                  // rather, we may as well go straight to the cell behind
-                  // this particular cell's most terminal child
-                  if (dim == 1)
-                    while (neighbor->has_children())
-                      neighbor = neighbor->child(face == 0 ? 1 : 0);
-
-                  if (neighbor->has_children())
-                    {
-                      for (unsigned int sub_nr = 0;
-                           sub_nr != cell_face->n_active_descendants();
-                           ++sub_nr)
-                        {
-                          const typename DoFHandler<dim, spacedim>::
-                            level_cell_iterator sub_neighbor =
-                              periodic_neighbor ?
-                                cell->periodic_neighbor_child_on_subface(
-                                  face, sub_nr) :
-                                cell->neighbor_child_on_subface(face, sub_nr);
-
-                          const unsigned int n_dofs_on_neighbor =
-                            sub_neighbor->get_fe().n_dofs_per_cell();
-                          dofs_on_other_cell.resize(n_dofs_on_neighbor);
-                          sub_neighbor->get_dof_indices(dofs_on_other_cell);
-
-                          constraints.add_entries_local_to_global(
-                            dofs_on_this_cell,
-                            dofs_on_other_cell,
-                            sparsity,
-                            keep_constrained_dofs);
+    const std::size_t max_dofs_per_cell =
+      dof.get_fe_collection().max_dofs_per_cell();
+    internal::add_entries_of_cells(
+      dof,
+      subdomain_id,
+      (1 + 4 * dim) * max_dofs_per_cell * max_dofs_per_cell,
+      sparsity,
+      [&](const auto                &cell,
+          internal::CellScratchData &scratch_data,
+          SparsityPatternBase       &cell_sparsity) {
+        std::vector<types::global_dof_index> &dofs_on_this_cell =
+          scratch_data.dofs_on_this_cell;
+        std::vector<types::global_dof_index> &dofs_on_other_cell =
+          scratch_data.dofs_on_other_cell;
+
+        const unsigned int n_dofs_on_this_cell =
+          cell->get_fe().n_dofs_per_cell();
+        dofs_on_this_cell.resize(n_dofs_on_this_cell);
+        cell->get_dof_indices(dofs_on_this_cell);
+
+        // make sparsity pattern for this cell. if no constraints pattern
+        // was given, then the following call acts as if simply no
+        // constraints existed
+        constraints.add_entries_local_to_global(dofs_on_this_cell,
+                                                cell_sparsity,
+                                                keep_constrained_dofs);
+
+        for (const unsigned int face : cell->face_indices())
+          {
+            typename DoFHandler<dim, spacedim>::face_iterator cell_face =
+              cell->face(face);
+            const bool periodic_neighbor = cell->has_periodic_neighbor(face);
+            if (!cell->at_boundary(face) || periodic_neighbor)
+              {
+                typename DoFHandler<dim, spacedim>::level_cell_iterator
+                  neighbor = cell->neighbor_or_periodic_neighbor(face);
+
+                // in 1d, we do not need to worry whether the neighbor
+                // might have children and then loop over those children.
+                // rather, we may as well go straight to the cell behind
+                // this particular cell's most terminal child
+                if (dim == 1)
+                  while (neighbor->has_children())
+                    neighbor = neighbor->child(face == 0 ? 1 : 0);
+
+                if (neighbor->has_children())
+                  {
+                    for (unsigned int sub_nr = 0;
+                         sub_nr != cell_face->n_active_descendants();
+                         ++sub_nr)
+                      {
+                        const typename DoFHandler<dim, spacedim>::
+                          level_cell_iterator sub_neighbor =
+                            periodic_neighbor ?
+                              cell->periodic_neighbor_child_on_subface(
+                                face, sub_nr) :
+                              cell->neighbor_child_on_subface(face, sub_nr);
+
+                        const unsigned int n_dofs_on_neighbor =
+                          sub_neighbor->get_fe().n_dofs_per_cell();
+                        dofs_on_other_cell.resize(n_dofs_on_neighbor);
+                        sub_neighbor->get_dof_indices(dofs_on_other_cell);
+
+                        constraints.add_entries_local_to_global(
+                          dofs_on_this_cell,
+                          dofs_on_other_cell,
+                          cell_sparsity,
+                          keep_constrained_dofs);
+                        constraints.add_entries_local_to_global(
+                          dofs_on_other_cell,
+                          dofs_on_this_cell,
+                          cell_sparsity,
+                          keep_constrained_dofs);
+                        // only need to add this when the neighbor is not
+                        // owned by the current processor, otherwise we add
+                        // the entries for the neighbor there
+                        if (sub_neighbor->subdomain_id() !=
+                            cell->subdomain_id())
                           constraints.add_entries_local_to_global(
                             dofs_on_other_cell,
-                            dofs_on_this_cell,
-                            sparsity,
+                            cell_sparsity,
                             keep_constrained_dofs);
-                          // only need to add this when the neighbor is not
-                          // owned by the current processor, otherwise we add
-                          // the entries for the neighbor there
-                          if (sub_neighbor->subdomain_id() !=
-                              cell->subdomain_id())
-                            constraints.add_entries_local_to_global(
-                              dofs_on_other_cell,
-                              sparsity,
-                              keep_constrained_dofs);
-                        }
-                    }
-                  else
-                    {
-                      // Refinement edges are taken care of by coarser
-                      // cells
-                      if ((!periodic_neighbor &&
-                           cell->neighbor_is_coarser(face)) ||
-                          (periodic_neighbor &&
-                           cell->periodic_neighbor_is_coarser(face)))
-                        if (neighbor->subdomain_id() == cell->subdomain_id())
-                          continue;
-
-                      const unsigned int n_dofs_on_neighbor =
-                        neighbor->get_fe().n_dofs_per_cell();
-                      dofs_on_other_cell.resize(n_dofs_on_neighbor);
-
-                      neighbor->get_dof_indices(dofs_on_other_cell);
-
-                      constraints.add_entries_local_to_global(
-                        dofs_on_this_cell,
-                        dofs_on_other_cell,
-                        sparsity,
-                        keep_constrained_dofs);
-
-                      // only need to add these in case the neighbor cell
-                      // is not locally owned - otherwise, we touch each
-                      // face twice and hence put the indices the other way
-                      // around
-                      if (!cell->neighbor_or_periodic_neighbor(face)
-                             ->is_active() ||
-                          (neighbor->subdomain_id() != cell->subdomain_id()))
-                        {
+                      }
+                  }
+                else
+                  {
+                    // Refinement edges are taken care of by coarser
+                    // cells
+                    if ((!periodic_neighbor &&
+                         cell->neighbor_is_coarser(face)) ||
+                        (periodic_neighbor &&
+                         cell->periodic_neighbor_is_coarser(face)))
+                      if (neighbor->subdomain_id() == cell->subdomain_id())
+                        continue;
+
+                    const unsigned int n_dofs_on_neighbor =
+                      neighbor->get_fe().n_dofs_per_cell();
+                    dofs_on_other_cell.resize(n_dofs_on_neighbor);
+
+                    neighbor->get_dof_indices(dofs_on_other_cell);
+
+                    constraints.add_entries_local_to_global(
+                      dofs_on_this_cell,
+                      dofs_on_other_cell,
+                      cell_sparsity,
+                      keep_constrained_dofs);
+
+                    // only need to add these in case the neighbor cell
+                    // is not locally owned - otherwise, we touch each
+                    // face twice and hence put the indices the other way
+                    // around
+                    if (!cell->neighbor_or_periodic_neighbor(face)
+                           ->is_active() ||
+                        (neighbor->subdomain_id() != cell->subdomain_id()))
+                      {
+                        constraints.add_entries_local_to_global(
+                          dofs_on_other_cell,
+                          dofs_on_this_cell,
+                          cell_sparsity,
+                          keep_constrained_dofs);
+                        if (neighbor->subdomain_id() != cell->subdomain_id())
                           constraints.add_entries_local_to_global(
                             dofs_on_other_cell,
-                            dofs_on_this_cell,
-                            sparsity,
+                            cell_sparsity,
                             keep_constrained_dofs);
-                          if (neighbor->subdomain_id() != cell->subdomain_id())
-                            constraints.add_entries_local_to_global(
-                              dofs_on_other_cell,
-                              sparsity,
-                              keep_constrained_dofs);
-                        }
-                    }
-                }
-            }
-        }
+                      }
+                  }
+              }
+          }
+      });
   }
 
 
@@ -888,19 +1460,9 @@ namespace DoFTools
           bool(const typename DoFHandler<dim, spacedim>::active_cell_iterator &,
                const unsigned int)> &face_has_flux_coupling)
       {
-        std::vector<types::global_dof_index> rows;
-        std::vector<std::pair<SparsityPatternBase::size_type,
-                              SparsityPatternBase::size_type>>
-          cell_entries;
-
         const dealii::hp::FECollection<dim, spacedim> &fe =
           dof.get_fe_collection();
 
-        std::vector<types::global_dof_index> dofs_on_this_cell(
-          dof.get_fe_collection().max_dofs_per_cell());
-        std::vector<types::global_dof_index> dofs_on_other_cell(
-          dof.get_fe_collection().max_dofs_per_cell());
-
         const unsigned int n_components = fe.n_components();
         AssertDimension(int_mask.size(0), n_components);
         AssertDimension(int_mask.size(1), n_components);
@@ -937,115 +1499,150 @@ namespace DoFTools
           }
 
 
-        for (const auto &cell : dof.active_cell_iterators())
-          if (((subdomain_id == numbers::invalid_subdomain_id) ||
-               (subdomain_id == cell->subdomain_id())) &&
-              cell->is_locally_owned())
-            {
-              dofs_on_this_cell.resize(cell->get_fe().n_dofs_per_cell());
-              cell->get_dof_indices(dofs_on_this_cell);
-
-              // make sparsity pattern for this cell also taking into
-              // account the couplings due to face contributions on the same
-              // cell
-              constraints.add_entries_local_to_global(
-                dofs_on_this_cell,
-                sparsity,
-                keep_constrained_dofs,
-                bool_int_and_flux_dof_mask[cell->active_fe_index()]);
-
-              // Loop over interior faces
-              for (const unsigned int face : cell->face_indices())
-                {
-                  const bool periodic_neighbor =
-                    cell->has_periodic_neighbor(face);
-
-                  if ((!cell->at_boundary(face)) || periodic_neighbor)
-                    {
-                      typename DoFHandler<dim, spacedim>::level_cell_iterator
-                        neighbor = cell->neighbor_or_periodic_neighbor(face);
-
-                      // If the cells are on the same level (and both are
-                      // active, locally-owned cells) then only add to the
-                      // sparsity pattern if the current cell is 'greater' in
-                      // the total ordering.
-                      if (neighbor->level() == cell->level() &&
-                          neighbor->index() > cell->index() &&
-                          neighbor->is_active() && neighbor->is_locally_owned())
-                        continue;
-
-                      // If we are more refined then the neighbor, then we
-                      // will automatically find the active neighbor cell when
-                      // we call 'neighbor (face)' above. The opposite is not
-                      // true; if the neighbor is more refined then the call
-                      // 'neighbor (face)' will *not* return an active
-                      // cell. Hence, only add things to the sparsity pattern
-                      // if (when the levels are different) the neighbor is
-                      // coarser than the current cell, except in the case
-                      // when the neighbor is not locally owned.
-                      if (neighbor->level() != cell->level() &&
-                          ((!periodic_neighbor &&
-                            !cell->neighbor_is_coarser(face)) ||
-                           (periodic_neighbor &&
-                            !cell->periodic_neighbor_is_coarser(face))) &&
-                          neighbor->is_locally_owned())
-                        continue; // (the neighbor is finer)
-
-                      if (!face_has_flux_coupling(cell, face))
-                        continue;
+        // The cells are processed in parallel, but the user-provided
+        // face_has_flux_coupling function may not be thread-safe, e.g., if
+        // it captures an FEFaceValues object or counters. Unless it is the
+        // default function, which is, we hence never call it concurrently.
+        using face_coupling_function_type =
+          bool (*)(const typename DoFHandler<dim, spacedim>::
+                     active_cell_iterator &,
+                   const unsigned int);
+        const face_coupling_function_type *face_coupling_function =
+          face_has_flux_coupling.template target<face_coupling_function_type>();
+        const bool face_has_flux_coupling_is_thread_safe =
+          (face_coupling_function != nullptr) &&
+          (*face_coupling_function ==
+           &always_couple_on_faces<dim, spacedim>);
+        std::mutex face_has_flux_coupling_mutex;
+        const auto has_flux_coupling = [&](const auto        &cell,
+                                           const unsigned int face) {
+          if (face_has_flux_coupling_is_thread_safe)
+            return face_has_flux_coupling(cell, face);
+          std::lock_guard<std::mutex> lock(face_has_flux_coupling_mutex);
+          return face_has_flux_coupling(cell, face);
+        };
+
+        const std::size_t max_dofs_per_cell = fe.max_dofs_per_cell();
+        add_entries_of_cells(
+          dof,
+          subdomain_id,
+          (1 + 4 * dim) * max_dofs_per_cell * max_dofs_per_cell,
+          sparsity,
+          [&](const auto          &cell,
+              CellScratchData     &scratch_data,
+              SparsityPatternBase &cell_sparsity) {
+            std::vector<types::global_dof_index> &dofs_on_this_cell =
+              scratch_data.dofs_on_this_cell;
+            std::vector<types::global_dof_index> &dofs_on_other_cell =
+              scratch_data.dofs_on_other_cell;
+            std::vector<std::pair<SparsityPatternBase::size_type,
+                                  SparsityPatternBase::size_type>>
+              &cell_entries = scratch_data.cell_entries;
+
+            dofs_on_this_cell.resize(cell->get_fe().n_dofs_per_cell());
+            cell->get_dof_indices(dofs_on_this_cell);
+
+            // make sparsity pattern for this cell also taking into
+            // account the couplings due to face contributions on the same
+            // cell
+            constraints.add_entries_local_to_global(
+              dofs_on_this_cell,
+              cell_sparsity,
+              keep_constrained_dofs,
+              bool_int_and_flux_dof_mask[cell->active_fe_index()]);
+
+            // Loop over interior faces
+            for (const unsigned int face : cell->face_indices())
+              {
+                const bool periodic_neighbor =
+                  cell->has_periodic_neighbor(face);
 
-                      const unsigned int neighbor_face_no =
-                        periodic_neighbor ?
-                          cell->periodic_neighbor_face_no(face) :
-                          cell->neighbor_face_no(face);
-
-                      // In 1d, go straight to the cell behind this
-                      // particular cell's most terminal cell. This makes us
-                      // skip the if (neighbor->has_children()) section
-                      // below. We need to do this since we otherwise
-                      // iterate over the children of the face, which are
-                      // always 0 in 1d.
-                      if (dim == 1)
-                        while (neighbor->has_children())
-                          neighbor = neighbor->child(face == 0 ? 1 : 0);
-
-                      if (neighbor->has_children())
-                        {
-                          for (unsigned int sub_nr = 0;
-                               sub_nr != cell->face(face)->n_children();
-                               ++sub_nr)
-                            {
-                              const typename DoFHandler<dim, spacedim>::
-                                level_cell_iterator sub_neighbor =
-                                  periodic_neighbor ?
-                                    cell->periodic_neighbor_child_on_subface(
-                                      face, sub_nr) :
-                                    cell->neighbor_child_on_subface(face,
-                                                                    sub_nr);
-                              add_cell_entries(cell,
-                                               face,
-                                               sub_neighbor,
-                                               neighbor_face_no,
-                                               flux_mask,
-                                               dofs_on_this_cell,
-                                               dofs_on_other_cell,
-                                               cell_entries);
-                            }
-                        }
-                      else
-                        add_cell_entries(cell,
-                                         face,
-                                         neighbor,
-                                         neighbor_face_no,
-                                         flux_mask,
-                                         dofs_on_this_cell,
-                                         dofs_on_other_cell,
-                                         cell_entries);
-                    }
-                }
-              sparsity.add_entries(make_array_view(cell_entries));
-              cell_entries.clear();
-            }
+                if ((!cell->at_boundary(face)) || periodic_neighbor)
+                  {
+                    typename DoFHandler<dim, spacedim>::level_cell_iterator
+                      neighbor = cell->neighbor_or_periodic_neighbor(face);
+
+                    // If the cells are on the same level (and both are
+                    // active, locally-owned cells) then only add to the
+                    // sparsity pattern if the current cell is 'greater' in
+                    // the total ordering.
+                    if (neighbor->level() == cell->level() &&
+                        neighbor->index() > cell->index() &&
+                        neighbor->is_active() && neighbor->is_locally_owned())
+                      continue;
+
+                    // If we are more refined then the neighbor, then we
+                    // will automatically find the active neighbor cell when
+                    // we call 'neighbor (face)' above. The opposite is not
+                    // true; if the neighbor is more refined then the call
+                    // 'neighbor (face)' will *not* return an active
+                    // cell. Hence, only add things to the sparsity pattern
+                    // if (when the levels are different) the neighbor is
+                    // coarser than the current cell, except in the case
+                    // when the neighbor is not locally owned.
+                    if (neighbor->level() != cell->level() &&
+                        ((!periodic_neighbor &&
+                          !cell->neighbor_is_coarser(face)) ||
+                         (periodic_neighbor &&
+                          !cell->periodic_neighbor_is_coarser(face))) &&
+                        neighbor->is_locally_owned())
+                      continue; // (the neighbor is finer)
+
+                    if (!has_flux_coupling(cell, face))
+                      continue;
+
+                    const unsigned int neighbor_face_no =
+                      periodic_neighbor ?
+                        cell->periodic_neighbor_face_no(face) :
+                        cell->neighbor_face_no(face);
+
+                    // In 1d, go straight to the cell behind this
+                    // particular cell's most terminal cell. This makes us
+                    // skip the if (neighbor->has_children()) section
+                    // below. We need to do this since we otherwise
+                    // iterate over the children of the face, which are
+                    // always 0 in 1d.
+                    if (dim == 1)
+                      while (neighbor->has_children())
+                        neighbor = neighbor->child(face == 0 ? 1 : 0);
+
+                    if (neighbor->has_children())
+                      {
+                        for (unsigned int sub_nr = 0;
+                             sub_nr != cell->face(face)->n_children();
+                             ++sub_nr)
+                          {
+                            const typename DoFHandler<dim, spacedim>::
+                              level_cell_iterator sub_neighbor =
+                                periodic_neighbor ?
+                                  cell->periodic_neighbor_child_on_subface(
+                                    face, sub_nr) :
+                                  cell->neighbor_child_on_subface(face,
+                                                                  sub_nr);
+                            add_cell_entries(cell,
+                                             face,
+                                             sub_neighbor,
+                                             neighbor_face_no,
+                                             flux_mask,
+                                             dofs_on_this_cell,
+                                             dofs_on_other_cell,
+                                             cell_entries);
+                          }
+                      }
+                    else
+                      add_cell_entries(cell,
+                                       face,
+                                       neighbor,
+                                       neighbor_face_no,
+                                       flux_mask,
+                                       dofs_on_this_cell,
+                                       dofs_on_other_cell,
+                                       cell_entries);
+                  }
+              }
+            cell_sparsity.add_entries(make_array_view(cell_entries));
+            cell_entries.clear();
+          });
       }
     } // namespace
 
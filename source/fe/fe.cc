@@ -26,7 +26,10 @@
 
 #include <algorithm>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <numeric>
+#include <tuple>
 #include <typeinfo>
 
 DEAL_II_NAMESPACE_OPEN
@@ -1420,6 +1423,250 @@ FiniteElement<dim, spacedim>::get_subface_data(
 
 
 
+namespace internal
+{
+  namespace FiniteElementImplementation
+  {
+    namespace
+    {
+      /**
+       * The objects stored in the cache of FiniteElement::get_shared_data()
+       * and related functions: The internal data object, and the shape
+       * values as they were left behind in the output object by
+       * FiniteElement::get_data(). The latter are the only part of the
+       * output object that the elements sharing their internal data fill
+       * independently of the cell; all other tables are computed in
+       * FiniteElement::fill_fe_values() and are therefore not kept.
+       */
+      template <int dim, int spacedim>
+      struct SharedInternalData
+      {
+        std::unique_ptr<
+          const typename FiniteElement<dim, spacedim>::InternalDataBase>
+          data;
+
+        typename dealii::internal::FEValuesImplementation::
+          FiniteElementRelatedData<dim, spacedim>::ShapeVector shape_values;
+      };
+
+
+
+      /**
+       * The key of the cache: The addresses of the finite element and the
+       * mapping, whether the data is for cells, faces, or subfaces, the
+       * update flags, and the points and weights of the quadrature formula.
+       */
+      using SharedInternalDataKey = std::tuple<const void *,
+                                               const void *,
+                                               unsigned int,
+                                               UpdateFlags,
+                                               std::vector<double>>;
+
+
+
+      template <int q_dim>
+      void
+      append_quadrature(const Quadrature<q_dim> &quadrature,
+                        std::vector<double>     &data)
+      {
+        data.push_back(quadrature.size());
+        for (unsigned int q = 0; q < quadrature.size(); ++q)
+          {
+            for (unsigned int d = 0; d < q_dim; ++d)
+              data.push_back(quadrature.point(q)[d]);
+            data.push_back(quadrature.weight(q));
+          }
+      }
+
+
+
+      /**
+       * Copy the shape values stored in @p source into @p destination if
+       * they have been set up in both places. Since the two output objects
+       * were handed to FiniteElement::get_data() with the same update flags,
+       * this is the case whenever get_data() may have filled them.
+       */
+      template <int dim, int spacedim>
+      void
+      copy_precomputed_output(
+        const SharedInternalData<dim, spacedim> &source,
+        dealii::internal::FEValuesImplementation::
+          FiniteElementRelatedData<dim, spacedim> &destination)
+      {
+        if (!source.shape_values.empty() &&
+            !destination.shape_values.empty())
+          {
+            AssertDimension(source.shape_values.size(0),
+                            destination.shape_values.size(0));
+            AssertDimension(source.shape_values.size(1),
+                            destination.shape_values.size(1));
+            destination.shape_values = source.shape_values;
+          }
+      }
+
+
+
+      /**
+       * Look up the object for the given key in the cache, or create it with
+       * the function @p create_data if no other object currently holds an
+       * object for that key. The data is created outside the lock, so that
+       * elements whose get_data() itself uses the cache (like the base
+       * elements of an FESystem) do not block each other; if two threads
+       * race for the same key, the object created first is kept.
+       */
+      template <int dim, int spacedim, typename CreateFunction>
+      std::shared_ptr<
+        const typename FiniteElement<dim, spacedim>::InternalDataBase>
+      get_or_create_shared_data(
+        SharedInternalDataKey &&key,
+        dealii::internal::FEValuesImplementation::
+          FiniteElementRelatedData<dim, spacedim> &output_data,
+        const CreateFunction                         &create_data)
+      {
+        static std::mutex mutex;
+        static std::map<SharedInternalDataKey,
+                        std::weak_ptr<SharedInternalData<dim, spacedim>>>
+          cache;
+
+        std::shared_ptr<SharedInternalData<dim, spacedim>> entry;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          const auto                  it = cache.find(key);
+          if (it != cache.end())
+            entry = it->second.lock();
+        }
+
+        if (entry != nullptr)
+          copy_precomputed_output(*entry, output_data);
+        else
+          {
+            auto new_entry =
+              std::make_shared<SharedInternalData<dim, spacedim>>();
+            new_entry->data         = create_data(output_data);
+            new_entry->shape_values = output_data.shape_values;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto it = cache.begin(); it != cache.end();)
+              if (it->second.expired())
+                it = cache.erase(it);
+              else
+                ++it;
+
+            std::weak_ptr<SharedInternalData<dim, spacedim>> &cached =
+              cache[std::move(key)];
+            entry = cached.lock();
+            if (entry == nullptr)
+              {
+                cached = new_entry;
+                entry  = std::move(new_entry);
+              }
+          }
+
+        return {entry, entry->data.get()};
+      }
+    } // namespace
+  } // namespace FiniteElementImplementation
+} // namespace internal
+
+
+
+template <int dim, int spacedim>
+bool
+FiniteElement<dim, spacedim>::internal_data_is_read_only() const
+{
+  return false;
+}
+
+
+
+template <int dim, int spacedim>
+bool
+FiniteElement<dim, spacedim>::fill_fe_values_respects_component_mask() const
+{
+  return false;
+}
+
+
+
+template <int dim, int spacedim>
+std::shared_ptr<const typename FiniteElement<dim, spacedim>::InternalDataBase>
+FiniteElement<dim, spacedim>::get_shared_data(
+  const UpdateFlags             flags,
+  const Mapping<dim, spacedim> &mapping,
+  const Quadrature<dim>        &quadrature,
+  dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
+                                                                     spacedim>
+    &output_data) const
+{
+  if (internal_data_is_read_only() == false)
+    return get_data(flags, mapping, quadrature, output_data);
+
+  std::vector<double> quadrature_data;
+  internal::FiniteElementImplementation::append_quadrature(quadrature,
+                                                           quadrature_data);
+  return internal::FiniteElementImplementation::get_or_create_shared_data(
+    {this, &mapping, 0, flags, std::move(quadrature_data)},
+    output_data,
+    [&](auto &output) {
+      return get_data(flags, mapping, quadrature, output);
+    });
+}
+
+
+
+template <int dim, int spacedim>
+std::shared_ptr<const typename FiniteElement<dim, spacedim>::InternalDataBase>
+FiniteElement<dim, spacedim>::get_shared_face_data(
+  const UpdateFlags               flags,
+  const Mapping<dim, spacedim>   &mapping,
+  const hp::QCollection<dim - 1> &quadrature,
+  dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
+                                                                     spacedim>
+    &output_data) const
+{
+  if (internal_data_is_read_only() == false)
+    return get_face_data(flags, mapping, quadrature, output_data);
+
+  std::vector<double> quadrature_data;
+  for (unsigned int i = 0; i < quadrature.size(); ++i)
+    internal::FiniteElementImplementation::append_quadrature(quadrature[i],
+                                                             quadrature_data);
+  return internal::FiniteElementImplementation::get_or_create_shared_data(
+    {this, &mapping, 1, flags, std::move(quadrature_data)},
+    output_data,
+    [&](auto &output) {
+      return get_face_data(flags, mapping, quadrature, output);
+    });
+}
+
+
+
+template <int dim, int spacedim>
+std::shared_ptr<const typename FiniteElement<dim, spacedim>::InternalDataBase>
+FiniteElement<dim, spacedim>::get_shared_subface_data(
+  const UpdateFlags             flags,
+  const Mapping<dim, spacedim> &mapping,
+  const Quadrature<dim - 1>    &quadrature,
+  dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
+                                                                     spacedim>
+    &output_data) const
+{
+  if (internal_data_is_read_only() == false)
+    return get_subface_data(flags, mapping, quadrature, output_data);
+
+  std::vector<double> quadrature_data;
+  internal::FiniteElementImplementation::append_quadrature(quadrature,
+                                                           quadrature_data);
+  return internal::FiniteElementImplementation::get_or_create_shared_data(
+    {this, &mapping, 2, flags, std::move(quadrature_data)},
+    output_data,
+    [&](auto &output) {
+      return get_subface_data(flags, mapping, quadrature, output);
+    });
+}
+
+
+
 template <int dim, int spacedim>
 const FiniteElement<dim, spacedim> &
 FiniteElement<dim, spacedim>::base_element(const unsigned int index) const
@@ -661,8 +661,8 @@ FE_Enriched<dim, spacedim>::multiply_by_enrichment(
     for (unsigned int base_no = 1; base_no < this->n_base_elements(); ++base_no)
       {
         const FiniteElement<dim, spacedim> &base_fe = base_element(base_no);
-        typename FiniteElement<dim, spacedim>::InternalDataBase &base_fe_data =
-          fe_data.get_fe_data(base_no);
+        const typename FiniteElement<dim, spacedim>::InternalDataBase
+          &base_fe_data = fe_data.get_fe_data(base_no);
         internal::FEValuesImplementation::FiniteElementRelatedData<dim,
                                                                    spacedim>
           &base_data = fe_data.get_fe_output_object(base_no);
@@ -1058,7 +1058,7 @@ FE_Enriched<dim, spacedim>::InternalData::InternalData(
 
 
 template <int dim, int spacedim>
-typename FiniteElement<dim, spacedim>::InternalDataBase &
+const typename FiniteElement<dim, spacedim>::InternalDataBase &
 FE_Enriched<dim, spacedim>::InternalData::get_fe_data(
   const unsigned int base_no) const
 {
@@ -190,6 +190,15 @@ FE_Poly<dim, spacedim>::shape_4th_derivative_component(
 //---------------------------------------------------------------------------
 
 
+template <int dim, int spacedim>
+bool
+FE_Poly<dim, spacedim>::internal_data_is_read_only() const
+{
+  return true;
+}
+
+
+
 template <int dim, int spacedim>
 UpdateFlags
 FE_Poly<dim, spacedim>::requires_update_flags(const UpdateFlags flags) const
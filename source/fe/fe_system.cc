@@ -248,7 +248,7 @@ FESystem<dim, spacedim>::InternalData::~InternalData()
 
 
 template <int dim, int spacedim>
-typename FiniteElement<dim, spacedim>::InternalDataBase &
+const typename FiniteElement<dim, spacedim>::InternalDataBase &
 FESystem<dim, spacedim>::InternalData::get_fe_data(
   const unsigned int base_no) const
 {
@@ -262,7 +262,8 @@ template <int dim, int spacedim>
 void
 FESystem<dim, spacedim>::InternalData::set_fe_data(
   const unsigned int base_no,
-  std::unique_ptr<typename FiniteElement<dim, spacedim>::InternalDataBase> ptr)
+  std::shared_ptr<const typename FiniteElement<dim, spacedim>::InternalDataBase>
+    ptr)
 {
   AssertIndexRange(base_no, base_fe_datas.size());
   base_fe_datas[base_no] = std::move(ptr);
@@ -1043,6 +1044,15 @@ FESystem<dim, spacedim>::requires_update_flags(const UpdateFlags flags) const
 
 
 
+template <int dim, int spacedim>
+bool
+FESystem<dim, spacedim>::fill_fe_values_respects_component_mask() const
+{
+  return true;
+}
+
+
+
 template <int dim, int spacedim>
 std::unique_ptr<typename FiniteElement<dim, spacedim>::InternalDataBase>
 FESystem<dim, spacedim>::get_data(
@@ -1092,10 +1102,11 @@ FESystem<dim, spacedim>::get_data(
       // out of the base output object into the system output object,
       // but we can't because we can't know what the elements already
       // copied and/or will want to update on every cell
-      auto base_fe_data = base_element(base_no).get_data(flags,
-                                                         mapping,
-                                                         quadrature,
-                                                         base_fe_output_object);
+      auto base_fe_data =
+        base_element(base_no).get_shared_data(flags,
+                                              mapping,
+                                              quadrature,
+                                              base_fe_output_object);
 
       data.set_fe_data(base_no, std::move(base_fe_data));
     }
@@ -1155,7 +1166,7 @@ FESystem<dim, spacedim>::get_face_data(
       // out of the base output object into the system output object,
       // but we can't because we can't know what the elements already
       // copied and/or will want to update on every cell
-      auto base_fe_data = base_element(base_no).get_face_data(
+      auto base_fe_data = base_element(base_no).get_shared_face_data(
         flags, mapping, quadrature, base_fe_output_object);
 
       data.set_fe_data(base_no, std::move(base_fe_data));
@@ -1219,7 +1230,7 @@ FESystem<dim, spacedim>::get_subface_data(
       // out of the base output object into the system output object,
       // but we can't because we can't know what the elements already
       // copied and/or will want to update on every cell
-      auto base_fe_data = base_element(base_no).get_subface_data(
+      auto base_fe_data = base_element(base_no).get_shared_subface_data(
         flags, mapping, quadrature, base_fe_output_object);
 
       data.set_fe_data(base_no, std::move(base_fe_data));
@@ -1345,6 +1356,20 @@ FESystem<dim, spacedim>::compute_fill(
 
   const UpdateFlags flags = fe_data.update_each;
 
+  // if the FEValues object only asks for some of the vector components, we
+  // can skip the base elements none of whose components is among them
+  const ComponentMask &component_mask = output_data.component_mask;
+  const auto           base_element_is_selected =
+    [&](const unsigned int base_no) {
+      if (component_mask.represents_the_all_selected_mask())
+        return true;
+      for (unsigned int c = 0; c < this->n_components(); ++c)
+        if (this->component_to_base_index(c).first == base_no &&
+            component_mask[c])
+          return true;
+      return false;
+    };
+
 
   // loop over the base elements, let them compute what they need to compute,
   // and then copy what is necessary.
@@ -1360,9 +1385,12 @@ FESystem<dim, spacedim>::compute_fill(
                update_3rd_derivatives))
     for (unsigned int base_no = 0; base_no < this->n_base_elements(); ++base_no)
       {
+        if (base_element_is_selected(base_no) == false)
+          continue;
+
         const FiniteElement<dim, spacedim> &base_fe = base_element(base_no);
-        typename FiniteElement<dim, spacedim>::InternalDataBase &base_fe_data =
-          fe_data.get_fe_data(base_no);
+        const typename FiniteElement<dim, spacedim>::InternalDataBase
+          &base_fe_data = fe_data.get_fe_data(base_no);
         internal::FEValuesImplementation::FiniteElementRelatedData<dim,
                                                                    spacedim>
           &base_data = fe_data.get_fe_output_object(base_no);
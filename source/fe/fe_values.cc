@@ -23,8 +23,12 @@
 #include <deal.II/dofs/dof_accessor.h>
 
 #include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_poly.h>
+#include <deal.II/fe/fe_system.h>
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/mapping.h>
+#include <deal.II/fe/mapping_cartesian.h>
+#include <deal.II/fe/mapping_q.h>
 
 #include <deal.II/grid/tria_accessor.h>
 #include <deal.II/grid/tria_iterator.h>
@@ -33,6 +37,8 @@
 
 #include <boost/container/small_vector.hpp>
 
+#include <cmath>
+#include <functional>
 #include <iomanip>
 #include <memory>
 #include <type_traits>
@@ -110,7 +116,8 @@ namespace internal
         MemoryConsumption::memory_consumption(shape_gradients) +
         MemoryConsumption::memory_consumption(shape_hessians) +
         MemoryConsumption::memory_consumption(shape_3rd_derivatives) +
-        MemoryConsumption::memory_consumption(shape_function_to_row_table));
+        MemoryConsumption::memory_consumption(shape_function_to_row_table) +
+        component_mask.memory_consumption());
     }
   } // namespace FEValuesImplementation
 } // namespace internal
@@ -134,6 +141,7 @@ FEValues<dim, spacedim>::FEValues(const Mapping<dim, spacedim>       &mapping,
                                 mapping,
                                 fe)
   , quadrature(q)
+  , geometry_cache_max_n_entries(0)
 {
   initialize(update_flags);
 }
@@ -163,6 +171,7 @@ FEValues<dim, spacedim>::FEValues(const FiniteElement<dim, spacedim> &fe,
       fe.reference_cell().template get_default_linear_mapping<spacedim>(),
       fe)
   , quadrature(q)
+  , geometry_cache_max_n_entries(0)
 {
   initialize(update_flags);
 }
@@ -194,7 +203,14 @@ FEValues<dim, spacedim>::initialize(const UpdateFlags update_flags)
                       "triangulation it refers to is embedded in a higher "
                       "dimensional space."));
 
-  const UpdateFlags flags = this->compute_update_flags(update_flags);
+  // if the solution can be evaluated with sum factorization, its gradients
+  // in real space are computed from the inverse Jacobians
+  const bool use_tensor_product_evaluation =
+    this->initialize_tensor_product_evaluation(quadrature);
+  const UpdateFlags flags = this->compute_update_flags(
+    (use_tensor_product_evaluation && (update_flags & update_gradients)) ?
+      update_flags | update_inverse_jacobians :
+      update_flags);
 
   // initialize the base classes
   if (flags & update_mapping)
@@ -205,13 +221,13 @@ FEValues<dim, spacedim>::initialize(const UpdateFlags update_flags)
 
   // then get objects into which the FE and the Mapping can store
   // intermediate data used across calls to reinit. we can do this in parallel
-  Threads::Task<
-    std::unique_ptr<typename FiniteElement<dim, spacedim>::InternalDataBase>>
+  Threads::Task<std::shared_ptr<
+    const typename FiniteElement<dim, spacedim>::InternalDataBase>>
     fe_get_data = Threads::new_task([&]() {
-      return this->fe->get_data(flags,
-                                *this->mapping,
-                                quadrature,
-                                this->finite_element_output);
+      return this->fe->get_shared_data(flags,
+                                       *this->mapping,
+                                       quadrature,
+                                       this->finite_element_output);
     });
 
   Threads::Task<
@@ -297,6 +313,17 @@ template <int dim, int spacedim>
 void
 FEValues<dim, spacedim>::do_reinit()
 {
+  // the geometry cache is only consulted if the cell is not a translation
+  // of the previous one, in which case the mapping and the finite element
+  // reuse their data by themselves
+  const bool use_geometry_cache =
+    (geometry_cache_max_n_entries > 0) &&
+    (this->cell_similarity == CellSimilarity::none);
+  std::vector<Tensor<1, spacedim>> vertex_differences;
+  std::size_t                      hash = 0;
+  if (use_geometry_cache && reuse_cached_geometry(vertex_differences, hash))
+    return;
+
   // first call the mapping and let it generate the data
   // specific to the mapping. also let it inspect the
   // cell similarity flag and, if necessary, update
@@ -323,6 +350,166 @@ FEValues<dim, spacedim>::do_reinit()
                                 this->mapping_output,
                                 *this->fe_data,
                                 this->finite_element_output);
+
+  if (use_geometry_cache &&
+      geometry_cache.size() < geometry_cache_max_n_entries)
+    {
+      GeometryCacheEntry entry;
+      entry.vertex_differences = std::move(vertex_differences);
+      entry.first_vertex =
+        static_cast<const typename Triangulation<dim, spacedim>::cell_iterator
+                      &>(this->present_cell)
+          ->vertex(0);
+      entry.mapping_output        = this->mapping_output;
+      entry.finite_element_output = this->finite_element_output;
+      geometry_cache.emplace(hash, std::move(entry));
+      geometry_cache_statistics.n_entries = geometry_cache.size();
+    }
+}
+
+
+
+template <int dim, int spacedim>
+bool
+FEValues<dim, spacedim>::reuse_cached_geometry(
+  std::vector<Tensor<1, spacedim>> &vertex_differences,
+  std::size_t                      &hash)
+{
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell =
+    this->present_cell;
+
+  vertex_differences.resize(cell->n_vertices() - 1);
+  for (unsigned int v = 1; v < cell->n_vertices(); ++v)
+    vertex_differences[v - 1] = cell->vertex(v) - cell->vertex(0);
+
+  // hash the vertex differences rounded to about eight digits relative to
+  // the first edge, such that cells whose differences only deviate by
+  // round-off usually end up with the same hash. the actual comparison
+  // below uses a much tighter tolerance, like
+  // TriaAccessor::is_translation_of()
+  const double scale     = 1e8 / vertex_differences[0].norm();
+  const double tolerance = 1e-24 * vertex_differences[0].norm_square();
+  hash                   = vertex_differences.size();
+  for (const Tensor<1, spacedim> &difference : vertex_differences)
+    for (unsigned int d = 0; d < spacedim; ++d)
+      hash ^= std::hash<long long>()(std::llround(difference[d] * scale)) +
+              0x9e3779b9 + (hash << 6) + (hash >> 2);
+
+  ++geometry_cache_statistics.n_lookups;
+  const auto range = geometry_cache.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it)
+    {
+      const GeometryCacheEntry &entry = it->second;
+      bool                      is_translation = true;
+      for (unsigned int v = 0; v < vertex_differences.size(); ++v)
+        if ((entry.vertex_differences[v] - vertex_differences[v])
+              .norm_square() > tolerance)
+          {
+            is_translation = false;
+            break;
+          }
+      if (is_translation == false)
+        continue;
+
+      this->mapping_output        = entry.mapping_output;
+      this->finite_element_output = entry.finite_element_output;
+      if (this->update_flags & update_quadrature_points)
+        {
+          const Tensor<1, spacedim> shift =
+            cell->vertex(0) - entry.first_vertex;
+          for (Point<spacedim> &point : this->mapping_output.quadrature_points)
+            point += shift;
+        }
+
+      // the internal data of the mapping and the finite element still
+      // belong to the cell computed last, so the next cell must not be
+      // treated as a translation of the present one
+      this->cell_similarity = CellSimilarity::invalid_next_cell;
+      ++geometry_cache_statistics.n_hits;
+      return true;
+    }
+
+  return false;
+}
+
+
+
+namespace internal
+{
+  namespace FEValuesImplementation
+  {
+    namespace
+    {
+      // return whether the given element only depends on the geometry of
+      // a cell through the Jacobians, as the elements derived from FE_Poly
+      // do
+      template <int dim, int spacedim>
+      bool
+      element_allows_geometry_cache(const FiniteElement<dim, spacedim> &fe)
+      {
+        if (const auto *fe_system =
+              dynamic_cast<const FESystem<dim, spacedim> *>(&fe))
+          {
+            for (unsigned int b = 0; b < fe_system->n_base_elements(); ++b)
+              if (element_allows_geometry_cache(fe_system->base_element(b)) ==
+                  false)
+                return false;
+            return true;
+          }
+        return dynamic_cast<const FE_Poly<dim, spacedim> *>(&fe) != nullptr;
+      }
+
+
+
+      // return whether the given mapping computes the same Jacobians on
+      // all cells that are translations of each other
+      template <int dim, int spacedim>
+      bool
+      mapping_allows_geometry_cache(const Mapping<dim, spacedim> &mapping)
+      {
+        if (dim != spacedim || mapping.preserves_vertex_locations() == false)
+          return false;
+        if (const auto *mapping_q =
+              dynamic_cast<const MappingQ<dim, spacedim> *>(&mapping))
+          return mapping_q->get_degree() == 1;
+        return dynamic_cast<const MappingCartesian<dim, spacedim> *>(
+                 &mapping) != nullptr;
+      }
+    } // namespace
+  }   // namespace FEValuesImplementation
+} // namespace internal
+
+
+
+template <int dim, int spacedim>
+void
+FEValues<dim, spacedim>::enable_geometry_cache(
+  const unsigned int max_n_entries)
+{
+  geometry_cache.clear();
+  geometry_cache_statistics = GeometryCacheStatistics();
+
+  if (internal::FEValuesImplementation::mapping_allows_geometry_cache(
+        this->get_mapping()) &&
+      internal::FEValuesImplementation::element_allows_geometry_cache(
+        this->get_fe()))
+    geometry_cache_max_n_entries = max_n_entries;
+  else
+    geometry_cache_max_n_entries = 0;
+
+  // do not treat the next cell as a translation of a cell that has been
+  // computed before the cache was changed
+  if (this->cell_similarity == CellSimilarity::translation)
+    this->cell_similarity = CellSimilarity::invalid_next_cell;
+}
+
+
+
+template <int dim, int spacedim>
+typename FEValues<dim, spacedim>::GeometryCacheStatistics
+FEValues<dim, spacedim>::get_geometry_cache_statistics() const
+{
+  return geometry_cache_statistics;
 }
 
 
@@ -331,8 +518,13 @@ template <int dim, int spacedim>
 std::size_t
 FEValues<dim, spacedim>::memory_consumption() const
 {
-  return (FEValuesBase<dim, spacedim>::memory_consumption() +
-          MemoryConsumption::memory_consumption(quadrature));
+  std::size_t memory = FEValuesBase<dim, spacedim>::memory_consumption() +
+                       MemoryConsumption::memory_consumption(quadrature);
+  for (const auto &[hash, entry] : geometry_cache)
+    memory += MemoryConsumption::memory_consumption(entry.vertex_differences) +
+              entry.mapping_output.memory_consumption() +
+              entry.finite_element_output.memory_consumption();
+  return memory;
 }
 
 #endif
@@ -488,29 +680,21 @@ FEFaceValues<dim, spacedim>::initialize(const UpdateFlags update_flags)
   // then get objects into which the FE and the Mapping can store
   // intermediate data used across calls to reinit. this can be done in parallel
 
-  std::unique_ptr<typename FiniteElement<dim, spacedim>::InternalDataBase> (
-    FiniteElement<dim, spacedim>::*finite_element_get_face_data)(
-    const UpdateFlags,
-    const Mapping<dim, spacedim> &,
-    const hp::QCollection<dim - 1> &,
-    dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
-                                                                       spacedim>
-      &) const = &FiniteElement<dim, spacedim>::get_face_data;
-
   std::unique_ptr<typename Mapping<dim, spacedim>::InternalDataBase> (
     Mapping<dim, spacedim>::*mapping_get_face_data)(
     const UpdateFlags, const hp::QCollection<dim - 1> &) const =
     &Mapping<dim, spacedim>::get_face_data;
 
 
-  Threads::Task<
-    std::unique_ptr<typename FiniteElement<dim, spacedim>::InternalDataBase>>
-    fe_get_data = Threads::new_task(finite_element_get_face_data,
-                                    *this->fe,
-                                    flags,
-                                    *this->mapping,
-                                    this->quadrature,
-                                    this->finite_element_output);
+  Threads::Task<std::shared_ptr<
+    const typename FiniteElement<dim, spacedim>::InternalDataBase>>
+    fe_get_data = Threads::new_task(
+      &FiniteElement<dim, spacedim>::get_shared_face_data,
+      *this->fe,
+      flags,
+      *this->mapping,
+      this->quadrature,
+      this->finite_element_output);
   Threads::Task<
     std::unique_ptr<typename Mapping<dim, spacedim>::InternalDataBase>>
     mapping_get_data;
@@ -726,15 +910,15 @@ FESubfaceValues<dim, spacedim>::initialize(const UpdateFlags update_flags)
   // then get objects into which the FE and the Mapping can store
   // intermediate data used across calls to reinit. this can be done
   // in parallel
-  Threads::Task<
-    std::unique_ptr<typename FiniteElement<dim, spacedim>::InternalDataBase>>
-    fe_get_data =
-      Threads::new_task(&FiniteElement<dim, spacedim>::get_subface_data,
-                        *this->fe,
-                        flags,
-                        *this->mapping,
-                        this->quadrature[0],
-                        this->finite_element_output);
+  Threads::Task<std::shared_ptr<
+    const typename FiniteElement<dim, spacedim>::InternalDataBase>>
+    fe_get_data = Threads::new_task(
+      &FiniteElement<dim, spacedim>::get_shared_subface_data,
+      *this->fe,
+      flags,
+      *this->mapping,
+      this->quadrature[0],
+      this->finite_element_output);
   Threads::Task<
     std::unique_ptr<typename Mapping<dim, spacedim>::InternalDataBase>>
     mapping_get_data;
@@ -14,6 +14,7 @@
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/multithread_info.h>
 #include <deal.II/base/numbers.h>
+#include <deal.II/base/partitioner.h>
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/signaling_nan.h>
 #include <deal.II/base/thread_management.h>
@@ -29,10 +30,18 @@
 #include <deal.II/grid/tria_accessor.h>
 #include <deal.II/grid/tria_iterator.h>
 
+#include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/vector.h>
 
+#include <deal.II/matrix_free/evaluation_flags.h>
+#include <deal.II/matrix_free/evaluation_template_factory.h>
+#include <deal.II/matrix_free/fe_evaluation_data.h>
+#include <deal.II/matrix_free/shape_info.h>
+
 #include <boost/container/small_vector.hpp>
 
+#include <array>
+#include <cmath>
 #include <complex>
 #include <iomanip>
 #include <memory>
@@ -101,6 +110,59 @@ namespace internal
       }
     };
   } // namespace
+
+
+
+  namespace FEValuesImplementation
+  {
+    template <int dim>
+    struct TensorProductEvaluationData
+    {
+      /**
+       * The one-dimensional shape functions and their derivatives evaluated
+       * at the one-dimensional quadrature points, as well as the
+       * lexicographic numbering of the degrees of freedom.
+       */
+      MatrixFreeFunctions::ShapeInfo<double> shape_info;
+
+      /**
+       * Temporary storage for the sum-factorization kernels. As the
+       * get_function_values() functions are const, this field is mutable.
+       */
+      mutable AlignedVector<VectorizedArray<double, 1>> scratch;
+    };
+  } // namespace FEValuesImplementation
+
+
+
+  namespace
+  {
+    // read the entries data[indices[i]] into out[i], using the SIMD gather
+    // instructions of VectorizedArray where possible
+    template <typename Number, typename IndexType>
+    void
+    gather_vector_entries(const Number            *data,
+                          const IndexType         *indices,
+                          const ArrayView<Number> &out)
+    {
+      const unsigned int n_entries = out.size();
+      unsigned int       i         = 0;
+      if constexpr (std::is_same_v<IndexType, unsigned int> &&
+                    (std::is_same_v<Number, double> ||
+                     std::is_same_v<Number, float>))
+        {
+          constexpr unsigned int n_lanes = VectorizedArray<Number>::size();
+          for (; i + n_lanes <= n_entries; i += n_lanes)
+            {
+              VectorizedArray<Number> entries;
+              entries.gather(data, indices + i);
+              entries.store(out.data() + i);
+            }
+        }
+      for (; i < n_entries; ++i)
+        out[i] = data[indices[i]];
+    }
+  } // namespace
 } // namespace internal
 
 /* ------------ FEValuesBase<dim,spacedim>::CellIteratorWrapper ----------- */
@@ -130,6 +192,21 @@ FEValuesBase<dim, spacedim>::CellIteratorWrapper::CellIteratorWrapper(
 
 
 
+template <int dim, int spacedim>
+typename FEValuesBase<dim, spacedim>::CellIteratorWrapper &
+FEValuesBase<dim, spacedim>::CellIteratorWrapper::operator=(
+  const CellIteratorWrapper &other)
+{
+  cell = other.cell;
+  dof_indices.assign(other.dof_indices.begin(), other.dof_indices.end());
+  local_dof_indices.assign(other.local_dof_indices.begin(),
+                           other.local_dof_indices.end());
+  local_dof_indices_partitioner = other.local_dof_indices_partitioner;
+  return *this;
+}
+
+
+
 template <int dim, int spacedim>
 bool
 FEValuesBase<dim, spacedim>::CellIteratorWrapper::is_initialized() const
@@ -189,8 +266,25 @@ FEValuesBase<dim, spacedim>::CellIteratorWrapper::get_interpolated_dof_values(
   switch (cell.value().index())
     {
       case 1:
-        std::get<1>(cell.value())->get_interpolated_dof_values(in, out);
-        break;
+        {
+          const typename DoFHandler<dim, spacedim>::cell_iterator
+            &dof_cell = std::get<1>(cell.value());
+          if (dof_cell->is_active())
+            {
+              // on active cells, the interpolated values are the values of
+              // the degrees of freedom of the cell. look up their indices
+              // only once per cell
+              if (dof_indices.empty())
+                {
+                  dof_indices.resize(dof_cell->get_fe().n_dofs_per_cell());
+                  dof_cell->get_dof_indices(dof_indices);
+                }
+              gather_dof_values(in, out);
+            }
+          else
+            dof_cell->get_interpolated_dof_values(in, out);
+          break;
+        }
 
       case 2:
         std::get<2>(cell.value())->get_interpolated_dof_values(in, out);
@@ -204,6 +298,65 @@ FEValuesBase<dim, spacedim>::CellIteratorWrapper::get_interpolated_dof_values(
 
 
 
+template <int dim, int spacedim>
+template <typename Number>
+void
+FEValuesBase<dim, spacedim>::CellIteratorWrapper::gather_dof_values(
+  const ReadVector<Number> &in,
+  ArrayView<Number>         out) const
+{
+  AssertDimension(out.size(), dof_indices.size());
+
+  if constexpr (std::is_same_v<Number, double> || std::is_same_v<Number, float>)
+    {
+      // for the vector types of deal.II, read directly from the memory of
+      // the vector
+      if (const auto *vector = dynamic_cast<const Vector<Number> *>(&in))
+        {
+          internal::gather_vector_entries(vector->begin(),
+                                          dof_indices.data(),
+                                          out);
+          return;
+        }
+      else if (const auto *vector = dynamic_cast<
+                 const LinearAlgebra::distributed::Vector<Number> *>(&in))
+        {
+          const Utilities::MPI::Partitioner &partitioner =
+            *vector->get_partitioner();
+          if (local_dof_indices.empty() ||
+              local_dof_indices_partitioner != &partitioner)
+            {
+              local_dof_indices.resize(dof_indices.size());
+              for (unsigned int i = 0; i < dof_indices.size(); ++i)
+                local_dof_indices[i] =
+                  partitioner.global_to_local(dof_indices[i]);
+              local_dof_indices_partitioner = &partitioner;
+            }
+
+          if constexpr (running_in_debug_mode())
+            {
+              for (const unsigned int index : local_dof_indices)
+                Assert(index < vector->locally_owned_size() ||
+                         vector->has_ghost_elements(),
+                       ExcMessage(
+                         "You tried to read a ghost element of this vector, "
+                         "but it has not imported its ghost values."));
+            }
+
+          internal::gather_vector_entries(vector->begin(),
+                                          local_dof_indices.data(),
+                                          out);
+          return;
+        }
+    }
+
+  in.extract_subvector_to(make_array_view(dof_indices.begin(),
+                                          dof_indices.end()),
+                          out);
+}
+
+
+
 /*------------------------------- FEValuesBase ---------------------------*/
 
 
@@ -451,6 +604,74 @@ namespace internal
 
 
 
+  // evaluate the values and/or the gradients of a scalar finite element
+  // function at the quadrature points with the sum-factorization kernels
+  // of the matrix-free framework, given the degrees of freedom of the cell
+  // in the numbering of the finite element. The gradients in real space
+  // are the gradients on the reference cell multiplied by the transpose of
+  // the inverse Jacobian
+  template <int dim, int spacedim, typename Number>
+  void
+  do_function_values_tensor_product(
+    const FEValuesImplementation::TensorProductEvaluationData<dim> &data,
+    const ArrayView<Number>                                        &dof_values,
+    const std::vector<DerivativeForm<1, spacedim, dim>> &inverse_jacobians,
+    std::vector<Number>                                 *values,
+    std::vector<Tensor<1, spacedim, Number>>            *gradients)
+  {
+    using VectorizedArrayType = VectorizedArray<double, 1>;
+
+    const MatrixFreeFunctions::ShapeInfo<double> &shape_info = data.shape_info;
+    const unsigned int n_q_points = shape_info.n_q_points;
+    AssertDimension(dof_values.size(), shape_info.dofs_per_component_on_cell);
+
+    FEEvaluationData<dim, VectorizedArrayType, false> eval(shape_info);
+    eval.set_data_pointers(&data.scratch, 1);
+
+    const std::vector<unsigned int> &lexicographic_numbering =
+      shape_info.lexicographic_numbering;
+    for (unsigned int i = 0; i < dof_values.size(); ++i)
+      eval.begin_dof_values()[i] =
+        static_cast<double>(dof_values[lexicographic_numbering[i]]);
+
+    const EvaluationFlags::EvaluationFlags evaluation_flags =
+      (values != nullptr ? EvaluationFlags::values : EvaluationFlags::nothing) |
+      (gradients != nullptr ? EvaluationFlags::gradients :
+                              EvaluationFlags::nothing);
+    FEEvaluationFactory<dim, VectorizedArrayType>::evaluate(
+      1, evaluation_flags, eval.begin_dof_values(), eval);
+
+    if (values != nullptr)
+      {
+        AssertDimension(values->size(), n_q_points);
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          (*values)[q] = eval.begin_values()[q][0];
+      }
+
+    if (gradients != nullptr)
+      {
+        AssertDimension(gradients->size(), n_q_points);
+        AssertDimension(inverse_jacobians.size(), n_q_points);
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          {
+            const VectorizedArrayType *unit_gradient =
+              eval.begin_gradients() + q * dim;
+            const DerivativeForm<1, spacedim, dim> &inverse_jacobian =
+              inverse_jacobians[q];
+            Tensor<1, spacedim, Number> &gradient = (*gradients)[q];
+            for (unsigned int d = 0; d < spacedim; ++d)
+              {
+                double sum = inverse_jacobian[0][d] * unit_gradient[0][0];
+                for (unsigned int e = 1; e < dim; ++e)
+                  sum += inverse_jacobian[e][d] * unit_gradient[e][0];
+                gradient[d] = sum;
+              }
+          }
+      }
+  }
+
+
+
   template <int order, int dim, int spacedim, typename Number>
   void
   do_function_derivatives(
@@ -726,6 +947,20 @@ FEValuesBase<dim, spacedim>::get_function_values(
   boost::container::small_vector<Number, 200> dof_values(dofs_per_cell);
   auto view = make_array_view(dof_values.begin(), dof_values.end());
   present_cell.get_interpolated_dof_values(fe_function, view);
+
+  // use sum factorization if possible
+  if constexpr (std::is_same_v<Number, double> || std::is_same_v<Number, float>)
+    if (tensor_product_evaluation != nullptr)
+      {
+        internal::do_function_values_tensor_product(
+          *tensor_product_evaluation,
+          view,
+          this->mapping_output.inverse_jacobians,
+          &values,
+          static_cast<std::vector<Tensor<1, spacedim, Number>> *>(nullptr));
+        return;
+      }
+
   internal::do_function_values(view,
                                this->finite_element_output.shape_values,
                                values);
@@ -749,6 +984,20 @@ FEValuesBase<dim, spacedim>::get_function_values(
   boost::container::small_vector<Number, 200> dof_values(dofs_per_cell);
   auto view = make_array_view(dof_values.begin(), dof_values.end());
   fe_function.extract_subvector_to(indices, view);
+
+  // use sum factorization if possible
+  if constexpr (std::is_same_v<Number, double> || std::is_same_v<Number, float>)
+    if (tensor_product_evaluation != nullptr)
+      {
+        internal::do_function_values_tensor_product(
+          *tensor_product_evaluation,
+          view,
+          this->mapping_output.inverse_jacobians,
+          &values,
+          static_cast<std::vector<Tensor<1, spacedim, Number>> *>(nullptr));
+        return;
+      }
+
   internal::do_function_values(view,
                                this->finite_element_output.shape_values,
                                values);
@@ -845,6 +1094,50 @@ FEValuesBase<dim, spacedim>::get_function_values(
 
 
 
+template <int dim, int spacedim>
+template <typename Number>
+void
+FEValuesBase<dim, spacedim>::get_function_values(
+  const std::vector<const ReadVector<Number> *> &fe_functions,
+  std::vector<std::vector<Number>>              &values) const
+{
+  Assert(this->update_flags & update_values,
+         ExcAccessToUninitializedField("update_values"));
+  AssertDimension(fe->n_components(), 1);
+  Assert(present_cell.is_initialized(), ExcNotReinited());
+  AssertDimension(fe_functions.size(), values.size());
+
+  // the indices of the degrees of freedom are cached in present_cell upon
+  // the first call, so they are only looked up once for all vectors
+  boost::container::small_vector<Number, 200> dof_values(dofs_per_cell);
+  auto view = make_array_view(dof_values.begin(), dof_values.end());
+  for (unsigned int v = 0; v < fe_functions.size(); ++v)
+    {
+      AssertDimension(fe_functions[v]->size(),
+                      present_cell.n_dofs_for_dof_handler());
+      present_cell.get_interpolated_dof_values(*fe_functions[v], view);
+
+      if constexpr (std::is_same_v<Number, double> ||
+                    std::is_same_v<Number, float>)
+        if (tensor_product_evaluation != nullptr)
+          {
+            internal::do_function_values_tensor_product(
+              *tensor_product_evaluation,
+              view,
+              this->mapping_output.inverse_jacobians,
+              &values[v],
+              static_cast<std::vector<Tensor<1, spacedim, Number>> *>(nullptr));
+            continue;
+          }
+
+      internal::do_function_values(view,
+                                   this->finite_element_output.shape_values,
+                                   values[v]);
+    }
+}
+
+
+
 template <int dim, int spacedim>
 template <typename Number>
 void
@@ -862,6 +1155,20 @@ FEValuesBase<dim, spacedim>::get_function_gradients(
   boost::container::small_vector<Number, 200> dof_values(dofs_per_cell);
   auto view = make_array_view(dof_values.begin(), dof_values.end());
   present_cell.get_interpolated_dof_values(fe_function, view);
+
+  // use sum factorization if possible
+  if constexpr (std::is_same_v<Number, double> || std::is_same_v<Number, float>)
+    if (tensor_product_evaluation != nullptr)
+      {
+        internal::do_function_values_tensor_product(
+          *tensor_product_evaluation,
+          view,
+          this->mapping_output.inverse_jacobians,
+          static_cast<std::vector<Number> *>(nullptr),
+          &gradients);
+        return;
+      }
+
   internal::do_function_derivatives(view,
                                     this->finite_element_output.shape_gradients,
                                     gradients);
@@ -885,6 +1192,20 @@ FEValuesBase<dim, spacedim>::get_function_gradients(
   boost::container::small_vector<Number, 200> dof_values(dofs_per_cell);
   auto view = make_array_view(dof_values.begin(), dof_values.end());
   fe_function.extract_subvector_to(indices, view);
+
+  // use sum factorization if possible
+  if constexpr (std::is_same_v<Number, double> || std::is_same_v<Number, float>)
+    if (tensor_product_evaluation != nullptr)
+      {
+        internal::do_function_values_tensor_product(
+          *tensor_product_evaluation,
+          view,
+          this->mapping_output.inverse_jacobians,
+          static_cast<std::vector<Number> *>(nullptr),
+          &gradients);
+        return;
+      }
+
   internal::do_function_derivatives(view,
                                     this->finite_element_output.shape_gradients,
                                     gradients);
@@ -949,6 +1270,47 @@ FEValuesBase<dim, spacedim>::get_function_gradients(
 
 
 
+template <int dim, int spacedim>
+template <typename Number>
+void
+FEValuesBase<dim, spacedim>::get_function_gradients(
+  const std::vector<const ReadVector<Number> *>         &fe_functions,
+  std::vector<std::vector<Tensor<1, spacedim, Number>>> &gradients) const
+{
+  Assert(this->update_flags & update_gradients,
+         ExcAccessToUninitializedField("update_gradients"));
+  AssertDimension(fe->n_components(), 1);
+  Assert(present_cell.is_initialized(), ExcNotReinited());
+  AssertDimension(fe_functions.size(), gradients.size());
+
+  boost::container::small_vector<Number, 200> dof_values(dofs_per_cell);
+  auto view = make_array_view(dof_values.begin(), dof_values.end());
+  for (unsigned int v = 0; v < fe_functions.size(); ++v)
+    {
+      AssertDimension(fe_functions[v]->size(),
+                      present_cell.n_dofs_for_dof_handler());
+      present_cell.get_interpolated_dof_values(*fe_functions[v], view);
+
+      if constexpr (std::is_same_v<Number, double> ||
+                    std::is_same_v<Number, float>)
+        if (tensor_product_evaluation != nullptr)
+          {
+            internal::do_function_values_tensor_product(
+              *tensor_product_evaluation,
+              view,
+              this->mapping_output.inverse_jacobians,
+              static_cast<std::vector<Number> *>(nullptr),
+              &gradients[v]);
+            continue;
+          }
+
+      internal::do_function_derivatives(
+        view, this->finite_element_output.shape_gradients, gradients[v]);
+    }
+}
+
+
+
 template <int dim, int spacedim>
 template <typename Number>
 void
@@ -1309,6 +1671,58 @@ FEValuesBase<dim, spacedim>::get_normal_vectors() const
 
 
 
+template <int dim, int spacedim>
+void
+FEValuesBase<dim, spacedim>::restrict_to_components(const ComponentMask &mask)
+{
+  Assert(mask.represents_n_components(fe->n_components()),
+         ExcMessage("The component mask needs to have as many entries as "
+                    "the finite element has vector components."));
+  if (mask == finite_element_output.component_mask)
+    return;
+  finite_element_output.component_mask = mask;
+
+  // The data of the components that are selected again have not been
+  // computed on the present cell, so the next call to reinit() must not
+  // reuse any data based on the similarity of cells.
+  cell_similarity = CellSimilarity::invalid_next_cell;
+
+  // Elements that ignore the mask compute all shape functions, some of them
+  // (like FE_Poly) even only once, so their data must not be touched.
+  if (fe->fill_fe_values_respects_component_mask() == false)
+    return;
+
+  // invalidate the rows of the shape function data that belong to
+  // components that are not selected any more, so that accessing them does
+  // not silently return the data of a previous cell
+  const auto invalidate_row = [](auto &table, const unsigned int row) {
+    if (!table.empty())
+      std::fill_n(&table(row, 0),
+                  table.size(1),
+                  numbers::signaling_nan<
+                    typename std::decay_t<decltype(table)>::value_type>());
+  };
+  const unsigned int n_components = fe->n_components();
+  for (unsigned int i = 0; i < dofs_per_cell; ++i)
+    for (unsigned int c = 0; c < n_components; ++c)
+      if (mask[c] == false)
+        {
+          const unsigned int row =
+            finite_element_output
+              .shape_function_to_row_table[i * n_components + c];
+          if (row != numbers::invalid_unsigned_int)
+            {
+              invalidate_row(finite_element_output.shape_values, row);
+              invalidate_row(finite_element_output.shape_gradients, row);
+              invalidate_row(finite_element_output.shape_hessians, row);
+              invalidate_row(finite_element_output.shape_3rd_derivatives,
+                             row);
+            }
+        }
+}
+
+
+
 template <int dim, int spacedim>
 std::size_t
 FEValuesBase<dim, spacedim>::memory_consumption() const
@@ -1325,7 +1739,12 @@ FEValuesBase<dim, spacedim>::memory_consumption() const
           MemoryConsumption::memory_consumption(fe) +
           MemoryConsumption::memory_consumption(fe_data) +
           MemoryConsumption::memory_consumption(*fe_data) +
-          MemoryConsumption::memory_consumption(finite_element_output));
+          MemoryConsumption::memory_consumption(finite_element_output) +
+          (tensor_product_evaluation != nullptr ?
+             tensor_product_evaluation->shape_info.memory_consumption() +
+               MemoryConsumption::memory_consumption(
+                 tensor_product_evaluation->scratch) :
+             0));
 }
 
 
@@ -1451,6 +1870,57 @@ FEValuesBase<dim, spacedim>::check_cell_similarity(
 
 
 
+template <int dim, int spacedim>
+bool
+FEValuesBase<dim, spacedim>::initialize_tensor_product_evaluation(
+  const Quadrature<dim> &quadrature)
+{
+  tensor_product_evaluation.reset();
+
+  // sum factorization only pays off for elements of degree two and higher
+  // and with more than one quadrature point, and we only consider scalar
+  // elements where the gradients in real space are given by the inverse
+  // Jacobian times the gradients on the reference cell
+  if (dim != spacedim || fe->n_components() != 1 || fe->degree < 2 ||
+      quadrature.size() < 2 || quadrature.is_tensor_product() == false ||
+      internal::MatrixFreeFunctions::ShapeInfo<double>::is_supported(*fe) ==
+        false)
+    return false;
+
+  // the one-dimensional quadrature formula must be the same in all
+  // directions
+  const std::array<Quadrature<1>, dim> &quadrature_1d =
+    quadrature.get_tensor_basis();
+  for (unsigned int d = 1; d < dim; ++d)
+    {
+      if (quadrature_1d[d].size() != quadrature_1d[0].size())
+        return false;
+      for (unsigned int q = 0; q < quadrature_1d[0].size(); ++q)
+        if (std::abs(quadrature_1d[d].point(q)[0] -
+                     quadrature_1d[0].point(q)[0]) > 1e-10 ||
+            std::abs(quadrature_1d[d].weight(q) - quadrature_1d[0].weight(q)) >
+              1e-10)
+          return false;
+    }
+
+  auto data = std::make_unique<
+    internal::FEValuesImplementation::TensorProductEvaluationData<dim>>();
+  data->shape_info.reinit(quadrature_1d[0], *fe);
+
+  // only accept elements that are complete tensor products, which excludes
+  // for example FE_DGP and FE_Q_DG0
+  if (data->shape_info.element_type >
+        internal::MatrixFreeFunctions::tensor_general ||
+      data->shape_info.n_q_points != quadrature.size() ||
+      data->shape_info.dofs_per_component_on_cell != fe->n_dofs_per_cell())
+    return false;
+
+  tensor_product_evaluation = std::move(data);
+  return true;
+}
+
+
+
 template <int dim, int spacedim>
 CellSimilarity::Similarity
 FEValuesBase<dim, spacedim>::get_cell_similarity() const
@@ -0,0 +1,277 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/tensor_product_polynomials.h>
+
+#include <deal.II/fe/fe_values_batch.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <boost/container/small_vector.hpp>
+
+#include <algorithm>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template <int dim, typename Number>
+FEValuesBatch<dim, Number>::FEValuesBatch(const Mapping<dim>       &mapping,
+                                          const FiniteElement<dim> &fe,
+                                          const Quadrature<dim>    &quadrature,
+                                          const UpdateFlags update_flags)
+  : dofs_per_cell(fe.n_dofs_per_cell())
+  , n_quadrature_points(quadrature.size())
+  , mapping(&mapping, typeid(*this).name())
+  , mapping_q(dynamic_cast<const MappingQ<dim, dim> *>(&mapping))
+  , fe(&fe, typeid(*this).name())
+  , quadrature(quadrature)
+  , update_flags(update_flags)
+  , n_filled_cells(0)
+{
+  Assert((update_flags &
+          ~(update_values | update_gradients | update_JxW_values |
+            update_quadrature_points | update_jacobians |
+            update_inverse_jacobians)) == update_default,
+         ExcMessage("FEValuesBatch only supports the flags update_values, "
+                    "update_gradients, update_JxW_values, "
+                    "update_quadrature_points, update_jacobians, and "
+                    "update_inverse_jacobians."));
+  Assert(fe.is_primitive(),
+         ExcMessage("FEValuesBatch only supports primitive elements."));
+
+  // the shape functions of primitive elements are not transformed from the
+  // reference cell, so their values and reference gradients are computed
+  // once and for all here
+  if (update_flags & update_values)
+    {
+      shape_values.resize(dofs_per_cell * n_quadrature_points);
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        for (unsigned int q = 0; q < n_quadrature_points; ++q)
+          shape_values[i * n_quadrature_points + q] =
+            fe.shape_value(i, quadrature.point(q));
+    }
+
+  if (update_flags & update_gradients)
+    {
+      unit_shape_gradients.resize(dofs_per_cell * n_quadrature_points);
+      shape_gradients.resize(dofs_per_cell * n_quadrature_points);
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        for (unsigned int q = 0; q < n_quadrature_points; ++q)
+          unit_shape_gradients[i * n_quadrature_points + q] =
+            fe.shape_grad(i, quadrature.point(q));
+    }
+
+  if (mapping_q != nullptr)
+    {
+      // evaluate the tensor-product polynomials of the mapping at the
+      // quadrature points, in the (hierarchical) order in which
+      // MappingQ::compute_mapping_support_points() returns the points
+      const TensorProductPolynomials<dim> polynomials(
+        mapping_q->polynomials_1d);
+      const unsigned int n_mapping_points = polynomials.n();
+      AssertDimension(mapping_q->renumber_lexicographic_to_hierarchic.size(),
+                      n_mapping_points);
+
+      mapping_support_points.resize(n_mapping_points);
+      mapping_shape_gradients.resize(n_quadrature_points * n_mapping_points);
+      if (update_flags & update_quadrature_points)
+        mapping_shape_values.resize(n_quadrature_points * n_mapping_points);
+      for (unsigned int q = 0; q < n_quadrature_points; ++q)
+        for (unsigned int i = 0; i < n_mapping_points; ++i)
+          {
+            const unsigned int k =
+              q * n_mapping_points +
+              mapping_q->renumber_lexicographic_to_hierarchic[i];
+            mapping_shape_gradients[k] =
+              polynomials.compute_grad(i, quadrature.point(q));
+            if (update_flags & update_quadrature_points)
+              mapping_shape_values[k] =
+                polynomials.compute_value(i, quadrature.point(q));
+          }
+    }
+  else
+    scalar_fe_values = std::make_unique<FEValues<dim>>(
+      mapping,
+      fe,
+      quadrature,
+      update_jacobians | (update_flags & update_quadrature_points));
+
+  jacobians.resize(n_quadrature_points);
+  if (update_flags & (update_gradients | update_inverse_jacobians))
+    inverse_jacobians.resize(n_quadrature_points);
+  if (update_flags & update_JxW_values)
+    JxW_values.resize(n_quadrature_points);
+  if (update_flags & update_quadrature_points)
+    quadrature_points.resize(n_quadrature_points);
+}
+
+
+
+template <int dim, typename Number>
+FEValuesBatch<dim, Number>::FEValuesBatch(const FiniteElement<dim> &fe,
+                                          const Quadrature<dim>    &quadrature,
+                                          const UpdateFlags update_flags)
+  : FEValuesBatch(
+      fe.reference_cell().template get_default_linear_mapping<dim>(),
+      fe,
+      quadrature,
+      update_flags)
+{}
+
+
+
+template <int dim, typename Number>
+void
+FEValuesBatch<dim, Number>::reinit(
+  const ArrayView<const typename Triangulation<dim>::cell_iterator> &cells)
+{
+  Assert(cells.size() > 0, ExcMessage("At least one cell must be given."));
+  AssertIndexRange(cells.size(), n_lanes + 1);
+
+  n_filled_cells = cells.size();
+  for (unsigned int lane = 0; lane < n_lanes; ++lane)
+    this->cells[lane] = cells[std::min(lane, n_filled_cells - 1)];
+
+  if (mapping_q != nullptr)
+    compute_mapping_data_q();
+  else
+    compute_mapping_data_generic();
+
+  const std::vector<double> &weights = quadrature.get_weights();
+  for (unsigned int q = 0; q < n_quadrature_points; ++q)
+    {
+      if (update_flags & update_JxW_values)
+        JxW_values[q] = determinant(jacobians[q]) * Number(weights[q]);
+      if (update_flags & (update_gradients | update_inverse_jacobians))
+        inverse_jacobians[q] = invert(jacobians[q]);
+    }
+
+  // the gradient in real space is J^{-T} times the gradient on the
+  // reference cell
+  if (update_flags & update_gradients)
+    for (unsigned int i = 0; i < dofs_per_cell; ++i)
+      for (unsigned int q = 0; q < n_quadrature_points; ++q)
+        {
+          const Tensor<2, dim, VectorizedArrayType> &inverse_jacobian =
+            inverse_jacobians[q];
+          const Tensor<1, dim, Number> &unit_gradient =
+            unit_shape_gradients[i * n_quadrature_points + q];
+          Tensor<1, dim, VectorizedArrayType> &gradient =
+            shape_gradients[i * n_quadrature_points + q];
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              gradient[d] = inverse_jacobian[0][d] * unit_gradient[0];
+              for (unsigned int e = 1; e < dim; ++e)
+                gradient[d] += inverse_jacobian[e][d] * unit_gradient[e];
+            }
+        }
+}
+
+
+
+template <int dim, typename Number>
+void
+FEValuesBatch<dim, Number>::compute_mapping_data_q()
+{
+  const unsigned int n_mapping_points = mapping_support_points.size();
+
+  // collect the support points of all cells into the lanes. the lanes
+  // beyond the filled ones keep the points of the last cell
+  boost::container::small_vector<Point<dim>, 200> points;
+  for (unsigned int lane = 0; lane < n_lanes; ++lane)
+    {
+      if (lane < n_filled_cells)
+        {
+          points.clear();
+          mapping_q->compute_mapping_support_points(cells[lane], points);
+          AssertDimension(points.size(), n_mapping_points);
+        }
+      for (unsigned int k = 0; k < n_mapping_points; ++k)
+        for (unsigned int d = 0; d < dim; ++d)
+          mapping_support_points[k][d][lane] = points[k][d];
+    }
+
+  for (unsigned int q = 0; q < n_quadrature_points; ++q)
+    {
+      const Tensor<1, dim, Number> *gradients =
+        mapping_shape_gradients.data() + q * n_mapping_points;
+      Tensor<2, dim, VectorizedArrayType> jacobian;
+      for (unsigned int k = 0; k < n_mapping_points; ++k)
+        for (unsigned int d = 0; d < dim; ++d)
+          for (unsigned int e = 0; e < dim; ++e)
+            jacobian[d][e] += mapping_support_points[k][d] * gradients[k][e];
+      jacobians[q] = jacobian;
+
+      if (update_flags & update_quadrature_points)
+        {
+          const Number *values =
+            mapping_shape_values.data() + q * n_mapping_points;
+          Point<dim, VectorizedArrayType> point;
+          for (unsigned int k = 0; k < n_mapping_points; ++k)
+            for (unsigned int d = 0; d < dim; ++d)
+              point[d] += mapping_support_points[k][d] * values[k];
+          quadrature_points[q] = point;
+        }
+    }
+}
+
+
+
+template <int dim, typename Number>
+void
+FEValuesBatch<dim, Number>::compute_mapping_data_generic()
+{
+  for (unsigned int lane = 0; lane < n_lanes; ++lane)
+    {
+      if (lane < n_filled_cells)
+        scalar_fe_values->reinit(cells[lane]);
+      for (unsigned int q = 0; q < n_quadrature_points; ++q)
+        {
+          const DerivativeForm<1, dim, dim> &jacobian =
+            scalar_fe_values->jacobian(q);
+          for (unsigned int d = 0; d < dim; ++d)
+            for (unsigned int e = 0; e < dim; ++e)
+              jacobians[q][d][e][lane] = jacobian[d][e];
+          if (update_flags & update_quadrature_points)
+            for (unsigned int d = 0; d < dim; ++d)
+              quadrature_points[q][d][lane] =
+                scalar_fe_values->quadrature_point(q)[d];
+        }
+    }
+}
+
+
+
+template <int dim, typename Number>
+std::size_t
+FEValuesBatch<dim, Number>::memory_consumption() const
+{
+  const auto vector_size = [](const auto &vector) {
+    return vector.capacity() * sizeof(vector[0]);
+  };
+  return sizeof(*this) + vector_size(shape_values) +
+         vector_size(unit_shape_gradients) + vector_size(shape_gradients) +
+         vector_size(mapping_shape_values) +
+         vector_size(mapping_shape_gradients) +
+         vector_size(mapping_support_points) + vector_size(quadrature_points) +
+         vector_size(jacobians) + vector_size(inverse_jacobians) +
+         vector_size(JxW_values) +
+         (scalar_fe_values ? scalar_fe_values->memory_consumption() : 0);
+}
+
+
+#include "fe/fe_values_batch.inst"
+
+DEAL_II_NAMESPACE_CLOSE
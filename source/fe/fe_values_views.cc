@@ -63,8 +63,11 @@ namespace FEValuesViews
             (fe.get_nonzero_components(i)[component] == true);
 
         if (shape_function_data[i].is_nonzero_shape_function_component == true)
-          shape_function_data[i].row_index =
-            shape_function_to_row_table[i * fe.n_components() + component];
+          {
+            shape_function_data[i].row_index =
+              shape_function_to_row_table[i * fe.n_components() + component];
+            nonzero_shape_function_indices.push_back(i);
+          }
         else
           shape_function_data[i].row_index = numbers::invalid_unsigned_int;
       }
@@ -129,6 +132,9 @@ namespace FEValuesViews
               true)
             ++n_nonzero_components;
 
+        if (n_nonzero_components > 0)
+          nonzero_shape_function_indices.push_back(i);
+
         if (n_nonzero_components == 0)
           shape_function_data[i].single_nonzero_component = -2;
         else if (n_nonzero_components > 1)
@@ -348,6 +354,7 @@ namespace FEValuesViews
       make_array_view(dof_values.cbegin(), dof_values.cend()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_function_indices,
       values);
   }
 
@@ -373,6 +380,7 @@ namespace FEValuesViews
       make_const_array_view(dof_values),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_function_indices,
       values);
   }
 
@@ -403,6 +411,7 @@ namespace FEValuesViews
       make_array_view(dof_values.cbegin(), dof_values.cend()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_function_indices,
       gradients);
   }
 
@@ -428,6 +437,7 @@ namespace FEValuesViews
       make_const_array_view(dof_values),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_function_indices,
       gradients);
   }
 
@@ -459,6 +469,7 @@ namespace FEValuesViews
 
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_function_indices,
       hessians);
   }
 
@@ -484,6 +495,7 @@ namespace FEValuesViews
       make_const_array_view(dof_values),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_function_indices,
       hessians);
   }
 
@@ -514,6 +526,7 @@ namespace FEValuesViews
       make_array_view(dof_values.cbegin(), dof_values.cend()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_function_indices,
       laplacians);
   }
 
@@ -539,6 +552,7 @@ namespace FEValuesViews
       make_const_array_view(dof_values),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_function_indices,
       laplacians);
   }
 
@@ -570,6 +584,7 @@ namespace FEValuesViews
       make_array_view(dof_values.cbegin(), dof_values.cend()),
       fe_values->finite_element_output.shape_3rd_derivatives,
       shape_function_data,
+      nonzero_shape_function_indices,
       third_derivatives);
   }
 
@@ -596,6 +611,7 @@ namespace FEValuesViews
       make_const_array_view(dof_values),
       fe_values->finite_element_output.shape_3rd_derivatives,
       shape_function_data,
+      nonzero_shape_function_indices,
       third_derivatives);
   }
 
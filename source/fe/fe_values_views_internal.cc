@@ -68,34 +68,31 @@ namespace FEValuesViews
       const ArrayView<const Number> &dof_values,
       const Table<2, double>        &shape_values,
       const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
-        &shape_function_data,
+                                      &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename ProductType<Number, double>::type> &values)
     {
-      const unsigned int dofs_per_cell       = dof_values.size();
       const unsigned int n_quadrature_points = values.size();
 
       std::fill(values.begin(),
                 values.end(),
                 dealii::internal::NumberType<Number>::value(0.0));
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
-        if (shape_function_data[shape_function]
-              .is_nonzero_shape_function_component)
-          {
-            const Number &value = dof_values[shape_function];
-            // For auto-differentiable numbers, the fact that a DoF value is
-            // zero does not imply that its derivatives are zero as well. So we
-            // can't filter by value for these number types.
-            if (CheckForZero<Number>::value(value) == true)
-              continue;
-
-            const double *shape_value_ptr =
-              &shape_values(shape_function_data[shape_function].row_index, 0);
-            for (unsigned int q_point = 0; q_point < n_quadrature_points;
-                 ++q_point, ++shape_value_ptr)
-              values[q_point] += value * (*shape_value_ptr);
-          }
+      for (const unsigned int shape_function : nonzero_shape_functions)
+        {
+          const Number &value = dof_values[shape_function];
+          // For auto-differentiable numbers, the fact that a DoF value is
+          // zero does not imply that its derivatives are zero as well. So we
+          // can't filter by value for these number types.
+          if (CheckForZero<Number>::value(value) == true)
+            continue;
+
+          const double *shape_value_ptr =
+            &shape_values(shape_function_data[shape_function].row_index, 0);
+          for (unsigned int q_point = 0; q_point < n_quadrature_points;
+               ++q_point, ++shape_value_ptr)
+            values[q_point] += value * (*shape_value_ptr);
+        }
     }
 
 
@@ -106,12 +103,12 @@ namespace FEValuesViews
       const ArrayView<const Number>                   &dof_values,
       const Table<2, dealii::Tensor<order, spacedim>> &shape_derivatives,
       const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
-        &shape_function_data,
+                                      &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<
         typename ProductType<Number, dealii::Tensor<order, spacedim>>::type>
         &derivatives)
     {
-      const unsigned int dofs_per_cell       = dof_values.size();
       const unsigned int n_quadrature_points = derivatives.size();
 
       std::fill(
@@ -119,25 +116,22 @@ namespace FEValuesViews
         derivatives.end(),
         typename ProductType<Number, dealii::Tensor<order, spacedim>>::type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
-        if (shape_function_data[shape_function]
-              .is_nonzero_shape_function_component)
-          {
-            const Number &value = dof_values[shape_function];
-            // For auto-differentiable numbers, the fact that a DoF value is
-            // zero does not imply that its derivatives are zero as well. So we
-            // can't filter by value for these number types.
-            if (CheckForZero<Number>::value(value) == true)
-              continue;
-
-            const dealii::Tensor<order, spacedim> *shape_derivative_ptr =
-              &shape_derivatives[shape_function_data[shape_function].row_index]
-                                [0];
-            for (unsigned int q_point = 0; q_point < n_quadrature_points;
-                 ++q_point)
-              derivatives[q_point] += value * (*shape_derivative_ptr++);
-          }
+      for (const unsigned int shape_function : nonzero_shape_functions)
+        {
+          const Number &value = dof_values[shape_function];
+          // For auto-differentiable numbers, the fact that a DoF value is
+          // zero does not imply that its derivatives are zero as well. So we
+          // can't filter by value for these number types.
+          if (CheckForZero<Number>::value(value) == true)
+            continue;
+
+          const dealii::Tensor<order, spacedim> *shape_derivative_ptr =
+            &shape_derivatives[shape_function_data[shape_function].row_index]
+                              [0];
+          for (unsigned int q_point = 0; q_point < n_quadrature_points;
+               ++q_point)
+            derivatives[q_point] += value * (*shape_derivative_ptr++);
+        }
     }
 
 
@@ -148,11 +142,11 @@ namespace FEValuesViews
       const ArrayView<const Number>               &dof_values,
       const Table<2, dealii::Tensor<2, spacedim>> &shape_hessians,
       const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
-        &shape_function_data,
+                                      &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename Scalar<dim, spacedim>::
                     template solution_laplacian_type<Number>> &laplacians)
     {
-      const unsigned int dofs_per_cell       = dof_values.size();
       const unsigned int n_quadrature_points = laplacians.size();
 
       std::fill(
@@ -161,24 +155,21 @@ namespace FEValuesViews
         typename Scalar<dim,
                         spacedim>::template solution_laplacian_type<Number>());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
-        if (shape_function_data[shape_function]
-              .is_nonzero_shape_function_component)
-          {
-            const Number &value = dof_values[shape_function];
-            // For auto-differentiable numbers, the fact that a DoF value is
-            // zero does not imply that its derivatives are zero as well. So we
-            // can't filter by value for these number types.
-            if (CheckForZero<Number>::value(value) == true)
-              continue;
-
-            const dealii::Tensor<2, spacedim> *shape_hessian_ptr =
-              &shape_hessians[shape_function_data[shape_function].row_index][0];
-            for (unsigned int q_point = 0; q_point < n_quadrature_points;
-                 ++q_point)
-              laplacians[q_point] += value * trace(*shape_hessian_ptr++);
-          }
+      for (const unsigned int shape_function : nonzero_shape_functions)
+        {
+          const Number &value = dof_values[shape_function];
+          // For auto-differentiable numbers, the fact that a DoF value is
+          // zero does not imply that its derivatives are zero as well. So we
+          // can't filter by value for these number types.
+          if (CheckForZero<Number>::value(value) == true)
+            continue;
+
+          const dealii::Tensor<2, spacedim> *shape_hessian_ptr =
+            &shape_hessians[shape_function_data[shape_function].row_index][0];
+          for (unsigned int q_point = 0; q_point < n_quadrature_points;
+               ++q_point)
+            laplacians[q_point] += value * trace(*shape_hessian_ptr++);
+        }
     }
 
 
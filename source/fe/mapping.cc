@@ -170,6 +170,21 @@ Mapping<dim, spacedim>::transform_points_real_to_unit_cell(
 
 
 
+template <int dim, int spacedim>
+void
+Mapping<dim, spacedim>::transform_points_real_to_unit_cell(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const ArrayView<const Point<spacedim>>                     &real_points,
+  const ArrayView<const Point<dim>> &initial_unit_points,
+  const ArrayView<Point<dim>>       &unit_points) const
+{
+  AssertDimension(real_points.size(), initial_unit_points.size());
+  (void)initial_unit_points;
+  transform_points_real_to_unit_cell(cell, real_points, unit_points);
+}
+
+
+
 template <int dim, int spacedim>
 Point<dim - 1>
 Mapping<dim, spacedim>::project_real_point_to_unit_point_on_face(
@@ -39,6 +39,7 @@
 #include <limits>
 #include <memory>
 #include <numeric>
+#include <optional>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -241,6 +242,7 @@ MappingQ<dim, spacedim>::MappingQ(const unsigned int p)
   , support_point_weights_cell(
       internal::MappingQImplementation::compute_support_point_weights_cell<dim>(
         this->polynomial_degree))
+  , inverse_mapping_counters{}
 {
   Assert(p >= 1,
          ExcMessage("It only makes sense to create polynomial mappings "
@@ -260,6 +262,7 @@ MappingQ<dim, spacedim>::MappingQ(const MappingQ<dim, spacedim> &mapping)
   , support_point_weights_perimeter_to_interior(
       mapping.support_point_weights_perimeter_to_interior)
   , support_point_weights_cell(mapping.support_point_weights_cell)
+  , inverse_mapping_counters{}
 {}
 
 
@@ -664,6 +667,48 @@ MappingQ<dim, spacedim>::transform_points_real_to_unit_cell(
       return;
     }
 
+  do_transform_points_real_to_unit_cell(cell,
+                                        real_points,
+                                        ArrayView<const Point<dim>>(),
+                                        unit_points);
+}
+
+
+
+template <int dim, int spacedim>
+void
+MappingQ<dim, spacedim>::transform_points_real_to_unit_cell(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const ArrayView<const Point<spacedim>>                     &real_points,
+  const ArrayView<const Point<dim>> &initial_unit_points,
+  const ArrayView<Point<dim>>       &unit_points) const
+{
+  AssertDimension(real_points.size(), initial_unit_points.size());
+
+  if (dim < spacedim)
+    {
+      Mapping<dim, spacedim>::transform_points_real_to_unit_cell(cell,
+                                                                 real_points,
+                                                                 unit_points);
+      return;
+    }
+
+  do_transform_points_real_to_unit_cell(cell,
+                                        real_points,
+                                        initial_unit_points,
+                                        unit_points);
+}
+
+
+
+template <int dim, int spacedim>
+void
+MappingQ<dim, spacedim>::do_transform_points_real_to_unit_cell(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const ArrayView<const Point<spacedim>>                     &real_points,
+  const ArrayView<const Point<dim>> &initial_unit_points,
+  const ArrayView<Point<dim>>       &unit_points) const
+{
   AssertDimension(real_points.size(), unit_points.size());
   boost::container::small_vector<Point<spacedim>, 200>
     support_points_higher_order;
@@ -685,62 +730,175 @@ MappingQ<dim, spacedim>::transform_points_real_to_unit_cell(
     Utilities::pow(polynomial_degree + 1, dim));
 
   // From the given (high-order) support points, now only pick the first
-  // 2^dim points and construct an affine approximation from those.
-  internal::MappingQImplementation::InverseQuadraticApproximation<dim, spacedim>
-    inverse_approximation(support_points, unit_cell_support_points);
+  // 2^dim points and construct an affine approximation from those. This is
+  // only needed when no initial guesses are given or when the iteration
+  // from one of them fails, so we set it up on first use.
+  std::optional<internal::MappingQImplementation::
+                  InverseQuadraticApproximation<dim, spacedim>>
+    inverse_approximation;
+  const auto get_inverse_approximation = [&]() -> const auto & {
+    if (!inverse_approximation)
+      inverse_approximation.emplace(support_points, unit_cell_support_points);
+    return *inverse_approximation;
+  };
+  // Guesses that are not finite, such as the signaling NaNs of reference
+  // locations that have not been computed yet, are treated as absent.
+  const auto has_initial_guess = [&](const unsigned int i) {
+    if (initial_unit_points.empty())
+      return false;
+    for (unsigned int d = 0; d < dim; ++d)
+      if (!numbers::is_finite(initial_unit_points[i][d]))
+        return false;
+    return true;
+  };
+
+  // Guesses far outside the reference cell could lead the Newton iteration
+  // to another preimage of the point under the polynomial mapping, which is
+  // only invertible in a neighborhood of the cell, so we start from their
+  // projection to the reference cell.
+  const auto get_initial_guess = [&](const unsigned int i) {
+    return GeometryInfo<dim>::project_to_unit_cell(initial_unit_points[i]);
+  };
 
   const unsigned int n_points = real_points.size();
   const unsigned int n_lanes  = VectorizedArray<double>::size();
 
+  std::size_t n_newton_iterations = 0, n_rejected = 0, n_failed = 0;
+
+  // Transform a single point, first from the initial guess (if given) and
+  // then from the approximation of the inverse mapping
+  const auto transform_single_point = [&](const unsigned int i,
+                                          const bool try_initial_guess) {
+    unsigned int n_iterations = 0;
+    if (try_initial_guess)
+      {
+        unit_points[i] = internal::MappingQImplementation::
+          do_transform_real_to_unit_cell_internal<dim, spacedim>(
+            real_points[i],
+            get_initial_guess(i),
+            support_points,
+            polynomials_1d,
+            renumber_lexicographic_to_hierarchic,
+            false,
+            &n_iterations);
+        n_newton_iterations += n_iterations;
+        if (unit_points[i][0] != std::numeric_limits<double>::lowest())
+          return;
+        ++n_rejected;
+      }
+    unit_points[i] = internal::MappingQImplementation::
+      do_transform_real_to_unit_cell_internal<dim, spacedim>(
+        real_points[i],
+        get_inverse_approximation().compute(real_points[i]),
+        support_points,
+        polynomials_1d,
+        renumber_lexicographic_to_hierarchic,
+        false,
+        &n_iterations);
+    n_newton_iterations += n_iterations;
+    if (unit_points[i][0] == std::numeric_limits<double>::lowest())
+      ++n_failed;
+  };
+
   // Use the more heavy VectorizedArray code path if there is more than
   // one point left to compute
   for (unsigned int i = 0; i < n_points; i += n_lanes)
     if (n_points - i > 1)
       {
-        Point<spacedim, VectorizedArray<double>> p_vec;
+        const unsigned int n_filled_lanes = std::min(n_lanes, n_points - i);
+
+        Point<spacedim, VectorizedArray<double>>          p_vec;
+        Point<dim, VectorizedArray<double>>               initial_p_unit;
+        std::array<bool, VectorizedArray<double>::size()> lane_has_guess;
+
+        bool all_lanes_have_guesses = true;
         for (unsigned int j = 0; j < n_lanes; ++j)
-          if (i + j < n_points)
-            for (unsigned int d = 0; d < spacedim; ++d)
-              p_vec[d][j] = real_points[i + j][d];
-          else
+          {
+            const unsigned int index = (j < n_filled_lanes ? i + j : i);
             for (unsigned int d = 0; d < spacedim; ++d)
-              p_vec[d][j] = real_points[i][d];
+              p_vec[d][j] = real_points[index][d];
+            lane_has_guess[j] = has_initial_guess(index);
+            if (lane_has_guess[j])
+              {
+                const Point<dim> guess = get_initial_guess(index);
+                for (unsigned int d = 0; d < dim; ++d)
+                  initial_p_unit[d][j] = guess[d];
+              }
+            else
+              all_lanes_have_guesses = false;
+          }
+        if (!all_lanes_have_guesses)
+          {
+            const Point<dim, VectorizedArray<double>> approximation =
+              get_inverse_approximation().compute(p_vec);
+            for (unsigned int j = 0; j < n_lanes; ++j)
+              if (!lane_has_guess[j])
+                for (unsigned int d = 0; d < dim; ++d)
+                  initial_p_unit[d][j] = approximation[d][j];
+          }
 
+        unsigned int                        n_iterations = 0;
         Point<dim, VectorizedArray<double>> unit_point =
           internal::MappingQImplementation::
             do_transform_real_to_unit_cell_internal<dim, spacedim>(
               p_vec,
-              inverse_approximation.compute(p_vec),
+              initial_p_unit,
               support_points,
               polynomials_1d,
-              renumber_lexicographic_to_hierarchic);
+              renumber_lexicographic_to_hierarchic,
+              false,
+              &n_iterations);
+        n_newton_iterations += n_iterations * n_filled_lanes;
 
         // If the vectorized computation failed, it could be that only some of
         // the lanes failed but others would have succeeded if we had let them
         // compute alone without interference (like negative Jacobian
         // determinants) from other SIMD lanes. Repeat the computation in this
-        // unlikely case with scalar arguments.
-        for (unsigned int j = 0; j < n_lanes && i + j < n_points; ++j)
+        // unlikely case with scalar arguments, starting from the
+        // approximation of the inverse mapping.
+        for (unsigned int j = 0; j < n_filled_lanes; ++j)
           if (unit_point[0][j] != std::numeric_limits<double>::lowest())
             for (unsigned int d = 0; d < dim; ++d)
               unit_points[i + j][d] = unit_point[d][j];
           else
-            unit_points[i + j] = internal::MappingQImplementation::
-              do_transform_real_to_unit_cell_internal<dim, spacedim>(
-                real_points[i + j],
-                inverse_approximation.compute(real_points[i + j]),
-                support_points,
-                polynomials_1d,
-                renumber_lexicographic_to_hierarchic);
+            {
+              if (lane_has_guess[j])
+                ++n_rejected;
+              transform_single_point(i + j, false);
+            }
       }
     else
-      unit_points[i] = internal::MappingQImplementation::
-        do_transform_real_to_unit_cell_internal<dim, spacedim>(
-          real_points[i],
-          inverse_approximation.compute(real_points[i]),
-          support_points,
-          polynomials_1d,
-          renumber_lexicographic_to_hierarchic);
+      transform_single_point(i, has_initial_guess(i));
+
+  inverse_mapping_counters[0].fetch_add(n_points, std::memory_order_relaxed);
+  inverse_mapping_counters[1].fetch_add(n_newton_iterations,
+                                        std::memory_order_relaxed);
+  inverse_mapping_counters[2].fetch_add(n_rejected, std::memory_order_relaxed);
+  inverse_mapping_counters[3].fetch_add(n_failed, std::memory_order_relaxed);
+}
+
+
+
+template <int dim, int spacedim>
+typename MappingQ<dim, spacedim>::InverseMappingStatistics
+MappingQ<dim, spacedim>::get_inverse_mapping_statistics() const
+{
+  InverseMappingStatistics statistics;
+  statistics.n_points                   = inverse_mapping_counters[0].load();
+  statistics.n_newton_iterations        = inverse_mapping_counters[1].load();
+  statistics.n_initial_guesses_rejected = inverse_mapping_counters[2].load();
+  statistics.n_failed                   = inverse_mapping_counters[3].load();
+  return statistics;
+}
+
+
+
+template <int dim, int spacedim>
+void
+MappingQ<dim, spacedim>::reset_inverse_mapping_statistics() const
+{
+  for (auto &counter : inverse_mapping_counters)
+    counter.store(0);
 }
 
 
@@ -11,9 +11,10 @@
 // -----------------------------------------------------------------------------
 
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/utilities.h>
-#include <deal.II/base/work_stream.h>
 
 #include <deal.II/dofs/dof_tools.h>
 
@@ -34,8 +35,10 @@ DEAL_II_NAMESPACE_OPEN
 
 template <int dim, int spacedim>
 MappingQCache<dim, spacedim>::MappingQCache(
-  const unsigned int polynomial_degree)
+  const unsigned int polynomial_degree,
+  const bool         use_float_storage)
   : MappingQ<dim, spacedim>(polynomial_degree)
+  , use_float_storage(use_float_storage)
   , uses_level_info(false)
 {}
 
@@ -45,7 +48,9 @@ template <int dim, int spacedim>
 MappingQCache<dim, spacedim>::MappingQCache(
   const MappingQCache<dim, spacedim> &mapping)
   : MappingQ<dim, spacedim>(mapping)
+  , use_float_storage(mapping.use_float_storage)
   , support_point_cache(mapping.support_point_cache)
+  , support_point_cache_float(mapping.support_point_cache_float)
   , uses_level_info(mapping.uses_level_info)
 {}
 
@@ -59,6 +64,7 @@ MappingQCache<dim, spacedim>::~MappingQCache()
   // invalid memory that has been left back by freeing an object of this
   // class.
   support_point_cache.reset();
+  support_point_cache_float.reset();
   clear_signal.disconnect();
 }
 
@@ -143,43 +149,121 @@ MappingQCache<dim, spacedim>::initialize(
     &compute_points_on_cell)
 {
   clear_signal.disconnect();
-  clear_signal = triangulation.signals.any_change.connect(
-    [&]() -> void { this->support_point_cache.reset(); });
+  clear_signal = triangulation.signals.any_change.connect([&]() -> void {
+    this->support_point_cache.reset();
+    this->support_point_cache_float.reset();
+  });
 
-  support_point_cache =
-    std::make_shared<std::vector<std::vector<std::vector<Point<spacedim>>>>>(
-      triangulation.n_levels());
+  support_point_cache.reset();
+  support_point_cache_float.reset();
+  if (use_float_storage)
+    {
+      support_point_cache_float = std::make_shared<
+        std::vector<std::vector<std::vector<Point<spacedim, float>>>>>(
+        triangulation.n_levels());
+      for (unsigned int l = 0; l < triangulation.n_levels(); ++l)
+        (*support_point_cache_float)[l].resize(triangulation.n_raw_cells(l));
+    }
+  else
+    {
+      support_point_cache = std::make_shared<
+        std::vector<std::vector<std::vector<Point<spacedim>>>>>(
+        triangulation.n_levels());
+      for (unsigned int l = 0; l < triangulation.n_levels(); ++l)
+        (*support_point_cache)[l].resize(triangulation.n_raw_cells(l));
+    }
+
+  // Work on contiguous ranges of cell indices on each level rather than
+  // scheduling one task per cell, which has a considerable overhead for
+  // cheap functions. Unused cells in the ranges are skipped.
   for (unsigned int l = 0; l < triangulation.n_levels(); ++l)
-    (*support_point_cache)[l].resize(triangulation.n_raw_cells(l));
-
-  WorkStream::run(
-    triangulation.begin(),
-    triangulation.end(),
-    [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell,
-        void *,
-        void *) {
-      const auto result = compute_points_on_cell(cell);
-      (*support_point_cache)[cell->level()][cell->index()].assign(
-        result.begin(), result.end());
-      // Do not use `this` in Assert because nvcc when using C++20 assumes that
-      // `this` is an integer and we get the following error: invalid type
-      // argument of unary '*' (have 'int')
-      const unsigned int d = this->get_degree() + 1;
-      AssertDimension(
-        (*support_point_cache)[cell->level()][cell->index()].size(),
-        Utilities::pow(d, dim));
-    },
-    /* copier */ std::function<void(void *)>(),
-    /* scratch_data */ nullptr,
-    /* copy_data */ nullptr,
-    2 * MultithreadInfo::n_threads(),
-    /* chunk_size = */ 1);
+    parallel::apply_to_subranges(
+      0U,
+      triangulation.n_raw_cells(l),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int index = begin; index < end; ++index)
+          {
+            const typename Triangulation<dim, spacedim>::cell_iterator cell(
+              &triangulation, l, index);
+            if (cell->used())
+              store_support_points(cell, compute_points_on_cell(cell));
+          }
+      },
+      /* grainsize = */ 16);
 
   uses_level_info = true;
 }
 
 
 
+template <int dim, int spacedim>
+void
+MappingQCache<dim, spacedim>::update(
+  const std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+    &cells,
+  const std::function<std::vector<Point<spacedim>>(
+    const typename Triangulation<dim, spacedim>::cell_iterator &)>
+    &compute_points_on_cell)
+{
+  Assert(support_point_cache.get() != nullptr ||
+           support_point_cache_float.get() != nullptr,
+         ExcMessage("Must call MappingQCache::initialize() before "
+                    "MappingQCache::update() and after the mesh has "
+                    "changed!"));
+
+  parallel::apply_to_subranges(
+    std::size_t(0),
+    cells.size(),
+    [&](const std::size_t begin, const std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i)
+        {
+          Assert(uses_level_info || cells[i]->is_active(),
+                 ExcMessage("The cache has only been set up for the active "
+                            "cells and can not be updated on other cells."));
+          store_support_points(cells[i], compute_points_on_cell(cells[i]));
+        }
+    },
+    /* grainsize = */ 16);
+}
+
+
+
+template <int dim, int spacedim>
+void
+MappingQCache<dim, spacedim>::store_support_points(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const std::vector<Point<spacedim>>                         &points)
+{
+  // Do not use `this` in Assert because nvcc when using C++20 assumes that
+  // `this` is an integer and we get the following error: invalid type
+  // argument of unary '*' (have 'int')
+  const unsigned int d = this->get_degree() + 1;
+  AssertDimension(points.size(), Utilities::pow(d, dim));
+
+  if (use_float_storage)
+    {
+      AssertIndexRange(cell->level(), support_point_cache_float->size());
+      AssertIndexRange(cell->index(),
+                       (*support_point_cache_float)[cell->level()].size());
+      auto &cached_points =
+        (*support_point_cache_float)[cell->level()][cell->index()];
+      cached_points.resize(points.size());
+      for (unsigned int i = 0; i < points.size(); ++i)
+        for (unsigned int c = 0; c < spacedim; ++c)
+          cached_points[i][c] = static_cast<float>(points[i][c]);
+    }
+  else
+    {
+      AssertIndexRange(cell->level(), support_point_cache->size());
+      AssertIndexRange(cell->index(),
+                       (*support_point_cache)[cell->level()].size());
+      (*support_point_cache)[cell->level()][cell->index()].assign(
+        points.begin(), points.end());
+    }
+}
+
+
+
 template <int dim, int spacedim>
 void
 MappingQCache<dim, spacedim>::initialize(
@@ -300,6 +384,46 @@ MappingQCache<dim, spacedim>::initialize(
   const DoFHandler<dim, spacedim> &dof_handler,
   const VectorType                &vector,
   const bool                       vector_describes_relative_displacement)
+{
+  initialize_or_update(mapping,
+                       dof_handler,
+                       vector,
+                       vector_describes_relative_displacement,
+                       nullptr);
+}
+
+
+
+template <int dim, int spacedim>
+template <typename VectorType>
+void
+MappingQCache<dim, spacedim>::update(
+  const Mapping<dim, spacedim>    &mapping,
+  const DoFHandler<dim, spacedim> &dof_handler,
+  const VectorType                &vector,
+  const bool                       vector_describes_relative_displacement,
+  const std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+    &cells)
+{
+  initialize_or_update(mapping,
+                       dof_handler,
+                       vector,
+                       vector_describes_relative_displacement,
+                       &cells);
+}
+
+
+
+template <int dim, int spacedim>
+template <typename VectorType>
+void
+MappingQCache<dim, spacedim>::initialize_or_update(
+  const Mapping<dim, spacedim>    &mapping,
+  const DoFHandler<dim, spacedim> &dof_handler,
+  const VectorType                &vector,
+  const bool                       vector_describes_relative_displacement,
+  const std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+    *cells)
 {
   AssertDimension(dof_handler.get_fe_collection().size(), 1);
   const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
@@ -339,9 +463,10 @@ MappingQCache<dim, spacedim>::initialize(
   const bool interpolation_of_values_is_needed =
     ((is_fe_q || is_fe_dgq) && fe.degree == this->get_degree()) == false;
 
-  // Step 2: loop over all cells
-  this->initialize(
-    dof_handler.get_triangulation(),
+  // Step 2: loop over all cells, or the given ones in case of an update
+  const std::function<std::vector<Point<spacedim>>(
+    const typename Triangulation<dim, spacedim>::cell_iterator &)>
+    compute_points_on_cell(
     [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell_tria)
       -> std::vector<Point<spacedim>> {
       const bool is_active_non_artificial_cell =
@@ -490,7 +615,13 @@ MappingQCache<dim, spacedim>::initialize(
       return std::vector<Point<spacedim>>(points.begin(), points.end());
     });
 
-  uses_level_info = false;
+  if (cells == nullptr)
+    {
+      this->initialize(dof_handler.get_triangulation(), compute_points_on_cell);
+      uses_level_info = false;
+    }
+  else
+    this->update(*cells, compute_points_on_cell);
 }
 
 
@@ -721,6 +852,9 @@ MappingQCache<dim, spacedim>::memory_consumption() const
   if (support_point_cache.get() != nullptr)
     return sizeof(*this) +
            MemoryConsumption::memory_consumption(*support_point_cache);
+  else if (support_point_cache_float.get() != nullptr)
+    return sizeof(*this) +
+           MemoryConsumption::memory_consumption(*support_point_cache_float);
   else
     return sizeof(*this);
 }
@@ -733,17 +867,34 @@ MappingQCache<dim, spacedim>::compute_mapping_support_points(
   const typename Triangulation<dim, spacedim>::cell_iterator &cell,
   boost::container::small_vector<Point<spacedim>, 200>       &points) const
 {
-  Assert(support_point_cache.get() != nullptr,
+  Assert(support_point_cache.get() != nullptr ||
+           support_point_cache_float.get() != nullptr,
          ExcMessage("Must call MappingQCache::initialize() before "
                     "using it or after mesh has changed!"));
 
   Assert(uses_level_info || cell->is_active(), ExcInternalError());
 
-  AssertIndexRange(cell->level(), support_point_cache->size());
-  AssertIndexRange(cell->index(), (*support_point_cache)[cell->level()].size());
-  const auto &cached_points =
-    (*support_point_cache)[cell->level()][cell->index()];
-  points.assign(cached_points.begin(), cached_points.end());
+  if (use_float_storage)
+    {
+      AssertIndexRange(cell->level(), support_point_cache_float->size());
+      AssertIndexRange(cell->index(),
+                       (*support_point_cache_float)[cell->level()].size());
+      const auto &cached_points =
+        (*support_point_cache_float)[cell->level()][cell->index()];
+      points.resize(cached_points.size());
+      for (unsigned int i = 0; i < cached_points.size(); ++i)
+        for (unsigned int c = 0; c < spacedim; ++c)
+          points[i][c] = cached_points[i][c];
+    }
+  else
+    {
+      AssertIndexRange(cell->level(), support_point_cache->size());
+      AssertIndexRange(cell->index(),
+                       (*support_point_cache)[cell->level()].size());
+      const auto &cached_points =
+        (*support_point_cache)[cell->level()][cell->index()];
+      points.assign(cached_points.begin(), cached_points.end());
+    }
 }
 
 
@@ -759,22 +910,43 @@ boost::container::small_vector<Point<spacedim>,
 MappingQCache<dim, spacedim>::get_vertices(
   const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
 {
-  Assert(support_point_cache.get() != nullptr,
+  Assert(support_point_cache.get() != nullptr ||
+           support_point_cache_float.get() != nullptr,
          ExcMessage("Must call MappingQCache::initialize() before "
                     "using it or after mesh has changed!"));
 
   Assert(uses_level_info || cell->is_active(), ExcInternalError());
 
-  AssertIndexRange(cell->level(), support_point_cache->size());
-  AssertIndexRange(cell->index(), (*support_point_cache)[cell->level()].size());
-  const auto ptr = (*support_point_cache)[cell->level()][cell->index()].begin();
-  return boost::container::small_vector<Point<spacedim>,
+  boost::container::small_vector<Point<spacedim>,
 #ifndef _MSC_VER
-                                        ReferenceCells::max_n_vertices<dim>()
+                                 ReferenceCells::max_n_vertices<dim>()
 #else
-                                        GeometryInfo<dim>::vertices_per_cell
+                                 GeometryInfo<dim>::vertices_per_cell
 #endif
-                                        >(ptr, ptr + cell->n_vertices());
+                                 >
+    vertices(cell->n_vertices());
+  if (use_float_storage)
+    {
+      AssertIndexRange(cell->level(), support_point_cache_float->size());
+      AssertIndexRange(cell->index(),
+                       (*support_point_cache_float)[cell->level()].size());
+      const auto &cached_points =
+        (*support_point_cache_float)[cell->level()][cell->index()];
+      for (unsigned int v = 0; v < vertices.size(); ++v)
+        for (unsigned int c = 0; c < spacedim; ++c)
+          vertices[v][c] = cached_points[v][c];
+    }
+  else
+    {
+      AssertIndexRange(cell->level(), support_point_cache->size());
+      AssertIndexRange(cell->index(),
+                       (*support_point_cache)[cell->level()].size());
+      const auto &cached_points =
+        (*support_point_cache)[cell->level()][cell->index()];
+      for (unsigned int v = 0; v < vertices.size(); ++v)
+        vertices[v] = cached_points[v];
+    }
+  return vertices;
 }
 
 
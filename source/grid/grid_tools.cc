@@ -14,6 +14,7 @@
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi.templates.h>
 #include <deal.II/base/mpi_consensus_algorithms.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/thread_management.h>
 
@@ -3387,62 +3388,46 @@ namespace GridTools
       return found_points[id.second];
     };
 
-    // check if the given cell was already in the vector of cells before. If so,
-    // insert in the corresponding vectors the reference point and the id.
-    // Otherwise append a new entry to all vectors.
-    const auto store_cell_point_and_id =
-      [&](
-        const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
-        const Point<dim>   &ref_point,
-        const unsigned int &id) {
-        const auto it = std::find(cells_out.rbegin(), cells_out.rend(), cell);
-        if (it != cells_out.rend())
-          {
-            const auto cell_id =
-              (cells_out.size() - 1 - (it - cells_out.rbegin()));
-            qpoints_out[cell_id].emplace_back(ref_point);
-            maps_out[cell_id].emplace_back(id);
-          }
-        else
-          {
-            cells_out.emplace_back(cell);
-            qpoints_out.emplace_back(std::vector<Point<dim>>({ref_point}));
-            maps_out.emplace_back(std::vector<unsigned int>({id}));
-          }
-      };
+    // The search proceeds in three phases. In the first one, we walk through
+    // the rtree of cell bounding boxes and collect, for each leaf visited, all
+    // points not yet assigned that lie within its box. This gives batches of
+    // points that are likely located in the same cell. In the second phase,
+    // we invert the mapping for all points of a batch at once (which allows
+    // mappings such as MappingQ to use their vectorized Newton iteration),
+    // possibly in parallel over batches, and only fall back to
+    // find_active_cell_around_point() for those points that are not
+    // unambiguously inside the cell of their batch. Finally, the results are
+    // merged serially in the order of the batches, which gives the same
+    // output as if all points had been searched for one at a time.
+    std::vector<
+      std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+                std::vector<unsigned int>>>
+      batches;
 
-    // Check all points within a given pair of box and cell
-    const auto check_all_points_within_box = [&](const auto &leaf) {
+    // Collect all points within a given pair of box and cell
+    const auto collect_all_points_within_box = [&](const auto &leaf) {
       const double                relative_tolerance = 1e-12;
       const BoundingBox<spacedim> box =
         leaf.first.create_extended_relative(relative_tolerance);
-      const auto &cell_hint = leaf.second;
 
+      std::vector<unsigned int> ids;
       for (const auto &point_and_id :
            p_tree | bgi::adaptors::queried(!bgi::satisfies(already_found) &&
                                            bgi::intersects(box)))
         {
-          const auto id = point_and_id.second;
-          const auto cell_and_ref =
-            GridTools::find_active_cell_around_point(cache,
-                                                     points[id],
-                                                     cell_hint);
-          const auto &cell      = cell_and_ref.first;
-          const auto &ref_point = cell_and_ref.second;
-
-          if (cell.state() == IteratorState::valid)
-            store_cell_point_and_id(cell, ref_point, id);
-          else
-            missing_points_out.emplace_back(id);
+          ids.push_back(point_and_id.second);
 
           // Don't look anymore for this point
-          found_points[id] = true;
+          found_points[point_and_id.second] = true;
         }
+
+      if (ids.size() > 0)
+        batches.emplace_back(leaf.second, std::move(ids));
     };
 
     // If a hint cell was given, use it
     if (cell_hint.state() == IteratorState::valid)
-      check_all_points_within_box(
+      collect_all_points_within_box(
         std::make_pair(mapping.get_bounding_box(cell_hint), cell_hint));
 
     // Now loop over all points that have not been found yet
@@ -3451,15 +3436,111 @@ namespace GridTools
         {
           // Get the closest cell to this point
           const auto leaf = b_tree.qbegin(bgi::nearest(points[i], 1));
-          // Now checks all points that fall within this box
+          // Now collect all points that fall within this box
           if (leaf != b_tree.qend())
-            check_all_points_within_box(*leaf);
+            collect_all_points_within_box(*leaf);
           else
             {
               // We should not get here. Throw an error.
               DEAL_II_ASSERT_UNREACHABLE();
             }
         }
+
+    // Set up the data structures used by find_active_cell_around_point()
+    // before entering the parallel region, so that the worker threads do not
+    // need to wait for each other on the first access.
+    cache.get_vertex_to_cell_map();
+    cache.get_vertex_to_cell_centers_directions();
+    cache.get_used_vertices_rtree();
+
+    // A point is accepted for the cell of its batch without a further search
+    // if it is inside the reference cell by at least this margin. Points
+    // closer to the boundary of the cell might also be found in a neighbor
+    // (and the choice among the candidates is made by
+    // find_active_cell_around_point()), so we treat them like points outside
+    // the cell.
+    const double interior_tolerance = 1e-6;
+
+    std::vector<std::vector<
+      std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+                Point<dim>>>>
+      batch_results(batches.size());
+
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(batches.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<Point<spacedim>> real_points;
+        std::vector<Point<dim>>      unit_points;
+
+        for (unsigned int b = begin; b < end; ++b)
+          {
+            const auto &cell = batches[b].first;
+            const auto &ids  = batches[b].second;
+            auto       &results = batch_results[b];
+
+            real_points.resize(ids.size());
+            for (unsigned int i = 0; i < ids.size(); ++i)
+              real_points[i] = points[ids[i]];
+
+            const bool try_batch = !cell->is_artificial();
+            if (try_batch)
+              {
+                unit_points.resize(ids.size());
+                mapping.transform_points_real_to_unit_cell(
+                  cell,
+                  make_array_view(real_points),
+                  make_array_view(unit_points));
+              }
+
+            results.resize(ids.size());
+            for (unsigned int i = 0; i < ids.size(); ++i)
+              if (try_batch &&
+                  cell->reference_cell().contains_point(unit_points[i],
+                                                        -interior_tolerance))
+                results[i] = std::make_pair(cell, unit_points[i]);
+              else
+                results[i] =
+                  GridTools::find_active_cell_around_point(cache,
+                                                           real_points[i],
+                                                           cell);
+          }
+      },
+      /* grainsize = */ 8);
+
+    // Check whether the given cell was already in the vector of cells
+    // before. If so, insert in the corresponding vectors the reference point
+    // and the id. Otherwise append a new entry to all vectors.
+    std::unordered_map<unsigned int, unsigned int> active_cell_to_out_index;
+    for (unsigned int b = 0; b < batches.size(); ++b)
+      for (unsigned int i = 0; i < batches[b].second.size(); ++i)
+        {
+          const auto &cell      = batch_results[b][i].first;
+          const auto &ref_point = batch_results[b][i].second;
+          const auto  id        = batches[b].second[i];
+
+          if (cell.state() != IteratorState::valid)
+            {
+              missing_points_out.emplace_back(id);
+              continue;
+            }
+
+          const auto it =
+            active_cell_to_out_index.emplace(cell->active_cell_index(),
+                                             cells_out.size());
+          if (it.second == false)
+            {
+              qpoints_out[it.first->second].emplace_back(ref_point);
+              maps_out[it.first->second].emplace_back(id);
+            }
+          else
+            {
+              cells_out.emplace_back(cell);
+              qpoints_out.emplace_back(std::vector<Point<dim>>({ref_point}));
+              maps_out.emplace_back(std::vector<unsigned int>({id}));
+            }
+        }
+
     // Now make sure we send out the rest of the points that we did not find.
     for (unsigned int i = 0; i < np; ++i)
       if (found_points[i] == false)
@@ -12,6 +12,7 @@
 
 #include <deal.II/base/bounding_box.h>
 #include <deal.II/base/mpi_stub.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/grid/filtered_iterator.h>
 #include <deal.II/grid/grid_tools.h>
@@ -27,9 +28,10 @@ namespace GridTools
     : update_flags(update_all)
     , tria(&tria)
     , mapping(&mapping)
+    , pending_update_flags(update_nothing)
+    , incremental_update_flags(update_nothing)
   {
-    tria_change_signal =
-      tria.signals.any_change.connect([&]() { mark_for_update(update_all); });
+    connect_to_triangulation_signals();
   }
 
 
@@ -38,9 +40,10 @@ namespace GridTools
   Cache<dim, spacedim>::Cache(const Triangulation<dim, spacedim> &tria)
     : update_flags(update_all)
     , tria(&tria)
+    , pending_update_flags(update_nothing)
+    , incremental_update_flags(update_nothing)
   {
-    tria_change_signal =
-      tria.signals.any_change.connect([&]() { mark_for_update(update_all); });
+    connect_to_triangulation_signals();
 
     // Allow users to set this class up with an empty Triangulation and no
     // Mapping argument by deferring Mapping assignment until after the
@@ -69,6 +72,408 @@ namespace GridTools
       tria_change_signal.disconnect();
     if (tria_create_signal.connected())
       tria_create_signal.disconnect();
+    for (auto &connection : tria_refinement_signals)
+      if (connection.connected())
+        connection.disconnect();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::connect_to_triangulation_signals()
+  {
+    // For parallel triangulations, refinement may also change the ownership
+    // of cells and the ghost layer, so simply recompute everything after any
+    // change.
+    if (dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+          &*tria) != nullptr)
+      {
+        tria_change_signal = tria->signals.any_change.connect(
+          [&]() { mark_for_update(update_all); });
+        return;
+      }
+
+    // For serial triangulations, connect to the signals that are collected
+    // in Triangulation::Signals::any_change individually, so that we can
+    // update the data structures incrementally upon refinement and keep the
+    // connectivity information when the mesh is only moved.
+    tria_refinement_signals.push_back(tria->signals.create.connect(
+      [&]() { mark_for_update(update_all); }));
+    tria_refinement_signals.push_back(tria->signals.clear.connect(
+      [&]() { mark_for_update(update_all); }));
+    tria_refinement_signals.push_back(tria->signals.mesh_movement.connect(
+      [&]() { mark_for_update(update_geometric_data); }));
+    tria_refinement_signals.push_back(tria->signals.pre_refinement.connect(
+      [&]() { prepare_incremental_update(); }));
+    tria_refinement_signals.push_back(
+      tria->signals.pre_coarsening_on_cell.connect(
+        [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+          remove_children_of_coarsened_cell(cell);
+        }));
+    tria_refinement_signals.push_back(tria->signals.post_refinement.connect(
+      [&]() { finalize_incremental_update(); }));
+  }
+
+
+
+  namespace
+  {
+    /**
+     * Append the vertex indices of the given object and of all of its
+     * descendants to @p vertices.
+     */
+    template <typename Iterator>
+    void
+    collect_vertices_of_descendants(const Iterator            &object,
+                                    std::vector<unsigned int> &vertices)
+    {
+      for (const unsigned int v : object->vertex_indices())
+        vertices.push_back(object->vertex_index(v));
+      if (object->has_children())
+        for (unsigned int c = 0; c < object->n_children(); ++c)
+          collect_vertices_of_descendants(object->child(c), vertices);
+    }
+  } // namespace
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::prepare_incremental_update()
+  {
+    // Cells that are still waiting to be added from a previous refinement
+    // step would have to be evaluated with a mapping that might already
+    // refer to the state before the current step, so simply recompute the
+    // affected data structures from scratch in that case.
+    update_flags |= pending_update_flags;
+    pending_update_flags = update_nothing;
+    pending_cells.clear();
+    refined_cells.clear();
+    coarsened_cells.clear();
+    vertices_of_removed_cells.clear();
+    touched_vertices.clear();
+
+    // Only those data structures that are currently up to date can be
+    // updated incrementally. All others are recomputed on their next use
+    // anyway.
+    const auto current_flags =
+      static_cast<CacheUpdateFlags>(update_flags.load());
+    incremental_update_flags = update_nothing;
+    if ((current_flags & update_cell_bounding_boxes_rtree) == 0)
+      incremental_update_flags |= update_cell_bounding_boxes_rtree;
+    if ((current_flags & update_locally_owned_cell_bounding_boxes_rtree) == 0)
+      incremental_update_flags |=
+        update_locally_owned_cell_bounding_boxes_rtree;
+    if ((current_flags & (update_used_vertices | update_used_vertices_rtree)) ==
+        0)
+      incremental_update_flags |=
+        update_used_vertices | update_used_vertices_rtree;
+    if ((current_flags & update_vertex_to_cell_centers_directions) == 0)
+      incremental_update_flags |= update_vertex_to_cell_centers_directions;
+
+    if (incremental_update_flags == update_nothing)
+      return;
+
+    // Coarsening may free vertices and re-use them for new cells within the
+    // same step, which invalidates relations between those vertices and
+    // cells not touched by the refinement. The same applies to anisotropic
+    // refinement with its more complicated hanging node structure. Rather
+    // than tracking this, recompute the vertex-to-cell relations in these
+    // cases.
+    for (const auto &cell : tria->active_cell_iterators())
+      if (cell->coarsen_flag_set() ||
+          (cell->refine_flag_set() != RefinementCase<dim>::no_refinement &&
+           cell->refine_flag_set() !=
+             RefinementCase<dim>::isotropic_refinement))
+        {
+          incremental_update_flags &=
+            ~update_vertex_to_cell_centers_directions;
+          update_flags |= update_vertex_to_cell_centers_directions;
+          break;
+        }
+
+    for (const auto &cell : tria->active_cell_iterators())
+      if (cell->refine_flag_set() != RefinementCase<dim>::no_refinement)
+        {
+          refined_cells.push_back(cell);
+          remove_cell(cell);
+        }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::remove_children_of_coarsened_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &parent)
+  {
+    if (incremental_update_flags == update_nothing)
+      return;
+
+    // This should have been detected in prepare_incremental_update()
+    // already, but make sure we do not update the vertex-to-cell relations
+    // incrementally in a step with coarsening.
+    if (incremental_update_flags & update_vertex_to_cell_map)
+      {
+        incremental_update_flags &= ~update_vertex_to_cell_centers_directions;
+        update_flags |= update_vertex_to_cell_centers_directions;
+      }
+
+    coarsened_cells.push_back(parent);
+    for (unsigned int c = 0; c < parent->n_children(); ++c)
+      remove_cell(parent->child(c));
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::remove_cell(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+  {
+    for (const unsigned int v : cell->vertex_indices())
+      vertices_of_removed_cells.push_back(cell->vertex_index(v));
+
+    // Remove the bounding box of the cell from the rtrees. The box is
+    // recomputed with the same mapping as the stored one, so we should find
+    // it. If not (because the mapping was changed without notifying this
+    // object), recompute the whole tree.
+    if (incremental_update_flags &
+        (update_cell_bounding_boxes_rtree |
+         update_locally_owned_cell_bounding_boxes_rtree))
+      {
+        const auto box_and_cell =
+          std::make_pair(mapping->get_bounding_box(cell), cell);
+
+        if (incremental_update_flags & update_cell_bounding_boxes_rtree)
+          {
+            std::lock_guard<std::mutex> lock(cell_bounding_boxes_rtree_mutex);
+            if (cell_bounding_boxes_rtree.remove(box_and_cell) == 0)
+              {
+                incremental_update_flags &= ~update_cell_bounding_boxes_rtree;
+                update_flags |= update_cell_bounding_boxes_rtree;
+              }
+          }
+
+        if ((incremental_update_flags &
+             update_locally_owned_cell_bounding_boxes_rtree) &&
+            cell->is_locally_owned())
+          {
+            std::lock_guard<std::mutex> lock(
+              locally_owned_cell_bounding_boxes_rtree_mutex);
+            if (locally_owned_cell_bounding_boxes_rtree.remove(box_and_cell) ==
+                0)
+              {
+                incremental_update_flags &=
+                  ~update_locally_owned_cell_bounding_boxes_rtree;
+                update_flags |= update_locally_owned_cell_bounding_boxes_rtree;
+              }
+          }
+      }
+
+    // Remove the cell from the vertex-to-cell map. Besides its own vertices,
+    // the cell is also listed for the hanging vertices on its faces and (in
+    // 3d) edges, which are all vertices of descendants of these objects.
+    if (incremental_update_flags & update_vertex_to_cell_map)
+      {
+        std::vector<unsigned int> candidates;
+        if constexpr (dim == 1)
+          for (const unsigned int v : cell->vertex_indices())
+            candidates.push_back(cell->vertex_index(v));
+        else
+          {
+            for (const unsigned int f : cell->face_indices())
+              collect_vertices_of_descendants(cell->face(f), candidates);
+            if constexpr (dim == 3)
+              for (const unsigned int l : cell->line_indices())
+                collect_vertices_of_descendants(cell->line(l), candidates);
+          }
+
+        std::lock_guard<std::mutex> lock(vertex_to_cells_mutex);
+        for (const unsigned int v : candidates)
+          if (vertex_to_cells[v].erase(cell) > 0)
+            touched_vertices.insert(v);
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::add_to_vertex_to_cell_map(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+  {
+    // Follow the rules of GridTools::vertex_to_cell_map(), with the
+    // difference that they are applied irrespective of whether the mesh has
+    // hanging nodes. Without hanging nodes, the additional rules do not
+    // change the map.
+    for (const unsigned int v : cell->vertex_indices())
+      if (vertex_to_cells[cell->vertex_index(v)].insert(cell).second)
+        touched_vertices.insert(cell->vertex_index(v));
+
+    if (tria->all_reference_cells_are_hyper_cube() == false)
+      return;
+
+    for (const unsigned int f : cell->face_indices())
+      if ((cell->at_boundary(f) == false) && (cell->neighbor(f)->is_active()))
+        {
+          const typename Triangulation<dim, spacedim>::active_cell_iterator
+            neighbor = cell->neighbor(f);
+          for (unsigned int j = 0; j < cell->face(f)->n_vertices(); ++j)
+            if (vertex_to_cells[cell->face(f)->vertex_index(j)]
+                  .insert(neighbor)
+                  .second)
+              touched_vertices.insert(cell->face(f)->vertex_index(j));
+        }
+
+    if constexpr (dim == 3)
+      for (unsigned int l = 0; l < cell->n_lines(); ++l)
+        if (cell->line(l)->has_children())
+          {
+            const unsigned int hanging_vertex =
+              cell->line(l)->child(0)->vertex_index(1);
+            if (vertex_to_cells[hanging_vertex].insert(cell).second)
+              touched_vertices.insert(hanging_vertex);
+          }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::finalize_incremental_update()
+  {
+    // Everything that is not updated incrementally must be recomputed.
+    update_flags |= ~incremental_update_flags;
+
+    if (incremental_update_flags == update_nothing)
+      return;
+
+    // Collect the new active cells
+    for (const auto &parent : refined_cells)
+      for (unsigned int c = 0; c < parent->n_children(); ++c)
+        pending_cells.emplace_back(parent->child(c));
+    for (const auto &parent : coarsened_cells)
+      pending_cells.emplace_back(parent);
+
+    // The vertex-to-cell relations only depend on the triangulation, so we
+    // can update them right away. New relations can only appear between the
+    // new cells and cells sharing a vertex with them, so apply the rules of
+    // GridTools::vertex_to_cell_map() to this neighborhood.
+    if (incremental_update_flags & update_vertex_to_cell_map)
+      {
+        std::lock_guard<std::mutex> lock(vertex_to_cells_mutex);
+        std::lock_guard<std::mutex> lock_centers(vertex_to_cell_centers_mutex);
+
+        vertex_to_cells.resize(tria->n_vertices());
+        for (const auto &cell : pending_cells)
+          for (const unsigned int v : cell->vertex_indices())
+            {
+              vertex_to_cells[cell->vertex_index(v)].insert(cell);
+              touched_vertices.insert(cell->vertex_index(v));
+            }
+
+        std::set<typename Triangulation<dim, spacedim>::active_cell_iterator>
+          cells_to_visit;
+        for (const auto &cell : pending_cells)
+          for (const unsigned int v : cell->vertex_indices())
+            cells_to_visit.insert(
+              vertex_to_cells[cell->vertex_index(v)].begin(),
+              vertex_to_cells[cell->vertex_index(v)].end());
+        for (const auto &cell : cells_to_visit)
+          add_to_vertex_to_cell_map(cell);
+
+        // Recompute the directions to the cell centers for all vertices
+        // whose list of cells has changed, in the same way as
+        // GridTools::vertex_to_cell_centers_directions().
+        const std::vector<Point<spacedim>> &vertices = tria->get_vertices();
+        vertex_to_cell_centers.resize(tria->n_vertices());
+        for (const unsigned int vertex : touched_vertices)
+          {
+            vertex_to_cell_centers[vertex].clear();
+            if (tria->vertex_used(vertex))
+              for (const auto &cell : vertex_to_cells[vertex])
+                {
+                  Tensor<1, spacedim> direction =
+                    cell->center() - vertices[vertex];
+                  direction /= direction.norm();
+                  vertex_to_cell_centers[vertex].push_back(direction);
+                }
+          }
+      }
+
+    // Remove the vertices that are no longer used, as well as the vertices
+    // of the new cells (whose slots might have been re-used for new vertices
+    // at a different location) from the used vertices. The latter are added
+    // back from the mapping on the next call to get_used_vertices().
+    if (incremental_update_flags & update_used_vertices)
+      {
+        std::lock_guard<std::mutex> lock(used_vertices_mutex);
+        std::lock_guard<std::mutex> lock_rtree(used_vertices_rtree_mutex);
+
+        std::set<unsigned int> outdated_vertices;
+        for (const unsigned int v : vertices_of_removed_cells)
+          if (v >= tria->n_vertices() || tria->vertex_used(v) == false)
+            outdated_vertices.insert(v);
+        for (const auto &cell : pending_cells)
+          for (const unsigned int v : cell->vertex_indices())
+            outdated_vertices.insert(cell->vertex_index(v));
+
+        for (const unsigned int v : outdated_vertices)
+          {
+            const auto it = used_vertices.find(v);
+            if (it != used_vertices.end())
+              {
+                used_vertices_rtree.remove(std::make_pair(it->second, v));
+                used_vertices.erase(it);
+              }
+          }
+      }
+
+    pending_update_flags |=
+      incremental_update_flags &
+      (update_cell_bounding_boxes_rtree |
+       update_locally_owned_cell_bounding_boxes_rtree | update_used_vertices |
+       update_used_vertices_rtree);
+
+    incremental_update_flags = update_nothing;
+    refined_cells.clear();
+    coarsened_cells.clear();
+    vertices_of_removed_cells.clear();
+    touched_vertices.clear();
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::vector<
+    std::pair<BoundingBox<spacedim>,
+              typename Triangulation<dim, spacedim>::active_cell_iterator>>
+  Cache<dim, spacedim>::compute_cell_bounding_boxes(
+    const std::vector<
+      typename Triangulation<dim, spacedim>::active_cell_iterator> &cells)
+    const
+  {
+    std::vector<std::pair<
+      BoundingBox<spacedim>,
+      typename Triangulation<dim, spacedim>::active_cell_iterator>>
+      boxes(cells.size());
+
+    // Computing the bounding box of a cell may be expensive for mappings
+    // that need to evaluate a finite element field, such as
+    // MappingQEulerian or MappingFEField, so do it in parallel.
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(cells.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
+          boxes[i] = std::make_pair(mapping->get_bounding_box(cells[i]),
+                                    cells[i]);
+      },
+      /* grainsize = */ 64);
+
+    return boxes;
   }
 
 
@@ -150,6 +555,20 @@ namespace GridTools
         // Atomically clear the flag that indicates that this data member
         // needs to be updated:
         update_flags &= ~update_used_vertices;
+        pending_update_flags &= ~update_used_vertices;
+      }
+    else if (pending_update_flags & update_used_vertices)
+      {
+        // Add the vertices of the cells created by the last refinement step
+        for (const auto &cell : pending_cells)
+          if (!cell->is_artificial())
+            {
+              const auto vs = mapping->get_vertices(cell);
+              for (unsigned int i = 0; i < vs.size(); ++i)
+                used_vertices[cell->vertex_index(i)] = vs[i];
+            }
+
+        pending_update_flags &= ~update_used_vertices;
       }
     return used_vertices;
   }
@@ -180,6 +599,25 @@ namespace GridTools
         // Atomically clear the flag that indicates that this data member
         // needs to be updated:
         update_flags &= ~update_used_vertices_rtree;
+        pending_update_flags &= ~update_used_vertices_rtree;
+      }
+    else if (pending_update_flags & update_used_vertices_rtree)
+      {
+        // Add the vertices of the cells created by the last refinement
+        // step, which have all been removed from the tree before
+        const auto            &used_vertices = get_used_vertices();
+        std::set<unsigned int> new_vertices;
+        for (const auto &cell : pending_cells)
+          for (const unsigned int v : cell->vertex_indices())
+            new_vertices.insert(cell->vertex_index(v));
+        for (const unsigned int v : new_vertices)
+          {
+            const auto it = used_vertices.find(v);
+            if (it != used_vertices.end())
+              used_vertices_rtree.insert(std::make_pair(it->second, v));
+          }
+
+        pending_update_flags &= ~update_used_vertices_rtree;
       }
     return used_vertices_rtree;
   }
@@ -201,19 +639,27 @@ namespace GridTools
 
     if (update_flags & update_cell_bounding_boxes_rtree)
       {
-        std::vector<std::pair<
-          BoundingBox<spacedim>,
-          typename Triangulation<dim, spacedim>::active_cell_iterator>>
-          boxes;
-        boxes.reserve(tria->n_active_cells());
+        std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+          cells;
+        cells.reserve(tria->n_active_cells());
         for (const auto &cell : tria->active_cell_iterators())
-          boxes.emplace_back(mapping->get_bounding_box(cell), cell);
+          cells.push_back(cell);
 
-        cell_bounding_boxes_rtree = pack_rtree(boxes);
+        cell_bounding_boxes_rtree =
+          pack_rtree(compute_cell_bounding_boxes(cells));
 
         // Atomically clear the flag that indicates that this data member
         // needs to be updated:
         update_flags &= ~update_cell_bounding_boxes_rtree;
+        pending_update_flags &= ~update_cell_bounding_boxes_rtree;
+      }
+    else if (pending_update_flags & update_cell_bounding_boxes_rtree)
+      {
+        // Add the cells created by the last refinement step
+        const auto boxes = compute_cell_bounding_boxes(pending_cells);
+        cell_bounding_boxes_rtree.insert(boxes.begin(), boxes.end());
+
+        pending_update_flags &= ~update_cell_bounding_boxes_rtree;
       }
     return cell_bounding_boxes_rtree;
   }
@@ -236,25 +682,40 @@ namespace GridTools
 
     if (update_flags & update_locally_owned_cell_bounding_boxes_rtree)
       {
-        std::vector<std::pair<
-          BoundingBox<spacedim>,
-          typename Triangulation<dim, spacedim>::active_cell_iterator>>
-          boxes;
+        std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+          cells;
         if (const parallel::TriangulationBase<dim, spacedim> *parallel_tria =
               dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
                 &*tria))
-          boxes.reserve(parallel_tria->n_locally_owned_active_cells());
+          cells.reserve(parallel_tria->n_locally_owned_active_cells());
         else
-          boxes.reserve(tria->n_active_cells());
+          cells.reserve(tria->n_active_cells());
         for (const auto &cell : tria->active_cell_iterators() |
                                   IteratorFilters::LocallyOwnedCell())
-          boxes.emplace_back(mapping->get_bounding_box(cell), cell);
+          cells.push_back(cell);
 
-        locally_owned_cell_bounding_boxes_rtree = pack_rtree(boxes);
+        locally_owned_cell_bounding_boxes_rtree =
+          pack_rtree(compute_cell_bounding_boxes(cells));
 
         // Atomically clear the flag that indicates that this data member
         // needs to be updated:
         update_flags &= ~update_locally_owned_cell_bounding_boxes_rtree;
+        pending_update_flags &= ~update_locally_owned_cell_bounding_boxes_rtree;
+      }
+    else if (pending_update_flags &
+             update_locally_owned_cell_bounding_boxes_rtree)
+      {
+        // Add the cells created by the last refinement step
+        std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+          cells;
+        for (const auto &cell : pending_cells)
+          if (cell->is_locally_owned())
+            cells.push_back(cell);
+        const auto boxes = compute_cell_bounding_boxes(cells);
+        locally_owned_cell_bounding_boxes_rtree.insert(boxes.begin(),
+                                                       boxes.end());
+
+        pending_update_flags &= ~update_locally_owned_cell_bounding_boxes_rtree;
       }
     return locally_owned_cell_bounding_boxes_rtree;
   }
@@ -41,6 +41,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <fstream>
@@ -182,10 +183,140 @@ namespace internal
   } // namespace TriangulationImplementation
 
 
+  struct PendingCellAttachedDataSave
+  {
+    /**
+     * Complete the write operation, see wait().
+     */
+    ~PendingCellAttachedDataSave();
+
+    /**
+     * Wait for all outstanding write operations to complete, close the
+     * files, and release the buffers. Calling this function more than once
+     * has no effect.
+     */
+    void
+    wait();
+
+    /**
+     * The buffers that are being written. They need to stay alive until
+     * all write operations have completed.
+     */
+    std::vector<unsigned int> sizes_fixed_cumulative;
+    std::vector<char>         data_fixed;
+    std::vector<int>          sizes_variable;
+    std::vector<char>         data_variable;
+
+#ifdef DEAL_II_WITH_MPI
+    /**
+     * The files opened for non-blocking MPI I/O, and the requests of the
+     * write operations started on them.
+     */
+    std::vector<MPI_File>    files;
+    std::vector<MPI_Request> requests;
+#endif
+
+    /**
+     * The task writing the files if MPI I/O is not used.
+     */
+    Threads::Task<void> task;
+
+    /**
+     * The number of bytes written by the current process, and the time at
+     * which the write operations were started.
+     */
+    std::size_t                           n_bytes = 0;
+    std::chrono::steady_clock::time_point start_time;
+
+    /**
+     * The wall time in seconds the write operations took. It is set by the
+     * task once it has written the files, and otherwise by wait().
+     */
+    double wall_time = -1.;
+
+    /**
+     * Whether wait() has been called.
+     */
+    bool completed = false;
+  };
+
+
+
+  PendingCellAttachedDataSave::~PendingCellAttachedDataSave()
+  {
+    try
+      {
+        wait();
+      }
+    catch (...)
+      {
+        AssertNothrow(false,
+                      ExcMessage("Writing cell-attached data to the file "
+                                 "system did not complete successfully."));
+      }
+  }
+
+
+
+  void
+  PendingCellAttachedDataSave::wait()
+  {
+    if (completed)
+      return;
+
+    // mark the operation as completed first, so that a failed write is only
+    // reported once
+    completed = true;
+
+    if (task.joinable())
+      {
+        Threads::Task<void> running_task = std::move(task);
+        task                             = Threads::Task<void>();
+        running_task.join();
+      }
+
+#ifdef DEAL_II_WITH_MPI
+    if (requests.size() > 0)
+      {
+        const int ierr = MPI_Waitall(requests.size(),
+                                     requests.data(),
+                                     MPI_STATUSES_IGNORE);
+        requests.clear();
+        AssertThrowMPI(ierr);
+      }
+
+    for (MPI_File &fh : files)
+      {
+        const int ierr = MPI_File_close(&fh);
+        AssertThrowMPI(ierr);
+      }
+    files.clear();
+#endif
+
+    if (wall_time < 0.)
+      wall_time = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start_time)
+                    .count();
+
+    // this object is kept for its statistics, so release the memory of the
+    // buffers
+    sizes_fixed_cumulative.clear();
+    sizes_fixed_cumulative.shrink_to_fit();
+    data_fixed.clear();
+    data_fixed.shrink_to_fit();
+    sizes_variable.clear();
+    sizes_variable.shrink_to_fit();
+    data_variable.clear();
+    data_variable.shrink_to_fit();
+  }
+
+
+
   template <int dim, int spacedim>
   DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
   CellAttachedDataSerializer<dim, spacedim>::CellAttachedDataSerializer()
     : variable_size_data_stored(false)
+    , save_asynchronously(false)
   {}
 
 
@@ -949,6 +1080,236 @@ namespace internal
   }
 
 
+  template <int dim, int spacedim>
+  DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
+  void CellAttachedDataSerializer<dim, spacedim>::start_save(
+    const unsigned int global_first_cell,
+    const unsigned int global_num_cells,
+    const std::string &file_basename,
+    const MPI_Comm    &mpi_communicator)
+  {
+    Assert(sizes_fixed_cumulative.size() > 0,
+           ExcMessage("No data has been packed!"));
+
+    // complete a previous write operation first, it might write into the
+    // same files
+    wait_for_save();
+
+    // take over the packed buffers, so that they stay alive until the data
+    // has been written
+    auto pending = std::make_shared<PendingCellAttachedDataSave>();
+    pending->sizes_fixed_cumulative = sizes_fixed_cumulative;
+    pending->data_fixed             = std::move(src_data_fixed);
+    if (variable_size_data_stored)
+      {
+        pending->sizes_variable = std::move(src_sizes_variable);
+        pending->data_variable  = std::move(src_data_variable);
+      }
+    src_data_fixed.clear();
+    src_sizes_variable.clear();
+    src_data_variable.clear();
+
+    const bool write_variable_size_data = variable_size_data_stored;
+
+    pending->n_bytes =
+      pending->data_fixed.size() +
+      pending->sizes_variable.size() * sizeof(int) +
+      pending->data_variable.size() +
+      (Utilities::MPI::this_mpi_process(mpi_communicator) == 0 ?
+         pending->sizes_fixed_cumulative.size() * sizeof(unsigned int) :
+         0);
+    pending->start_time = std::chrono::steady_clock::now();
+
+#ifdef DEAL_II_WITH_MPI
+    const unsigned int myrank =
+      Utilities::MPI::this_mpi_process(mpi_communicator);
+    const unsigned int mpisize =
+      Utilities::MPI::n_mpi_processes(mpi_communicator);
+
+    if (mpisize > 1)
+      {
+        // Open a file and truncate it. This part is the same as in save()
+        // and is done synchronously, only the actual writes below are
+        // non-blocking.
+        const auto open_file = [&](const std::string &fname) {
+          MPI_Info info;
+          int      ierr = MPI_Info_create(&info);
+          AssertThrowMPI(ierr);
+
+          MPI_File fh;
+          ierr = MPI_File_open(mpi_communicator,
+                               fname.c_str(),
+                               MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                               info,
+                               &fh);
+          AssertThrowMPI(ierr);
+          pending->files.push_back(fh);
+
+          ierr = MPI_File_set_size(fh, 0); // delete the file contents
+          AssertThrowMPI(ierr);
+          // this barrier is necessary, because otherwise others might already
+          // write while one core is still setting the size to zero.
+          ierr = MPI_Barrier(mpi_communicator);
+          AssertThrowMPI(ierr);
+          ierr = MPI_Info_free(&info);
+          AssertThrowMPI(ierr);
+
+          return fh;
+        };
+
+        const auto start_write = [&](MPI_File           fh,
+                                     const MPI_Offset   offset,
+                                     const void        *buffer,
+                                     const std::size_t  count,
+                                     const MPI_Datatype datatype) {
+          MPI_Request request;
+          const int   ierr = Utilities::MPI::LargeCount::File_iwrite_at_c(
+            fh, offset, buffer, count, datatype, &request);
+          AssertThrowMPI(ierr);
+          pending->requests.push_back(request);
+        };
+
+        //
+        // ---------- Fixed size data ----------
+        //
+        {
+          MPI_File fh = open_file(std::string(file_basename) + "_fixed.data");
+
+          // Only the first process writes the cumulative sizes, see save().
+          if (myrank == 0)
+            start_write(fh,
+                        0,
+                        pending->sizes_fixed_cumulative.data(),
+                        pending->sizes_fixed_cumulative.size(),
+                        MPI_UNSIGNED);
+
+          const MPI_Offset size_header =
+            pending->sizes_fixed_cumulative.size() * sizeof(unsigned int);
+          const MPI_Offset my_global_file_position =
+            size_header + static_cast<MPI_Offset>(global_first_cell) *
+                            pending->sizes_fixed_cumulative.back();
+
+          start_write(fh,
+                      my_global_file_position,
+                      pending->data_fixed.data(),
+                      pending->data_fixed.size(),
+                      MPI_BYTE);
+        }
+
+        //
+        // ---------- Variable size data ----------
+        //
+        if (write_variable_size_data)
+          {
+            MPI_File fh =
+              open_file(std::string(file_basename) + "_variable.data");
+
+            AssertThrow(pending->sizes_variable.size() <
+                          static_cast<std::size_t>(
+                            std::numeric_limits<int>::max()),
+                        ExcNotImplemented());
+
+            start_write(fh,
+                        static_cast<MPI_Offset>(global_first_cell) *
+                          sizeof(unsigned int),
+                        pending->sizes_variable.data(),
+                        pending->sizes_variable.size(),
+                        MPI_INT);
+
+            const std::uint64_t size_on_proc = pending->data_variable.size();
+            std::uint64_t       prefix_sum   = 0;
+            const int           ierr         = MPI_Exscan(&size_on_proc,
+                                          &prefix_sum,
+                                          1,
+                                          MPI_UINT64_T,
+                                          MPI_SUM,
+                                          mpi_communicator);
+            AssertThrowMPI(ierr);
+
+            start_write(fh,
+                        static_cast<MPI_Offset>(global_num_cells) *
+                            sizeof(unsigned int) +
+                          prefix_sum,
+                        pending->data_variable.data(),
+                        pending->data_variable.size(),
+                        MPI_BYTE);
+          }
+      } // if (mpisize > 1)
+    else
+#endif
+      {
+        (void)global_first_cell;
+        (void)global_num_cells;
+        (void)mpi_communicator;
+
+        // Write the same files as the serial part of save(), but on a
+        // separate thread. The task only accesses the buffers owned by
+        // the pending object.
+        PendingCellAttachedDataSave *const data = pending.get();
+        pending->task = Threads::new_task([data,
+                                           file_basename,
+                                           write_variable_size_data]() {
+          {
+            std::ofstream file(std::string(file_basename) + "_fixed.data",
+                               std::ios::binary | std::ios::out);
+            AssertThrow(file.fail() == false, ExcIO());
+
+            file.write(reinterpret_cast<const char *>(
+                         data->sizes_fixed_cumulative.data()),
+                       data->sizes_fixed_cumulative.size() *
+                         sizeof(unsigned int));
+            file.write(data->data_fixed.data(), data->data_fixed.size());
+            AssertThrow(file.fail() == false, ExcIO());
+          }
+
+          if (write_variable_size_data)
+            {
+              std::ofstream file(std::string(file_basename) +
+                                   "_variable.data",
+                                 std::ios::binary | std::ios::out);
+              AssertThrow(file.fail() == false, ExcIO());
+
+              file.write(reinterpret_cast<const char *>(
+                           data->sizes_variable.data()),
+                         data->sizes_variable.size() * sizeof(int));
+              file.write(data->data_variable.data(),
+                         data->data_variable.size());
+              AssertThrow(file.fail() == false, ExcIO());
+            }
+
+          data->wall_time = std::chrono::duration<double>(
+                              std::chrono::steady_clock::now() -
+                              data->start_time)
+                              .count();
+        });
+      }
+
+    pending_save = std::move(pending);
+  }
+
+
+
+  template <int dim, int spacedim>
+  DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
+  void CellAttachedDataSerializer<dim, spacedim>::wait_for_save()
+  {
+    if (pending_save != nullptr)
+      pending_save->wait();
+  }
+
+
+
+  template <int dim, int spacedim>
+  DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
+  std::pair<std::size_t, double> CellAttachedDataSerializer<dim, spacedim>::
+    get_save_statistics() const
+  {
+    if (pending_save == nullptr || pending_save->completed == false)
+      return {0, 0.};
+    return {pending_save->n_bytes, pending_save->wall_time};
+  }
+
+
   template <int dim, int spacedim>
   DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
   void CellAttachedDataSerializer<dim, spacedim>::load(
@@ -14640,6 +15001,53 @@ void Triangulation<dim, spacedim>::load(const std::string &file_basename)
   this->update_cell_relations();
 }
 
+
+
+template <int dim, int spacedim>
+DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
+void Triangulation<dim, spacedim>::set_asynchronous_save(
+  const bool asynchronous)
+{
+  data_serializer.save_asynchronously = asynchronous;
+}
+
+
+
+template <int dim, int spacedim>
+DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
+void Triangulation<dim, spacedim>::wait_for_asynchronous_save() const
+{
+  // cast away constness
+  auto tria = const_cast<Triangulation<dim, spacedim> *>(this);
+  tria->data_serializer.wait_for_save();
+}
+
+
+
+template <int dim, int spacedim>
+DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
+double Triangulation<dim, spacedim>::AsynchronousSaveStatistics::throughput()
+  const
+{
+  return (wall_time > 0. ? n_bytes / wall_time : 0.);
+}
+
+
+
+template <int dim, int spacedim>
+DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
+typename Triangulation<dim, spacedim>::AsynchronousSaveStatistics
+  Triangulation<dim, spacedim>::get_asynchronous_save_statistics() const
+{
+  const std::pair<std::size_t, double> n_bytes_and_time =
+    data_serializer.get_save_statistics();
+
+  AsynchronousSaveStatistics statistics;
+  statistics.n_bytes   = n_bytes_and_time.first;
+  statistics.wall_time = n_bytes_and_time.second;
+  return statistics;
+}
+
 #endif
 namespace
 {
@@ -16831,6 +17239,10 @@ void Triangulation<dim, spacedim>::save_attached_data(
   // cast away constness
   auto tria = const_cast<Triangulation<dim, spacedim> *>(this);
 
+  // complete a previous asynchronous save, it might write into the same
+  // files
+  tria->data_serializer.wait_for_save();
+
   // each cell should have been flagged `CellStatus::cell_will_persist`
   for (const auto &cell_rel : this->local_cell_relations)
     {
@@ -16849,11 +17261,19 @@ void Triangulation<dim, spacedim>::save_attached_data(
         tria->cell_attached_data.pack_callbacks_variable,
         this->get_mpi_communicator());
 
-      // then store buffers in file
-      tria->data_serializer.save(global_first_cell,
-                                 global_num_cells,
-                                 file_basename,
-                                 this->get_mpi_communicator());
+      // then store buffers in file, possibly only starting the write
+      // operations (the buffers are then owned by the serializer until the
+      // data has been written)
+      if (tria->data_serializer.save_asynchronously)
+        tria->data_serializer.start_save(global_first_cell,
+                                         global_num_cells,
+                                         file_basename,
+                                         this->get_mpi_communicator());
+      else
+        tria->data_serializer.save(global_first_cell,
+                                   global_num_cells,
+                                   file_basename,
+                                   this->get_mpi_communicator());
 
       // and release the memory afterwards
       tria->data_serializer.clear();
@@ -16879,6 +17299,9 @@ void Triangulation<dim, spacedim>::load_attached_data(
   const unsigned int n_attached_deserialize_fixed,
   const unsigned int n_attached_deserialize_variable)
 {
+  // the files might still be written by an asynchronous save
+  this->data_serializer.wait_for_save();
+
   // load saved data, if any was stored
   if (this->cell_attached_data.n_attached_deserialize > 0)
     {
@@ -16,6 +16,7 @@
 
 #include <deal.II/hp/fe_values.h>
 
+#include <chrono>
 #include <memory>
 #include <numeric>
 
@@ -80,7 +81,10 @@ namespace hp
                               numbers::invalid_unsigned_int,
                               numbers::invalid_unsigned_int)
     , update_flags(update_flags)
-  {}
+    , measure_times(false)
+  {
+    reset_reinit_statistics();
+  }
 
   template <int dim, int q_dim, typename FEValuesType>
   FEValuesBase<dim, q_dim, FEValuesType>::FEValuesBase(
@@ -100,7 +104,10 @@ namespace hp
                               numbers::invalid_unsigned_int,
                               numbers::invalid_unsigned_int)
     , update_flags(update_flags)
-  {}
+    , measure_times(false)
+  {
+    reset_reinit_statistics();
+  }
 
 
   template <int dim, int q_dim, typename FEValuesType>
@@ -145,7 +152,10 @@ namespace hp
                       other.fe_values_table.size(2))
     , present_fe_values_index(other.present_fe_values_index)
     , update_flags(other.update_flags)
+    , measure_times(other.measure_times)
   {
+    reset_reinit_statistics();
+
     // We've already resized the `fe_values_table` correctly above, but right
     // now it just contains nullptrs. Create copies of the objects that
     // `other.fe_values_table` stores
@@ -189,11 +199,14 @@ namespace hp
     // first check whether we already have an object for this particular
     // combination of indices
     if (fe_values_table(present_fe_values_index).get() == nullptr)
-      fe_values_table(present_fe_values_index) =
-        std::make_unique<FEValuesType>((*mapping_collection)[mapping_index],
-                                       (*fe_collection)[fe_index],
-                                       q_collections[q_index],
-                                       update_flags);
+      {
+        fe_values_table(present_fe_values_index) =
+          std::make_unique<FEValuesType>((*mapping_collection)[mapping_index],
+                                         (*fe_collection)[fe_index],
+                                         q_collections[q_index],
+                                         update_flags);
+        ++reinit_statistics.n_fe_values_created[fe_index];
+      }
 
     // now there definitely is one!
     return *fe_values_table(present_fe_values_index);
@@ -201,6 +214,55 @@ namespace hp
 
 
 
+  template <int dim, int q_dim, typename FEValuesType>
+  template <typename... Args>
+  void
+  FEValuesBase<dim, q_dim, FEValuesType>::reinit_fe_values(
+    const unsigned int fe_index,
+    const unsigned int mapping_index,
+    const unsigned int q_index,
+    const Args &...args)
+  {
+    AssertIndexRange(fe_index, fe_collection->size());
+    ++reinit_statistics.n_reinits[fe_index];
+
+    if (measure_times == false)
+      select_fe_values(fe_index, mapping_index, q_index).reinit(args...);
+    else
+      {
+        const auto start = std::chrono::steady_clock::now();
+        select_fe_values(fe_index, mapping_index, q_index).reinit(args...);
+        reinit_statistics.reinit_times[fe_index] +=
+          std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                        start)
+            .count();
+      }
+  }
+
+
+
+  template <int dim, int q_dim, typename FEValuesType>
+  void
+  FEValuesBase<dim, q_dim, FEValuesType>::reset_reinit_statistics()
+  {
+    const unsigned int n_fe_indices = fe_values_table.size(0);
+    reinit_statistics.n_reinits.assign(n_fe_indices, 0);
+    reinit_statistics.n_fe_values_created.assign(n_fe_indices, 0);
+    reinit_statistics.reinit_times.assign(n_fe_indices, 0.);
+  }
+
+
+
+  template <int dim, int q_dim, typename FEValuesType>
+  void
+  FEValuesBase<dim, q_dim, FEValuesType>::measure_reinit_times(
+    const bool measure)
+  {
+    measure_times = measure;
+  }
+
+
+
   template <int dim, int q_dim, typename FEValuesType>
   void
   FEValuesBase<dim, q_dim, FEValuesType>::precalculate_fe_values(
@@ -211,6 +273,9 @@ namespace hp
     AssertDimension(fe_indices.size(), mapping_indices.size());
     AssertDimension(fe_indices.size(), q_indices.size());
 
+    Table<3, bool> is_scheduled(fe_values_table.size(0),
+                                fe_values_table.size(1),
+                                fe_values_table.size(2));
     Threads::TaskGroup<> task_group;
     for (unsigned int i = 0; i < fe_indices.size(); ++i)
       {
@@ -222,6 +287,19 @@ namespace hp
         AssertIndexRange(mapping_index, mapping_collection->size());
         AssertIndexRange(q_index, q_collections.size());
 
+        // objects that already exist, e.g., because they have been used in
+        // reinit() before, need not be created again
+        if (fe_values_table[fe_index][mapping_index][q_index].get() !=
+            nullptr)
+          continue;
+
+        // the same combination of indices may appear several times in the
+        // input, so make sure to create only one object for it
+        if (is_scheduled[fe_index][mapping_index][q_index])
+          continue;
+        is_scheduled[fe_index][mapping_index][q_index] = true;
+        ++reinit_statistics.n_fe_values_created[fe_index];
+
         task_group +=
           Threads::new_task([&, fe_index, mapping_index, q_index]() {
             fe_values_table[fe_index][mapping_index][q_index] =
@@ -326,8 +404,8 @@ namespace hp
     AssertIndexRange(real_fe_index, this->fe_collection->size());
 
     // now finally actually get the corresponding object and initialize it
-    this->select_fe_values(real_fe_index, real_mapping_index, real_q_index)
-      .reinit(cell);
+    this->reinit_fe_values(
+      real_fe_index, real_mapping_index, real_q_index, cell);
   }
 
 
@@ -359,8 +437,8 @@ namespace hp
     AssertIndexRange(real_fe_index, this->fe_collection->size());
 
     // now finally actually get the corresponding object and initialize it
-    this->select_fe_values(real_fe_index, real_mapping_index, real_q_index)
-      .reinit(cell);
+    this->reinit_fe_values(
+      real_fe_index, real_mapping_index, real_q_index, cell);
   }
 
 
@@ -458,8 +536,8 @@ namespace hp
     AssertIndexRange(real_fe_index, this->fe_collection->size());
 
     // now finally actually get the corresponding object and initialize it
-    this->select_fe_values(real_fe_index, real_mapping_index, real_q_index)
-      .reinit(cell, face_no);
+    this->reinit_fe_values(
+      real_fe_index, real_mapping_index, real_q_index, cell, face_no);
   }
 
 
@@ -509,8 +587,8 @@ namespace hp
     AssertIndexRange(real_fe_index, this->fe_collection->size());
 
     // now finally actually get the corresponding object and initialize it
-    this->select_fe_values(real_fe_index, real_mapping_index, real_q_index)
-      .reinit(cell, face_no);
+    this->reinit_fe_values(
+      real_fe_index, real_mapping_index, real_q_index, cell, face_no);
   }
 
 
@@ -598,8 +676,12 @@ namespace hp
     AssertIndexRange(real_fe_index, this->fe_collection->size());
 
     // now finally actually get the corresponding object and initialize it
-    this->select_fe_values(real_fe_index, real_mapping_index, real_q_index)
-      .reinit(cell, face_no, subface_no);
+    this->reinit_fe_values(real_fe_index,
+                           real_mapping_index,
+                           real_q_index,
+                           cell,
+                           face_no,
+                           subface_no);
   }
 
 
@@ -633,8 +715,12 @@ namespace hp
     AssertIndexRange(real_fe_index, this->fe_collection->size());
 
     // now finally actually get the corresponding object and initialize it
-    this->select_fe_values(real_fe_index, real_mapping_index, real_q_index)
-      .reinit(cell, face_no, subface_no);
+    this->reinit_fe_values(real_fe_index,
+                           real_mapping_index,
+                           real_q_index,
+                           cell,
+                           face_no,
+                           subface_no);
   }
 } // namespace hp
 
@@ -59,6 +59,8 @@ DEAL_II_NAMESPACE_OPEN
       MatrixType &,                                           \
       VectorType &,                                           \
       bool,                                                   \
+      const AffineConstraints::LocalToGlobalCache *,          \
+      unsigned int,                                           \
       std::bool_constant<false>) const
 
 #define INSTANTIATE_DLTG_BLOCK_VECTORMATRIX(MatrixType, VectorType) \
@@ -70,6 +72,8 @@ DEAL_II_NAMESPACE_OPEN
       MatrixType &,                                                 \
       VectorType &,                                                 \
       bool,                                                         \
+      const AffineConstraints::LocalToGlobalCache *,                \
+      unsigned int,                                                 \
       std::bool_constant<true>) const
 
 #define INSTANTIATE_DLTG_MATRIX(MatrixType)                              \
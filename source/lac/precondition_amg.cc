@@ -0,0 +1,417 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/precondition_amg.h>
+
+#include <algorithm>
+#include <cmath>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace
+{
+  using size_type = types::global_dof_index;
+
+
+
+  /**
+   * Return the column indices of the strong couplings of each row of
+   * @p matrix, not including the diagonal entry.
+   */
+  std::vector<std::vector<size_type>>
+  compute_strong_couplings(const SparseMatrix<double> &matrix,
+                           const double                threshold)
+  {
+    const size_type     n_rows = matrix.m();
+    std::vector<double> diagonal(n_rows);
+    for (size_type i = 0; i < n_rows; ++i)
+      diagonal[i] = std::abs(matrix.diag_element(i));
+
+    std::vector<std::vector<size_type>> strong_couplings(n_rows);
+    parallel::apply_to_subranges(
+      size_type(0),
+      n_rows,
+      [&](const size_type begin_row, const size_type end_row) {
+        for (size_type i = begin_row; i < end_row; ++i)
+          for (auto entry = matrix.begin(i); entry != matrix.end(i); ++entry)
+            {
+              const size_type j = entry->column();
+              if (j != i && std::abs(entry->value()) >
+                              threshold * std::sqrt(diagonal[i] * diagonal[j]))
+                strong_couplings[i].push_back(j);
+            }
+      },
+      internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+
+    return strong_couplings;
+  }
+
+
+
+  /**
+   * Group the rows into aggregates with the three phases of the greedy
+   * algorithm by Vaněk, Mandel, and Brezina, and return the number of
+   * aggregates. Rows without strong couplings are not assigned to any
+   * aggregate, which is indicated by numbers::invalid_size_type in
+   * @p aggregate_of.
+   */
+  size_type
+  compute_aggregates(
+    const std::vector<std::vector<size_type>> &strong_couplings,
+    std::vector<size_type>                    &aggregate_of)
+  {
+    const size_type n_rows = strong_couplings.size();
+    aggregate_of.assign(n_rows, numbers::invalid_size_type);
+    size_type n_aggregates = 0;
+
+    const auto is_free = [&](const size_type i) {
+      return aggregate_of[i] == numbers::invalid_size_type;
+    };
+
+    // phase 1: every row whose strong neighbors are all still free forms a
+    // new aggregate together with them
+    for (size_type i = 0; i < n_rows; ++i)
+      if (strong_couplings[i].empty() == false && is_free(i) &&
+          std::all_of(strong_couplings[i].begin(),
+                      strong_couplings[i].end(),
+                      is_free))
+        {
+          aggregate_of[i] = n_aggregates;
+          for (const size_type j : strong_couplings[i])
+            aggregate_of[j] = n_aggregates;
+          ++n_aggregates;
+        }
+
+    // phase 2: add the remaining rows to the aggregate of one of their strong
+    // neighbors. only use the aggregates of phase 1 to avoid that aggregates
+    // grow along chains of rows
+    const std::vector<size_type> aggregates_of_phase_1 = aggregate_of;
+    for (size_type i = 0; i < n_rows; ++i)
+      if (is_free(i))
+        for (const size_type j : strong_couplings[i])
+          if (aggregates_of_phase_1[j] != numbers::invalid_size_type)
+            {
+              aggregate_of[i] = aggregates_of_phase_1[j];
+              break;
+            }
+
+    // phase 3: rows that are still free form new aggregates together with
+    // their strong neighbors that are still free
+    for (size_type i = 0; i < n_rows; ++i)
+      if (strong_couplings[i].empty() == false && is_free(i))
+        {
+          aggregate_of[i] = n_aggregates;
+          for (const size_type j : strong_couplings[i])
+            if (is_free(j))
+              aggregate_of[j] = n_aggregates;
+          ++n_aggregates;
+        }
+
+    return n_aggregates;
+  }
+
+
+
+  /**
+   * Set up @p transpose as the transpose of @p matrix, using @p sparsity as
+   * its sparsity pattern.
+   */
+  void
+  compute_transpose(const SparseMatrix<double> &matrix,
+                    SparsityPattern            &sparsity,
+                    SparseMatrix<double>       &transpose)
+  {
+    DynamicSparsityPattern dsp(matrix.n(), matrix.m());
+    for (size_type i = 0; i < matrix.m(); ++i)
+      for (auto entry = matrix.begin(i); entry != matrix.end(i); ++entry)
+        dsp.add(entry->column(), i);
+    sparsity.copy_from(dsp);
+
+    transpose.reinit(sparsity);
+    for (size_type i = 0; i < matrix.m(); ++i)
+      for (auto entry = matrix.begin(i); entry != matrix.end(i); ++entry)
+        transpose.set(entry->column(), i, entry->value());
+  }
+} // namespace
+
+
+
+PreconditionAMG::AdditionalData::AdditionalData(
+  const double       aggregation_threshold,
+  const unsigned int smoother_sweeps,
+  const double       smoothing_range,
+  const unsigned int n_cycles,
+  const size_type    max_coarse_size,
+  const unsigned int max_levels,
+  const double       prolongator_damping)
+  : aggregation_threshold(aggregation_threshold)
+  , smoother_sweeps(smoother_sweeps)
+  , smoothing_range(smoothing_range)
+  , n_cycles(n_cycles)
+  , max_coarse_size(max_coarse_size)
+  , max_levels(max_levels)
+  , prolongator_damping(prolongator_damping)
+{}
+
+
+
+void
+PreconditionAMG::initialize(const SparseMatrix<double> &matrix,
+                            const AdditionalData       &additional_data)
+{
+  AssertDimension(matrix.m(), matrix.n());
+  Assert(additional_data.max_levels > 0,
+         ExcMessage("The hierarchy needs to have at least one level."));
+
+  clear();
+  this->matrix = &matrix;
+  data         = additional_data;
+
+  using SmootherType =
+    PreconditionChebyshev<SparseMatrix<double>, Vector<double>>;
+  SmootherType::AdditionalData smoother_data;
+  smoother_data.degree          = data.smoother_sweeps;
+  smoother_data.smoothing_range = data.smoothing_range;
+#ifndef DEAL_II_WITH_LAPACK
+  // the eigenvalues of the tridiagonal matrix of the Lanczos method are
+  // computed with LAPACK, so fall back to the power iteration
+  smoother_data.eigenvalue_algorithm =
+    SmootherType::AdditionalData::EigenvalueAlgorithm::power_iteration;
+  smoother_data.eig_cg_n_iterations = 15;
+#endif
+
+  levels.push_back(std::make_unique<Level>());
+  while (true)
+    {
+      const unsigned int          level   = levels.size() - 1;
+      Level                      &current = *levels.back();
+      const SparseMatrix<double> &A       = get_matrix(level);
+
+      current.residual.reinit(A.m());
+      current.smoother.initialize(A, smoother_data);
+      const double max_eigenvalue =
+        current.smoother.estimate_eigenvalues(current.residual)
+          .max_eigenvalue_estimate;
+
+      if (A.m() <= data.max_coarse_size || level + 1 == data.max_levels)
+        break;
+
+      std::vector<size_type> aggregate_of;
+      const size_type        n_aggregates = compute_aggregates(
+        compute_strong_couplings(A, data.aggregation_threshold), aggregate_of);
+      if (n_aggregates == 0 || n_aggregates == A.m())
+        break;
+
+      // the tentative prolongation interpolates the constant function on each
+      // aggregate, scaled such that its columns have unit length
+      SparsityPattern tentative_sparsity(A.m(), n_aggregates, 1);
+      std::vector<double> tentative_value(n_aggregates, 0.);
+      for (size_type i = 0; i < A.m(); ++i)
+        if (aggregate_of[i] != numbers::invalid_size_type)
+          {
+            tentative_sparsity.add(i, aggregate_of[i]);
+            tentative_value[aggregate_of[i]] += 1.;
+          }
+      tentative_sparsity.compress();
+      for (double &value : tentative_value)
+        value = 1. / std::sqrt(value);
+
+      SparseMatrix<double> tentative(tentative_sparsity);
+      for (size_type i = 0; i < A.m(); ++i)
+        if (aggregate_of[i] != numbers::invalid_size_type)
+          tentative.set(i, aggregate_of[i], tentative_value[aggregate_of[i]]);
+
+      // smooth the prolongation by one step of the damped Jacobi method,
+      // P = T - omega D^{-1} A T. the sparsity pattern of AT contains the
+      // one of T, as A has entries on the diagonal
+      const double omega = data.prolongator_damping / max_eigenvalue;
+      current.prolongation.reinit(current.prolongation_sparsity);
+      A.mmult(current.prolongation, tentative);
+      parallel::apply_to_subranges(
+        size_type(0),
+        A.m(),
+        [&](const size_type begin_row, const size_type end_row) {
+          for (size_type i = begin_row; i < end_row; ++i)
+            {
+              const double factor = -omega / A.diag_element(i);
+              for (auto entry = current.prolongation.begin(i);
+                   entry != current.prolongation.end(i);
+                   ++entry)
+                entry->value() *= factor;
+              if (aggregate_of[i] != numbers::invalid_size_type)
+                current.prolongation.add(i,
+                                         aggregate_of[i],
+                                         tentative_value[aggregate_of[i]]);
+            }
+        },
+        internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+
+      compute_transpose(current.prolongation,
+                        current.restriction_sparsity,
+                        current.restriction);
+      current.coarse_rhs.reinit(n_aggregates);
+      current.coarse_solution.reinit(n_aggregates);
+
+      Level &coarse = *levels.emplace_back(std::make_unique<Level>());
+      coarse.matrix.reinit(coarse.matrix_sparsity);
+      A.triple_product(coarse.matrix,
+                       current.restriction,
+                       current.prolongation);
+    }
+
+  const SparseMatrix<double> &coarsest_matrix = get_matrix(levels.size() - 1);
+  if (coarsest_matrix.m() <= data.max_coarse_size)
+    {
+      coarse_inverse.copy_from(coarsest_matrix);
+      coarse_inverse.gauss_jordan();
+    }
+}
+
+
+
+void
+PreconditionAMG::clear()
+{
+  levels.clear();
+  coarse_inverse.reinit(0, 0);
+  matrix = nullptr;
+}
+
+
+
+void
+PreconditionAMG::v_cycle(const unsigned int    level,
+                         Vector<double>       &dst,
+                         const Vector<double> &src,
+                         const bool            dst_is_zero) const
+{
+  const Level                &current = *levels[level];
+  const SparseMatrix<double> &A       = get_matrix(level);
+
+  if (level + 1 == levels.size())
+    {
+      if (coarse_inverse.m() > 0)
+        {
+          if (dst_is_zero)
+            coarse_inverse.vmult(dst, src);
+          else
+            {
+              A.residual(current.residual, dst, src);
+              coarse_inverse.vmult(dst, current.residual, true);
+            }
+        }
+      else if (dst_is_zero)
+        current.smoother.vmult(dst, src);
+      else
+        current.smoother.step(dst, src);
+      return;
+    }
+
+  // pre-smoothing
+  if (dst_is_zero)
+    current.smoother.vmult(dst, src);
+  else
+    current.smoother.step(dst, src);
+
+  // coarse-grid correction
+  A.residual(current.residual, dst, src);
+  current.restriction.vmult(current.coarse_rhs, current.residual);
+  v_cycle(level + 1, current.coarse_solution, current.coarse_rhs, true);
+  current.prolongation.vmult_add(dst, current.coarse_solution);
+
+  // post-smoothing
+  current.smoother.step(dst, src);
+}
+
+
+
+void
+PreconditionAMG::vmult(Vector<double> &dst, const Vector<double> &src) const
+{
+  Assert(levels.empty() == false, ExcNotInitialized());
+  AssertDimension(dst.size(), m());
+  AssertDimension(src.size(), n());
+
+  for (unsigned int cycle = 0; cycle < data.n_cycles; ++cycle)
+    v_cycle(0, dst, src, cycle == 0);
+}
+
+
+
+void
+PreconditionAMG::Tvmult(Vector<double> &dst, const Vector<double> &src) const
+{
+  vmult(dst, src);
+}
+
+
+
+PreconditionAMG::size_type
+PreconditionAMG::m() const
+{
+  Assert(matrix != nullptr, ExcNotInitialized());
+  return matrix->m();
+}
+
+
+
+PreconditionAMG::size_type
+PreconditionAMG::n() const
+{
+  Assert(matrix != nullptr, ExcNotInitialized());
+  return matrix->n();
+}
+
+
+
+unsigned int
+PreconditionAMG::n_levels() const
+{
+  return levels.size();
+}
+
+
+
+const SparseMatrix<double> &
+PreconditionAMG::get_matrix(const unsigned int level) const
+{
+  AssertIndexRange(level, levels.size());
+  if (level == 0)
+    return *matrix;
+  else
+    return levels[level]->matrix;
+}
+
+
+
+std::size_t
+PreconditionAMG::memory_consumption() const
+{
+  std::size_t memory = sizeof(*this) + coarse_inverse.memory_consumption();
+  for (const auto &level : levels)
+    memory += level->matrix_sparsity.memory_consumption() +
+              level->matrix.memory_consumption() +
+              level->prolongation_sparsity.memory_consumption() +
+              level->prolongation.memory_consumption() +
+              level->restriction_sparsity.memory_consumption() +
+              level->restriction.memory_consumption() +
+              level->residual.memory_consumption() +
+              level->coarse_rhs.memory_consumption() +
+              level->coarse_solution.memory_consumption();
+  return memory;
+}
+
+DEAL_II_NAMESPACE_CLOSE
@@ -345,6 +345,22 @@ SparsityPattern::compress()
     std::count_if(&colnums[rowstart[0]],
                   &colnums[rowstart[rows]],
                   [](const size_type col) { return col != invalid_entry; });
+
+  // if all rows are completely filled (as is the case if the pattern was
+  // initialized with the exact row lengths), we only need to sort the rows
+  // and can keep the current memory
+  if (nonzero_elements == rowstart[rows] - rowstart[0])
+    {
+      for (size_type line = 0; line < n_rows(); ++line)
+        if (rowstart[line + 1] - rowstart[line] > 1)
+          std::sort(&colnums[rowstart[line]] +
+                      (store_diagonal_first_in_row ? 1 : 0),
+                    &colnums[rowstart[line + 1]]);
+
+      compressed = true;
+      return;
+    }
+
   // now allocate the respective memory
   std::unique_ptr<size_type[]> new_colnums(new size_type[nonzero_elements]);
 
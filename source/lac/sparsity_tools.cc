@@ -12,6 +12,9 @@
 
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/utilities.h>
 
 #include <deal.II/lac/exceptions.h>
 #include <deal.II/lac/sparsity_pattern.h>
@@ -24,7 +27,6 @@
 
 #ifdef DEAL_II_WITH_MPI
 #  include <deal.II/base/mpi.h>
-#  include <deal.II/base/utilities.h>
 
 #  include <deal.II/lac/block_sparsity_pattern.h>
 #  include <deal.II/lac/dynamic_sparsity_pattern.h>
@@ -564,144 +566,384 @@ namespace SparsityTools
 
       return starting_point;
     }
-  } // namespace internal
 
 
 
-  void
-  reorder_Cuthill_McKee(
-    const DynamicSparsityPattern                         &sparsity,
-    std::vector<DynamicSparsityPattern::size_type>       &new_indices,
-    const std::vector<DynamicSparsityPattern::size_type> &starting_indices)
-  {
-    Assert(sparsity.n_rows() == sparsity.n_cols(),
-           ExcDimensionMismatch(sparsity.n_rows(), sparsity.n_cols()));
-    Assert(sparsity.n_rows() == new_indices.size(),
-           ExcDimensionMismatch(sparsity.n_rows(), new_indices.size()));
-    Assert(starting_indices.size() <= sparsity.n_rows(),
-           ExcMessage(
-             "You can't specify more starting indices than there are rows"));
-    Assert(sparsity.row_index_set().size() == 0 ||
-             sparsity.row_index_set().size() == sparsity.n_rows(),
-           ExcMessage(
-             "Only valid for sparsity patterns which store all rows."));
-    for (const auto starting_index : starting_indices)
-      {
-        (void)starting_index;
-        Assert(starting_index < sparsity.n_rows(),
-               ExcMessage("Invalid starting index: All starting indices need "
-                          "to be between zero and the number of rows in the "
-                          "sparsity pattern."));
-      }
+    /**
+     * Append all neighbors of the indices in @p front that have not been
+     * visited yet (i.e., for which @p marks is still invalid_size_type) to
+     * @p next_front and set their entry in @p marks to @p mark_value.
+     *
+     * The neighbors are appended in the same order as a loop over @p front
+     * and the rows of @p sparsity would find them. For large fronts, the
+     * search for candidates is split among several tasks, which only read
+     * from @p marks; the (cheap) de-duplication of the candidates then
+     * happens sequentially, in the order of the tasks. The result is thus
+     * independent of the number of threads.
+     */
+    void
+    expand_front(const DynamicSparsityPattern                         &sparsity,
+                 const std::vector<DynamicSparsityPattern::size_type> &front,
+                 std::vector<DynamicSparsityPattern::size_type>       &marks,
+                 const DynamicSparsityPattern::size_type mark_value,
+                 std::vector<DynamicSparsityPattern::size_type> &next_front)
+    {
+      using size_type = DynamicSparsityPattern::size_type;
+
+      // minimal number of front indices handed to a single task
+      const std::size_t grain_size = 512;
+      const unsigned int n_threads = MultithreadInfo::n_threads();
+      const unsigned int n_chunks =
+        (n_threads > 1 ?
+           std::min<std::size_t>(4 * n_threads, front.size() / grain_size) :
+           1);
+
+      if (n_chunks <= 1)
+        {
+          for (const auto index : front)
+            {
+              const unsigned int row_length = sparsity.row_length(index);
+              for (unsigned int i = 0; i < row_length; ++i)
+                {
+                  const size_type column = sparsity.column_number(index, i);
+                  if (marks[column] == numbers::invalid_size_type)
+                    {
+                      next_front.push_back(column);
+                      marks[column] = mark_value;
+                    }
+                }
+            }
+          return;
+        }
+
+      std::vector<std::vector<size_type>> candidates(n_chunks);
+      Threads::TaskGroup<void>            tasks;
+      for (unsigned int c = 0; c < n_chunks; ++c)
+        tasks += Threads::new_task([&, c]() {
+          const std::size_t begin = front.size() * c / n_chunks;
+          const std::size_t end   = front.size() * (c + 1) / n_chunks;
+          for (std::size_t f = begin; f < end; ++f)
+            {
+              const unsigned int row_length = sparsity.row_length(front[f]);
+              for (unsigned int i = 0; i < row_length; ++i)
+                {
+                  const size_type column =
+                    sparsity.column_number(front[f], i);
+                  if (marks[column] == numbers::invalid_size_type)
+                    candidates[c].push_back(column);
+                }
+            }
+        });
+      tasks.join_all();
 
-    // store the indices of the dofs renumbered in the last round. Default to
-    // starting points
-    std::vector<DynamicSparsityPattern::size_type> last_round_dofs(
-      starting_indices);
+      for (const auto &chunk : candidates)
+        for (const auto column : chunk)
+          if (marks[column] == numbers::invalid_size_type)
+            {
+              next_front.push_back(column);
+              marks[column] = mark_value;
+            }
+    }
 
-    // initialize the new_indices array with invalid values
-    std::fill(new_indices.begin(),
-              new_indices.end(),
-              numbers::invalid_size_type);
 
-    // if no starting indices were given: find dof with lowest coordination
-    // number
-    if (last_round_dofs.empty())
-      last_round_dofs.push_back(
-        internal::find_unnumbered_starting_index(sparsity, new_indices));
 
-    // store next free dof index
-    DynamicSparsityPattern::size_type next_free_number = 0;
+    /**
+     * Compute the level structure of the connected component of @p root,
+     * i.e., the sets of indices with the same graph distance from @p root.
+     * Return the number of levels and the indices of the last level, sorted
+     * by their coordination number (and then by index).
+     *
+     * @p marks is a scratch array of the size of the graph that needs to be
+     * all invalid_size_type on entry and is reset to that state on exit.
+     */
+    unsigned int
+    compute_last_level(
+      const DynamicSparsityPattern                   &sparsity,
+      const DynamicSparsityPattern::size_type         root,
+      std::vector<DynamicSparsityPattern::size_type> &marks,
+      std::vector<DynamicSparsityPattern::size_type> &last_level)
+    {
+      using size_type = DynamicSparsityPattern::size_type;
 
-    // enumerate the first round dofs
-    for (const auto &last_round_dof : last_round_dofs)
-      new_indices[last_round_dof] = next_free_number++;
+      std::vector<size_type> visited = {root};
+      std::vector<size_type> front   = {root};
+      std::vector<size_type> next_front;
+      marks[root] = 0;
 
-    // store the indices of the dofs to be renumbered in the next round
-    std::vector<DynamicSparsityPattern::size_type> next_round_dofs;
+      unsigned int n_levels = 1;
+      while (true)
+        {
+          next_front.clear();
+          expand_front(sparsity, front, marks, n_levels, next_front);
+          if (next_front.empty())
+            break;
+          visited.insert(visited.end(), next_front.begin(), next_front.end());
+          front.swap(next_front);
+          ++n_levels;
+        }
 
-    // store for each coordination number the dofs with these coordination
-    // number
-    std::vector<std::pair<unsigned int, DynamicSparsityPattern::size_type>>
-      dofs_by_coordination;
+      for (const auto index : visited)
+        marks[index] = numbers::invalid_size_type;
 
-    // now do as many steps as needed to renumber all dofs
-    while (true)
-      {
-        next_round_dofs.clear();
+      std::vector<std::pair<unsigned int, size_type>> by_coordination;
+      by_coordination.reserve(front.size());
+      for (const auto index : front)
+        by_coordination.emplace_back(sparsity.row_length(index), index);
+      std::sort(by_coordination.begin(), by_coordination.end());
 
-        // find all neighbors of the dofs numbered in the last round
-        for (const auto dof : last_round_dofs)
-          {
-            const unsigned int row_length = sparsity.row_length(dof);
-            for (unsigned int i = 0; i < row_length; ++i)
-              {
-                // skip dofs which are already numbered
-                const auto column = sparsity.column_number(dof, i);
-                if (new_indices[column] == numbers::invalid_size_type)
-                  {
-                    next_round_dofs.push_back(column);
+      last_level.clear();
+      for (const auto &entry : by_coordination)
+        last_level.push_back(entry.second);
 
-                    // assign a dummy value to 'new_indices' to avoid adding
-                    // the same index again; those will get the right number
-                    // at the end of the outer 'while' loop
-                    new_indices[column] = 0;
-                  }
-              }
-          }
+      return n_levels;
+    }
 
-        // check whether there are any new dofs in the list. if there are
-        // none, then we have completely numbered the current component of the
-        // graph. check if there are as yet unnumbered components of the graph
-        // that we would then have to do next
-        if (next_round_dofs.empty())
-          {
-            if (std::find(new_indices.begin(),
-                          new_indices.end(),
-                          numbers::invalid_size_type) == new_indices.end())
-              // no unnumbered indices, so we can leave now
-              break;
 
-            // otherwise find a valid starting point for the next component of
-            // the graph and continue with numbering that one. we only do so
-            // if no starting indices were provided by the user (see the
-            // documentation of this function) so produce an error if we got
-            // here and starting indices were given
-            Assert(starting_indices.empty(),
-                   ExcMessage("The input graph appears to have more than one "
-                              "component, but as stated in the documentation "
-                              "we only want to reorder such graphs if no "
-                              "starting indices are given. The function was "
-                              "called with starting indices, however."));
-
-            next_round_dofs.push_back(
-              internal::find_unnumbered_starting_index(sparsity, new_indices));
+
+    /**
+     * The algorithm of George and Liu behind find_pseudo_peripheral_index(),
+     * using @p marks as scratch space, see compute_last_level().
+     */
+    DynamicSparsityPattern::size_type
+    find_pseudo_peripheral_index(
+      const DynamicSparsityPattern                   &sparsity,
+      const DynamicSparsityPattern::size_type         start,
+      std::vector<DynamicSparsityPattern::size_type> &marks)
+    {
+      std::vector<DynamicSparsityPattern::size_type> last_level;
+
+      DynamicSparsityPattern::size_type root = start;
+      unsigned int n_levels =
+        compute_last_level(sparsity, root, marks, last_level);
+
+      // the number of levels is bounded by the size of the component, so
+      // this loop terminates
+      while (true)
+        {
+          // try the candidate with the smallest coordination number of the
+          // last level and see whether it is farther away from anything else
+          const DynamicSparsityPattern::size_type candidate = last_level[0];
+          const unsigned int                      candidate_n_levels =
+            compute_last_level(sparsity, candidate, marks, last_level);
+          if (candidate_n_levels <= n_levels)
+            break;
+
+          root     = candidate;
+          n_levels = candidate_n_levels;
+        }
+
+      return root;
+    }
+
+
+
+    /**
+     * The Cuthill-McKee front marching algorithm behind
+     * reorder_Cuthill_McKee() and reorder_reverse_Cuthill_McKee(). If
+     * @p pseudo_peripheral is set and no @p starting_indices are given, each
+     * connected component is started from a pseudo-peripheral index rather
+     * than from one with the smallest coordination number.
+     */
+    void
+    reorder_Cuthill_McKee(
+      const DynamicSparsityPattern                         &sparsity,
+      std::vector<DynamicSparsityPattern::size_type>       &new_indices,
+      const std::vector<DynamicSparsityPattern::size_type> &starting_indices,
+      const bool                                            pseudo_peripheral)
+    {
+      using size_type = DynamicSparsityPattern::size_type;
+
+      Assert(sparsity.n_rows() == sparsity.n_cols(),
+             ExcDimensionMismatch(sparsity.n_rows(), sparsity.n_cols()));
+      Assert(sparsity.n_rows() == new_indices.size(),
+             ExcDimensionMismatch(sparsity.n_rows(), new_indices.size()));
+      Assert(starting_indices.size() <= sparsity.n_rows(),
+             ExcMessage(
+               "You can't specify more starting indices than there are rows"));
+      Assert(sparsity.row_index_set().size() == 0 ||
+               sparsity.row_index_set().size() == sparsity.n_rows(),
+             ExcMessage(
+               "Only valid for sparsity patterns which store all rows."));
+      for (const auto starting_index : starting_indices)
+        {
+          (void)starting_index;
+          Assert(starting_index < sparsity.n_rows(),
+                 ExcMessage("Invalid starting index: All starting indices "
+                            "need to be between zero and the number of rows "
+                            "in the sparsity pattern."));
+        }
+
+      // initialize the new_indices array with invalid values
+      std::fill(new_indices.begin(),
+                new_indices.end(),
+                numbers::invalid_size_type);
+
+      // scratch space for the search of pseudo-peripheral indices
+      std::vector<size_type> marks;
+
+      // all indices sorted by their coordination number, and the position
+      // of the next possibly unnumbered one in that list. this is only set
+      // up once the graph turns out to have a second component: the linear
+      // search of find_unnumbered_starting_index() is cheaper for the first
+      // one, but would make graphs with many components quadratic in cost
+      std::vector<std::pair<unsigned int, size_type>> by_coordination;
+      std::size_t next_candidate = 0;
+
+      const auto make_starting_index = [&](const size_type candidate) {
+        if (pseudo_peripheral == false)
+          return candidate;
+
+        marks.resize(sparsity.n_rows(), numbers::invalid_size_type);
+        return find_pseudo_peripheral_index(sparsity, candidate, marks);
+      };
+
+      const auto find_next_starting_index = [&]() {
+        if (by_coordination.empty())
+          {
+            by_coordination.reserve(sparsity.n_rows());
+            for (size_type row = 0; row < sparsity.n_rows(); ++row)
+              by_coordination.emplace_back(sparsity.row_length(row), row);
+            std::sort(by_coordination.begin(), by_coordination.end());
           }
 
+        while (new_indices[by_coordination[next_candidate].second] !=
+               numbers::invalid_size_type)
+          ++next_candidate;
+        return make_starting_index(by_coordination[next_candidate].second);
+      };
 
-        // find coordination number for each of these dofs
-        dofs_by_coordination.clear();
-        for (const types::global_dof_index next_round_dof : next_round_dofs)
-          dofs_by_coordination.emplace_back(sparsity.row_length(next_round_dof),
-                                            next_round_dof);
-        std::sort(dofs_by_coordination.begin(), dofs_by_coordination.end());
+      // store the indices of the dofs renumbered in the last round. Default
+      // to starting points
+      std::vector<size_type> last_round_dofs(starting_indices);
 
-        // assign new DoF numbers to the elements of the present front:
-        for (const auto &i : dofs_by_coordination)
-          new_indices[i.second] = next_free_number++;
+      // if no starting indices were given: find dof with lowest
+      // coordination number (or a pseudo-peripheral one)
+      if (last_round_dofs.empty() && sparsity.n_rows() > 0)
+        last_round_dofs.push_back(make_starting_index(
+          find_unnumbered_starting_index(sparsity, new_indices)));
 
-        // after that: use this round's dofs for the next round
-        last_round_dofs.swap(next_round_dofs);
-      }
+      // store next free dof index
+      size_type next_free_number = 0;
+
+      // enumerate the first round dofs
+      for (const auto &last_round_dof : last_round_dofs)
+        new_indices[last_round_dof] = next_free_number++;
+
+      // store the indices of the dofs to be renumbered in the next round
+      std::vector<size_type> next_round_dofs;
+
+      // store for each coordination number the dofs with these coordination
+      // number
+      std::vector<std::pair<unsigned int, size_type>> dofs_by_coordination;
+
+      // now do as many steps as needed to renumber all dofs
+      while (next_free_number < sparsity.n_rows())
+        {
+          next_round_dofs.clear();
+
+          // find all neighbors of the dofs numbered in the last round. assign
+          // a dummy value to 'new_indices' to avoid adding the same index
+          // again; those will get the right number at the end of this loop
+          expand_front(
+            sparsity, last_round_dofs, new_indices, 0, next_round_dofs);
+
+          // check whether there are any new dofs in the list. if there are
+          // none, then we have completely numbered the current component of
+          // the graph, but there are as yet unnumbered components of the
+          // graph that we would then have to do next
+          if (next_round_dofs.empty())
+            {
+              // find a valid starting point for the next component of the
+              // graph and continue with numbering that one. we only do so if
+              // no starting indices were provided by the user (see the
+              // documentation of this function) so produce an error if we got
+              // here and starting indices were given
+              Assert(starting_indices.empty(),
+                     ExcMessage("The input graph appears to have more than one "
+                                "component, but as stated in the documentation "
+                                "we only want to reorder such graphs if no "
+                                "starting indices are given. The function was "
+                                "called with starting indices, however."));
+
+              next_round_dofs.push_back(find_next_starting_index());
+            }
 
-    // test for all indices numbered. this mostly tests whether the
-    // front-marching-algorithm (which Cuthill-McKee actually is) has reached
-    // all points.
-    Assert((std::find(new_indices.begin(),
-                      new_indices.end(),
-                      numbers::invalid_size_type) == new_indices.end()) &&
-             (next_free_number == sparsity.n_rows()),
-           ExcInternalError());
+
+          // find coordination number for each of these dofs
+          dofs_by_coordination.clear();
+          for (const size_type next_round_dof : next_round_dofs)
+            dofs_by_coordination.emplace_back(sparsity.row_length(
+                                                next_round_dof),
+                                              next_round_dof);
+          std::sort(dofs_by_coordination.begin(), dofs_by_coordination.end());
+
+          // assign new DoF numbers to the elements of the present front:
+          for (const auto &i : dofs_by_coordination)
+            new_indices[i.second] = next_free_number++;
+
+          // after that: use this round's dofs for the next round
+          last_round_dofs.swap(next_round_dofs);
+        }
+
+      // test for all indices numbered. this mostly tests whether the
+      // front-marching-algorithm (which Cuthill-McKee actually is) has
+      // reached all points.
+      Assert((std::find(new_indices.begin(),
+                        new_indices.end(),
+                        numbers::invalid_size_type) == new_indices.end()) &&
+               (next_free_number == sparsity.n_rows()),
+             ExcInternalError());
+    }
+  } // namespace internal
+
+
+
+  void
+  reorder_Cuthill_McKee(
+    const DynamicSparsityPattern                         &sparsity,
+    std::vector<DynamicSparsityPattern::size_type>       &new_indices,
+    const std::vector<DynamicSparsityPattern::size_type> &starting_indices)
+  {
+    internal::reorder_Cuthill_McKee(sparsity,
+                                    new_indices,
+                                    starting_indices,
+                                    /* pseudo_peripheral = */ false);
+  }
+
+
+
+  void
+  reorder_reverse_Cuthill_McKee(
+    const DynamicSparsityPattern                   &sparsity,
+    std::vector<DynamicSparsityPattern::size_type> &new_indices)
+  {
+    internal::reorder_Cuthill_McKee(sparsity,
+                                    new_indices,
+                                    {},
+                                    /* pseudo_peripheral = */ true);
+    new_indices = Utilities::reverse_permutation(new_indices);
+  }
+
+
+
+  DynamicSparsityPattern::size_type
+  find_pseudo_peripheral_index(const DynamicSparsityPattern &sparsity,
+                               DynamicSparsityPattern::size_type start)
+  {
+    Assert(sparsity.n_rows() == sparsity.n_cols(),
+           ExcDimensionMismatch(sparsity.n_rows(), sparsity.n_cols()));
+    Assert(sparsity.n_rows() > 0, ExcMessage("The graph must not be empty."));
+
+    if (start == numbers::invalid_size_type)
+      start = internal::find_unnumbered_starting_index(
+        sparsity,
+        std::vector<DynamicSparsityPattern::size_type>(
+          sparsity.n_rows(), numbers::invalid_size_type));
+    AssertIndexRange(start, sparsity.n_rows());
+
+    std::vector<DynamicSparsityPattern::size_type> marks(
+      sparsity.n_rows(), numbers::invalid_size_type);
+    return internal::find_pseudo_peripheral_index(sparsity, start, marks);
   }
 
 
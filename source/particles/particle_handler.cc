@@ -1255,10 +1255,12 @@ namespace Particles
     struct StageOne_ScratchData
     {
       std::vector<Point<spacedim>> real_locations;
+      std::vector<Point<dim>>      old_reference_locations;
       std::vector<Point<dim>>      reference_locations;
       StageOne_ScratchData(const unsigned int size)
       {
         real_locations.reserve(size);
+        old_reference_locations.reserve(size);
         reference_locations.reserve(size);
       }
     };
@@ -1281,16 +1283,27 @@ namespace Particles
           }
 
         scratch.real_locations.clear();
+        scratch.old_reference_locations.clear();
 
         const unsigned int n_pic = n_particles_in_cell(cell);
         auto               pic   = particles_in_cell(cell);
 
         for (const auto &particle : pic)
-          scratch.real_locations.push_back(particle.get_location());
+          {
+            scratch.real_locations.push_back(particle.get_location());
+            scratch.old_reference_locations.push_back(
+              particle.get_reference_location());
+          }
 
+        // The particles have usually moved only a small distance since their
+        // reference locations were computed, so these are good initial
+        // guesses for the inverse mapping.
         scratch.reference_locations.resize(n_pic);
         mapping->transform_points_real_to_unit_cell(
-          cell, scratch.real_locations, scratch.reference_locations);
+          cell,
+          scratch.real_locations,
+          scratch.old_reference_locations,
+          scratch.reference_locations);
 
         auto particle = pic.begin();
         for (const auto &p_unit : scratch.reference_locations)
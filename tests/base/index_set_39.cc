@@ -0,0 +1,152 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Test IndexSet::operator&, IndexSet::subtract_set(), IndexSet::add_indices()
+// with unsorted input and IndexSet::pop_front() on a large fragmented set and
+// a set with few ranges, compared against the same operations on std::set.
+// the fragmented set has many ranges between two consecutive ranges of the
+// other one, which are skipped by a binary search in the first two
+// operations.
+
+#include <deal.II/base/index_set.h>
+
+#include <random>
+#include <set>
+
+#include "../tests.h"
+
+
+bool
+equal(const IndexSet &is, const std::set<types::global_dof_index> &reference)
+{
+  if (is.n_elements() != reference.size())
+    return false;
+
+  types::global_dof_index n = 0;
+  for (const auto i : reference)
+    {
+      if (is.is_element(i) == false || is.index_within_set(i) != n ||
+          is.nth_index_in_set(n) != i)
+        return false;
+      ++n;
+    }
+  return true;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const types::global_dof_index size = 100000;
+
+  // a fragmented set, built from unsorted indices with duplicates
+  std::vector<types::global_dof_index> indices;
+  for (types::global_dof_index i = 0; i < size; i += 7)
+    {
+      indices.push_back(i);
+      if (i % 3 == 0)
+        indices.push_back(i + 1);
+    }
+  for (types::global_dof_index i = 0; i < 1000; ++i)
+    indices.push_back(Testing::rand() % size);
+  std::shuffle(indices.begin(), indices.end(), std::mt19937());
+
+  IndexSet fragmented(size);
+  fragmented.add_indices(indices.begin(), indices.end());
+  fragmented.compress();
+  std::set<types::global_dof_index> fragmented_reference(indices.begin(),
+                                                         indices.end());
+  deallog << "Fragmented set: " << fragmented.n_elements() << " elements in "
+          << fragmented.n_intervals() << " intervals, "
+          << (equal(fragmented, fragmented_reference) ? "OK" : "wrong")
+          << std::endl;
+
+  // a set with few, large ranges
+  IndexSet                          blocks(size);
+  std::set<types::global_dof_index> blocks_reference;
+  for (const auto &[begin, end] :
+       std::vector<std::pair<types::global_dof_index, types::global_dof_index>>{
+         {10, 20}, {5000, 5003}, {40000, 60000}, {99990, 100000}})
+    {
+      blocks.add_range(begin, end);
+      for (types::global_dof_index i = begin; i < end; ++i)
+        blocks_reference.insert(i);
+    }
+  blocks.compress();
+
+  std::set<types::global_dof_index> intersection_reference;
+  std::set_intersection(fragmented_reference.begin(),
+                        fragmented_reference.end(),
+                        blocks_reference.begin(),
+                        blocks_reference.end(),
+                        std::inserter(intersection_reference,
+                                      intersection_reference.end()));
+  deallog << "Intersection: "
+          << (equal(fragmented & blocks, intersection_reference) ? "OK" :
+                                                                   "wrong")
+          << ' '
+          << (equal(blocks & fragmented, intersection_reference) ? "OK" :
+                                                                   "wrong")
+          << std::endl;
+
+  for (const bool subtract_blocks : {true, false})
+    {
+      IndexSet difference = subtract_blocks ? fragmented : blocks;
+      difference.subtract_set(subtract_blocks ? blocks : fragmented);
+
+      std::set<types::global_dof_index> difference_reference;
+      if (subtract_blocks)
+        std::set_difference(fragmented_reference.begin(),
+                            fragmented_reference.end(),
+                            blocks_reference.begin(),
+                            blocks_reference.end(),
+                            std::inserter(difference_reference,
+                                          difference_reference.end()));
+      else
+        std::set_difference(blocks_reference.begin(),
+                            blocks_reference.end(),
+                            fragmented_reference.begin(),
+                            fragmented_reference.end(),
+                            std::inserter(difference_reference,
+                                          difference_reference.end()));
+      deallog << "Difference "
+              << (subtract_blocks ? "fragmented-blocks: " :
+                                    "blocks-fragmented: ")
+              << (equal(difference, difference_reference) ? "OK" : "wrong")
+              << std::endl;
+    }
+
+  // pop_front() has to keep the set usable without another call to
+  // compress(). pop through the first two ranges of the block set and into
+  // the third one, which is the largest one, and then some elements of the
+  // fragmented set
+  for (unsigned int i = 0; i < 14; ++i)
+    {
+      const types::global_dof_index index = blocks.pop_front();
+      AssertThrow(index == *blocks_reference.begin(), ExcInternalError());
+      blocks_reference.erase(blocks_reference.begin());
+    }
+  for (unsigned int i = 0; i < 100; ++i)
+    {
+      const types::global_dof_index index = fragmented.pop_front();
+      AssertThrow(index == *fragmented_reference.begin(), ExcInternalError());
+      fragmented_reference.erase(fragmented_reference.begin());
+    }
+  deallog << "pop_front: "
+          << (equal(blocks, blocks_reference) ? "OK" : "wrong") << ' '
+          << (equal(fragmented, fragmented_reference) ? "OK" : "wrong")
+          << std::endl;
+}
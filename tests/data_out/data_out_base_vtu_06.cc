@@ -0,0 +1,152 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+
+// check that compressed arrays in vtu files that are larger than one block
+// of the vtk compression header are split into several blocks, and that the
+// blocks decompress to the original data
+
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/utilities.h>
+
+#include <zlib.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+
+
+std::vector<DataOutBase::Patch<2, 2>> patches;
+std::vector<std::string>              names;
+
+class DataOutX : public DataOutInterface<2, 2>
+{
+  virtual const std::vector<::DataOutBase::Patch<2, 2>> &
+  get_patches() const
+  {
+    return patches;
+  }
+
+  virtual std::vector<std::string>
+  get_dataset_names() const
+  {
+    return names;
+  }
+};
+
+
+
+int
+main()
+{
+  initlog();
+
+  // one patch with so many subdivisions that the point coordinates take
+  // more than 4 MB
+  const unsigned int n_subdivisions = 600;
+  const unsigned int n_points_1d    = n_subdivisions + 1;
+
+  patches.resize(1);
+  DataOutBase::Patch<2, 2> &patch = patches[0];
+  patch.n_subdivisions            = n_subdivisions;
+  patch.reference_cell            = ReferenceCells::Quadrilateral;
+  patch.vertices[1][0]            = 1.;
+  patch.vertices[2][1]            = 1.;
+  patch.vertices[3][0]            = 1.;
+  patch.vertices[3][1]            = 1.;
+  patch.data.reinit(1, n_points_1d * n_points_1d);
+  for (unsigned int i = 0; i < patch.data.n_cols(); ++i)
+    patch.data(0, i) = i;
+  names = {"i"};
+
+  DataOutX              x;
+  DataOutBase::VtkFlags vtk_flags;
+  vtk_flags.compression_level = DataOutBase::CompressionLevel::best_speed;
+  x.set_flags(vtk_flags);
+
+  std::ostringstream out;
+  x.write_vtu(out);
+  const std::string vtu = out.str();
+
+  // extract the encoded point coordinates, the first data array
+  const std::size_t array_begin =
+    vtu.find('\n', vtu.find("<DataArray", vtu.find("<Points>"))) + 1;
+  const std::size_t array_end = vtu.find('\n', array_begin);
+  const std::string encoded =
+    vtu.substr(array_begin, array_end - array_begin);
+
+  // the first 16 characters encode the number of blocks and the (uncompressed)
+  // sizes of the blocks
+  const std::vector<unsigned char> header_start =
+    Utilities::decode_base64(encoded.substr(0, 16));
+  std::uint32_t header[3];
+  std::memcpy(header, header_start.data(), sizeof(header));
+  const std::uint32_t n_blocks = header[0];
+  deallog << "Number of blocks: " << n_blocks << std::endl;
+  deallog << "Block size: " << header[1] << std::endl;
+  deallog << "Last block size: " << header[2] << std::endl;
+
+  const std::size_t header_length = (3 + n_blocks) * sizeof(std::uint32_t);
+  const std::size_t encoded_header_length = (header_length + 2) / 3 * 4;
+  const std::vector<unsigned char> header_data =
+    Utilities::decode_base64(encoded.substr(0, encoded_header_length));
+  std::vector<std::uint32_t> compressed_sizes(n_blocks);
+  std::memcpy(compressed_sizes.data(),
+              header_data.data() + 3 * sizeof(std::uint32_t),
+              n_blocks * sizeof(std::uint32_t));
+
+  const std::vector<unsigned char> compressed_data =
+    Utilities::decode_base64(encoded.substr(encoded_header_length));
+
+  // decompress all blocks and compare with the point coordinates
+  std::vector<float> coordinates(3 * n_points_1d * n_points_1d);
+  AssertThrow(coordinates.size() * sizeof(float) ==
+                (n_blocks - 1) * header[1] + header[2],
+              ExcInternalError());
+  std::size_t compressed_position = 0;
+  for (unsigned int b = 0; b < n_blocks; ++b)
+    {
+      uLongf uncompressed_size = (b == n_blocks - 1) ? header[2] : header[1];
+      const int err =
+        uncompress(reinterpret_cast<Bytef *>(coordinates.data()) +
+                     b * header[1],
+                   &uncompressed_size,
+                   compressed_data.data() + compressed_position,
+                   compressed_sizes[b]);
+      AssertThrow(err == Z_OK, ExcInternalError());
+      compressed_position += compressed_sizes[b];
+    }
+  AssertThrow(compressed_position <= compressed_data.size(),
+              ExcInternalError());
+
+  double max_error = 0;
+  for (unsigned int j = 0; j < n_points_1d; ++j)
+    for (unsigned int i = 0; i < n_points_1d; ++i)
+      {
+        const unsigned int p = i + n_points_1d * j;
+
+        max_error =
+          std::max({max_error,
+                    std::abs(coordinates[3 * p] - 1. * i / n_subdivisions),
+                    std::abs(coordinates[3 * p + 1] - 1. * j / n_subdivisions),
+                    std::abs(double(coordinates[3 * p + 2]))});
+      }
+  deallog << "Maximal error in coordinates: "
+          << (max_error < 1e-6 ? "below 1e-6" : "too large") << std::endl;
+
+  deallog << "OK" << std::endl;
+}
@@ -0,0 +1,90 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+
+// Check that DoFTools::make_hanging_node_constraints() and
+// AffineConstraints::close() time their internal phases in the sections of a
+// TimerOutput object if one is given, and that the constraints are the same
+// as without timer.
+
+#include <deal.II/base/timer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  const FE_Q<dim> fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+
+  TimerOutput timer(deallog.get_file_stream(),
+                    TimerOutput::never,
+                    TimerOutput::wall_times);
+
+  AffineConstraints<double> timed_constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler,
+                                          timed_constraints,
+                                          &timer);
+  timed_constraints.close(&timer);
+
+  std::ostringstream lines, timed_lines;
+  constraints.print(lines);
+  timed_constraints.print(timed_lines);
+  deallog << "constraints "
+          << (lines.str() == timed_lines.str() ? "equal" : "different")
+          << std::endl;
+
+  for (const auto &section :
+       timer.get_summary_data(TimerOutput::n_calls))
+    deallog << section.first << ": " << section.second << " call(s)"
+            << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
@@ -0,0 +1,157 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Check DoFRenumbering::reverse_Cuthill_McKee and
+// DoFRenumbering::hilbert_curve on an adaptively refined mesh: both need to
+// produce valid permutations, the former a bandwidth not larger than the one
+// of the reversed Cuthill_McKee numbering, the latter a numbering in which
+// the degrees of freedom first encountered on a cell are numbered
+// contiguously.
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+types::global_dof_index
+bandwidth(const DoFHandler<dim> &dof_handler)
+{
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+  return sparsity.bandwidth();
+}
+
+
+
+void
+check_permutation(const std::vector<types::global_dof_index> &new_indices)
+{
+  std::vector<bool> found(new_indices.size(), false);
+  for (const auto i : new_indices)
+    {
+      AssertIndexRange(i, new_indices.size());
+      Assert(found[i] == false, ExcInternalError());
+      found[i] = true;
+    }
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(5 - dim);
+  for (unsigned int step = 0; step < 2; ++step)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->center()[0] > 0.3)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  deallog << "dim=" << dim << ", n_dofs=" << dof_handler.n_dofs()
+          << std::endl;
+
+  std::vector<types::global_dof_index> new_indices(dof_handler.n_dofs());
+
+  DoFRenumbering::compute_reverse_Cuthill_McKee(new_indices,
+                                                dof_handler,
+                                                true);
+  check_permutation(new_indices);
+  DoFRenumbering::compute_hilbert_curve(new_indices, dof_handler);
+  check_permutation(new_indices);
+
+  DoFRenumbering::Cuthill_McKee(dof_handler, true, true);
+  const types::global_dof_index cm_bandwidth = bandwidth(dof_handler);
+
+  DoFRenumbering::reverse_Cuthill_McKee(dof_handler, true);
+  const types::global_dof_index rcm_bandwidth = bandwidth(dof_handler);
+  deallog << "Bandwidth reverse Cuthill-McKee not larger: "
+          << (rcm_bandwidth <= cm_bandwidth ? "yes" : "no") << std::endl;
+
+  // after the Hilbert curve numbering, walking over the cells in the order of
+  // the curve has to encounter the degrees of freedom in increasing order. as
+  // every cell has an interior degree of freedom for FE_Q(2), the largest
+  // index on each cell is one that was numbered on this cell, so we can
+  // recover the order of the curve by sorting the cells by that index
+  DoFRenumbering::hilbert_curve(dof_handler);
+  std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    cells.push_back(cell);
+  std::sort(cells.begin(),
+            cells.end(),
+            [](const auto &a, const auto &b) {
+              std::vector<types::global_dof_index> a_dofs(
+                a->get_fe().n_dofs_per_cell());
+              std::vector<types::global_dof_index> b_dofs(
+                b->get_fe().n_dofs_per_cell());
+              a->get_dof_indices(a_dofs);
+              b->get_dof_indices(b_dofs);
+              return *std::max_element(a_dofs.begin(), a_dofs.end()) <
+                     *std::max_element(b_dofs.begin(), b_dofs.end());
+            });
+  types::global_dof_index              next_dof = 0;
+  bool                                 ok       = true;
+  std::vector<types::global_dof_index> dofs(fe.n_dofs_per_cell());
+  std::vector<bool>                    seen(dof_handler.n_dofs(), false);
+  for (const auto &cell : cells)
+    {
+      cell->get_dof_indices(dofs);
+      std::sort(dofs.begin(), dofs.end());
+      for (const auto i : dofs)
+        if (seen[i] == false)
+          {
+            ok      = ok && (i == next_dof);
+            seen[i] = true;
+            ++next_dof;
+          }
+    }
+  deallog << "Hilbert curve numbering is cell-wise: " << (ok ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
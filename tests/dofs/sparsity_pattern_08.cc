@@ -0,0 +1,108 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+
+// Check that DoFTools::make_sparsity_pattern_two_pass() creates the same
+// sparsity pattern as DoFTools::make_sparsity_pattern() with a
+// DynamicSparsityPattern, for an adaptively refined mesh with hanging node
+// and boundary constraints. Run with one and with several threads, where the
+// cells and rows are split into several ranges.
+
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+check(const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  for (unsigned int step = 0; step < 2; ++step)
+    {
+      unsigned int index = 0;
+      for (const auto &cell : tria.active_cell_iterators())
+        if (index++ % 3 == 0)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  VectorTools::interpolate_boundary_values(dof,
+                                           0,
+                                           Functions::ZeroFunction<dim>(
+                                             fe.n_components()),
+                                           constraints);
+  constraints.close();
+
+  for (const unsigned int n_threads : {1U, 4U})
+    for (const bool keep_constrained_dofs : {true, false})
+      {
+        MultithreadInfo::set_thread_limit(n_threads);
+
+        DynamicSparsityPattern dsp(dof.n_dofs());
+        DoFTools::make_sparsity_pattern(dof,
+                                        dsp,
+                                        constraints,
+                                        keep_constrained_dofs);
+        SparsityPattern sparsity_1;
+        sparsity_1.copy_from(dsp);
+
+        SparsityPattern sparsity_2;
+        DoFTools::make_sparsity_pattern_two_pass(dof,
+                                                 sparsity_2,
+                                                 constraints,
+                                                 keep_constrained_dofs);
+
+        deallog << fe.get_name() << ", " << n_threads
+                << " threads, keep_constrained_dofs = "
+                << keep_constrained_dofs << ": "
+                << (sparsity_1 == sparsity_2 ? "OK" : "FAILED") << std::endl;
+      }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check<2>(FE_Q<2>(1));
+  check<2>(FESystem<2>(FE_Q<2>(2), 2));
+  check<3>(FE_Q<3>(1));
+  check<3>(FESystem<3>(FE_Q<3>(2), 1, FE_Q<3>(1), 1));
+}
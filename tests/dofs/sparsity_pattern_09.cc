@@ -0,0 +1,145 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+
+// Check that DoFTools::make_sparsity_pattern() and
+// DoFTools::make_flux_sparsity_pattern() create the same sparsity patterns
+// when run with one thread and with several threads, on an adaptively
+// refined mesh with hanging node constraints. The last pattern uses a
+// face_has_flux_coupling function with mutable state, which must not be
+// called concurrently.
+
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+check(const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  for (unsigned int step = 0; step < 2; ++step)
+    {
+      unsigned int index = 0;
+      for (const auto &cell : tria.active_cell_iterators())
+        if (index++ % 3 == 0)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  constraints.close();
+
+  Table<2, DoFTools::Coupling> couplings(fe.n_components(),
+                                         fe.n_components());
+  couplings.fill(DoFTools::none);
+  for (unsigned int c = 0; c < fe.n_components(); ++c)
+    couplings(c, c) = DoFTools::always;
+
+  // a function with mutable state that records whether it is called
+  // concurrently
+  unsigned int n_calls = 0;
+  bool         in_call = false, called_concurrently = false;
+  const auto   face_has_flux_coupling =
+    [&](const typename DoFHandler<dim>::active_cell_iterator &cell,
+        const unsigned int                                    face) {
+      if (in_call)
+        called_concurrently = true;
+      in_call = true;
+      ++n_calls;
+      const bool result = cell->face(face)->center()[0] > 0.5;
+      in_call           = false;
+      return result;
+    };
+
+  const auto create_patterns = [&]() {
+    std::vector<SparsityPattern>        patterns(5);
+    std::vector<DynamicSparsityPattern> dsp(5);
+    for (auto &d : dsp)
+      d.reinit(dof.n_dofs(), dof.n_dofs());
+    DoFTools::make_sparsity_pattern(dof, dsp[0], constraints, false);
+    DoFTools::make_sparsity_pattern(dof, couplings, dsp[1], constraints);
+    DoFTools::make_flux_sparsity_pattern(dof, dsp[2], constraints);
+    DoFTools::make_flux_sparsity_pattern(
+      dof,
+      dsp[3],
+      constraints,
+      true,
+      couplings,
+      couplings,
+      numbers::invalid_subdomain_id);
+    DoFTools::make_flux_sparsity_pattern(dof,
+                                         dsp[4],
+                                         constraints,
+                                         true,
+                                         couplings,
+                                         couplings,
+                                         numbers::invalid_subdomain_id,
+                                         face_has_flux_coupling);
+    for (unsigned int i = 0; i < patterns.size(); ++i)
+      patterns[i].copy_from(dsp[i]);
+    return patterns;
+  };
+
+  MultithreadInfo::set_thread_limit(1);
+  const std::vector<SparsityPattern> serial_patterns = create_patterns();
+  const unsigned int                 n_calls_serial  = n_calls;
+  n_calls                                            = 0;
+  MultithreadInfo::set_thread_limit(4);
+  const std::vector<SparsityPattern> parallel_patterns = create_patterns();
+
+  for (unsigned int i = 0; i < serial_patterns.size(); ++i)
+    deallog << fe.get_name() << ", pattern " << i << ": "
+            << (serial_patterns[i] == parallel_patterns[i] ? "OK" : "FAILED")
+            << std::endl;
+  deallog << fe.get_name() << ", face_has_flux_coupling: same number of calls "
+          << (n_calls == n_calls_serial ? "OK" : "FAILED")
+          << ", called concurrently " << (called_concurrently ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check<2>(FE_Q<2>(2));
+  check<2>(FESystem<2>(FE_Q<2>(1), 1, FE_DGQ<2>(1), 1));
+  check<3>(FE_Q<3>(1));
+  check<3>(FESystem<3>(FE_Q<3>(1), 1, FE_DGQ<3>(0), 1));
+}
@@ -0,0 +1,133 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Compare the shape values and gradients, JxW values, and quadrature points
+// computed by FEValuesBatch with the ones of FEValues, for a curved mesh with
+// a number of cells that is not a multiple of the number of lanes, both with
+// a MappingQ (which is evaluated in a vectorized way) and with a MappingFE
+// (which is evaluated one cell at a time).
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_values_batch.h>
+#include <deal.II/fe/mapping_fe.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <string>
+
+#include "../tests.h"
+
+
+template <int dim, typename Number>
+void
+test(const Mapping<dim> &mapping, const std::string &mapping_name)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  const FE_Q<dim>   fe(2);
+  const QGauss<dim> quadrature(3);
+  const UpdateFlags flags = update_values | update_gradients |
+                            update_JxW_values | update_quadrature_points;
+
+  FEValues<dim>              fe_values(mapping, fe, quadrature, flags);
+  FEValuesBatch<dim, Number> fe_values_batch(mapping, fe, quadrature, flags);
+
+  std::vector<typename Triangulation<dim>::active_cell_iterator> cells;
+  for (const auto &cell : tria.active_cell_iterators())
+    cells.push_back(cell);
+
+  double error_value = 0, error_grad = 0, error_JxW = 0, error_point = 0;
+  for (unsigned int c = 0; c < cells.size(); c += fe_values_batch.n_lanes)
+    {
+      const unsigned int n_cells =
+        std::min<unsigned int>(fe_values_batch.n_lanes, cells.size() - c);
+      fe_values_batch.reinit(
+        make_array_view(cells.data() + c, cells.data() + c + n_cells));
+      AssertDimension(fe_values_batch.n_filled_lanes(), n_cells);
+
+      for (unsigned int lane = 0; lane < n_cells; ++lane)
+        {
+          AssertThrow(fe_values_batch.get_cell(lane) == cells[c + lane],
+                      ExcInternalError());
+          fe_values.reinit(cells[c + lane]);
+          for (const unsigned int q : fe_values.quadrature_point_indices())
+            {
+              error_JxW =
+                std::max(error_JxW,
+                         std::abs(fe_values_batch.JxW(q)[lane] -
+                                  fe_values.JxW(q)) /
+                           fe_values.JxW(q));
+              for (unsigned int d = 0; d < dim; ++d)
+                error_point = std::max(
+                  error_point,
+                  std::abs(fe_values_batch.quadrature_point(q)[d][lane] -
+                           fe_values.quadrature_point(q)[d]));
+              for (const unsigned int i : fe_values.dof_indices())
+                {
+                  error_value =
+                    std::max(error_value,
+                             std::abs(fe_values_batch.shape_value(i, q)[lane] -
+                                      fe_values.shape_value(i, q)));
+                  for (unsigned int d = 0; d < dim; ++d)
+                    error_grad = std::max(
+                      error_grad,
+                      std::abs(fe_values_batch.shape_grad(i, q)[d][lane] -
+                               fe_values.shape_grad(i, q)[d]) /
+                        fe_values.shape_grad(i, q).norm());
+                }
+            }
+        }
+    }
+
+  const double tolerance = std::is_same_v<Number, float> ? 1e-4 : 1e-10;
+  deallog << "dim=" << dim << ' ' << mapping_name << ' '
+          << (std::is_same_v<Number, float> ? "float" : "double") << ": "
+          << cells.size() << " cells, "
+          << (error_value < tolerance && error_grad < tolerance &&
+                  error_JxW < tolerance && error_point < tolerance ?
+                "OK" :
+                "wrong")
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  const MappingQ<dim>  mapping_q(3);
+  const MappingFE<dim> mapping_fe(FE_Q<dim>(2));
+
+  test<dim, double>(mapping_q, "MappingQ(3)");
+  test<dim, float>(mapping_q, "MappingQ(3)");
+  test<dim, double>(mapping_fe, "MappingFE(FE_Q(2))");
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
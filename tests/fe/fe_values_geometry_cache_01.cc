@@ -0,0 +1,129 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Test FEValues::enable_geometry_cache() on a locally refined mesh of a
+// parallelogram whose cells are visited in an order where consecutive cells
+// are usually not translations of each other. Compare with an FEValues
+// object without cache, and print the statistics of the cache. With a
+// MappingQ of degree two, the cache is not used.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const Mapping<dim> &mapping, const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  Point<dim>         corners[dim];
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      corners[d][d] = 1.;
+      if (d > 0)
+        corners[d][0] = 0.3;
+    }
+  GridGenerator::parallelepiped(tria, corners);
+  tria.refine_global(2);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.5)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  // visit the cells with a stride that is coprime to their number
+  std::vector<typename Triangulation<dim>::active_cell_iterator> cells;
+  for (const auto &cell : tria.active_cell_iterators())
+    cells.push_back(cell);
+  unsigned int stride = 7;
+  while (cells.size() % stride == 0)
+    stride += 2;
+
+  const QGauss<dim> quadrature(fe.degree + 1);
+  const UpdateFlags flags = update_values | update_gradients |
+                            update_JxW_values | update_quadrature_points;
+  FEValues<dim>     fe_values(mapping, fe, quadrature, flags);
+  FEValues<dim>     fe_values_cached(mapping, fe, quadrature, flags);
+  fe_values.always_allow_check_for_cell_similarity(true);
+  fe_values_cached.always_allow_check_for_cell_similarity(true);
+  fe_values_cached.enable_geometry_cache();
+
+  double error = 0;
+  for (unsigned int c = 0; c < cells.size(); ++c)
+    {
+      const auto &cell = cells[(c * stride) % cells.size()];
+      fe_values.reinit(cell);
+      fe_values_cached.reinit(cell);
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        {
+          error = std::max(error,
+                           std::abs(fe_values.JxW(q) -
+                                    fe_values_cached.JxW(q)) /
+                             fe_values.JxW(q));
+          error = std::max(error,
+                           fe_values.quadrature_point(q).distance(
+                             fe_values_cached.quadrature_point(q)));
+          for (const unsigned int i : fe_values.dof_indices())
+            {
+              error = std::max(error,
+                               std::abs(fe_values.shape_value(i, q) -
+                                        fe_values_cached.shape_value(i, q)));
+              error = std::max(error,
+                               (fe_values.shape_grad(i, q) -
+                                fe_values_cached.shape_grad(i, q))
+                                   .norm() *
+                                 cell->minimum_vertex_distance());
+            }
+        }
+    }
+
+  const auto statistics = fe_values_cached.get_geometry_cache_statistics();
+  deallog << fe.get_name() << ": " << cells.size() << " cells, "
+          << statistics.n_lookups << " lookups, " << statistics.n_hits
+          << " hits, " << statistics.n_entries << " entries, "
+          << (error < 1e-10 ? "OK" : "wrong") << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  const MappingQ<dim> mapping_q1(1);
+  const MappingQ<dim> mapping_q2(2);
+
+  test(mapping_q1, FE_Q<dim>(2));
+  test(mapping_q1, FESystem<dim>(FE_Q<dim>(2), dim, FE_DGQ<dim>(1), 1));
+  test(mapping_q2, FE_Q<dim>(2));
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
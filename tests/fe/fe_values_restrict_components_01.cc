@@ -0,0 +1,210 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Check FEValuesBase::restrict_to_components() for a Taylor-Hood element:
+// When only the pressure is selected, the pressure shape functions and the
+// pressure values computed through FEValuesViews::Scalar must be the same
+// as for an unrestricted FEValues object, and the velocity data must not be
+// computed. Also check FEValuesViews::Scalar::nonzero_shape_functions() and
+// FEValuesViews::Vector::nonzero_shape_functions(), and that all components
+// are computed again once the restriction is lifted. Finally, change the
+// restriction from cell to cell on a Cartesian mesh, where subsequent cells
+// are translations of each other, both for the Taylor-Hood element and for a
+// scalar element that ignores the restriction.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+
+  const FESystem<dim> fe(FE_Q<dim>(2), dim, FE_Q<dim>(1), 1);
+  DoFHandler<dim>     dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < solution.size(); ++i)
+    solution(i) = random_value<double>();
+
+  const FEValuesExtractors::Vector velocities(0);
+  const FEValuesExtractors::Scalar pressure(dim);
+
+  const MappingQ<dim> mapping(2);
+  const QGauss<dim>   quadrature(3);
+  const UpdateFlags   flags = update_values | update_gradients;
+  FEValues<dim>       fe_values_reference(mapping, fe, quadrature, flags);
+  FEValues<dim>       fe_values(mapping, fe, quadrature, flags);
+
+  // the shape functions with a nonzero pressure or velocity component
+  std::vector<unsigned int> pressure_dofs, velocity_dofs;
+  for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+    if (fe.system_to_component_index(i).first == dim)
+      pressure_dofs.push_back(i);
+    else
+      velocity_dofs.push_back(i);
+  deallog << "nonzero shape functions: pressure "
+          << (fe_values[pressure].nonzero_shape_functions() == pressure_dofs ?
+                "OK" :
+                "wrong")
+          << ", velocities "
+          << (fe_values[velocities].nonzero_shape_functions() ==
+                  velocity_dofs ?
+                "OK" :
+                "wrong")
+          << std::endl;
+
+  fe_values.restrict_to_components(fe.component_mask(pressure));
+  deallog << "component mask: " << fe_values.get_component_mask()
+          << std::endl;
+
+  std::vector<double> p_values(quadrature.size()),
+    p_values_reference(quadrature.size());
+  double error_shape = 0, error_function = 0;
+  bool   velocity_computed = false;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values_reference.reinit(cell);
+      fe_values.reinit(cell);
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        {
+          for (const unsigned int i :
+               fe_values[pressure].nonzero_shape_functions())
+            error_shape =
+              std::max({error_shape,
+                        std::abs(fe_values[pressure].value(i, q) -
+                                 fe_values_reference[pressure].value(i, q)),
+                        (fe_values[pressure].gradient(i, q) -
+                         fe_values_reference[pressure].gradient(i, q))
+                          .norm()});
+          for (const unsigned int i : velocity_dofs)
+            if (!std::isnan(fe_values.shape_value_component(
+                  i, q, fe.system_to_component_index(i).first)))
+              velocity_computed = true;
+        }
+
+      fe_values[pressure].get_function_values(solution, p_values);
+      fe_values_reference[pressure].get_function_values(solution,
+                                                        p_values_reference);
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        error_function =
+          std::max(error_function,
+                   std::abs(p_values[q] - p_values_reference[q]));
+    }
+  deallog << "restricted: pressure shape functions "
+          << (error_shape < 1e-12 ? "OK" : "wrong") << ", pressure values "
+          << (error_function < 1e-12 ? "OK" : "wrong")
+          << ", velocity computed " << (velocity_computed ? "yes" : "no")
+          << std::endl;
+
+  // lift the restriction again and check all components
+  fe_values.restrict_to_components(ComponentMask());
+  double error_all = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values_reference.reinit(cell);
+      fe_values.reinit(cell);
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        for (const unsigned int i : fe_values.dof_indices())
+          for (unsigned int c = 0; c < fe.n_components(); ++c)
+            error_all = std::max(
+              {error_all,
+               std::abs(fe_values.shape_value_component(i, q, c) -
+                        fe_values_reference.shape_value_component(i, q, c)),
+               (fe_values.shape_grad_component(i, q, c) -
+                fe_values_reference.shape_grad_component(i, q, c))
+                 .norm()});
+    }
+  deallog << "unrestricted: " << (error_all < 1e-12 ? "OK" : "wrong")
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test_cartesian(const FiniteElement<dim> &fe, const ComponentMask &mask)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  const MappingQ<dim> mapping(1);
+  const QGauss<dim>   quadrature(fe.degree + 1);
+  const UpdateFlags   flags = update_values | update_gradients;
+  FEValues<dim>       fe_values_reference(mapping, fe, quadrature, flags);
+  FEValues<dim>       fe_values(mapping, fe, quadrature, flags);
+
+  // only FESystem skips the components that are not selected
+  const bool mask_is_used = (dynamic_cast<const FESystem<dim> *>(&fe) !=
+                             nullptr);
+
+  // sum up the errors so that NaNs are not dropped as by std::max()
+  double error = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      const bool restricted = (cell->active_cell_index() % 2 == 0);
+      fe_values.restrict_to_components(restricted ? mask : ComponentMask());
+      fe_values_reference.reinit(cell);
+      fe_values.reinit(cell);
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        for (const unsigned int i : fe_values.dof_indices())
+          for (unsigned int c = 0; c < fe.n_components(); ++c)
+            if (!restricted || !mask_is_used || mask[c])
+              error +=
+                std::abs(fe_values.shape_value_component(i, q, c) -
+                         fe_values_reference.shape_value_component(i, q, c)) +
+                (fe_values.shape_grad_component(i, q, c) -
+                 fe_values_reference.shape_grad_component(i, q, c))
+                  .norm();
+    }
+  deallog << fe.get_name() << " on Cartesian mesh: "
+          << (error < 1e-12 ? "OK" : "wrong") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+
+  const FESystem<2> fe_system(FE_Q<2>(2), 2, FE_Q<2>(1), 1);
+  test_cartesian<2>(fe_system,
+                    fe_system.component_mask(FEValuesExtractors::Scalar(2)));
+  test_cartesian<2>(FE_Q<2>(2), ComponentMask(1, false));
+  test_cartesian<3>(FE_Q<3>(1), ComponentMask(1, false));
+}
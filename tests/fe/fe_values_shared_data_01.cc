@@ -0,0 +1,199 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// FEValues and FEFaceValues objects created with the same finite element,
+// mapping, quadrature formula, and update flags share the internal data of
+// the finite element (also for the base elements of an FESystem). Check that
+// such objects, created one after the other and concurrently on several
+// threads, really use the same internal data object, that they give the same
+// results as an object with different update flags (which does not share the
+// data), and that an object keeps working once the objects it shared the
+// data with have been destroyed. An FESystem does not share its own internal
+// data, only that of its base elements.
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <memory>
+
+#include "../tests.h"
+
+
+// A class that gives access to the internal data object of the finite
+// element used by an FEValues or FEFaceValues object
+template <typename FEValuesType>
+class FEValuesWithData : public FEValuesType
+{
+public:
+  using FEValuesType::FEValuesType;
+
+  const void *
+  get_fe_data() const
+  {
+    return this->fe_data.get();
+  }
+};
+
+
+
+template <typename FEValuesType>
+std::string
+check_sharing(
+  const FEValuesWithData<FEValuesType> &reference,
+  const std::vector<std::unique_ptr<FEValuesWithData<FEValuesType>>> &shared)
+{
+  for (const auto &fe_v : shared)
+    if (fe_v->get_fe_data() != shared[0]->get_fe_data())
+      return "not shared";
+  return shared[0]->get_fe_data() == reference.get_fe_data() ?
+           "shared with reference" :
+           "shared";
+}
+
+
+
+template <int dim, typename FEValuesType>
+double
+compare(const FEValuesType &fe_values_1, const FEValuesType &fe_values_2)
+{
+  const FiniteElement<dim> &fe    = fe_values_1.get_fe();
+  double                    error = 0;
+  for (const unsigned int i : fe_values_1.dof_indices())
+    for (const unsigned int q : fe_values_1.quadrature_point_indices())
+      for (unsigned int c = 0; c < fe.n_components(); ++c)
+        error =
+          std::max({error,
+                    std::abs(fe_values_1.shape_value_component(i, q, c) -
+                             fe_values_2.shape_value_component(i, q, c)),
+                    (fe_values_1.shape_grad_component(i, q, c) -
+                     fe_values_2.shape_grad_component(i, q, c))
+                      .norm()});
+  return error;
+}
+
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+
+  const MappingQ<dim>   mapping(3);
+  const QGauss<dim>     quadrature(fe.degree + 1);
+  const QGauss<dim - 1> face_quadrature(fe.degree + 1);
+  const UpdateFlags     flags = update_values | update_gradients;
+
+  using CellValues = FEValuesWithData<FEValues<dim>>;
+  using FaceValues = FEValuesWithData<FEFaceValues<dim>>;
+
+  // objects with different update flags, which do not share the data
+  CellValues fe_values_reference(mapping,
+                                 fe,
+                                 quadrature,
+                                 flags | update_hessians);
+  FaceValues fe_face_values_reference(mapping,
+                                      fe,
+                                      face_quadrature,
+                                      flags | update_hessians);
+
+  // create objects with the same arguments, which share the data, both one
+  // after the other and on several threads
+  std::vector<std::unique_ptr<CellValues>> fe_values_shared(4);
+  std::vector<std::unique_ptr<FaceValues>> fe_face_values_shared(4);
+  fe_values_shared[0] =
+    std::make_unique<CellValues>(mapping, fe, quadrature, flags);
+  fe_face_values_shared[0] =
+    std::make_unique<FaceValues>(mapping, fe, face_quadrature, flags);
+  Threads::TaskGroup<void> tasks;
+  for (unsigned int i = 1; i < fe_values_shared.size(); ++i)
+    tasks += Threads::new_task([&, i]() {
+      fe_values_shared[i] =
+        std::make_unique<CellValues>(mapping, fe, quadrature, flags);
+      fe_face_values_shared[i] =
+        std::make_unique<FaceValues>(mapping, fe, face_quadrature, flags);
+    });
+  tasks.join_all();
+
+  deallog << fe.get_name() << ": cell data "
+          << check_sharing(fe_values_reference, fe_values_shared)
+          << ", face data "
+          << check_sharing(fe_face_values_reference, fe_face_values_shared)
+          << std::endl;
+
+  double error_cell = 0, error_face = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      fe_values_reference.reinit(cell);
+      for (const auto &fe_v : fe_values_shared)
+        {
+          fe_v->reinit(cell);
+          error_cell =
+            std::max(error_cell, compare<dim>(*fe_v, fe_values_reference));
+        }
+      for (const unsigned int f : cell->face_indices())
+        {
+          fe_face_values_reference.reinit(cell, f);
+          for (const auto &fe_v : fe_face_values_shared)
+            {
+              fe_v->reinit(cell, f);
+              error_face =
+                std::max(error_face,
+                         compare<dim>(*fe_v, fe_face_values_reference));
+            }
+        }
+    }
+
+  // destroy all but the last of the objects sharing the data and check
+  // that the remaining one, now the only owner of the data, still gives the
+  // correct results
+  fe_values_shared.erase(fe_values_shared.begin(), fe_values_shared.end() - 1);
+  double error_remaining = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      fe_values_reference.reinit(cell);
+      fe_values_shared.back()->reinit(cell);
+      error_remaining =
+        std::max(error_remaining,
+                 compare<dim>(*fe_values_shared.back(), fe_values_reference));
+    }
+
+  deallog << fe.get_name() << ": cell " << (error_cell < 1e-12 ? "OK" : "wrong")
+          << ", face " << (error_face < 1e-12 ? "OK" : "wrong")
+          << ", after destruction "
+          << (error_remaining < 1e-12 ? "OK" : "wrong") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test(FE_Q<2>(2));
+  test(FESystem<2>(FE_Q<2>(2), 2, FE_DGQ<2>(1), 1));
+  test(FE_Q<3>(2));
+  test(FESystem<3>(FE_Q<3>(3), 3, FE_Q<3>(2), 1));
+}
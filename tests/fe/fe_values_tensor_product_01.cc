@@ -0,0 +1,130 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Check that FEValues::get_function_values() and get_function_gradients(),
+// which use sum factorization for FE_Q and FE_DGQ with tensor-product
+// quadrature formulas, give the same result as summing up the shape values
+// and shape gradients, on a curved mesh. Also check a quadrature formula
+// that is not a tensor product and thus uses the table-based evaluation.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe, const Quadrature<dim> &quadrature)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < solution.size(); ++i)
+    solution(i) = random_value<double>();
+
+  const MappingQ<dim> mapping(3);
+  const UpdateFlags   flags = update_values | update_gradients;
+  FEValues<dim>       fe_values(mapping, fe, quadrature, flags);
+
+  std::vector<double>                  values(quadrature.size());
+  std::vector<Tensor<1, dim>>          gradients(quadrature.size());
+  std::vector<double>                  values_indices(quadrature.size());
+  std::vector<Tensor<1, dim>>          gradients_indices(quadrature.size());
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+
+  double error_values = 0, error_gradients = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      cell->get_dof_indices(dof_indices);
+      fe_values.get_function_values(solution, values);
+      fe_values.get_function_gradients(solution, gradients);
+      fe_values.get_function_values(solution,
+                                    make_array_view(dof_indices),
+                                    values_indices);
+      fe_values.get_function_gradients(solution,
+                                       make_array_view(dof_indices),
+                                       gradients_indices);
+
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        {
+          double         value = 0;
+          Tensor<1, dim> gradient;
+          for (const unsigned int i : fe_values.dof_indices())
+            {
+              value += solution(dof_indices[i]) * fe_values.shape_value(i, q);
+              gradient += solution(dof_indices[i]) * fe_values.shape_grad(i, q);
+            }
+          error_values =
+            std::max(error_values,
+                     std::max(std::abs(values[q] - value),
+                              std::abs(values_indices[q] - value)));
+          error_gradients =
+            std::max(error_gradients,
+                     std::max((gradients[q] - gradient).norm(),
+                              (gradients_indices[q] - gradient).norm()) *
+                       cell->diameter());
+        }
+    }
+
+  deallog << fe.get_name() << " with " << quadrature.size()
+          << " points: values " << (error_values < 1e-12 ? "OK" : "wrong")
+          << ", gradients " << (error_gradients < 1e-11 ? "OK" : "wrong")
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  for (unsigned int degree = 1; degree < 6; ++degree)
+    {
+      test(FE_Q<dim>(degree), QGauss<dim>(degree + 1));
+      test(FE_DGQ<dim>(degree), QGauss<dim>(degree + 2));
+    }
+  test(FE_Q<dim>(4), QGaussLobatto<dim>(5));
+
+  const QGauss<dim> quadrature(4);
+  test(FE_Q<dim>(3),
+       Quadrature<dim>(quadrature.get_points(), quadrature.get_weights()));
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,142 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Check FEInterfaceValues::get_jump_in_shape_values() and the related
+// functions that compute the jumps and averages of all shape functions at
+// all quadrature points at once against the functions for individual shape
+// functions and quadrature points, on interior faces, faces with hanging
+// nodes, and boundary faces. Use both discontinuous elements, where the
+// interface DoFs are set up without a search for common DoFs, and continuous
+// elements. Also print the number of interface DoFs.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_interface_values.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+double
+compare(const FEInterfaceValues<dim> &fiv, const unsigned int component)
+{
+  Table<2, double>         jumps, averages;
+  Table<2, Tensor<1, dim>> jump_gradients, average_gradients;
+  fiv.get_jump_in_shape_values(jumps, component);
+  fiv.get_average_of_shape_values(averages, component);
+  fiv.get_jump_in_shape_gradients(jump_gradients, component);
+  fiv.get_average_of_shape_gradients(average_gradients, component);
+
+  double error = 0;
+  for (const unsigned int i : fiv.dof_indices())
+    for (const unsigned int q : fiv.quadrature_point_indices())
+      error = std::max(
+        {error,
+         std::abs(jumps(i, q) - fiv.jump_in_shape_values(i, q, component)),
+         std::abs(averages(i, q) -
+                  fiv.average_of_shape_values(i, q, component)),
+         (jump_gradients(i, q) - fiv.jump_in_shape_gradients(i, q, component))
+           .norm(),
+         (average_gradients(i, q) -
+          fiv.average_of_shape_gradients(i, q, component))
+           .norm()});
+  return error;
+}
+
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe, const unsigned int component)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  const MappingQ<dim>    mapping(1);
+  FEInterfaceValues<dim> fiv(mapping,
+                             fe,
+                             QGauss<dim - 1>(fe.degree + 1),
+                             update_values | update_gradients);
+
+  double       error                  = 0;
+  unsigned int n_interface_dofs       = 0;
+  unsigned int n_interface_dofs_inner = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    for (const unsigned int f : cell->face_indices())
+      {
+        if (cell->at_boundary(f))
+          {
+            fiv.reinit(cell, f);
+            n_interface_dofs += fiv.n_current_interface_dofs();
+          }
+        else if (cell->neighbor_is_coarser(f))
+          {
+            const auto neighbor_face = cell->neighbor_of_coarser_neighbor(f);
+            fiv.reinit(cell,
+                       f,
+                       numbers::invalid_unsigned_int,
+                       cell->neighbor(f),
+                       neighbor_face.first,
+                       neighbor_face.second);
+            n_interface_dofs_inner += fiv.n_current_interface_dofs();
+          }
+        else if (cell->neighbor(f)->is_active())
+          {
+            fiv.reinit(cell,
+                       f,
+                       numbers::invalid_unsigned_int,
+                       cell->neighbor(f),
+                       cell->neighbor_of_neighbor(f),
+                       numbers::invalid_unsigned_int);
+            n_interface_dofs_inner += fiv.n_current_interface_dofs();
+          }
+        else
+          continue;
+
+        error = std::max(error, compare(fiv, component));
+      }
+
+  deallog << fe.get_name() << ", component " << component
+          << ": interface dofs on boundary " << n_interface_dofs
+          << ", interior " << n_interface_dofs_inner << ", error "
+          << (error < 1e-12 ? "OK" : "wrong") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(FE_DGQ<2>(2), 0);
+  test<2>(FE_Q<2>(2), 0);
+  test<2>(FESystem<2>(FE_DGQ<2>(1), 2), 1);
+  test<3>(FE_DGQ<3>(1), 0);
+  test<3>(FE_Q<3>(1), 0);
+}
@@ -0,0 +1,106 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+// Test GridTools::compute_point_locations on a curved mesh with a
+// high-order mapping, where the points of one cell are inverted as a
+// batch. Check that all points are found, that the reference points map
+// back to the original points, and that every cell is listed only once.
+
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include <set>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int n_points)
+{
+  deallog << "Testing for dim = " << dim << " on " << n_points << " points"
+          << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(6 - dim);
+
+  MappingQ<dim>              mapping(3);
+  GridTools::Cache<dim, dim> cache(tria, mapping);
+
+  // Create random points well inside the ball
+  std::vector<Point<dim>> points;
+  while (points.size() < n_points)
+    {
+      Point<dim> p;
+      for (unsigned int d = 0; d < dim; ++d)
+        p[d] = 2. * random_value<double>() - 1.;
+      if (p.norm() < 0.9)
+        points.push_back(p);
+    }
+
+  const auto cell_qpoint_map =
+    GridTools::compute_point_locations_try_all(cache, points);
+  const auto &cells   = std::get<0>(cell_qpoint_map);
+  const auto &qpoints = std::get<1>(cell_qpoint_map);
+  const auto &indices = std::get<2>(cell_qpoint_map);
+  const auto &missing = std::get<3>(cell_qpoint_map);
+
+  deallog << "Points not found: " << missing.size() << std::endl;
+
+  std::set<unsigned int> visited_cells;
+  std::vector<bool>      point_seen(points.size(), false);
+  unsigned int           n_found = 0;
+  for (unsigned int c = 0; c < cells.size(); ++c)
+    {
+      if (visited_cells.insert(cells[c]->active_cell_index()).second == false)
+        deallog << "Cell " << cells[c]->id() << " listed twice" << std::endl;
+
+      for (unsigned int q = 0; q < qpoints[c].size(); ++q)
+        {
+          const unsigned int index = indices[c][q];
+          if (point_seen[index])
+            deallog << "Point " << index << " found twice" << std::endl;
+          point_seen[index] = true;
+          ++n_found;
+
+          if (cells[c]->reference_cell().contains_point(qpoints[c][q],
+                                                        1e-10) == false)
+            deallog << "Reference point " << qpoints[c][q]
+                    << " outside of cell " << cells[c]->id() << std::endl;
+
+          const Point<dim> p_real =
+            mapping.transform_unit_to_real_cell(cells[c], qpoints[c][q]);
+          if (p_real.distance(points[index]) > 1e-10)
+            deallog << "Point " << points[index] << " mapped back to "
+                    << p_real << std::endl;
+        }
+    }
+
+  deallog << "Points found: " << n_found << std::endl;
+  deallog << "OK" << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(1000);
+  test<3>(1000);
+}
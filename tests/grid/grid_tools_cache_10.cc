@@ -0,0 +1,162 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+// Check that the incremental update of GridTools::Cache upon local
+// refinement and coarsening of a serial triangulation gives the same data
+// structures as a cache that is built from scratch.
+
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim, typename RTreeType>
+std::map<unsigned int, std::pair<Point<dim>, Point<dim>>>
+extract_boxes(const RTreeType &tree)
+{
+  std::map<unsigned int, std::pair<Point<dim>, Point<dim>>> result;
+  for (const auto &box_and_cell : tree)
+    result[box_and_cell.second->active_cell_index()] =
+      box_and_cell.first.get_boundary_points();
+  return result;
+}
+
+
+
+template <int dim>
+void
+compare(const GridTools::Cache<dim> &cache,
+        const GridTools::Cache<dim> &reference)
+{
+  bool ok = true;
+
+  if (cache.get_vertex_to_cell_map() != reference.get_vertex_to_cell_map())
+    {
+      deallog << "vertex_to_cell_map differs" << std::endl;
+      ok = false;
+    }
+
+  const auto &directions = cache.get_vertex_to_cell_centers_directions();
+  const auto &reference_directions =
+    reference.get_vertex_to_cell_centers_directions();
+  if (directions.size() != reference_directions.size())
+    ok = false;
+  else
+    for (unsigned int v = 0; v < directions.size(); ++v)
+      {
+        if (directions[v].size() != reference_directions[v].size())
+          ok = false;
+        else
+          for (unsigned int i = 0; i < directions[v].size(); ++i)
+            if ((directions[v][i] - reference_directions[v][i]).norm() > 1e-12)
+              ok = false;
+      }
+  if (!ok)
+    deallog << "vertex_to_cell_centers_directions differs" << std::endl;
+
+  if (cache.get_used_vertices() != reference.get_used_vertices())
+    {
+      deallog << "used_vertices differs" << std::endl;
+      ok = false;
+    }
+
+  std::set<std::pair<unsigned int, std::vector<double>>> vertices, ref_vertices;
+  for (const auto &p : cache.get_used_vertices_rtree())
+    vertices.emplace(p.second,
+                     std::vector<double>(p.first.begin_raw(),
+                                         p.first.end_raw()));
+  for (const auto &p : reference.get_used_vertices_rtree())
+    ref_vertices.emplace(p.second,
+                         std::vector<double>(p.first.begin_raw(),
+                                             p.first.end_raw()));
+  if (vertices != ref_vertices)
+    {
+      deallog << "used_vertices_rtree differs" << std::endl;
+      ok = false;
+    }
+
+  if (extract_boxes<dim>(cache.get_cell_bounding_boxes_rtree()) !=
+      extract_boxes<dim>(reference.get_cell_bounding_boxes_rtree()))
+    {
+      deallog << "cell_bounding_boxes_rtree differs" << std::endl;
+      ok = false;
+    }
+
+  if (extract_boxes<dim>(cache.get_locally_owned_cell_bounding_boxes_rtree()) !=
+      extract_boxes<dim>(
+        reference.get_locally_owned_cell_bounding_boxes_rtree()))
+    {
+      deallog << "locally_owned_cell_bounding_boxes_rtree differs"
+              << std::endl;
+      ok = false;
+    }
+
+  if (ok)
+    deallog << "OK" << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  deallog << "dim = " << dim << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+
+  MappingQ<dim>         mapping(2);
+  GridTools::Cache<dim> cache(tria, mapping);
+
+  for (unsigned int cycle = 0; cycle < 6; ++cycle)
+    {
+      // Compare all data structures. This also makes sure they are computed
+      // before the refinement step, so that they are updated incrementally
+      deallog << "Cycle " << cycle << ": ";
+      {
+        GridTools::Cache<dim> reference(tria, mapping);
+        compare(cache, reference);
+      }
+
+      // Refine some cells in every cycle, and coarsen some cells in every
+      // other cycle
+      for (const auto &cell : tria.active_cell_iterators())
+        if (Testing::rand() % 5 == 0)
+          cell->set_refine_flag();
+        else if (cycle % 2 == 1 && cell->level() > 1 &&
+                 Testing::rand() % 3 == 0)
+          cell->set_coarsen_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  deallog << "Final mesh: ";
+  GridTools::Cache<dim> reference(tria, mapping);
+  compare(cache, reference);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,153 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Test Triangulation::save() with asynchronous saving of fixed and variable
+// size data attached to the cells, see Triangulation::set_asynchronous_save(),
+// and check that the number of bytes reported by
+// Triangulation::get_asynchronous_save_statistics() matches the size of the
+// files written. Load the data again and compare.
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+std::vector<char>
+pack_center(const typename Triangulation<dim>::cell_iterator &cell,
+            const CellStatus)
+{
+  return Utilities::pack(cell->center(), /*allow_compression=*/false);
+}
+
+
+
+template <int dim>
+std::vector<char>
+pack_id(const typename Triangulation<dim>::cell_iterator &cell,
+        const CellStatus)
+{
+  const std::string id = cell->id().to_string();
+  return std::vector<char>(id.begin(), id.end());
+}
+
+
+
+std::size_t
+file_size(const std::string &filename)
+{
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  return file.tellg();
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  const std::string filename = "save_load_" + std::to_string(dim) + "d_out";
+
+  {
+    Triangulation<dim> tria;
+    GridGenerator::hyper_cube(tria);
+    tria.refine_global(2);
+    tria.begin_active()->set_refine_flag();
+    tria.execute_coarsening_and_refinement();
+
+    tria.register_data_attach(pack_center<dim>,
+                              /*returns_variable_size_data=*/false);
+    tria.register_data_attach(pack_id<dim>,
+                              /*returns_variable_size_data=*/true);
+
+    deallog << "statistics before save: "
+            << tria.get_asynchronous_save_statistics().n_bytes << " bytes"
+            << std::endl;
+
+    tria.set_asynchronous_save(true);
+    tria.save(filename);
+    deallog << "writing #cells = " << tria.n_active_cells() << std::endl;
+
+    // the mesh can be modified while the data is being written
+    tria.refine_global(1);
+
+    tria.wait_for_asynchronous_save();
+
+    const auto statistics = tria.get_asynchronous_save_statistics();
+    deallog << "bytes written "
+            << (statistics.n_bytes == file_size(filename + "_fixed.data") +
+                                        file_size(filename + "_variable.data") ?
+                  "OK" :
+                  "wrong")
+            << ", time measured " << (statistics.wall_time >= 0 ? "yes" : "no")
+            << ", throughput "
+            << (statistics.throughput() >= 0 ? "nonnegative" : "negative")
+            << std::endl;
+  }
+
+  Triangulation<dim> tria;
+  tria.load(filename);
+
+  const unsigned int handle_center =
+    tria.register_data_attach(pack_center<dim>,
+                              /*returns_variable_size_data=*/false);
+  const unsigned int handle_id =
+    tria.register_data_attach(pack_id<dim>,
+                              /*returns_variable_size_data=*/true);
+
+  unsigned int n_errors = 0;
+  tria.notify_ready_to_unpack(
+    handle_center,
+    [&](const typename Triangulation<dim>::cell_iterator &cell,
+        const CellStatus,
+        const boost::iterator_range<std::vector<char>::const_iterator>
+          &data_range) {
+      const Point<dim> center =
+        Utilities::unpack<Point<dim>>(data_range.begin(),
+                                      data_range.end(),
+                                      /*allow_compression=*/false);
+      if (center.distance(cell->center()) > 1e-12)
+        ++n_errors;
+    });
+  tria.notify_ready_to_unpack(
+    handle_id,
+    [&](const typename Triangulation<dim>::cell_iterator &cell,
+        const CellStatus,
+        const boost::iterator_range<std::vector<char>::const_iterator>
+          &data_range) {
+      if (std::string(data_range.begin(), data_range.end()) !=
+          cell->id().to_string())
+        ++n_errors;
+    });
+
+  deallog << "reading #cells = " << tria.n_active_cells()
+          << ", #errors = " << n_errors << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
@@ -0,0 +1,107 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Check the statistics of hp::FEValues::reinit() returned by
+// hp::FEValuesBase::get_reinit_statistics(), both for objects created lazily
+// and in advance by precalculate_fe_values(), and check that calling
+// precalculate_fe_values() again does not create objects anew.
+
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/hp/fe_collection.h>
+#include <deal.II/hp/fe_values.h>
+#include <deal.II/hp/q_collection.h>
+
+#include "../tests.h"
+
+
+template <int dim, typename FEValuesType>
+void
+print_statistics(const FEValuesType &hp_fe_values)
+{
+  const auto &statistics = hp_fe_values.get_reinit_statistics();
+  for (unsigned int i = 0; i < statistics.n_reinits.size(); ++i)
+    deallog << "fe_index " << i << ": " << statistics.n_reinits[i]
+            << " reinits, " << statistics.n_fe_values_created[i]
+            << " objects created, time measured "
+            << (statistics.reinit_times[i] > 0 ? "yes" : "no") << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+
+  hp::FECollection<dim> fe_collection;
+  hp::QCollection<dim>  q_collection;
+  for (unsigned int degree = 1; degree <= 4; ++degree)
+    {
+      fe_collection.push_back(FE_Q<dim>(degree));
+      q_collection.push_back(QGauss<dim>(degree + 1));
+    }
+
+  // use the last element of the collection nowhere
+  DoFHandler<dim> dof_handler(tria);
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    cell->set_active_fe_index(cell->active_cell_index() % 3);
+  dof_handler.distribute_dofs(fe_collection);
+
+  hp::FEValues<dim> hp_fe_values(fe_collection,
+                                 q_collection,
+                                 update_values | update_gradients);
+
+  deallog << "lazy creation:" << std::endl;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    hp_fe_values.reinit(cell);
+  print_statistics<dim>(hp_fe_values);
+
+  deallog << "complete by precalculate_fe_values():" << std::endl;
+  hp_fe_values.precalculate_fe_values();
+  print_statistics<dim>(hp_fe_values);
+
+  deallog << "precalculate_fe_values() again:" << std::endl;
+  hp_fe_values.reset_reinit_statistics();
+  hp_fe_values.precalculate_fe_values();
+  print_statistics<dim>(hp_fe_values);
+
+  deallog << "copy with time measurements:" << std::endl;
+  hp::FEValues<dim> hp_fe_values_copy(hp_fe_values);
+  hp_fe_values_copy.measure_reinit_times();
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    hp_fe_values_copy.reinit(cell);
+  print_statistics<dim>(hp_fe_values_copy);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
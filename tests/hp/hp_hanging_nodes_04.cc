@@ -0,0 +1,89 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Check that DoFTools::make_hanging_node_constraints() computes the same
+// constraints for hp-discretizations with one and with several threads.
+
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/hp/fe_collection.h>
+
+#include <sstream>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> triangulation;
+  GridGenerator::hyper_cube(triangulation);
+  triangulation.refine_global(2);
+  for (unsigned int step = 0; step < 2; ++step)
+    {
+      unsigned int index = 0;
+      for (const auto &cell : triangulation.active_cell_iterators())
+        if (index++ % 3 == 0)
+          cell->set_refine_flag();
+      triangulation.execute_coarsening_and_refinement();
+    }
+
+  hp::FECollection<dim> fe_collection;
+  for (unsigned int degree = 1; degree <= 3; ++degree)
+    fe_collection.push_back(FE_Q<dim>(degree));
+
+  DoFHandler<dim> dof_handler(triangulation);
+  unsigned int    index = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    cell->set_active_fe_index((index++ * 7) % fe_collection.size());
+  dof_handler.distribute_dofs(fe_collection);
+
+  const auto print_constraints = [&]() {
+    AffineConstraints<double> constraints;
+    DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+    constraints.close();
+
+    std::ostringstream stream;
+    constraints.print(stream);
+    return stream.str();
+  };
+
+  MultithreadInfo::set_thread_limit(1);
+  const auto serial_constraints = print_constraints();
+  MultithreadInfo::set_thread_limit(4);
+  const auto parallel_constraints = print_constraints();
+
+  deallog << "dim = " << dim << ": "
+          << (serial_constraints == parallel_constraints ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,102 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Check that AffineConstraints::close() resolves long chains of constraints
+// that were added in arbitrary order, and that it detects cycles.
+
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <vector>
+
+#include "../tests.h"
+
+
+void
+test_chains()
+{
+  // dofs 0...n-1 are constrained to their two successors, dofs n and n+1
+  // are unconstrained. add the lines in reverse order to make sure that they
+  // need to be sorted
+  const unsigned int        n = 2000;
+  AffineConstraints<double> constraints;
+  for (unsigned int i = n; i-- > 0;)
+    constraints.add_constraint(i, {{i + 1, 0.5}, {i + 2, 0.5}}, 1.);
+  constraints.close();
+
+  bool ok = true;
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      const auto &entries = *constraints.get_constraint_entries(i);
+      if (entries.size() != 2 || entries[0].first != n ||
+          entries[1].first != n + 1 ||
+          std::abs(entries[0].second + entries[1].second - 1.) > 1e-12)
+        ok = false;
+    }
+  deallog << "Chains resolved: " << (ok ? "OK" : "FAILED") << std::endl;
+
+  for (const unsigned int i : {n - 1, n - 2, n - 3})
+    {
+      deallog << i << ':';
+      for (const auto &entry : *constraints.get_constraint_entries(i))
+        deallog << ' ' << entry.first << '(' << entry.second << ')';
+      deallog << " inhomogeneity " << constraints.get_inhomogeneity(i)
+              << std::endl;
+    }
+
+  // the inhomogeneity of dof i is the sum of the inhomogeneities of the lines
+  // it depends on, i.e., it satisfies the recursion
+  // g_i = 1 + (g_{i+1} + g_{i+2})/2
+  std::vector<double> inhomogeneities(n + 2, 0.);
+  for (unsigned int i = n; i-- > 0;)
+    inhomogeneities[i] =
+      1. + 0.5 * (inhomogeneities[i + 1] + inhomogeneities[i + 2]);
+  ok = true;
+  for (unsigned int i = 0; i < n; ++i)
+    if (std::abs(constraints.get_inhomogeneity(i) - inhomogeneities[i]) >
+        1e-10 * inhomogeneities[i])
+      ok = false;
+  deallog << "Inhomogeneities: " << (ok ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+void
+test_cycle()
+{
+  AffineConstraints<double> constraints;
+  constraints.add_constraint(0, {{1, 1.}}, 0.);
+  constraints.add_constraint(1, {{2, 1.}}, 0.);
+  constraints.add_constraint(2, {{0, 1.}}, 0.);
+
+  try
+    {
+      constraints.close();
+      deallog << "Cycle not detected" << std::endl;
+    }
+  catch (const ExceptionBase &)
+    {
+      deallog << "Cycle detected" << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test_chains();
+  test_cycle();
+}
@@ -0,0 +1,140 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Check AffineConstraints::distribute_local_to_global_atomic() with several
+// threads writing into the same SparseMatrix and Vector at the same time,
+// and Threads::atomic_add() itself.
+
+
+#include <deal.II/base/atomic_add.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <complex>
+#include <thread>
+#include <vector>
+
+#include "../tests.h"
+
+
+void
+test_atomic_add()
+{
+  const unsigned int n_threads = 4, n_additions = 100000;
+
+  double                   sum = 0;
+  std::complex<float>      complex_sum(0, 0);
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < n_threads; ++t)
+    threads.emplace_back([&]() {
+      for (unsigned int i = 0; i < n_additions; ++i)
+        {
+          Threads::atomic_add(sum, 1.);
+          Threads::atomic_add(complex_sum, std::complex<float>(1, -2));
+        }
+    });
+  for (auto &thread : threads)
+    thread.join();
+
+  deallog << "Sum: " << sum << ", complex sum: " << complex_sum << std::endl;
+}
+
+
+
+void
+test_distribute()
+{
+  // a one-dimensional chain of cells with four dofs each, where neighboring
+  // cells share two dofs
+  const unsigned int n_cells = 400;
+  const unsigned int n_dofs  = 2 * n_cells + 2;
+  std::vector<std::vector<types::global_dof_index>> cells(n_cells);
+  for (unsigned int c = 0; c < n_cells; ++c)
+    cells[c] = {2 * c + 3, 2 * c, 2 * c + 2, 2 * c + 1};
+
+  AffineConstraints<double> constraints;
+  constraints.add_constraint(0, {}, 2.);
+  for (unsigned int i = 5; i < n_dofs - 1; i += 5)
+    constraints.add_constraint(i,
+                               {{i - 1, 0.25}, {i + 1, 0.75}},
+                               (i % 3 == 0) ? 0.5 : 0.);
+  constraints.close();
+
+  DynamicSparsityPattern dsp(n_dofs, n_dofs);
+  for (const auto &cell : cells)
+    constraints.add_entries_local_to_global(cell, dsp, false);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  const auto local_matrix = [](const unsigned int c) {
+    FullMatrix<double> matrix(4, 4);
+    for (unsigned int i = 0; i < 4; ++i)
+      for (unsigned int j = 0; j < 4; ++j)
+        matrix(i, j) = (i == j ? 4. : -1.) + 0.01 * ((c + i + 2 * j) % 7);
+    return matrix;
+  };
+  const auto local_vector = [](const unsigned int c) {
+    Vector<double> vector(4);
+    for (unsigned int i = 0; i < 4; ++i)
+      vector(i) = 1. + 0.1 * ((c + i) % 5);
+    return vector;
+  };
+
+  SparseMatrix<double> matrix_ref(sparsity);
+  Vector<double>       rhs_ref(n_dofs);
+  for (unsigned int c = 0; c < n_cells; ++c)
+    constraints.distribute_local_to_global(
+      local_matrix(c), local_vector(c), cells[c], matrix_ref, rhs_ref, true);
+
+  // let several threads work on interleaved cells, so that they
+  // permanently write into the same rows
+  SparseMatrix<double>     matrix(sparsity);
+  Vector<double>           rhs(n_dofs);
+  const unsigned int       n_threads = 4;
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < n_threads; ++t)
+    threads.emplace_back([&, t]() {
+      for (unsigned int c = t; c < n_cells; c += n_threads)
+        constraints.distribute_local_to_global_atomic(
+          local_matrix(c), local_vector(c), cells[c], matrix, rhs, true);
+    });
+  for (auto &thread : threads)
+    thread.join();
+
+  matrix.add(-1., matrix_ref);
+  rhs -= rhs_ref;
+  deallog << "Relative difference matrix: "
+          << (matrix.frobenius_norm() / matrix_ref.frobenius_norm() < 1e-14 ?
+                "OK" :
+                "FAILED")
+          << std::endl;
+  deallog << "Relative difference vector: "
+          << (rhs.l2_norm() / rhs_ref.l2_norm() < 1e-14 ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test_atomic_add();
+  test_distribute();
+}
@@ -0,0 +1,157 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Check that AffineConstraints::distribute_local_to_global() gives the same
+// result when the constraint resolution is taken from a
+// AffineConstraints::LocalToGlobalCache object, for standard and block
+// matrices.
+
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/block_sparse_matrix.h>
+#include <deal.II/lac/block_sparsity_pattern.h>
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <vector>
+
+#include "../tests.h"
+
+
+template <typename MatrixType, typename VectorType>
+void
+assemble(const AffineConstraints<double>                          &constraints,
+         const AffineConstraints<double>::LocalToGlobalCache      *cache,
+         const std::vector<std::vector<types::global_dof_index>> &cells,
+         MatrixType                                               &matrix,
+         VectorType                                               &rhs)
+{
+  unsigned int counter = 0;
+  for (unsigned int c = 0; c < cells.size(); ++c)
+    {
+      const unsigned int n = cells[c].size();
+      FullMatrix<double> local_matrix(n, n);
+      Vector<double>     local_vector(n);
+      for (unsigned int i = 0; i < n; ++i)
+        {
+          for (unsigned int j = 0; j < n; ++j)
+            local_matrix(i, j) = (i == j ? 4. : -1.) + 0.01 * (++counter % 7);
+          local_vector(i) = 1. + 0.1 * (counter % 5);
+        }
+      if (cache == nullptr)
+        constraints.distribute_local_to_global(
+          local_matrix, local_vector, cells[c], matrix, rhs, true);
+      else
+        constraints.distribute_local_to_global(*cache,
+                                               c,
+                                               local_matrix,
+                                               local_vector,
+                                               cells[c],
+                                               matrix,
+                                               rhs,
+                                               true);
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  // a one-dimensional chain of cells with four dofs each, where neighboring
+  // cells share two dofs. the cells are numbered in a scattered way to make
+  // sure that the local indices are not sorted
+  const unsigned int                                n_cells = 40;
+  const unsigned int                                n_dofs  = 2 * n_cells + 2;
+  std::vector<std::vector<types::global_dof_index>> cells(n_cells);
+  for (unsigned int c = 0; c < n_cells; ++c)
+    cells[(7 * c) % n_cells] = {2 * c + 3, 2 * c, 2 * c + 2, 2 * c + 1};
+
+  // constrain every fifth dof to its two neighbors, some of them
+  // inhomogeneously, and the first dof to a fixed value
+  AffineConstraints<double> constraints;
+  constraints.add_constraint(0, {}, 2.);
+  for (unsigned int i = 5; i < n_dofs - 1; i += 5)
+    constraints.add_constraint(i,
+                               {{i - 1, 0.25}, {i + 1, 0.75}},
+                               (i % 3 == 0) ? 0.5 : 0.);
+  constraints.close();
+
+  AffineConstraints<double>::LocalToGlobalCache cache;
+  cache.reinit(n_cells);
+  for (unsigned int c = 0; c < n_cells; ++c)
+    constraints.prepare_local_to_global(c, cells[c], cache);
+  deallog << "Cells with constraints: " << cache.n_constrained_cells()
+          << " of " << cache.size() << std::endl;
+
+  DynamicSparsityPattern dsp(n_dofs, n_dofs);
+  for (const auto &cell : cells)
+    constraints.add_entries_local_to_global(cell, dsp, false);
+
+  // standard matrix
+  {
+    SparsityPattern sparsity;
+    sparsity.copy_from(dsp);
+    SparseMatrix<double> matrix_ref(sparsity), matrix(sparsity);
+    Vector<double>       rhs_ref(n_dofs), rhs(n_dofs);
+    assemble(constraints, nullptr, cells, matrix_ref, rhs_ref);
+    assemble(constraints, &cache, cells, matrix, rhs);
+
+    matrix.add(-1., matrix_ref);
+    rhs -= rhs_ref;
+    deallog << "SparseMatrix difference: " << matrix.frobenius_norm() << ' '
+            << rhs.l2_norm() << " (reference " << matrix_ref.frobenius_norm()
+            << ' ' << rhs_ref.l2_norm() << ')' << std::endl;
+
+    FullMatrix<double> full(n_dofs, n_dofs);
+    Vector<double>     rhs_full(n_dofs);
+    assemble(constraints, &cache, cells, full, rhs_full);
+    FullMatrix<double> full_ref;
+    full_ref.copy_from(matrix_ref);
+    full.add(-1., full_ref);
+    rhs_full -= rhs_ref;
+    deallog << "FullMatrix difference: " << full.frobenius_norm() << ' '
+            << rhs_full.l2_norm() << std::endl;
+  }
+
+  // block matrix
+  {
+    const std::vector<types::global_dof_index> block_sizes = {n_dofs / 2,
+                                                              n_dofs / 2};
+    BlockDynamicSparsityPattern block_dsp(block_sizes, block_sizes);
+    for (const auto &cell : cells)
+      constraints.add_entries_local_to_global(cell, block_dsp, false);
+    BlockSparsityPattern block_sparsity;
+    block_sparsity.copy_from(block_dsp);
+
+    BlockSparseMatrix<double> matrix_ref(block_sparsity),
+      matrix(block_sparsity);
+    BlockVector<double> rhs_ref(block_sizes), rhs(block_sizes);
+    assemble(constraints, nullptr, cells, matrix_ref, rhs_ref);
+    assemble(constraints, &cache, cells, matrix, rhs);
+
+    double difference = 0;
+    for (unsigned int i = 0; i < n_dofs; ++i)
+      for (unsigned int j = 0; j < n_dofs; ++j)
+        difference += std::abs(matrix.el(i, j) - matrix_ref.el(i, j));
+    rhs -= rhs_ref;
+    deallog << "BlockSparseMatrix difference: " << difference << ' '
+            << rhs.l2_norm() << std::endl;
+  }
+}
@@ -0,0 +1,103 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Solve the five-point finite difference discretization of the Laplace
+// equation on the unit square with SolverCG and PreconditionAMG. The
+// boundary unknowns are kept in the system as rows with only a diagonal
+// entry. The number of iterations should not depend on the mesh size.
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/precondition_amg.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+void
+test(const unsigned int n)
+{
+  const unsigned int size = (n + 1) * (n + 1);
+
+  const auto is_boundary = [n](const unsigned int i, const unsigned int j) {
+    return i == 0 || j == 0 || i == n || j == n;
+  };
+
+  DynamicSparsityPattern dsp(size, size);
+  for (unsigned int j = 0; j <= n; ++j)
+    for (unsigned int i = 0; i <= n; ++i)
+      {
+        const unsigned int row = i + (n + 1) * j;
+        dsp.add(row, row);
+        if (is_boundary(i, j) == false)
+          for (const unsigned int neighbor :
+               {row - 1, row + 1, row - (n + 1), row + (n + 1)})
+            dsp.add(row, neighbor);
+      }
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  SparseMatrix<double> matrix(sparsity);
+  Vector<double>       rhs(size), solution(size);
+  for (unsigned int j = 0; j <= n; ++j)
+    for (unsigned int i = 0; i <= n; ++i)
+      {
+        const unsigned int row = i + (n + 1) * j;
+        if (is_boundary(i, j))
+          matrix.set(row, row, 1.);
+        else
+          {
+            matrix.set(row, row, 4.);
+            for (const unsigned int neighbor :
+                 {row - 1, row + 1, row - (n + 1), row + (n + 1)})
+              if (is_boundary(neighbor % (n + 1), neighbor / (n + 1)) == false)
+                matrix.set(row, neighbor, -1.);
+            rhs(row) = 1.;
+          }
+      }
+
+  PreconditionAMG amg;
+  amg.initialize(matrix);
+  deallog << "n=" << n << ": " << amg.n_levels() << " levels with sizes";
+  for (unsigned int level = 0; level < amg.n_levels(); ++level)
+    deallog << ' ' << amg.get_matrix(level).m();
+  deallog << std::endl;
+
+  SolverControl            control(100, 1e-10 * rhs.l2_norm());
+  SolverCG<Vector<double>> solver(control);
+  check_solver_within_range(solver.solve(matrix, solution, rhs, amg),
+                            control.last_step(),
+                            10,
+                            20);
+
+  Vector<double> residual(size);
+  AssertThrow(matrix.residual(residual, solution, rhs) <=
+                1e-10 * rhs.l2_norm(),
+              ExcInternalError());
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test(32);
+  test(64);
+  test(128);
+  test(256);
+}
@@ -0,0 +1,113 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// check SparseMatrix::triple_product for a sparse fine-level matrix and a
+// piecewise constant prolongation with R = P^T, both by comparing with two
+// calls to SparseMatrix::mmult and by multiplying with a vector. then check
+// that the numeric product can be repeated on the sparsity pattern computed
+// before
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+void
+test(const unsigned int n, const unsigned int n_coarse)
+{
+  // a 1d Laplacian-like matrix with some random couplings
+  DynamicSparsityPattern dsp(n, n);
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      dsp.add(i, i);
+      if (i > 0)
+        dsp.add(i, i - 1);
+      if (i + 1 < n)
+        dsp.add(i, i + 1);
+      dsp.add(i, Testing::rand() % n);
+    }
+  SparsityPattern sp_A;
+  sp_A.copy_from(dsp);
+  SparseMatrix<double> A(sp_A);
+  for (unsigned int i = 0; i < n; ++i)
+    for (auto entry = A.begin(i); entry != A.end(i); ++entry)
+      entry->value() = 1. + Testing::rand() % 10;
+
+  // aggregate consecutive fine indices into coarse ones
+  DynamicSparsityPattern dsp_P(n, n_coarse), dsp_R(n_coarse, n);
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      dsp_P.add(i, i * n_coarse / n);
+      dsp_R.add(i * n_coarse / n, i);
+    }
+  SparsityPattern sp_P, sp_R;
+  sp_P.copy_from(dsp_P);
+  sp_R.copy_from(dsp_R);
+  SparseMatrix<double> P(sp_P), R(sp_R);
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      P.set(i, i * n_coarse / n, 1.);
+      R.set(i * n_coarse / n, i, 1.);
+    }
+
+  SparsityPattern      sp_C;
+  SparseMatrix<double> C(sp_C);
+  A.triple_product(C, R, P);
+
+  SparsityPattern      sp_RA, sp_RAP;
+  SparseMatrix<double> RA(sp_RA), RAP(sp_RAP);
+  R.mmult(RA, A);
+  RA.mmult(RAP, P);
+
+  deallog << "n=" << n << ": " << C.m() << 'x' << C.n() << " with "
+          << C.n_nonzero_elements() << " entries, same pattern as mmult: "
+          << (sp_C == sp_RAP ? "yes" : "no") << std::endl;
+
+  Vector<double> x(n_coarse), y(n_coarse), z(n_coarse), tmp1(n), tmp2(n);
+  for (unsigned int j = 0; j < n_coarse; ++j)
+    x(j) = Testing::rand() % 10;
+
+  C.vmult(y, x);
+  RAP.vmult(z, x);
+  z -= y;
+  AssertThrow(z.l2_norm() <= 1e-12 * y.l2_norm(), ExcInternalError());
+
+  P.vmult(tmp1, x);
+  A.vmult(tmp2, tmp1);
+  R.vmult(z, tmp2);
+  z -= y;
+  AssertThrow(z.l2_norm() <= 1e-12 * y.l2_norm(), ExcInternalError());
+
+  // repeat the numeric product only, for a changed fine-level matrix
+  A *= 2.;
+  C = 0;
+  A.triple_product(C, R, P, false);
+  C.vmult(z, x);
+  z.add(-2., y);
+  AssertThrow(z.l2_norm() <= 1e-12 * y.l2_norm(), ExcInternalError());
+
+  deallog << "OK" << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  test(10, 3);
+  test(1000, 100);
+}
@@ -0,0 +1,187 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Test MappingQCache::update() for a displacement field that changes only in
+// a part of the domain, by comparing with a cache that is initialized from
+// scratch, and test the storage of the support points in single precision.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/fe/mapping_q_cache.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+double
+compare(const Mapping<dim>       &mapping_1,
+        const Mapping<dim>       &mapping_2,
+        const Triangulation<dim> &tria,
+        const FiniteElement<dim> &fe,
+        const Quadrature<dim>    &quadrature)
+{
+  FEValues<dim> fe_values_1(mapping_1,
+                            fe,
+                            quadrature,
+                            update_quadrature_points | update_JxW_values);
+  FEValues<dim> fe_values_2(mapping_2,
+                            fe,
+                            quadrature,
+                            update_quadrature_points | update_JxW_values);
+
+  double error = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      fe_values_1.reinit(cell);
+      fe_values_2.reinit(cell);
+      for (const unsigned int q : fe_values_1.quadrature_point_indices())
+        error = std::max({error,
+                          fe_values_1.quadrature_point(q).distance(
+                            fe_values_2.quadrature_point(q)),
+                          std::abs(fe_values_1.JxW(q) - fe_values_2.JxW(q)) /
+                            fe_values_1.JxW(q)});
+    }
+  return error;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int degree)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+
+  const FESystem<dim> fe(FE_Q<dim>(degree), dim);
+  DoFHandler<dim>     dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  const MappingQ<dim> mapping(degree);
+  const QGauss<dim>   quadrature(degree + 1);
+
+  Vector<double> displacement(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < displacement.size(); ++i)
+    displacement(i) = 0.01 * std::sin(1. + i);
+
+  MappingQCache<dim> mapping_cache(degree);
+  mapping_cache.initialize(mapping, dof_handler, displacement, true);
+
+  // change the displacement on the degrees of freedom of the cells in the
+  // left half of the domain, and collect all cells touching these degrees
+  // of freedom
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+  std::vector<bool>                    dof_changed(dof_handler.n_dofs(), false);
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    if (cell->center()[0] < 0)
+      {
+        cell->get_dof_indices(dof_indices);
+        for (const types::global_dof_index i : dof_indices)
+          {
+            displacement(i) += 0.02 * std::cos(1. + i);
+            dof_changed[i] = true;
+          }
+      }
+  std::vector<typename Triangulation<dim>::cell_iterator> changed_cells;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      cell->get_dof_indices(dof_indices);
+      for (const types::global_dof_index i : dof_indices)
+        if (dof_changed[i])
+          {
+            changed_cells.push_back(cell);
+            break;
+          }
+    }
+  mapping_cache.update(mapping, dof_handler, displacement, true, changed_cells);
+
+  MappingQCache<dim> mapping_reference(degree);
+  mapping_reference.initialize(mapping, dof_handler, displacement, true);
+
+  MappingQCache<dim> mapping_float(degree, true);
+  mapping_float.initialize(mapping, dof_handler, displacement, true);
+
+  deallog << "dim=" << dim << " degree=" << degree << ": updated "
+          << changed_cells.size() << " of " << tria.n_active_cells()
+          << " cells, update "
+          << (compare(mapping_cache, mapping_reference, tria, fe, quadrature) <
+                  1e-14 ?
+                "OK" :
+                "wrong")
+          << ", float storage "
+          << (compare(mapping_float, mapping_reference, tria, fe, quadrature) <
+                  1e-4 ?
+                "OK" :
+                "wrong")
+          << ", memory ratio "
+          << (mapping_float.memory_consumption() <
+                  0.75 * mapping_reference.memory_consumption() ?
+                "OK" :
+                "wrong")
+          << std::endl;
+
+  // update via a function that shifts the cells with a positive
+  // y-coordinate, starting from the cache set up for all cells
+  const FE_Q<dim> fe_support(QGaussLobatto<1>(degree + 1));
+  Tensor<1, dim>  shift;
+  shift[0] = 0.1;
+  const auto shifted_points =
+    [&](const typename Triangulation<dim>::cell_iterator &cell) {
+      std::vector<Point<dim>> points;
+      for (const Point<dim> &p : fe_support.get_unit_support_points())
+        points.push_back(mapping.transform_unit_to_real_cell(cell, p) +
+                         (cell->center()[1] > 0 ? shift : Tensor<1, dim>()));
+      return points;
+    };
+  std::vector<typename Triangulation<dim>::cell_iterator> upper_cells;
+  for (const auto &cell : tria.cell_iterators())
+    if (cell->center()[1] > 0)
+      upper_cells.push_back(cell);
+
+  MappingQCache<dim> mapping_shifted(degree, true);
+  mapping_shifted.initialize(mapping, tria);
+  mapping_shifted.update(upper_cells, shifted_points);
+  mapping_reference.initialize(tria, shifted_points);
+  deallog << "dim=" << dim << " degree=" << degree
+          << ": update by function with float storage "
+          << (compare(
+                mapping_shifted, mapping_reference, tria, fe, quadrature) <
+                  1e-4 ?
+                "OK" :
+                "wrong")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(2);
+  test<2>(3);
+  test<3>(2);
+}
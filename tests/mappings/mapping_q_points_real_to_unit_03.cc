@@ -0,0 +1,147 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Check MappingQ::transform_points_real_to_unit_cell() with initial guesses
+// for points that moved by a small distance, compared to the variant without
+// initial guesses, and check that the statistics of the Newton iterations
+// show fewer iterations with the initial guesses. Also check that initial
+// guesses far away from the solution still give the correct result, as do
+// guesses that are signaling NaNs, which must be ignored.
+
+#include <deal.II/base/signaling_nan.h>
+
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int degree)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+
+  const MappingQ<dim> mapping(degree);
+
+  // create points with known reference coordinates on each cell and move
+  // them by a small distance
+  const unsigned int                   n_points = 11;
+  std::vector<std::vector<Point<dim>>> old_unit_points, real_points;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      old_unit_points.emplace_back(n_points);
+      real_points.emplace_back(n_points);
+      for (unsigned int i = 0; i < n_points; ++i)
+        {
+          for (unsigned int d = 0; d < dim; ++d)
+            old_unit_points.back()[i][d] = 0.1 + 0.8 * random_value<double>();
+          real_points.back()[i] =
+            mapping.transform_unit_to_real_cell(cell,
+                                                old_unit_points.back()[i]);
+          for (unsigned int d = 0; d < dim; ++d)
+            real_points.back()[i][d] += 1e-6 * cell->diameter() * (d + 1.);
+        }
+    }
+
+  std::vector<std::vector<Point<dim>>> unit_points(
+    tria.n_active_cells(), std::vector<Point<dim>>(n_points));
+  for (const auto &cell : tria.active_cell_iterators())
+    mapping.transform_points_real_to_unit_cell(
+      cell,
+      real_points[cell->active_cell_index()],
+      unit_points[cell->active_cell_index()]);
+  const auto statistics_without_guess =
+    mapping.get_inverse_mapping_statistics();
+  mapping.reset_inverse_mapping_statistics();
+
+  std::vector<Point<dim>> unit_points_guess(n_points);
+  double                  error_close = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      const unsigned int c = cell->active_cell_index();
+      mapping.transform_points_real_to_unit_cell(cell,
+                                                 real_points[c],
+                                                 old_unit_points[c],
+                                                 unit_points_guess);
+      for (unsigned int i = 0; i < n_points; ++i)
+        error_close =
+          std::max(error_close,
+                   unit_points[c][i].distance(unit_points_guess[i]));
+    }
+  const auto statistics_with_guess = mapping.get_inverse_mapping_statistics();
+
+  std::vector<Point<dim>> far_guesses(n_points);
+  for (unsigned int i = 0; i < n_points; ++i)
+    for (unsigned int d = 0; d < dim; ++d)
+      far_guesses[i][d] = (i % 2 == 0 ? -2. : 3.);
+  double error_far = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      const unsigned int c = cell->active_cell_index();
+      mapping.transform_points_real_to_unit_cell(cell,
+                                                 real_points[c],
+                                                 far_guesses,
+                                                 unit_points_guess);
+      for (unsigned int i = 0; i < n_points; ++i)
+        error_far =
+          std::max(error_far, unit_points[c][i].distance(unit_points_guess[i]));
+    }
+
+  // some of the guesses are missing, as for particles whose reference
+  // location has not been computed yet
+  double error_nan = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      const unsigned int      c = cell->active_cell_index();
+      std::vector<Point<dim>> nan_guesses(old_unit_points[c]);
+      for (unsigned int i = 0; i < n_points; i += 3)
+        nan_guesses[i] = numbers::signaling_nan<Point<dim>>();
+      mapping.transform_points_real_to_unit_cell(cell,
+                                                 real_points[c],
+                                                 nan_guesses,
+                                                 unit_points_guess);
+      for (unsigned int i = 0; i < n_points; ++i)
+        error_nan =
+          std::max(error_nan, unit_points[c][i].distance(unit_points_guess[i]));
+    }
+
+  deallog << "dim=" << dim << " degree=" << degree << ": "
+          << statistics_with_guess.n_points << " points, "
+          << statistics_with_guess.n_failed << " failed, "
+          << "fewer iterations with guesses: "
+          << (statistics_with_guess.n_newton_iterations <
+                  statistics_without_guess.n_newton_iterations ?
+                "yes" :
+                "no")
+          << ", error close guesses " << (error_close < 1e-10 ? "OK" : "wrong")
+          << ", error far guesses " << (error_far < 1e-10 ? "OK" : "wrong")
+          << ", error NaN guesses " << (error_nan < 1e-10 ? "OK" : "wrong")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(1);
+  test<2>(3);
+  test<3>(2);
+}
@@ -0,0 +1,127 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+
+// Check that DoFHandler::distribute_dofs() and DoFHandler::renumber_dofs()
+// on a distributed triangulation with hanging nodes and several finite
+// elements leave every ghost cell with the same DoF indices as the cell has
+// on its owner. The comparison uses GridTools::exchange_cell_data_to_ghosts()
+// rather than the communication pattern of the DoFHandler itself.
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_description.h>
+
+#include <deal.II/hp/fe_collection.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+check_ghost_indices(const DoFHandler<dim> &dof_handler)
+{
+  using cell_iterator = typename DoFHandler<dim>::active_cell_iterator;
+  using DataType      = std::vector<types::global_dof_index>;
+
+  unsigned int n_ghosts = 0, n_mismatches = 0;
+  GridTools::exchange_cell_data_to_ghosts<DataType, DoFHandler<dim>>(
+    dof_handler,
+    [](const cell_iterator &cell) {
+      DataType dof_indices(cell->get_fe().n_dofs_per_cell());
+      cell->get_dof_indices(dof_indices);
+      return dof_indices;
+    },
+    [&](const cell_iterator &cell, const DataType &owner_indices) {
+      DataType dof_indices(cell->get_fe().n_dofs_per_cell());
+      cell->get_dof_indices(dof_indices);
+      ++n_ghosts;
+      if (dof_indices != owner_indices)
+        ++n_mismatches;
+    });
+
+  deallog << "n_dofs: " << dof_handler.n_dofs()
+          << ", n_locally_owned_dofs: " << dof_handler.n_locally_owned_dofs()
+          << ", ghost cells: " << n_ghosts << ", mismatches: " << n_mismatches
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test(const MPI_Comm comm)
+{
+  Triangulation<dim> basetria;
+  GridGenerator::hyper_cube(basetria);
+  basetria.refine_global(2);
+  for (unsigned int step = 0; step < 2; ++step)
+    {
+      for (const auto &cell : basetria.active_cell_iterators())
+        if (cell->center()[0] < 0.4 && cell->center()[1] < 0.6)
+          cell->set_refine_flag();
+      basetria.execute_coarsening_and_refinement();
+    }
+  GridTools::partition_triangulation_zorder(
+    Utilities::MPI::n_mpi_processes(comm), basetria);
+
+  parallel::fullydistributed::Triangulation<dim> tria(comm);
+  tria.create_triangulation(
+    TriangulationDescription::Utilities::create_description_from_triangulation(
+      basetria, comm));
+
+  hp::FECollection<dim> fe_collection;
+  for (unsigned int degree = 1; degree <= 3; ++degree)
+    fe_collection.push_back(FE_Q<dim>(degree));
+
+  DoFHandler<dim> dof_handler(tria);
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        const Point<dim> center = cell->center();
+        cell->set_active_fe_index(
+          static_cast<unsigned int>(4 * center[0] + 2 * center[1]) %
+          fe_collection.size());
+      }
+  dof_handler.distribute_dofs(fe_collection);
+  check_ghost_indices(dof_handler);
+
+  DoFRenumbering::Cuthill_McKee(dof_handler);
+  check_ghost_indices(dof_handler);
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  deallog.push("2d");
+  test<2>(MPI_COMM_WORLD);
+  deallog.pop();
+  deallog.push("3d");
+  test<3>(MPI_COMM_WORLD);
+  deallog.pop();
+}
@@ -0,0 +1,149 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+// Check FEValues::get_function_values() and get_function_gradients() for a
+// Vector, a LinearAlgebra::distributed::Vector whose locally owned range
+// does not start at zero on all processes (so that the local indices differ
+// from the global ones), and a BlockVector, as well as the variants taking
+// several vectors at once, against summing up the shape values and
+// gradients. Every process holds the whole mesh.
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int degree)
+{
+  const unsigned int my_id   = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+
+  const FE_Q<dim> fe(degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  const types::global_dof_index n_dofs = dof_handler.n_dofs();
+
+  // split the degrees of freedom into contiguous ranges, and let all other
+  // ones be ghosts
+  IndexSet owned(n_dofs), relevant(n_dofs);
+  owned.add_range(my_id * n_dofs / n_procs, (my_id + 1) * n_dofs / n_procs);
+  relevant.add_range(0, n_dofs);
+
+  Vector<double>                             serial(n_dofs), serial_2(n_dofs);
+  LinearAlgebra::distributed::Vector<double> distributed(owned,
+                                                         relevant,
+                                                         MPI_COMM_WORLD);
+  BlockVector<double> block(std::vector<types::global_dof_index>{n_dofs / 2,
+                                                                 n_dofs -
+                                                                   n_dofs / 2});
+  for (types::global_dof_index i = 0; i < n_dofs; ++i)
+    {
+      serial(i)   = std::sin(1. + i);
+      serial_2(i) = std::cos(2. * i);
+      block(i)    = serial_2(i);
+    }
+  for (const types::global_dof_index i : owned)
+    distributed(i) = serial(i);
+  distributed.update_ghost_values();
+
+  const MappingQ<dim> mapping(2);
+  const QGauss<dim>   quadrature(degree + 1);
+  const UpdateFlags   flags = update_values | update_gradients;
+  FEValues<dim>       fe_values(mapping, fe, quadrature, flags);
+
+  const unsigned int          n_q_points = quadrature.size();
+  std::vector<double>         values(n_q_points);
+  std::vector<Tensor<1, dim>> gradients(n_q_points);
+  std::vector<std::vector<double>> multiple_values(
+    3, std::vector<double>(n_q_points));
+  std::vector<std::vector<Tensor<1, dim>>> multiple_gradients(
+    3, std::vector<Tensor<1, dim>>(n_q_points));
+  const std::vector<const ReadVector<double> *> vectors = {&serial,
+                                                           &distributed,
+                                                           &block};
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+
+  double error = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      cell->get_dof_indices(dof_indices);
+      fe_values.get_function_values(vectors, multiple_values);
+      fe_values.get_function_gradients(vectors, multiple_gradients);
+
+      for (unsigned int v = 0; v < vectors.size(); ++v)
+        {
+          const Vector<double> &reference = (v == 2 ? serial_2 : serial);
+          fe_values.get_function_values(*vectors[v], values);
+          fe_values.get_function_gradients(*vectors[v], gradients);
+
+          for (const unsigned int q : fe_values.quadrature_point_indices())
+            {
+              double         value = 0;
+              Tensor<1, dim> gradient;
+              for (const unsigned int i : fe_values.dof_indices())
+                {
+                  value += reference(dof_indices[i]) *
+                           fe_values.shape_value(i, q);
+                  gradient += reference(dof_indices[i]) *
+                              fe_values.shape_grad(i, q);
+                }
+              error = std::max({error,
+                                std::abs(values[q] - value),
+                                std::abs(multiple_values[v][q] - value),
+                                (gradients[q] - gradient).norm() *
+                                  cell->diameter(),
+                                (multiple_gradients[v][q] - gradient).norm() *
+                                  cell->diameter()});
+            }
+        }
+    }
+
+  error = Utilities::MPI::max(error, MPI_COMM_WORLD);
+  deallog << fe.get_name() << ": " << (error < 1e-12 ? "OK" : "wrong")
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log;
+
+  test<2>(1);
+  test<2>(3);
+  test<3>(2);
+}
@@ -0,0 +1,167 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+
+// save a triangulation with fixed and variable size data attached
+// asynchronously (see Triangulation::set_asynchronous_save()), and load it
+// with a different number of cpus
+
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+std::vector<char>
+pack_center(
+  const typename parallel::distributed::Triangulation<dim>::cell_iterator
+    &cell,
+  const CellStatus)
+{
+  return Utilities::pack(cell->center(), /*allow_compression=*/false);
+}
+
+
+
+template <int dim>
+std::vector<char>
+pack_id(
+  const typename parallel::distributed::Triangulation<dim>::cell_iterator
+    &cell,
+  const CellStatus)
+{
+  const std::string id = cell->id().to_string();
+  return std::vector<char>(id.begin(), id.end());
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  const unsigned int myid = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  MPI_Comm           com_small;
+
+  // split the communicator in proc 0,1,2 and 3,4
+  MPI_Comm_split(MPI_COMM_WORLD, (myid < 3) ? 0 : 1, myid, &com_small);
+
+  // write with small com
+  if (myid < 3)
+    {
+      parallel::distributed::Triangulation<dim> tr(com_small);
+      GridGenerator::subdivided_hyper_cube(tr, 2);
+      tr.refine_global(2);
+      for (const auto &cell : tr.active_cell_iterators())
+        if (cell->is_locally_owned() && cell->center()[0] < 0.3)
+          cell->set_refine_flag();
+      tr.execute_coarsening_and_refinement();
+
+      tr.register_data_attach(pack_center<dim>,
+                              /*returns_variable_size_data=*/false);
+      tr.register_data_attach(pack_id<dim>,
+                              /*returns_variable_size_data=*/true);
+
+      tr.set_asynchronous_save(true);
+      tr.save("file");
+
+      if (myid == 0)
+        deallog << "writing with " << Utilities::MPI::n_mpi_processes(com_small)
+                << ", #cells = " << tr.n_global_active_cells() << std::endl;
+
+      // the mesh can be modified while the data is being written
+      tr.refine_global(1);
+
+      tr.wait_for_asynchronous_save();
+    }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  {
+    parallel::distributed::Triangulation<dim> tr(MPI_COMM_WORLD);
+
+    GridGenerator::subdivided_hyper_cube(tr, 2);
+    tr.load("file");
+
+    const unsigned int handle_center =
+      tr.register_data_attach(pack_center<dim>,
+                              /*returns_variable_size_data=*/false);
+    const unsigned int handle_id =
+      tr.register_data_attach(pack_id<dim>,
+                              /*returns_variable_size_data=*/true);
+
+    using cell_iterator =
+      typename parallel::distributed::Triangulation<dim>::cell_iterator;
+
+    unsigned int n_errors = 0;
+    tr.notify_ready_to_unpack(
+      handle_center,
+      [&](const cell_iterator &cell,
+          const CellStatus,
+          const boost::iterator_range<std::vector<char>::const_iterator>
+            &data_range) {
+        const Point<dim> center =
+          Utilities::unpack<Point<dim>>(data_range.begin(),
+                                        data_range.end(),
+                                        /*allow_compression=*/false);
+        if (center.distance(cell->center()) > 1e-12)
+          ++n_errors;
+      });
+    tr.notify_ready_to_unpack(
+      handle_id,
+      [&](const cell_iterator &cell,
+          const CellStatus,
+          const boost::iterator_range<std::vector<char>::const_iterator>
+            &data_range) {
+        if (std::string(data_range.begin(), data_range.end()) !=
+            cell->id().to_string())
+          ++n_errors;
+      });
+
+    n_errors = Utilities::MPI::sum(n_errors, MPI_COMM_WORLD);
+
+    if (myid == 0)
+      deallog << "reading with "
+              << Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD)
+              << ", #cells = " << tr.n_global_active_cells()
+              << ", #errors = " << n_errors << std::endl;
+  }
+
+  MPI_Comm_free(&com_small);
+
+  if (myid == 0)
+    deallog << "OK" << std::endl;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log;
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
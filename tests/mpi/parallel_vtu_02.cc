@@ -0,0 +1,107 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+
+// write a vtu file with DataOutInterface::write_vtu_in_parallel() using
+// aggregation, and check that the file is the same as the one written
+// without aggregation
+
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/mpi.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+#include "../data_out/patches.h"
+
+
+
+std::vector<DataOutBase::Patch<2, 2>> patches;
+std::vector<std::string>              names;
+
+class DataOutX : public DataOutInterface<2, 2>
+{
+  virtual const std::vector<::DataOutBase::Patch<2, 2>> &
+  get_patches() const
+  {
+    return patches;
+  }
+
+  virtual std::vector<std::string>
+  get_dataset_names() const
+  {
+    return names;
+  }
+};
+
+
+
+std::string
+read_file(const std::string &filename)
+{
+  std::ifstream     in(filename);
+  std::stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+
+
+void
+check(const DataOutBase::CompressionLevel compression_level)
+{
+  const unsigned int myid = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  // give every process a different number of patches, and the second one
+  // none at all
+  patches.resize(myid == 1 ? 0 : myid + 1);
+  create_patches(patches);
+
+  DataOutX              x;
+  DataOutBase::VtkFlags vtk_flags;
+  vtk_flags.compression_level = compression_level;
+  x.set_flags(vtk_flags);
+
+  x.write_vtu_in_parallel("reference.vtu", MPI_COMM_WORLD);
+  for (const unsigned int n_aggregators : {1, 2, 100, 0})
+    {
+      x.write_vtu_in_parallel("aggregated.vtu", MPI_COMM_WORLD, n_aggregators);
+      MPI_Barrier(MPI_COMM_WORLD);
+
+      if (myid == 0)
+        deallog << "n_aggregators = " << n_aggregators << ": "
+                << (read_file("aggregated.vtu") ==
+                        read_file("reference.vtu") ?
+                      "identical" :
+                      "different")
+                << std::endl;
+    }
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log;
+
+  names = {"x1", "x2", "x3", "x4", "i"};
+
+  check(DataOutBase::CompressionLevel::no_compression);
+  check(DataOutBase::CompressionLevel::best_speed);
+}
@@ -0,0 +1,177 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark that measures the effect of the numbering of the
+// degrees of freedom on sparse matrix operations. For the matrix of the
+// operator -Delta + 1 discretized with FE_Q(2) elements on a
+// three-dimensional ball, the matrix-vector product and the setup and
+// application of a SparseILU preconditioner are timed with the numbering
+// created by DoFHandler::distribute_dofs() and after renumbering with
+// DoFRenumbering::Cuthill_McKee(), DoFRenumbering::reverse_Cuthill_McKee(),
+// and DoFRenumbering::hilbert_curve().
+//
+// Status: experimental
+//
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <string>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+static constexpr unsigned int n_products = 50;
+
+static const std::vector<std::string> orderings = {"default",
+                                                   "cuthill_mckee",
+                                                   "reverse_cuthill_mckee",
+                                                   "hilbert_curve"};
+
+
+void
+renumber(DoFHandler<3> &dof_handler, const std::string &ordering)
+{
+  if (ordering == "cuthill_mckee")
+    DoFRenumbering::Cuthill_McKee(dof_handler);
+  else if (ordering == "reverse_cuthill_mckee")
+    DoFRenumbering::reverse_Cuthill_McKee(dof_handler);
+  else if (ordering == "hilbert_curve")
+    DoFRenumbering::hilbert_curve(dof_handler);
+}
+
+
+
+void
+assemble_matrix(const DoFHandler<3> &dof_handler, SparseMatrix<double> &matrix)
+{
+  const FiniteElement<3> &fe = dof_handler.get_fe();
+
+  FEValues<3> fe_values(fe,
+                        QGauss<3>(fe.degree + 1),
+                        update_values | update_gradients | update_JxW_values);
+
+  FullMatrix<double> cell_matrix(fe.n_dofs_per_cell(), fe.n_dofs_per_cell());
+  std::vector<types::global_dof_index> local_dof_indices(fe.n_dofs_per_cell());
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      cell_matrix = 0;
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        for (const unsigned int i : fe_values.dof_indices())
+          for (const unsigned int j : fe_values.dof_indices())
+            cell_matrix(i, j) +=
+              (fe_values.shape_grad(i, q) * fe_values.shape_grad(j, q) +
+               fe_values.shape_value(i, q) * fe_values.shape_value(j, q)) *
+              fe_values.JxW(q);
+
+      cell->get_dof_indices(local_dof_indices);
+      matrix.add(local_dof_indices, cell_matrix);
+    }
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  std::vector<std::string> names;
+  for (const std::string &ordering : orderings)
+    {
+      names.push_back(ordering + "_spmv");
+      names.push_back(ordering + "_ilu_setup");
+      names.push_back(ordering + "_ilu_apply");
+    }
+
+  return {Metric::timing, 4, names};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  Triangulation<3> triangulation;
+  GridGenerator::hyper_ball(triangulation);
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        triangulation.refine_global(2);
+        break;
+      case TestingEnvironment::medium:
+        triangulation.refine_global(3);
+        break;
+      case TestingEnvironment::heavy:
+        triangulation.refine_global(4);
+        break;
+    }
+
+  const FE_Q<3> fe(2);
+
+  Measurement measurement(std::initializer_list<double>{});
+  for (const std::string &ordering : orderings)
+    {
+      DoFHandler<3> dof_handler(triangulation);
+      dof_handler.distribute_dofs(fe);
+      renumber(dof_handler, ordering);
+
+      DynamicSparsityPattern dsp(dof_handler.n_dofs());
+      DoFTools::make_sparsity_pattern(dof_handler, dsp);
+      SparsityPattern sparsity_pattern;
+      sparsity_pattern.copy_from(dsp);
+
+      SparseMatrix<double> matrix(sparsity_pattern);
+      assemble_matrix(dof_handler, matrix);
+
+      Vector<double> src(dof_handler.n_dofs()), dst(dof_handler.n_dofs());
+      for (unsigned int i = 0; i < src.size(); ++i)
+        src(i) = static_cast<double>(i % 17) / 17.;
+
+      Timer timer;
+      for (unsigned int i = 0; i < n_products; ++i)
+        matrix.vmult(dst, src);
+      measurement.timing.push_back(timer.wall_time());
+
+      timer.restart();
+      SparseILU<double> ilu;
+      ilu.initialize(matrix);
+      measurement.timing.push_back(timer.wall_time());
+
+      timer.restart();
+      for (unsigned int i = 0; i < n_products; ++i)
+        ilu.vmult(dst, src);
+      measurement.timing.push_back(timer.wall_time());
+    }
+
+  return measurement;
+}
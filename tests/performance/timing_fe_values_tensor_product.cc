@@ -0,0 +1,137 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+//
+// Description:
+//
+// A performance benchmark that measures the time to evaluate the values and
+// gradients of a finite element function with FEValues::get_function_values()
+// and FEValues::get_function_gradients() for FE_Q elements of degree 2 to 8
+// on a curved three-dimensional mesh. For a tensor-product quadrature
+// formula, these functions use sum factorization; for comparison, the same
+// quadrature formula without tensor-product structure is evaluated with the
+// tables of shape values and gradients.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <string>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+static constexpr unsigned int min_degree = 2;
+static constexpr unsigned int max_degree = 8;
+
+
+double
+evaluate(const DoFHandler<3>  &dof_handler,
+         const Quadrature<3>  &quadrature,
+         const Vector<double> &solution,
+         const Mapping<3>     &mapping)
+{
+  FEValues<3> fe_values(mapping,
+                        dof_handler.get_fe(),
+                        quadrature,
+                        update_values | update_gradients);
+
+  std::vector<double>       values(quadrature.size());
+  std::vector<Tensor<1, 3>> gradients(quadrature.size());
+
+  Timer timer;
+  timer.stop();
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+
+      timer.start();
+      fe_values.get_function_values(solution, values);
+      fe_values.get_function_gradients(solution, gradients);
+      timer.stop();
+    }
+
+  return timer.wall_time();
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  std::vector<std::string> names;
+  for (unsigned int degree = min_degree; degree <= max_degree; ++degree)
+    {
+      names.push_back("tensor_product_p" + std::to_string(degree));
+      names.push_back("table_p" + std::to_string(degree));
+    }
+
+  return {Metric::timing, 4, names};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  Triangulation<3> triangulation;
+  GridGenerator::hyper_ball(triangulation);
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        break;
+      case TestingEnvironment::medium:
+        triangulation.refine_global(1);
+        break;
+      case TestingEnvironment::heavy:
+        triangulation.refine_global(2);
+        break;
+    }
+
+  Measurement measurement(std::initializer_list<double>{});
+  for (unsigned int degree = min_degree; degree <= max_degree; ++degree)
+    {
+      const FE_Q<3>     fe(degree);
+      const MappingQ<3> mapping(degree);
+      DoFHandler<3>     dof_handler(triangulation);
+      dof_handler.distribute_dofs(fe);
+
+      Vector<double> solution(dof_handler.n_dofs());
+      for (unsigned int i = 0; i < solution.size(); ++i)
+        solution(i) = static_cast<double>(i % 17) / 17.;
+
+      const QGauss<3> quadrature(degree + 1);
+      measurement.timing.push_back(
+        evaluate(dof_handler, quadrature, solution, mapping));
+      measurement.timing.push_back(
+        evaluate(dof_handler,
+                 Quadrature<3>(quadrature.get_points(),
+                               quadrature.get_weights()),
+                 solution,
+                 mapping));
+    }
+
+  return measurement;
+}
@@ -0,0 +1,151 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark that compares the construction of a SparsityPattern
+// for an adaptively refined three-dimensional mesh with hanging node
+// constraints via DoFTools::make_sparsity_pattern() into a
+// DynamicSparsityPattern followed by SparsityPattern::copy_from(), with
+// DoFTools::make_sparsity_pattern_two_pass() that builds the compressed
+// pattern directly. Besides the wall time, the increase of the peak resident
+// memory of the process during the construction is reported in MB (in the
+// same columns as the timings), as measured by resetting the high water mark
+// through /proc/self/clear_refs on Linux.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include <fstream>
+#include <functional>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+
+// Reset the peak resident memory of this process to its current value and
+// return the latter in kB.
+unsigned long int
+reset_peak_memory()
+{
+  {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+  }
+
+  Utilities::System::MemoryStats stats;
+  Utilities::System::get_memory_stats(stats);
+  return stats.VmRSS;
+}
+
+
+
+// Run the given function and return its wall time in seconds and the
+// increase of the peak resident memory during the call in MB.
+std::pair<double, double>
+measure(const std::function<void()> &function)
+{
+  const unsigned long int memory_before = reset_peak_memory();
+
+  Timer timer;
+  function();
+  timer.stop();
+
+  Utilities::System::MemoryStats stats;
+  Utilities::System::get_memory_stats(stats);
+
+  return {timer.wall_time(),
+          (stats.VmHWM > memory_before ? stats.VmHWM - memory_before : 0) /
+            1024.};
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing,
+          4,
+          {"dynamic_sparsity_pattern_time",
+           "dynamic_sparsity_pattern_peak_memory",
+           "two_pass_time",
+           "two_pass_peak_memory"}};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  Triangulation<3> triangulation;
+  GridGenerator::hyper_cube(triangulation);
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        triangulation.refine_global(3);
+        break;
+      case TestingEnvironment::medium:
+        triangulation.refine_global(4);
+        break;
+      case TestingEnvironment::heavy:
+        triangulation.refine_global(5);
+        break;
+    }
+  for (const auto &cell : triangulation.active_cell_iterators())
+    if (cell->center()[0] < 0.5)
+      cell->set_refine_flag();
+  triangulation.execute_coarsening_and_refinement();
+
+  const FE_Q<3>  fe(2);
+  DoFHandler<3> dof_handler(triangulation);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+
+  const auto dynamic = measure([&]() {
+    SparsityPattern sparsity_pattern;
+    {
+      DynamicSparsityPattern dsp(dof_handler.n_dofs());
+      DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
+      sparsity_pattern.copy_from(dsp);
+    }
+  });
+
+  const auto two_pass = measure([&]() {
+    SparsityPattern sparsity_pattern;
+    DoFTools::make_sparsity_pattern_two_pass(dof_handler,
+                                             sparsity_pattern,
+                                             constraints,
+                                             false);
+  });
+
+  return {dynamic.first, dynamic.second, two_pass.first, two_pass.second};
+}
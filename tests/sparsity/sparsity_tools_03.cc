@@ -0,0 +1,137 @@
+// -----------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception OR LGPL-2.1-or-later
+// Copyright (C) 2026 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Detailed license information governing the source code and contributions
+// can be found in LICENSE.md and CONTRIBUTING.md at the top level directory.
+//
+// -----------------------------------------------------------------------------
+
+
+
+// test SparsityTools::find_pseudo_peripheral_index and
+// SparsityTools::reorder_reverse_Cuthill_McKee on the graph of a structured
+// 3d grid plus a disconnected 2d grid, and check that
+// SparsityTools::reorder_Cuthill_McKee gives the same result with one and
+// several threads (the fronts of the 3d grid are large enough to be expanded
+// by several tasks)
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_tools.h>
+
+#include "../tests.h"
+
+
+types::global_dof_index
+bandwidth(const DynamicSparsityPattern               &dsp,
+          const std::vector<types::global_dof_index> &permutation)
+{
+  types::global_dof_index result = 0;
+  for (types::global_dof_index row = 0; row < dsp.n_rows(); ++row)
+    for (unsigned int j = 0; j < dsp.row_length(row); ++j)
+      {
+        const types::global_dof_index a = permutation[row];
+        const types::global_dof_index b =
+          permutation[dsp.column_number(row, j)];
+        result = std::max(result, a > b ? a - b : b - a);
+      }
+  return result;
+}
+
+
+
+bool
+is_permutation(const std::vector<types::global_dof_index> &permutation)
+{
+  std::vector<bool> found(permutation.size(), false);
+  for (const auto p : permutation)
+    {
+      if (p >= permutation.size() || found[p])
+        return false;
+      found[p] = true;
+    }
+  return true;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  // a 3d grid with n^3 nodes and a 7-point stencil, followed by a 2d grid
+  // with m^2 nodes and a 5-point stencil
+  const unsigned int     n = 40, m = 10;
+  const unsigned int     n_3d = n * n * n;
+  DynamicSparsityPattern dsp(n_3d + m * m, n_3d + m * m);
+  for (unsigned int k = 0; k < n; ++k)
+    for (unsigned int j = 0; j < n; ++j)
+      for (unsigned int i = 0; i < n; ++i)
+        {
+          const unsigned int row = i + n * j + n * n * k;
+          dsp.add(row, row);
+          if (i > 0)
+            dsp.add(row, row - 1);
+          if (i + 1 < n)
+            dsp.add(row, row + 1);
+          if (j > 0)
+            dsp.add(row, row - n);
+          if (j + 1 < n)
+            dsp.add(row, row + n);
+          if (k > 0)
+            dsp.add(row, row - n * n);
+          if (k + 1 < n)
+            dsp.add(row, row + n * n);
+        }
+  for (unsigned int j = 0; j < m; ++j)
+    for (unsigned int i = 0; i < m; ++i)
+      {
+        const unsigned int row = n_3d + i + m * j;
+        dsp.add(row, row);
+        if (i > 0)
+          dsp.add(row, row - 1);
+        if (i + 1 < m)
+          dsp.add(row, row + 1);
+        if (j > 0)
+          dsp.add(row, row - m);
+        if (j + 1 < m)
+          dsp.add(row, row + m);
+      }
+
+  // a pseudo-peripheral index must be a corner of the respective grid, no
+  // matter where we start
+  for (const unsigned int start : {0u, n / 2 + n * (n / 2) + n * n * (n / 2)})
+    deallog << "Pseudo-peripheral index from " << start << ": "
+            << SparsityTools::find_pseudo_peripheral_index(dsp, start)
+            << std::endl;
+  deallog << "Pseudo-peripheral index from " << n_3d + m / 2 + m * (m / 2)
+          << ": "
+          << SparsityTools::find_pseudo_peripheral_index(dsp,
+                                                         n_3d + m / 2 +
+                                                           m * (m / 2))
+          << std::endl;
+
+  std::vector<types::global_dof_index> permutation(dsp.n_rows());
+  SparsityTools::reorder_Cuthill_McKee(dsp, permutation);
+  deallog << "Cuthill-McKee: permutation "
+          << (is_permutation(permutation) ? "OK" : "wrong")
+          << ", bandwidth " << bandwidth(dsp, permutation) << std::endl;
+
+  MultithreadInfo::set_thread_limit(1);
+  std::vector<types::global_dof_index> serial_permutation(dsp.n_rows());
+  SparsityTools::reorder_Cuthill_McKee(dsp, serial_permutation);
+  deallog << "Same result with one thread: "
+          << (serial_permutation == permutation ? "yes" : "no") << std::endl;
+  MultithreadInfo::set_thread_limit();
+
+  SparsityTools::reorder_reverse_Cuthill_McKee(dsp, permutation);
+  deallog << "Reverse Cuthill-McKee: permutation "
+          << (is_permutation(permutation) ? "OK" : "wrong")
+          << ", bandwidth " << bandwidth(dsp, permutation) << std::endl;
+}